@@ -24,6 +24,8 @@
 #include <string>
 #include "Environment.h"
 #include <helpers/StringUtils.h>
+#include <helpers/ConstantTadHelper.h>
+#include <helpers/ShapeCache.h>
 
 namespace nd4j {
 
@@ -35,6 +37,13 @@ namespace nd4j {
         _profile.store(false);
         _precBoost.store(false);
         _dataType.store(nd4j::DataType::FLOAT32);
+        _tadCacheLimit.store(4096);
+        _shapeCacheLimit.store(64);
+        _conv2dAlgorithm.store(CONV2D_AUTO);
+        _convTileBytes.store(8L * 1024L * 1024L);
+        _opProfiling.store(false);
+        _workspaceZeroing.store(true);
+        _elementwiseFusion.store(false);
 
 #ifndef ANDROID
         const char* omp_threads = std::getenv("OMP_NUM_THREADS");
@@ -49,6 +58,47 @@ namespace nd4j {
                 // still do nothing
             }
         }
+
+        const char* conv2dAlgo = std::getenv("ND4J_CONV2D_ALGO");
+        if (conv2dAlgo != nullptr) {
+            std::string algo(conv2dAlgo);
+            if (algo == "im2col")
+                _conv2dAlgorithm.store(CONV2D_IM2COL);
+            else if (algo == "winograd")
+                _conv2dAlgorithm.store(CONV2D_WINOGRAD);
+            else if (algo == "direct")
+                _conv2dAlgorithm.store(CONV2D_DIRECT);
+        }
+
+        const char* convTile = std::getenv("ND4J_CONV_TILE_BYTES");
+        if (convTile != nullptr) {
+            try {
+                std::string tile(convTile);
+                _convTileBytes.store(std::stoll(tile));
+            } catch (std::invalid_argument &e) {
+                // just do nothing
+            } catch (std::out_of_range &e) {
+                // still do nothing
+            }
+        }
+
+        const char* opProfiling = std::getenv("ND4J_OP_PROFILING");
+        if (opProfiling != nullptr) {
+            std::string profiling(opProfiling);
+            _opProfiling.store(profiling == "1" || profiling == "true");
+        }
+
+        const char* workspaceZeroing = std::getenv("ND4J_WORKSPACE_ZEROING");
+        if (workspaceZeroing != nullptr) {
+            std::string zeroing(workspaceZeroing);
+            _workspaceZeroing.store(!(zeroing == "0" || zeroing == "false"));
+        }
+
+        const char* elementwiseFusion = std::getenv("ND4J_ELEMENTWISE_FUSION");
+        if (elementwiseFusion != nullptr) {
+            std::string fusion(elementwiseFusion);
+            _elementwiseFusion.store(fusion == "1" || fusion == "true");
+        }
 #endif
     }
 
@@ -130,6 +180,46 @@ namespace nd4j {
         _maxThreads.store(max);
     }
 
+    Conv2dAlgorithm Environment::conv2dAlgorithm() {
+        return static_cast<Conv2dAlgorithm>(_conv2dAlgorithm.load());
+    }
+
+    void Environment::setConv2dAlgorithm(Conv2dAlgorithm algorithm) {
+        _conv2dAlgorithm.store(static_cast<int>(algorithm));
+    }
+
+    Nd4jLong Environment::convTileBytes() {
+        return _convTileBytes.load();
+    }
+
+    void Environment::setConvTileBytes(Nd4jLong bytes) {
+        _convTileBytes.store(bytes);
+    }
+
+    bool Environment::isOpProfiling() {
+        return _opProfiling.load();
+    }
+
+    void Environment::setOpProfiling(bool reallyProfile) {
+        _opProfiling.store(reallyProfile);
+    }
+
+    bool Environment::isWorkspaceZeroing() {
+        return _workspaceZeroing.load();
+    }
+
+    void Environment::setWorkspaceZeroing(bool reallyZero) {
+        _workspaceZeroing.store(reallyZero);
+    }
+
+    bool Environment::isElementwiseFusion() {
+        return _elementwiseFusion.load();
+    }
+
+    void Environment::setElementwiseFusion(bool reallyFuse) {
+        _elementwiseFusion.store(reallyFuse);
+    }
+
     bool Environment::precisionBoostAllowed() {
         return _precBoost.load();
     }
@@ -138,6 +228,49 @@ namespace nd4j {
         _precBoost.store(reallyAllow);
     }
 
+    Nd4jLong Environment::tadCacheLimit() {
+        return _tadCacheLimit.load();
+    }
+
+    void Environment::setTadCacheLimit(Nd4jLong limit) {
+        if (limit < 0)
+            throw std::runtime_error("TAD cache limit can't be negative");
+
+        _tadCacheLimit.store(limit);
+
+        // cache is trimmed lazily on next insertion, but disabling it should release memory right away
+        if (limit == 0)
+            nd4j::ConstantTadHelper::getInstance()->purge();
+    }
+
+    Nd4jLong Environment::tadCacheHits() {
+        return nd4j::ConstantTadHelper::getInstance()->hits();
+    }
+
+    Nd4jLong Environment::tadCacheMisses() {
+        return nd4j::ConstantTadHelper::getInstance()->misses();
+    }
+
+    Nd4jLong Environment::shapeCacheLimit() {
+        return _shapeCacheLimit.load();
+    }
+
+    void Environment::setShapeCacheLimit(Nd4jLong limit) {
+        if (limit < 0)
+            throw std::runtime_error("Shape cache limit can't be negative");
+
+        // per-op caches are trimmed lazily on next insertion
+        _shapeCacheLimit.store(limit);
+    }
+
+    Nd4jLong Environment::shapeCacheHits() {
+        return nd4j::ShapeCache::totalHits();
+    }
+
+    Nd4jLong Environment::shapeCacheMisses() {
+        return nd4j::ShapeCache::totalMisses();
+    }
+
     nd4j::Environment *nd4j::Environment::_instance = 0;
 
 }
@@ -25,8 +25,19 @@
 #include <dll.h>
 #include <stdexcept>
 #include <array/DataType.h>
+#include <pointercast.h>
 
 namespace nd4j{
+    /**
+     * Algorithms available for conv2d on CPU. AUTO picks one by layer shape
+     */
+    enum Conv2dAlgorithm {
+        CONV2D_AUTO = 0,
+        CONV2D_IM2COL = 1,
+        CONV2D_WINOGRAD = 2,
+        CONV2D_DIRECT = 3,
+    };
+
     class ND4J_EXPORT Environment {
     private:
         std::atomic<int> _tadThreshold;
@@ -38,6 +49,13 @@ namespace nd4j{
         std::atomic<nd4j::DataType> _dataType;
         std::atomic<bool> _precBoost;
         std::atomic<bool> _useMKLDNN{true};
+        std::atomic<Nd4jLong> _tadCacheLimit;
+        std::atomic<Nd4jLong> _shapeCacheLimit;
+        std::atomic<int> _conv2dAlgorithm;
+        std::atomic<Nd4jLong> _convTileBytes;
+        std::atomic<bool> _opProfiling;
+        std::atomic<bool> _workspaceZeroing;
+        std::atomic<bool> _elementwiseFusion;
 
 #ifdef __ND4J_EXPERIMENTAL__
         const bool _experimental = true;
@@ -79,6 +97,55 @@ namespace nd4j{
         void allowPrecisionBoost(bool reallyAllow);
 
         bool isExperimentalBuild();
+
+        /**
+         * TAD cache: max number of cached TAD packs, and hit/miss counters. Limit of 0 disables caching.
+         */
+        Nd4jLong tadCacheLimit();
+        void setTadCacheLimit(Nd4jLong limit);
+        Nd4jLong tadCacheHits();
+        Nd4jLong tadCacheMisses();
+
+        /**
+         * Output shapes cache: max number of cached shape sets per op, and hit/miss counters over all ops. Limit of 0 disables caching.
+         */
+        Nd4jLong shapeCacheLimit();
+        void setShapeCacheLimit(Nd4jLong limit);
+        Nd4jLong shapeCacheHits();
+        Nd4jLong shapeCacheMisses();
+
+        /**
+         * conv2d algorithm override, mostly for benchmarking. Can be set via ND4J_CONV2D_ALGO env variable:
+         * auto, im2col, winograd or direct
+         */
+        Conv2dAlgorithm conv2dAlgorithm();
+        void setConv2dAlgorithm(Conv2dAlgorithm algorithm);
+
+        /**
+         * Memory budget for im2col buffers of convolutions, in bytes. Layers that need more are processed in tiles
+         * over (batch, output rows). Can be set via ND4J_CONV_TILE_BYTES env variable, 0 disables tiling
+         */
+        Nd4jLong convTileBytes();
+        void setConvTileBytes(Nd4jLong bytes);
+
+        /**
+         * Per-op profiling of NativeOps calls, see OpProfiler. Can be enabled via ND4J_OP_PROFILING env variable
+         */
+        bool isOpProfiling();
+        void setOpProfiling(bool reallyProfile);
+
+        /**
+         * Whether workspace buffers are zeroed when allocated or grown. Can be disabled via ND4J_WORKSPACE_ZEROING=false,
+         * then memory is committed lazily, as it's touched
+         */
+        bool isWorkspaceZeroing();
+        void setWorkspaceZeroing(bool reallyZero);
+
+        /**
+         * Whether Graph fuses chains of elementwise legacy ops into single pass over memory. Disabled by default, can be enabled via ND4J_ELEMENTWISE_FUSION=true
+         */
+        bool isElementwiseFusion();
+        void setElementwiseFusion(bool reallyFuse);
     };
 }
 
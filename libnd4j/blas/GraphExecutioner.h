@@ -66,10 +66,20 @@ namespace nd4j {
 
         static flatbuffers::Offset<FlatResult> execute(Graph *graph, flatbuffers::FlatBufferBuilder &builder, const FlatInferenceRequest* request);
 
+        /**
+         * This method executes given Graph against external VariableSpace, so Graph itself stays untouched
+         */
+        static flatbuffers::Offset<FlatResult> execute(Graph *graph, VariableSpace *variableSpace, flatbuffers::FlatBufferBuilder &builder, const FlatInferenceRequest* request);
+
         static Graph *importFromTensorFlow(const char *fileName);
 
 
-        static Graph *importFromFlatBuffers(const char *filename);
+        /**
+         * This method reads given FlatBuffers file and returns Graph instance
+         * @param mapped - if true, file is mapped into memory instead of being read, and weights aren't copied out of it,
+         *                 so startup time doesn't depend on model size, and processes share the same page cache
+         */
+        static Graph *importFromFlatBuffers(const char *filename, bool mapped = false);
 
         static Graph *importFromFlatPointer(Nd4jPointer ptr);
     };
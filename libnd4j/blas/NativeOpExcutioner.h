@@ -551,6 +551,13 @@ public:
         BUILD_SINGLE_SELECTOR(xType, nd4j::SpecialMethods, ::sortTadGeneric(x, xShapeInfo, dimension, dimensionLength, tadShapeInfo, tadOffsets, descending), LIBND4J_TYPES);
     }
 
+    static void execSortByKey(void *x, Nd4jLong *xShapeInfo, void *y, Nd4jLong *yShapeInfo, bool descending) {
+        auto xType = nd4j::ArrayOptions::dataType(xShapeInfo);
+        auto yType = nd4j::ArrayOptions::dataType(yShapeInfo);
+
+        BUILD_DOUBLE_SELECTOR(xType, yType, nd4j::DoubleMethods, ::sortByKey(x, xShapeInfo, y, yShapeInfo, descending), LIBND4J_TYPES, LIBND4J_TYPES);
+    }
+
     inline static void execSortCooIndices(Nd4jLong *indices, void *values, Nd4jLong length, int rank) {
         nd4j::sparse::SparseUtils<Nd4jLong>::sortCooIndicesGeneric(indices, reinterpret_cast<Nd4jLong *>(values), length, rank);
     }
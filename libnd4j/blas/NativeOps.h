@@ -1568,6 +1568,16 @@ public:
             bool descending);
 
 
+    /**
+     * Sorts keys x, and moves values y together with them
+     */
+    void sortByKey(Nd4jPointer *extraPointers,
+            void *x, Nd4jLong *xShapeInfo,
+            void *dx, Nd4jLong *dxShapeInfo,
+            void *y, Nd4jLong *yShapeInfo,
+            void *dy, Nd4jLong *dyShapeInfo,
+            bool descending);
+
     // special sort impl for sorting out COO indices and values
     void sortCooIndices(Nd4jPointer *extraPointers, Nd4jLong *indices, void *values, Nd4jLong length, int rank);
 
@@ -1585,6 +1595,21 @@ public:
 
     const char* getAllOperations();
 
+    /**
+     * This method enables or disables per-op profiling of exec* and execCustomOp calls
+     * @param reallyEnable
+     */
+    void enableOpProfiler(bool reallyEnable);
+
+    /**
+     * This method returns per-op stats gathered so far as JSON: calls, total/min/max/percentile wall time,
+     * bytes allocated from workspaces and heap, and input shapes. Returned string must be released via deleteCharArray
+     * @param reset if true, stats are cleared after snapshot
+     */
+    const char* getOpProfilerSnapshot(bool reset);
+
+    void resetOpProfiler();
+
     // customOp executioner
     int execCustomOp(Nd4jPointer* extraPointers, Nd4jLong hash, Nd4jPointer* inputBuffers, Nd4jPointer* inputShapes, int numInputs, Nd4jPointer* outputBuffers, Nd4jPointer* outputShapes, int numOutputs, double* tArgs, int numTArgs, Nd4jLong *iArgs, int numIArgs, bool* bArgs, int numBArgs, bool isInplace);
     nd4j::ShapeList* calculateOutputShapes(Nd4jPointer* extraPointers, Nd4jLong hash, Nd4jPointer* inputShapes, int numInputShapes, double* tArgs, int numTArgs, Nd4jLong *iArgs, int numIArgs);
@@ -1600,6 +1625,7 @@ public:
 
     void deleteIntArray(Nd4jPointer pointer);
     void deleteLongArray(Nd4jPointer pointer);
+    void deleteCharArray(Nd4jPointer pointer);
     void deletePointerArray(Nd4jPointer pointer);
 
     void deleteVariablesSet(Nd4jPointer pointer);
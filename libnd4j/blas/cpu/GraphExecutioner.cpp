@@ -44,6 +44,8 @@
 #include <chrono>
 #include <ctime>
 #include <graph/execution/LogicExecutor.h>
+#include <graph/SynchronizedVariableSpace.h>
+#include <graph/MemoryPlanner.h>
 #include <array/DataTypeUtils.h>
 #include <helpers/BitwiseUtils.h>
 #include <generated/array_generated.h>
@@ -198,6 +200,96 @@ namespace graph {
 }
 
 
+/**
+ * This method checks if given Node should be skipped, due to inactive inputs or divergent branches
+ */
+static bool shouldSkipNode(Graph *graph, Node *node, FlowPath *flowPath) {
+    // result of fused node is computed by node it was fused into
+    if (node->isFused())
+        return true;
+
+    if (node->opType() == OpType_LOGIC && node->opNum() == nd4j::logic::Merge) {
+        // Merge node has own checkout logic
+
+        auto inputId0 = node->input()->at(0);
+        auto inputId1 = node->input()->at(1);
+
+        // Merge node can be skipped only both inputs are inactive
+        return !flowPath->isNodeActive(inputId0.first) && !flowPath->isNodeActive(inputId1.first);
+    }
+
+    // let's check for input nodes, if they are disabled or contain divergents
+    for (int e = 0; e < node->input()->size(); e++) {
+        auto inputId = node->input()->at(e);
+
+        // not a node. skipping checks
+        if (graph->getMapped()->count(inputId.first) == 0)
+            continue;
+
+        /**
+         * We can skip current node, in two cases:
+         * 1) If previous node was disabled
+         * 2) If previous node was divergent node (i.e. IF op) and code went other way
+         */
+        Node *prevNode = graph->getMapped()->at(inputId.first);
+        if (!flowPath->isNodeActive(inputId.first)) {
+            flowPath->markNodeActive(node->id(), false);
+
+            nd4j_debug("Skipping Node_%i due to inactive input [%i]\n", node->id(), inputId.first);
+            return true;
+        } else if (prevNode->isDivergencePoint()) { // literally checking for switch here
+            if (flowPath->branch(inputId.first) != inputId.second) {
+                flowPath->markNodeActive(node->id(), false);
+                nd4j_debug("Skipping Node_%i due to divergent branch [%i]\n", node->id(), inputId.first);
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+/**
+ * This method checks if all nodes of given layer can be executed concurrently:
+ * logic ops, divergence points and embedded graphs change FlowPath state and must be executed sequentially
+ */
+static bool isLayerParallelizable(std::vector<Node*> *layer) {
+    for (auto node: *layer) {
+        if (node->opType() == OpType_LOGIC || node->isDivergencePoint() || node->hasGraphEmbedded() || node->hasExternalOutputs())
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * This method returns id of node which results were reused in-place by given node, or 0 if there's none
+ */
+static int findInplaceSource(Node *node, VariableSpace *variableSpace) {
+    for (int e = 0; variableSpace->hasVariable(node->id(), e); e++) {
+        auto out = variableSpace->getVariable(node->id(), e);
+        if (!out->hasNDArray())
+            continue;
+
+        auto outBuffer = reinterpret_cast<int8_t *>(out->getNDArray()->getBuffer());
+        for (auto &in: *node->input()) {
+            if (in.first <= 0 || !variableSpace->hasVariable(in))
+                continue;
+
+            auto var = variableSpace->getVariable(in);
+            if (!var->hasNDArray())
+                continue;
+
+            auto array = var->getNDArray();
+            auto inBuffer = reinterpret_cast<int8_t *>(array->getBuffer());
+            if (outBuffer >= inBuffer && outBuffer < inBuffer + array->lengthOf() * array->sizeOfT())
+                return in.first;
+        }
+    }
+
+    return 0;
+}
+
 /**
  * This method executes given Graph instance, and returns error code.
  *
@@ -217,7 +309,35 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
     Nd4jLong tb0 = Environment::getInstance()->isProfiling() ? GraphProfile::currentTime() : 0L;
     graph->buildGraph();
 
-    auto footprintForward = nd4j::memory::MemoryRegistrator::getInstance()->getGraphMemoryFootprint(graph->hashCode());
+    // node states are addressed by the same dense index as variables
+    auto index = __variableSpace->variableIndex();
+    if (flowPath->variableIndex() != index)
+        flowPath->setVariableIndex(index);
+
+    bool pe = graph->getExecutorConfiguration()->_parallelLayers;
+
+    // static memory plan is applied only to sequential execution within own workspace
+    auto planner = pe || __variableSpace->workspace() == nullptr ? nullptr : flowPath->memoryPlanner();
+    auto workspace = __variableSpace->workspace();
+    std::shared_ptr<MemoryPlan> plan;
+    bool planOverflow = false;
+
+    // these are used only while execution is recorded for planning
+    std::vector<int> plannedOrder;
+    std::map<int, Nd4jLong> plannedBytes;
+    std::map<int, int> plannedAliases;
+
+    if (planner != nullptr) {
+        plan = planner->plan();
+
+        // recorded execution goes to spills, so its total allocations don't inflate workspace
+        if (plan != nullptr)
+            workspace->expandTo(plan->arenaSize());
+        else
+            workspace->scopeTo(0L, 0L);
+    }
+
+    auto footprintForward = planner != nullptr ? 0L : nd4j::memory::MemoryRegistrator::getInstance()->getGraphMemoryFootprint(graph->hashCode());
     if (footprintForward > 0) {
         if (__variableSpace->workspace() != nullptr) {
             // this method will work only if current workspace size is smaller then proposed value
@@ -232,7 +352,8 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
 
     Nd4jLong timeStart = Environment::getInstance()->isProfiling() ? GraphProfile::currentTime() : 0L;
 
-    bool pe = graph->getExecutorConfiguration()->_executionMode == ExecutionMode_AUTO;
+    // used only for layers executed concurrently
+    SynchronizedVariableSpace syncSpace(__variableSpace);
 
 
     // basically if at some point code diverges, code branch might be _DISABLED_, and all nodes within that branch will be disabled as well
@@ -248,9 +369,86 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
     for (int l = 0; l < (int) graph->getOnion()->size(); l++) {
         int layerSize = graph->getOnion()->count(l) == 1 ? graph->getOnion()->at(l)->size() : 0;
 
+        // independent nodes of the same layer can be executed concurrently
+        if (pe && layerSize > 1 && isLayerParallelizable(graph->getOnion()->at(l))) {
+            if (leftFrame) {
+                auto frame_id = frames.back();
+                frames.pop_back();
+                flowPath->markFrameActive(frame_id, false);
+                flowPath->forgetFrame(frame_id);
+
+                leftFrame = false;
+            }
+
+            if (Environment::getInstance()->isProfiling() && lastId != -10000000) {
+                flowPath->profile()->nodeById(lastId)->setTotalTime(GraphProfile::relativeTime(nodeTime));
+                lastId = -10000000;
+            }
+
+            // FlowPath is updated sequentially, before and after concurrent execution
+            std::vector<Node*> runnable;
+            for (int n = 0; n < layerSize; n++) {
+                if (++exec_counter > 10000)
+                    return Status::THROW("Early termination hit");
+
+                Node* node = graph->getOnion()->at(l)->at(n);
+
+                if (Environment::getInstance()->isProfiling())
+                    flowPath->profile()->nodeById(node->id(), node->name()->c_str());
+
+                if (shouldSkipNode(graph, node, flowPath))
+                    continue;
+
+                if (frames.size() > 0 && node->getFrameId() < 0)
+                    node->setFrameId(frames.back());
+
+                flowPath->markNodeActive(node->id(), true);
+                runnable.emplace_back(node);
+            }
+
+            int numRunnable = (int) runnable.size();
+            std::vector<Nd4jStatus> statuses(numRunnable, Status::OK());
+            std::vector<Nd4jLong> outerTimes(numRunnable, 0L);
+            std::vector<Nd4jLong> totalTimes(numRunnable, 0L);
+
+#pragma omp parallel for if (numRunnable > 1) schedule(dynamic, 1) num_threads(nd4j::math::nd4j_min<int>(numRunnable, omp_get_max_threads()))
+            for (int n = 0; n < numRunnable; n++) {
+                // nested parallelism is disabled, so ops must not split their work for more threads than they'll get
+                if (omp_get_num_threads() > 1)
+                    omp_set_num_threads(1);
+
+                auto nodeStart = GraphProfile::currentTime();
+                auto timeStart = std::chrono::system_clock::now();
+
+                try {
+                    statuses[n] = executeFlatNode(graph, runnable[n], &syncSpace);
+                } catch (std::exception &e) {
+                    nd4j_printf("Node_%i failed: %s\n", runnable[n]->id(), e.what());
+                    statuses[n] = ND4J_STATUS_KERNEL_FAILURE;
+                }
+
+                auto timeEnd = std::chrono::system_clock::now();
+                outerTimes[n] = std::chrono::duration_cast<std::chrono::nanoseconds>(timeEnd - timeStart).count();
+                totalTimes[n] = GraphProfile::relativeTime(nodeStart);
+            }
+
+            for (int n = 0; n < numRunnable; n++) {
+                auto node = runnable[n];
+                flowPath->setOuterTime(node->id(), outerTimes[n]);
+
+                if (statuses[n] != ND4J_STATUS_OK)
+                    return statuses[n];
+
+                if (Environment::getInstance()->isProfiling())
+                    flowPath->profile()->nodeById(node->id())->setTotalTime(totalTimes[n]);
+
+                flowPath->markExecuted(node->id(), true);
+            }
+
+            continue;
+        }
+
         int n = 0;
-// this omp block will probably never be the case
-//#pragma omp parallel for if (layerSize > 1 && pe) schedule(dynamic) proc_bind(spread) private(n)
         for (; n < layerSize; n++) {
             if (++exec_counter > 10000) {
                 l = graph->getOnion()->size();
@@ -287,53 +485,7 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
                 }
 
 
-                // TODO: move inactivity check right here
-                bool shouldSkip = false;
-                if (node->opType() == OpType_LOGIC && node->opNum() == nd4j::logic::Merge) {
-                    // Merge node has own checkout logic
-
-                    auto inputId0 = node->input()->at(0);
-                    auto inputId1 = node->input()->at(1);
-
-                    // Merge node can be skipped only both inputs are inactive
-                    if (!flowPath->isNodeActive(inputId0.first) && !flowPath->isNodeActive(inputId1.first))
-                        shouldSkip = true;
-
-                } else {
-                    // let's check for input nodes, if they are disabled or contain divergents
-                    for (int e = 0; e < node->input()->size(); e++) {
-                        auto inputId = node->input()->at(e);
-
-                        // not a node. skipping checks
-                        if (graph->getMapped()->count(inputId.first) == 0)
-                            continue;
-
-                        /**
-                         * We can skip current node, in two cases:
-                         * 1) If previous node was disabled
-                         * 2) If previous node was divergent node (i.e. IF op) and code went other way
-                         */
-                        Node *prevNode = graph->getMapped()->at(inputId.first);
-                        if (!flowPath->isNodeActive(inputId.first)) {
-                            shouldSkip = true;
-                            flowPath->markNodeActive(node->id(), false);
-
-                            nd4j_debug("Skipping Node_%i due to inactive input [%i]\n", node->id(), inputId.first);
-                            break;
-
-                        } else if (prevNode->isDivergencePoint()) { // literally checking for switch here
-                            if (flowPath->branch(inputId.first) != inputId.second) {
-                                shouldSkip = true;
-                                flowPath->markNodeActive(node->id(), false);
-                                nd4j_debug("Skipping Node_%i due to divergent branch [%i]\n", node->id(),
-                                           inputId.first);
-                                break;
-                            }
-                        }
-                    }
-                }
-
-                if (shouldSkip)
+                if (shouldSkipNode(graph, node, flowPath))
                     continue;
             }
 
@@ -436,11 +588,38 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
 
                 auto timeStart = std::chrono::system_clock::now();
 
+                Nd4jLong spilledBefore = 0L;
+                if (planner != nullptr) {
+                    // node allocates within its planned block, whatever doesn't fit there goes to spills
+                    if (plan != nullptr) {
+                        if (plan->hasBlock(node->id()))
+                            workspace->scopeTo(plan->offset(node->id()), plan->offset(node->id()) + plan->size(node->id()));
+                        else
+                            workspace->scopeTo(0L, 0L);
+                    }
+
+                    spilledBefore = workspace->getSpilledSize();
+                }
+
                 // actual node execution happens right here
                 Nd4jStatus status = executeFlatNode(graph, node, __variableSpace);
 
                 auto timeEnd = std::chrono::system_clock::now();
 
+                if (planner != nullptr && status == ND4J_STATUS_OK) {
+                    auto spilled = workspace->getSpilledSize() - spilledBefore;
+
+                    if (plan == nullptr) {
+                        plannedOrder.emplace_back(node->id());
+                        plannedBytes[node->id()] = spilled;
+
+                        auto source = findInplaceSource(node, __variableSpace);
+                        if (source != 0)
+                            plannedAliases[node->id()] = source;
+                    } else if (spilled > 0)
+                        planOverflow = true;
+                }
+
                 auto outerTime = std::chrono::duration_cast<std::chrono::nanoseconds>(timeEnd - timeStart).count();
 
 
@@ -482,13 +661,25 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
 
     // optionally saving execution time
     if (Environment::getInstance()->isProfiling()) {
-        flowPath->profile()->nodeById(lastId)->setTotalTime(GraphProfile::relativeTime(nodeTime));
+        if (lastId != -10000000)
+            flowPath->profile()->nodeById(lastId)->setTotalTime(GraphProfile::relativeTime(nodeTime));
+
         flowPath->profile()->setExecutionTime(GraphProfile::relativeTime(timeStart));
         //flowPath->profile().printOut();
     }
 
+    if (planner != nullptr) {
+        if (plan == nullptr)
+            planner->update(graph, plannedOrder, plannedBytes, plannedAliases);
+        else if (planOverflow)
+            planner->invalidate();
+
+        // anything allocated after execution must not overwrite planned blocks, results live there
+        workspace->scopeTo(plan != nullptr ? plan->arenaSize() : 0L, -1L);
+    }
+
     // saving memory footprint for current run
-    if (__variableSpace->workspace() != nullptr) {
+    if (planner == nullptr && __variableSpace->workspace() != nullptr) {
         auto m = __variableSpace->workspace()->getAllocatedSize();
         auto h = graph->hashCode();
         nd4j::memory::MemoryRegistrator::getInstance()->setGraphMemoryFootprintIfGreater(h, m);
@@ -835,24 +1026,28 @@ uint8_t* readFlatBuffers(const char * filename) {
 
     nd4j_debug("File length: %i\n", fileLen);
 
-    uint8_t * data = new uint8_t[fileLen];
-
     FILE *in = fopen(filename, "rb");
-    int cnt = 0;
-    int b = 0;
-    while (cnt < fileLen) {
-        b += fread(data + cnt, 1, 1, in);
+    if (in == nullptr)
+        throw std::runtime_error("Failed to open file");
 
-        cnt++;
-    }
+    uint8_t * data = new uint8_t[fileLen];
+    auto cnt = fread(data, 1, fileLen, in);
     fclose(in);
 
+    if ((long) cnt != fileLen) {
+        delete[] data;
+        throw std::runtime_error("Failed to read file");
+    }
+
     return data;
 }
 
 flatbuffers::Offset<FlatResult> GraphExecutioner::execute(Graph *graph, flatbuffers::FlatBufferBuilder &builder, const FlatInferenceRequest* request) {
+    return execute(graph, graph->getVariableSpace(), builder, request);
+}
+
+flatbuffers::Offset<FlatResult> GraphExecutioner::execute(Graph *graph, VariableSpace *varSpace, flatbuffers::FlatBufferBuilder &builder, const FlatInferenceRequest* request) {
     ExecutionResult result;
-    auto varSpace = graph->getVariableSpace();
 
     if (request != nullptr && request->variables() != nullptr) {
         auto vars = request->variables();
@@ -866,11 +1061,11 @@ flatbuffers::Offset<FlatResult> GraphExecutioner::execute(Graph *graph, flatbuff
     if (Environment::getInstance()->isDebugAndVerbose())
         graph->printOut();
 
-    auto status = GraphExecutioner::execute(graph);
+    auto status = GraphExecutioner::execute(graph, varSpace);
     if (status != nd4j::Status::OK())
         throw graph_execution_exception(request->id());
 
-    auto outputs = graph->fetchOutputs();
+    auto outputs = graph->fetchOutputs(varSpace);
 
     if (outputs->size() == 0)
         throw no_results_exception(request->id());
@@ -893,7 +1088,17 @@ flatbuffers::Offset<FlatResult> GraphExecutioner::execute(Graph *graph, flatbuff
         *
         *   PLEASE NOTE: This method is mostly suited for tests and debugging/profiling
         */
-        Graph* GraphExecutioner::importFromFlatBuffers(const char *filename) {
+        Graph* GraphExecutioner::importFromFlatBuffers(const char *filename, bool mapped) {
+            if (mapped) {
+                auto file = new MappedFile(filename);
+                try {
+                    return new Graph(file);
+                } catch (...) {
+                    delete file;
+                    throw;
+                }
+            }
+
             auto data = readFlatBuffers(filename);
             auto restoredGraph = importFromFlatPointer(reinterpret_cast<Nd4jPointer>(data));
             delete[] data;
@@ -35,6 +35,7 @@
 #include <indexing/NDIndex.h>
 #include <indexing/IndicesList.h>
 #include <helpers/ShapeUtils.h>
+#include <helpers/ConstantTadHelper.h>
 #include <sstream>
 #include <helpers/ArrayUtils.h>
 #include <MmulHelper.h>
@@ -1396,11 +1397,9 @@ void NDArray::reduceAlongDimension(nd4j::reduce::FloatOps op, NDArray* target, c
         //target->_buffer[0] = functions::reduce::ReduceFloatFunction<T>::template execScalar<OpName>(_buffer, _shapeInfo, extras);
         NativeOpExcutioner::execReduceFloatScalar(op, this->getBuffer(), this->getShapeInfo(), nullptr, target->buffer(), target->shapeInfo());
     else {
-        shape::TAD tad(_shapeInfo, copy.data(), copy.size());
-        tad.createTadOnlyShapeInfo();
-        tad.createOffsets();
+        auto tad = ConstantTadHelper::getInstance()->tadForDimensions(_shapeInfo, copy.data(), copy.size());
 
-        NativeOpExcutioner::execReduceFloat(op, this->getBuffer(), this->getShapeInfo(), nullptr, target->getBuffer(), target->getShapeInfo(), copy.data(), copy.size(), tad.tadOnlyShapeInfo, tad.tadOffsets);
+        NativeOpExcutioner::execReduceFloat(op, this->getBuffer(), this->getShapeInfo(), nullptr, target->getBuffer(), target->getShapeInfo(), copy.data(), copy.size(), tad.primaryShapeInfo(), tad.primaryOffsets());
     }
 }
 
@@ -1427,11 +1426,9 @@ void NDArray::reduceAlongDimension(nd4j::reduce::SameOps op, NDArray* target, co
         //target->_buffer[0] = functions::reduce::ReduceFloatFunction<T>::template execScalar<OpName>(_buffer, _shapeInfo, extras);
         NativeOpExcutioner::execReduceSameScalar(op, this->getBuffer(), this->getShapeInfo(), nullptr, target->buffer(), target->shapeInfo());
     else {
-        shape::TAD tad(_shapeInfo, copy.data(), copy.size());
-        tad.createTadOnlyShapeInfo();
-        tad.createOffsets();
+        auto tad = ConstantTadHelper::getInstance()->tadForDimensions(_shapeInfo, copy.data(), copy.size());
 
-        NativeOpExcutioner::execReduceSame(op, this->getBuffer(), this->getShapeInfo(), nullptr, target->getBuffer(), target->getShapeInfo(), copy.data(), copy.size(), tad.tadOnlyShapeInfo, tad.tadOffsets);
+        NativeOpExcutioner::execReduceSame(op, this->getBuffer(), this->getShapeInfo(), nullptr, target->getBuffer(), target->getShapeInfo(), copy.data(), copy.size(), tad.primaryShapeInfo(), tad.primaryOffsets());
     }
 }
 
@@ -1456,11 +1453,9 @@ void NDArray::reduceAlongDimension(nd4j::reduce::BoolOps op, NDArray* target, co
         //target->_buffer[0] = functions::reduce::ReduceFloatFunction<T>::template execScalar<OpName>(_buffer, _shapeInfo, extras);
         NativeOpExcutioner::execReduceBoolScalar(op, this->getBuffer(), this->getShapeInfo(), nullptr, target->buffer(), target->shapeInfo());
     else {
-        shape::TAD tad(_shapeInfo, copy.data(), copy.size());
-        tad.createTadOnlyShapeInfo();
-        tad.createOffsets();
+        auto tad = ConstantTadHelper::getInstance()->tadForDimensions(_shapeInfo, copy.data(), copy.size());
 
-        NativeOpExcutioner::execReduceBool(op, this->getBuffer(), this->getShapeInfo(), nullptr, target->getBuffer(), target->getShapeInfo(), copy.data(), copy.size(), tad.tadOnlyShapeInfo, tad.tadOffsets);
+        NativeOpExcutioner::execReduceBool(op, this->getBuffer(), this->getShapeInfo(), nullptr, target->getBuffer(), target->getShapeInfo(), copy.data(), copy.size(), tad.primaryShapeInfo(), tad.primaryOffsets());
     }
 }
 
@@ -1485,11 +1480,9 @@ void NDArray::reduceAlongDimension(nd4j::reduce::LongOps op, NDArray* target, co
         //target->_buffer[0] = functions::reduce::ReduceFloatFunction<T>::template execScalar<OpName>(_buffer, _shapeInfo, extras);
         NativeOpExcutioner::execReduceLongScalar(op, this->getBuffer(), this->getShapeInfo(), nullptr, target->buffer(), target->shapeInfo());
     else {
-        shape::TAD tad(_shapeInfo, copy.data(), copy.size());
-        tad.createTadOnlyShapeInfo();
-        tad.createOffsets();
+        auto tad = ConstantTadHelper::getInstance()->tadForDimensions(_shapeInfo, copy.data(), copy.size());
 
-        NativeOpExcutioner::execReduceLong(op, this->getBuffer(), this->getShapeInfo(), nullptr, target->getBuffer(), target->getShapeInfo(), copy.data(), copy.size(), tad.tadOnlyShapeInfo, tad.tadOffsets);
+        NativeOpExcutioner::execReduceLong(op, this->getBuffer(), this->getShapeInfo(), nullptr, target->getBuffer(), target->getShapeInfo(), copy.data(), copy.size(), tad.primaryShapeInfo(), tad.primaryOffsets());
     }
 }
 
@@ -1999,19 +1992,17 @@ void NDArray::applyPairwiseTransform(nd4j::pairwise::BoolOps op, const NDArray *
         if (index >= numTads)
             throw std::runtime_error("Can't get index higher than total number of TADs");
 
-        shape::TAD tad(this->_shapeInfo, copy.data(), copy.size());
-        tad.createTadOnlyShapeInfo();
-        tad.createOffsets();
+        auto tad = ConstantTadHelper::getInstance()->tadForDimensions(this->_shapeInfo, copy.data(), copy.size());
 
         Nd4jLong* shapeInfo;
         if (_workspace == nullptr) {
-            shapeInfo = new Nd4jLong[shape::shapeInfoLength(tad.tadOnlyShapeInfo)];
+            shapeInfo = new Nd4jLong[shape::shapeInfoLength(tad.primaryShapeInfo())];
         } else {
-            shapeInfo = reinterpret_cast<Nd4jLong *>(_workspace->allocateBytes(shape::shapeInfoByteLength(tad.tadOnlyShapeInfo)));
+            shapeInfo = reinterpret_cast<Nd4jLong *>(_workspace->allocateBytes(shape::shapeInfoByteLength(tad.primaryShapeInfo())));
         }
-        std::memcpy(shapeInfo, tad.tadOnlyShapeInfo, shape::shapeInfoByteLength(tad.tadOnlyShapeInfo));
+        std::memcpy(shapeInfo, tad.primaryShapeInfo(), shape::shapeInfoByteLength(tad.primaryShapeInfo()));
 
-        auto array = new NDArray(bufferWithOffset(tad.tadOffsets[index]), shapeInfo, _workspace);
+        auto array = new NDArray(bufferWithOffset(tad.primaryOffsets()[index]), shapeInfo, _workspace);
         array->_isBuffAlloc = false;
         array->_isShapeAlloc = true;
         array->_isView = true;
@@ -2150,11 +2141,9 @@ NDArray NDArray::transp() const {
 
         int dimension[1] = {1};
 
-        std::unique_ptr<shape::TAD> tad(new shape::TAD(_shapeInfo, dimension, 1));
-        tad->createTadOnlyShapeInfo();
-        tad->createOffsets();
+        auto tad = ConstantTadHelper::getInstance()->tadForDimensions(_shapeInfo, dimension, 1);
 
-        NativeOpExcutioner::execBroadcast(nd4j::broadcast::Ops::Add, _buffer, _shapeInfo, row->_buffer, row->_shapeInfo, target->getBuffer(), target->getShapeInfo(), dimension, 1, tad->tadOnlyShapeInfo, tad->tadOffsets, tad->tadOnlyShapeInfo, tad->tadOffsets);
+        NativeOpExcutioner::execBroadcast(nd4j::broadcast::Ops::Add, _buffer, _shapeInfo, row->_buffer, row->_shapeInfo, target->getBuffer(), target->getShapeInfo(), dimension, 1, tad.primaryShapeInfo(), tad.primaryOffsets(), tad.primaryShapeInfo(), tad.primaryOffsets());
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -2169,11 +2158,9 @@ NDArray NDArray::transp() const {
 
         int dimension[1] = {1};
 
-        std::unique_ptr<shape::TAD> tad(new shape::TAD(_shapeInfo, dimension, 1));
-        tad->createTadOnlyShapeInfo();
-        tad->createOffsets();
+        auto tad = ConstantTadHelper::getInstance()->tadForDimensions(_shapeInfo, dimension, 1);
 
-        NativeOpExcutioner::execBroadcast(nd4j::broadcast::Ops::Subtract, _buffer, _shapeInfo, row->_buffer, row->_shapeInfo, target->getBuffer(), target->getShapeInfo(), dimension, 1, tad->tadOnlyShapeInfo, tad->tadOffsets, tad->tadOnlyShapeInfo, tad->tadOffsets);
+        NativeOpExcutioner::execBroadcast(nd4j::broadcast::Ops::Subtract, _buffer, _shapeInfo, row->_buffer, row->_shapeInfo, target->getBuffer(), target->getShapeInfo(), dimension, 1, tad.primaryShapeInfo(), tad.primaryOffsets(), tad.primaryShapeInfo(), tad.primaryOffsets());
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -2188,11 +2175,9 @@ NDArray NDArray::transp() const {
 
         int dimension[1] = {1};
 
-        std::unique_ptr<shape::TAD> tad(new shape::TAD(_shapeInfo, dimension, 1));
-        tad->createTadOnlyShapeInfo();
-        tad->createOffsets();
+        auto tad = ConstantTadHelper::getInstance()->tadForDimensions(_shapeInfo, dimension, 1);
 
-        NativeOpExcutioner::execBroadcast(nd4j::broadcast::Ops::Multiply, _buffer, _shapeInfo, row->_buffer, row->_shapeInfo, target->getBuffer(), target->getShapeInfo(), dimension, 1, tad->tadOnlyShapeInfo, tad->tadOffsets, tad->tadOnlyShapeInfo, tad->tadOffsets);
+        NativeOpExcutioner::execBroadcast(nd4j::broadcast::Ops::Multiply, _buffer, _shapeInfo, row->_buffer, row->_shapeInfo, target->getBuffer(), target->getShapeInfo(), dimension, 1, tad.primaryShapeInfo(), tad.primaryOffsets(), tad.primaryShapeInfo(), tad.primaryOffsets());
     }
 
 //////////////////////////////////////////////////////////////////////////
@@ -2209,13 +2194,11 @@ NDArray NDArray::transp() const {
 
         int dimension[1] = {1};
 
-        std::unique_ptr<shape::TAD> tad(new shape::TAD(_shapeInfo, dimension, 1));
-        tad->createTadOnlyShapeInfo();
-        tad->createOffsets();
+        auto tad = ConstantTadHelper::getInstance()->tadForDimensions(_shapeInfo, dimension, 1);
 
         NativeOpExcutioner::execBroadcast(nd4j::broadcast::Divide, _buffer, _shapeInfo, row->_buffer, row->_shapeInfo, target->getBuffer(), target->getShapeInfo(),
-                                             dimension, 1, tad->tadOnlyShapeInfo, tad->tadOffsets,
-                                             tad->tadOnlyShapeInfo, tad->tadOffsets);
+                                             dimension, 1, tad.primaryShapeInfo(), tad.primaryOffsets(),
+                                             tad.primaryShapeInfo(), tad.primaryOffsets());
 
     }
 
@@ -2230,13 +2213,11 @@ NDArray NDArray::transp() const {
 
         int dimension[1] = {1};
 
-        std::unique_ptr<shape::TAD> tad(new shape::TAD(_shapeInfo, dimension, 1));
-        tad->createTadOnlyShapeInfo();
-        tad->createOffsets();
+        auto tad = ConstantTadHelper::getInstance()->tadForDimensions(_shapeInfo, dimension, 1);
 
         NativeOpExcutioner::execBroadcast(nd4j::broadcast::Ops::Add, _buffer, _shapeInfo, row->_buffer, row->_shapeInfo, _buffer, _shapeInfo,
-                                             dimension, 1, tad->tadOnlyShapeInfo, tad->tadOffsets,
-                                             tad->tadOnlyShapeInfo, tad->tadOffsets);
+                                             dimension, 1, tad.primaryShapeInfo(), tad.primaryOffsets(),
+                                             tad.primaryShapeInfo(), tad.primaryOffsets());
     }
 
 //////////////////////////////////////////////////////////////////////////
@@ -2250,13 +2231,11 @@ NDArray NDArray::transp() const {
 
         int dimension[1] = {0};
 
-        std::unique_ptr<shape::TAD> tad(new shape::TAD(_shapeInfo, dimension, 1));
-        tad->createTadOnlyShapeInfo();
-        tad->createOffsets();
+        auto tad = ConstantTadHelper::getInstance()->tadForDimensions(_shapeInfo, dimension, 1);
 
         NativeOpExcutioner::execBroadcast(nd4j::broadcast::Ops::Add, _buffer, _shapeInfo, column->_buffer, column->_shapeInfo, target->getBuffer(), target->getShapeInfo(),
-                                             dimension, 1, tad->tadOnlyShapeInfo, tad->tadOffsets,
-                                             tad->tadOnlyShapeInfo, tad->tadOffsets);
+                                             dimension, 1, tad.primaryShapeInfo(), tad.primaryOffsets(),
+                                             tad.primaryShapeInfo(), tad.primaryOffsets());
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -2269,13 +2248,11 @@ NDArray NDArray::transp() const {
 
         int dimension[1] = {0};
 
-        std::unique_ptr<shape::TAD> tad(new shape::TAD(_shapeInfo, dimension, 1));
-        tad->createTadOnlyShapeInfo();
-        tad->createOffsets();
+        auto tad = ConstantTadHelper::getInstance()->tadForDimensions(_shapeInfo, dimension, 1);
 
         NativeOpExcutioner::execBroadcast(nd4j::broadcast::Ops::Add, _buffer, _shapeInfo, column->_buffer, column->_shapeInfo, _buffer, _shapeInfo,
-                                             dimension, 1, tad->tadOnlyShapeInfo, tad->tadOffsets,
-                                             tad->tadOnlyShapeInfo, tad->tadOffsets);
+                                             dimension, 1, tad.primaryShapeInfo(), tad.primaryOffsets(),
+                                             tad.primaryShapeInfo(), tad.primaryOffsets());
     }
 
 //////////////////////////////////////////////////////////////////////////
@@ -2288,13 +2265,11 @@ NDArray NDArray::transp() const {
 
         int dimension[1] = {0};
 
-        std::unique_ptr<shape::TAD> tad(new shape::TAD(_shapeInfo, dimension, 1));
-        tad->createTadOnlyShapeInfo();
-        tad->createOffsets();
+        auto tad = ConstantTadHelper::getInstance()->tadForDimensions(_shapeInfo, dimension, 1);
 
         NativeOpExcutioner::execBroadcast(nd4j::broadcast::Ops::Multiply, _buffer, _shapeInfo, column->_buffer, column->_shapeInfo, _buffer, _shapeInfo,
-                                             dimension, 1, tad->tadOnlyShapeInfo, tad->tadOffsets,
-                                             tad->tadOnlyShapeInfo, tad->tadOffsets);
+                                             dimension, 1, tad.primaryShapeInfo(), tad.primaryOffsets(),
+                                             tad.primaryShapeInfo(), tad.primaryOffsets());
     }
 
 
@@ -2998,12 +2973,10 @@ template void NDArray::applyScalar(nd4j::scalar::Ops op, const bool scalar, NDAr
         if (tadLength != tadArray->lengthOf())
             throw std::runtime_error("NDArray::applyBroadcast method: tad length mismatch !");
 
-        shape::TAD tad(this->_shapeInfo, copy.data(), copy.size());
-        tad.createTadOnlyShapeInfo();
-        tad.createOffsets();
+        auto tad = ConstantTadHelper::getInstance()->tadForDimensions(this->_shapeInfo, copy.data(), copy.size());
 
         // TODO: eventually we want separate tads here
-        NativeOpExcutioner::execBroadcast(op, this->_buffer, this->_shapeInfo, tadArray->_buffer, tadArray->_shapeInfo, result->_buffer, result->_shapeInfo, copy.data(), (int)copy.size(), tad.tadOnlyShapeInfo, tad.tadOffsets, tad.tadOnlyShapeInfo, tad.tadOffsets);
+        NativeOpExcutioner::execBroadcast(op, this->_buffer, this->_shapeInfo, tadArray->_buffer, tadArray->_shapeInfo, result->_buffer, result->_shapeInfo, copy.data(), (int)copy.size(), tad.primaryShapeInfo(), tad.primaryOffsets(), tad.primaryShapeInfo(), tad.primaryOffsets());
     }
 
     //////////////////////////////////////////////////////////////////////////
@@ -3032,12 +3005,10 @@ template void NDArray::applyScalar(nd4j::scalar::Ops op, const bool scalar, NDAr
         if (tadLength != tadArray->lengthOf())
             throw std::runtime_error("Tad length mismatch");
 
-        shape::TAD tad(this->_shapeInfo, copy.data(), copy.size());
-        tad.createTadOnlyShapeInfo();
-        tad.createOffsets();
+        auto tad = ConstantTadHelper::getInstance()->tadForDimensions(this->_shapeInfo, copy.data(), copy.size());
 
         // TODO: eventually we want separate tads here
-        NativeOpExcutioner::execBroadcastBool(op, this->_buffer, this->_shapeInfo, tadArray->_buffer, tadArray->_shapeInfo, result->_buffer, result->_shapeInfo, copy.data(), (int)copy.size(), tad.tadOnlyShapeInfo, tad.tadOffsets, tad.tadOnlyShapeInfo, tad.tadOffsets);
+        NativeOpExcutioner::execBroadcastBool(op, this->_buffer, this->_shapeInfo, tadArray->_buffer, tadArray->_shapeInfo, result->_buffer, result->_shapeInfo, copy.data(), (int)copy.size(), tad.primaryShapeInfo(), tad.primaryOffsets(), tad.primaryShapeInfo(), tad.primaryOffsets());
     }
 
     //////////////////////////////////////////////////////////////////////////
@@ -3817,14 +3788,12 @@ template void NDArray::pIdx(const Nd4jLong* indices, const bool value);
             if (dimensions.size() > 1)
                 std::sort(copy.begin(), copy.end());
 
-            shape::TAD tad(_shapeInfo, copy.data(), copy.size());
-            tad.createTadOnlyShapeInfo();
-            tad.createOffsets();
+            auto tad = ConstantTadHelper::getInstance()->tadForDimensions(_shapeInfo, copy.data(), copy.size());
 
             NativeOpExcutioner::execIndexReduce(op, _buffer, _shapeInfo, const_cast<void *>(extraParams),
                                                                           reinterpret_cast<Nd4jLong *>(target->_buffer),
                                                                           target->_shapeInfo, copy.data(), copy.size(),
-                                                                          tad.tadOnlyShapeInfo, tad.tadOffsets);
+                                                                          tad.primaryShapeInfo(), tad.primaryOffsets());
         }
     }
     ////////////////////////////////////////////////////////////////////////
@@ -3845,14 +3814,12 @@ template void NDArray::pIdx(const Nd4jLong* indices, const bool value);
         if (rankOf() == copy.size()) {
             NativeOpExcutioner::execIndexReduceScalar(op, _buffer, _shapeInfo, const_cast<void *>(extraParams), result->getBuffer(), result->getShapeInfo());
         } else {
-            shape::TAD tad(_shapeInfo, copy.data(), copy.size());
-            tad.createTadOnlyShapeInfo();
-            tad.createOffsets();
+            auto tad = ConstantTadHelper::getInstance()->tadForDimensions(_shapeInfo, copy.data(), copy.size());
 
             NativeOpExcutioner::execIndexReduce(op, _buffer, _shapeInfo, const_cast<void *>(extraParams),
                                                                     reinterpret_cast<Nd4jLong *>(result->_buffer),
                                                                     result->_shapeInfo, copy.data(), copy.size(),
-                                                                    tad.tadOnlyShapeInfo, tad.tadOffsets);
+                                                                    tad.primaryShapeInfo(), tad.primaryOffsets());
         }
         
         return result;
@@ -3898,15 +3865,10 @@ template void NDArray::pIdx(const Nd4jLong* indices, const bool value);
         shape::checkDimensions(rankOf(), copy);
         shape::checkDimensions(other->rankOf(), copy);               
         // create tads
-        shape::TAD tadX(_shapeInfo, copy.data(), copy.size());
-        tadX.createTadOnlyShapeInfo();
-        tadX.createOffsets();
-
-        shape::TAD tadY(other->_shapeInfo, copy.data(), copy.size());
-        tadY.createTadOnlyShapeInfo();
-        tadY.createOffsets();        
+        auto tadX = ConstantTadHelper::getInstance()->tadForDimensions(_shapeInfo, copy.data(), copy.size());
+        auto tadY = ConstantTadHelper::getInstance()->tadForDimensions(other->_shapeInfo, copy.data(), copy.size());
         // check tads shapes
-        if(!shape::equalsSoft(tadX.tadOnlyShapeInfo, tadY.tadOnlyShapeInfo)) 
+        if(!shape::equalsSoft(tadX.primaryShapeInfo(), tadY.primaryShapeInfo())) 
             throw std::runtime_error("NDArray::applyAllReduce3 method: the shapes of array tads are different !");
         // evaluate numbers of tads
         Nd4jLong tadLengthX = shape::tadLength(_shapeInfo, copy.data(), copy.size());
@@ -3932,7 +3894,7 @@ template void NDArray::pIdx(const Nd4jLong* indices, const bool value);
         }
 
         NativeOpExcutioner::execReduce3All(op, _buffer, _shapeInfo, params, other->_buffer, other->_shapeInfo, result->_buffer,result->_shapeInfo,
-                                           copy.data(), copy.size(), tadX.tadOnlyShapeInfo, tadX.tadOffsets, tadY.tadOnlyShapeInfo, tadY.tadOffsets);
+                                           copy.data(), copy.size(), tadX.primaryShapeInfo(), tadX.primaryOffsets(), tadY.primaryShapeInfo(), tadY.primaryOffsets());
         if(params != extraParams)
             delete [] static_cast<int8_t*>(params);
 
@@ -3963,17 +3925,8 @@ template void NDArray::pIdx(const Nd4jLong* indices, const bool value);
         // perform calculations
         if(rankOf() == copy.size() && other->rankOf() == copy.size())
             NativeOpExcutioner::execReduce3Scalar(op, _buffer, _shapeInfo, params, other->_buffer, other->_shapeInfo, result->_buffer, result->shapeInfo());
-        else {
-            shape::TAD tadX(_shapeInfo, copy.data(), copy.size());
-            tadX.createTadOnlyShapeInfo();
-            tadX.createOffsets();
-
-            shape::TAD tadY(other->_shapeInfo, copy.data(), copy.size());
-            tadY.createTadOnlyShapeInfo();
-            tadY.createOffsets();        
-        
+        else
             NativeOpExcutioner::execReduce3(op, _buffer, _shapeInfo, params, other->_buffer, other->_shapeInfo, result->_buffer,result->_shapeInfo, copy.data(), copy.size());
-        }
         
         if(params != extraParams)
             delete [] static_cast<int8_t*>(params);
@@ -5058,13 +5011,11 @@ template void NDArray::operator/=(const bool scalar);
         auto tadLength = shape::tadLength(_shapeInfo, copy.data(), copy.size());
         auto numTads = _length / tadLength;
 
-        std::unique_ptr<shape::TAD> tad(new shape::TAD(_shapeInfo, copy.data(), copy.size()));
-        tad->createTadOnlyShapeInfo();
-        tad->createOffsets();
+        auto tad = ConstantTadHelper::getInstance()->tadForDimensions(_shapeInfo, copy.data(), copy.size());
 
         // FIXME: why we're not using workspaces here?
-        Nd4jLong* shapeInfo = new Nd4jLong[shape::shapeInfoLength(tad->tadOnlyShapeInfo[0])];
-        std::memcpy(shapeInfo, tad->tadOnlyShapeInfo, shape::shapeInfoByteLength(tad->tadOnlyShapeInfo));
+        Nd4jLong* shapeInfo = new Nd4jLong[shape::shapeInfoLength(tad.primaryShapeInfo()[0])];
+        std::memcpy(shapeInfo, tad.primaryShapeInfo(), shape::shapeInfoByteLength(tad.primaryShapeInfo()));
 
         for (auto idx: indices) {
             if (idx >= numTads) {
@@ -5072,7 +5023,7 @@ template void NDArray::operator/=(const bool scalar);
                 throw std::runtime_error("Bad index");
             }
 
-            auto array = new NDArray(bufferWithOffset(tad->tadOffsets[idx]), shapeInfo);
+            auto array = new NDArray(bufferWithOffset(tad.primaryOffsets()[idx]), shapeInfo);
             result->push_back(array);
         }
 
@@ -5104,15 +5055,13 @@ template void NDArray::operator/=(const bool scalar);
         auto tadLength = shape::tadLength(_shapeInfo, copy.data(), copy.size());
         auto numTads = _length / tadLength;
 
-        std::unique_ptr<shape::TAD> tad(new shape::TAD(_shapeInfo, copy.data(), copy.size()));
-        tad->createTadOnlyShapeInfo();
-        tad->createOffsets();
+        auto tad = ConstantTadHelper::getInstance()->tadForDimensions(_shapeInfo, copy.data(), copy.size());
 
-        auto shapeInfo = new Nd4jLong[shape::shapeInfoLength(tad->tadOnlyShapeInfo[0])];
-        std::memcpy(shapeInfo, tad->tadOnlyShapeInfo, shape::shapeInfoByteLength(tad->tadOnlyShapeInfo));
+        auto shapeInfo = new Nd4jLong[shape::shapeInfoLength(tad.primaryShapeInfo()[0])];
+        std::memcpy(shapeInfo, tad.primaryShapeInfo(), shape::shapeInfoByteLength(tad.primaryShapeInfo()));
 
         for (int idx = 0; idx < numTads; idx++ ) {
-            auto array = new NDArray(bufferWithOffset(tad->tadOffsets[idx]), shapeInfo);
+            auto array = new NDArray(bufferWithOffset(tad.primaryOffsets()[idx]), shapeInfo);
             result->push_back(array);
         }
 
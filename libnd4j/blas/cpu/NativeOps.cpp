@@ -65,6 +65,8 @@ bool experimentalSupport = false;
 #include <ops/specials.h>
 #include "../Environment.h"
 #include <TAD.h>
+#include <helpers/ConstantTadHelper.h>
+#include <graph/profiling/OpProfiler.h>
 #include <ops/declarable/OpRegistrator.h>
 #include <graph/Context.h>
 #include <graph/ResultWrapper.h>
@@ -95,6 +97,7 @@ void NativeOps::execIndexReduceScalar(Nd4jPointer *extraPointers,
                                                 void *extraParams,
                                                 void *hZ, Nd4jLong *hZShapeInfo,
                                                 void *dZ, Nd4jLong *dZShapeInfo) {
+    nd4j::graph::OpProfilerScope profiler("index_reduce", opNum, hXShapeInfo);
 
     NativeOpExcutioner::execIndexReduceScalar(opNum, hX, hXShapeInfo, extraParams, hZ, hZShapeInfo);
 }
@@ -118,6 +121,7 @@ void  NativeOps::execIndexReduce(Nd4jPointer *extraPointers,int opNum,
                                         void *dZ, Nd4jLong *dZShapeInfo,
                                         void *hDimension, Nd4jLong *hDimensionShape,
                                         void *dDimension, Nd4jLong *dDimensionShape) {
+    nd4j::graph::OpProfilerScope profiler("index_reduce", opNum, hXShapeInfo);
 
     auto dimension = reinterpret_cast<int *>(hDimension);
     int dimensionLength = static_cast<int>(shape::length(hDimensionShape));
@@ -161,6 +165,7 @@ void NativeOps::execBroadcast(Nd4jPointer *extraPointers,
                                       void *dZ, Nd4jLong *dZShapeInfo,
                                       void *hDimension, Nd4jLong *hDimensionShape,
                                       void *dDimension, Nd4jLong *dDimensionShape) {
+    nd4j::graph::OpProfilerScope profiler("broadcast", opNum, hXShapeInfo, hYShapeInfo);
     auto dimension = reinterpret_cast<int *>(hDimension);
     int dimensionLength = static_cast<int>(shape::length(hDimensionShape));
 
@@ -190,6 +195,7 @@ void NativeOps::execBroadcastBool(Nd4jPointer *extraPointers,
                               void *dZ, Nd4jLong *dZShapeInfo,
                                   void *hDimension, Nd4jLong *hDimensionShape,
                                   void *dDimension, Nd4jLong *dDimensionShape) {
+    nd4j::graph::OpProfilerScope profiler("broadcast_bool", opNum, hXShapeInfo, hYShapeInfo);
     auto dimension = reinterpret_cast<int *>(hDimension);
     int dimensionLength = static_cast<int>(shape::length(hDimensionShape));
 
@@ -231,6 +237,7 @@ void NativeOps::execPairwiseTransform(
         void *hZ, Nd4jLong *hZShapeInfo,
         void *dZ, Nd4jLong *dZShapeInfo,
         void *extraParams) {
+    nd4j::graph::OpProfilerScope profiler("pairwise", opNum, hXShapeInfo, hYShapeInfo);
     NativeOpExcutioner::execPairwiseTransform(
             opNum,
             hX,
@@ -252,6 +259,7 @@ void NativeOps::execPairwiseTransformBool(
         void *hZ, Nd4jLong *hZShapeInfo,
         void *dZ, Nd4jLong *dZShapeInfo,
         void *extraParams) {
+    nd4j::graph::OpProfilerScope profiler("pairwise_bool", opNum, hXShapeInfo, hYShapeInfo);
     NativeOpExcutioner::execPairwiseBoolTransform(
             opNum,
             hX,
@@ -280,6 +288,7 @@ void NativeOps::execReduceFloat(
         void *extraParams,
         void *hZ, Nd4jLong *hZShapeInfo,
         void *dZ, Nd4jLong *dZShapeInfo) {
+    nd4j::graph::OpProfilerScope profiler("reduce_float", opNum, hXShapeInfo);
 
     NativeOpExcutioner::execReduceFloatScalar(
             opNum,
@@ -299,6 +308,7 @@ void NativeOps::execReduceSame(
         void *extraParams,
         void *hZ, Nd4jLong *hZShapeInfo,
         void *dZ, Nd4jLong *dZShapeInfo) {
+    nd4j::graph::OpProfilerScope profiler("reduce_same", opNum, hXShapeInfo);
 
     NativeOpExcutioner::execReduceSameScalar(
             opNum,
@@ -318,6 +328,7 @@ void NativeOps::execReduceBool(
         void *extraParams,
         void *hZ, Nd4jLong *hZShapeInfo,
         void *dZ, Nd4jLong *dZShapeInfo) {
+    nd4j::graph::OpProfilerScope profiler("reduce_bool", opNum, hXShapeInfo);
 
     NativeOpExcutioner::execReduceBoolScalar(
             opNum,
@@ -337,6 +348,7 @@ void NativeOps::execReduceLong(
         void *extraParams,
         void *hZ, Nd4jLong *hZShapeInfo,
         void *dZ, Nd4jLong *dZShapeInfo) {
+    nd4j::graph::OpProfilerScope profiler("reduce_long", opNum, hXShapeInfo);
 
     NativeOpExcutioner::execReduceLongScalar(
             opNum,
@@ -366,6 +378,7 @@ void NativeOps::execReduceFloat(Nd4jPointer *extraPointers,
                                    void *dZ, Nd4jLong *dZShapeInfo,
                                 void *hDimension, Nd4jLong *hDimensionShape,
                                 void *dDimension, Nd4jLong *dDimensionShape) {
+    nd4j::graph::OpProfilerScope profiler("reduce_float", opNum, hXShapeInfo);
     auto dimension = reinterpret_cast<int *>(hDimension);
     int dimensionLength = static_cast<int>(shape::length(hDimensionShape));
 
@@ -393,6 +406,7 @@ void NativeOps::execReduceBool(Nd4jPointer *extraPointers,
                                 void *dZ, Nd4jLong *dZShapeInfo,
                                void *hDimension, Nd4jLong *hDimensionShape,
                                void *dDimension, Nd4jLong *dDimensionShape) {
+    nd4j::graph::OpProfilerScope profiler("reduce_bool", opNum, hXShapeInfo);
     auto dimension = reinterpret_cast<int *>(hDimension);
     int dimensionLength = static_cast<int>(shape::length(hDimensionShape));
 
@@ -420,6 +434,7 @@ void NativeOps::execReduceSame(Nd4jPointer *extraPointers,
                                 void *dZ, Nd4jLong *dZShapeInfo,
                                void *hDimension, Nd4jLong *hDimensionShape,
                                void *dDimension, Nd4jLong *dDimensionShape) {
+    nd4j::graph::OpProfilerScope profiler("reduce_same", opNum, hXShapeInfo);
     auto dimension = reinterpret_cast<int *>(hDimension);
     int dimensionLength = static_cast<int>(shape::length(hDimensionShape));
 
@@ -447,6 +462,7 @@ void NativeOps::execReduceLong(Nd4jPointer *extraPointers,
                                 void *dZ, Nd4jLong *dZShapeInfo,
                                void *hDimension, Nd4jLong *hDimensionShape,
                                void *dDimension, Nd4jLong *dDimensionShape) {
+    nd4j::graph::OpProfilerScope profiler("reduce_long", opNum, hXShapeInfo);
     auto dimension = reinterpret_cast<int *>(hDimension);
     int dimensionLength = static_cast<int>(shape::length(hDimensionShape));
 
@@ -487,6 +503,7 @@ void NativeOps::execReduce3(Nd4jPointer *extraPointers,
                                     void *dZ, Nd4jLong *dZShapeInfo,
                                     Nd4jLong *tadOnlyShapeInfo, Nd4jLong *tadOffsets,
                                     Nd4jLong *yTadOnlyShapeInfo, Nd4jLong *yTadOffsets) {
+    nd4j::graph::OpProfilerScope profiler("reduce3", opNum, hXShapeInfo, hYShapeInfo);
 
     NativeOpExcutioner::execReduce3(opNum, hX, hXShapeInfo, extraParams, hY, hYShapeInfo, hZ, hZShapeInfo);
 }
@@ -508,6 +525,7 @@ void NativeOps::execReduce3Scalar(Nd4jPointer *extraPointers,int opNum,
                                             void *dY, Nd4jLong *dYShapeInfo,
                                             void *hZ, Nd4jLong *hZShapeInfo,
                                             void *dZ, Nd4jLong *dZShapeInfo) {
+    nd4j::graph::OpProfilerScope profiler("reduce3", opNum, hXShapeInfo, hYShapeInfo);
 
     NativeOpExcutioner::execReduce3Scalar(opNum,hX,hXShapeInfo,extraParams,hY,hYShapeInfo, hZ, hZShapeInfo);
 }
@@ -537,6 +555,7 @@ void NativeOps::execReduce3(Nd4jPointer *extraPointers,
                                     void *dDimension, Nd4jLong *dDimensionShape,
                                     Nd4jLong *tadOnlyShapeInfo, Nd4jLong *tadOffsets,
                                     Nd4jLong *yTadOnlyShapeInfo, Nd4jLong *yTadOffsets) {
+    nd4j::graph::OpProfilerScope profiler("reduce3", opNum, hXShapeInfo, hYShapeInfo);
     auto dimension = reinterpret_cast<int *>(hDimension);
     int dimensionLength = static_cast<int>(shape::length(hDimensionShape));
 
@@ -573,6 +592,7 @@ void NativeOps::execScalar(
         void *hScalar, Nd4jLong *hScalarShapeInfo,
         void *dScalar, Nd4jLong *dScalarShapeInfo,
         void *extraParams) {
+    nd4j::graph::OpProfilerScope profiler("scalar", opNum, hXShapeInfo, hScalarShapeInfo);
     NativeOpExcutioner::execScalar(
             opNum,
             hX,
@@ -594,6 +614,7 @@ void NativeOps::execScalarBool(
         void *hScalar, Nd4jLong *hScalarShapeInfo,
         void *dScalar, Nd4jLong *dScalarShapeInfo,
         void *extraParams) {
+    nd4j::graph::OpProfilerScope profiler("scalar_bool", opNum, hXShapeInfo, hScalarShapeInfo);
     NativeOpExcutioner::execScalarBool(
             opNum,
             hX,
@@ -620,6 +641,7 @@ void NativeOps::execSummaryStatsScalar(Nd4jPointer *extraPointers,
         void *hZ, Nd4jLong *hZShapeInfo,
         void *dZ, Nd4jLong *dZShapeInfo,
         bool biasCorrected) {
+    nd4j::graph::OpProfilerScope profiler("summary_stats", opNum, hXShapeInfo);
     NativeOpExcutioner::execSummaryStatsScalar(
             opNum,
             hX,
@@ -646,6 +668,7 @@ void NativeOps::execSummaryStats(Nd4jPointer *extraPointers,
                                          void *hZ, Nd4jLong *hZShapeInfo,
                                          void *dZ, Nd4jLong *dZShapeInfo,
                                          bool biasCorrected) {
+    nd4j::graph::OpProfilerScope profiler("summary_stats", opNum, hXShapeInfo);
     NativeOpExcutioner::execSummaryStats(
             opNum,
             hX,
@@ -677,6 +700,7 @@ void NativeOps::execSummaryStats(Nd4jPointer *extraPointers,
                                          void *dDimension, Nd4jLong *dDimensionShape,
                                          bool biasCorrected,
                                          Nd4jLong *tadShapeInfo, Nd4jLong *tadOffsets) {
+    nd4j::graph::OpProfilerScope profiler("summary_stats", opNum, hXShapeInfo);
     auto dimension = reinterpret_cast<int *>(hDimension);
     int dimensionLength = static_cast<int>(shape::length(hDimensionShape));
 
@@ -711,6 +735,7 @@ void NativeOps::execTransformFloat(
         void *hZ, Nd4jLong *hZShapeInfo,
         void *dZ, Nd4jLong *dZShapeInfo,
         void *extraParams) {
+    nd4j::graph::OpProfilerScope profiler("transform_float", opNum, hXShapeInfo);
     auto tadShapeInfo = reinterpret_cast<Nd4jLong *>(extraPointers != nullptr ? extraPointers[0] : nullptr);
     auto tadOffsets = reinterpret_cast<Nd4jLong *>(extraPointers != nullptr ? extraPointers[1] : nullptr);
 
@@ -733,6 +758,7 @@ void NativeOps::execTransformSame(
         void *hZ, Nd4jLong *hZShapeInfo,
         void *dZ, Nd4jLong *dZShapeInfo,
         void *extraParams) {
+    nd4j::graph::OpProfilerScope profiler("transform_same", opNum, hXShapeInfo);
     auto tadShapeInfo = reinterpret_cast<Nd4jLong *>(extraPointers != nullptr ? extraPointers[0] : nullptr);
     auto tadOffsets = reinterpret_cast<Nd4jLong *>(extraPointers != nullptr ? extraPointers[1] : nullptr);
 
@@ -755,6 +781,7 @@ void NativeOps::execTransformBool(
         void *hZ, Nd4jLong *hZShapeInfo,
         void *dZ, Nd4jLong *dZShapeInfo,
         void *extraParams) {
+    nd4j::graph::OpProfilerScope profiler("transform_bool", opNum, hXShapeInfo);
     auto tadShapeInfo = reinterpret_cast<Nd4jLong *>(extraPointers != nullptr ? extraPointers[0] : nullptr);
     auto tadOffsets = reinterpret_cast<Nd4jLong *>(extraPointers != nullptr ? extraPointers[1] : nullptr);
 
@@ -777,6 +804,7 @@ void NativeOps::execTransformAny(
         void *hZ, Nd4jLong *hZShapeInfo,
         void *dZ, Nd4jLong *dZShapeInfo,
         void *extraParams) {
+    nd4j::graph::OpProfilerScope profiler("transform_any", opNum, hXShapeInfo);
 
     NativeOpExcutioner::execTransformAny(
             opNum,
@@ -797,6 +825,7 @@ void NativeOps::execTransformStrict(
         void *hZ, Nd4jLong *hZShapeInfo,
         void *dZ, Nd4jLong *dZShapeInfo,
         void *extraParams) {
+    nd4j::graph::OpProfilerScope profiler("transform_strict", opNum, hXShapeInfo);
     auto tadShapeInfo = reinterpret_cast<Nd4jLong *>(extraPointers != nullptr ? extraPointers[0] : nullptr);
     auto tadOffsets = reinterpret_cast<Nd4jLong *>(extraPointers != nullptr ? extraPointers[1] : nullptr);
 
@@ -826,6 +855,7 @@ void NativeOps::execReduce3All(Nd4jPointer *extraPointers,
                                      Nd4jLong *xOffsets,
                                      Nd4jLong *yTadShapeInfo,
                                      Nd4jLong *yOffsets) {
+    nd4j::graph::OpProfilerScope profiler("reduce3", opNum, hXShapeInfo, hYShapeInfo);
 
     auto dimension = reinterpret_cast<int *>(hDimension);
     int dimensionLength = static_cast<int>(shape::length(hDimensionShape));
@@ -1195,15 +1225,10 @@ void NativeOps::setGridLimit(int gridSize) {
 }
 
 void NativeOps::tadOnlyShapeInfo(Nd4jLong *hXShapeInfo, int *dimension, int dimensionLength, Nd4jLong *target, Nd4jLong *offsets) {
-    shape::TAD tad;
-    tad.init(hXShapeInfo, dimension, dimensionLength);
-    //tad->setOutputBuffer(target);
-    tad.createTadOnlyShapeInfo();
-    tad.createOffsets();
+    auto tadPack = nd4j::ConstantTadHelper::getInstance()->tadForDimensions(hXShapeInfo, dimension, dimensionLength);
 
-
-    std::memcpy(reinterpret_cast<void *>(target), tad.tadOnlyShapeInfo, shape::shapeInfoByteLength(tad.tadOnlyShapeInfo));
-    std::memcpy(reinterpret_cast<void *>(offsets), tad.tadOffsets, tad.numTads * sizeof(Nd4jLong));
+    std::memcpy(reinterpret_cast<void *>(target), tadPack.primaryShapeInfo(), shape::shapeInfoByteLength(tadPack.primaryShapeInfo()));
+    std::memcpy(reinterpret_cast<void *>(offsets), tadPack.primaryOffsets(), tadPack.numberOfTads() * sizeof(Nd4jLong));
 }
 
 int NativeOps::memcpyConstantAsync(Nd4jLong dst, Nd4jPointer src, Nd4jLong size, int flags, Nd4jPointer reserved) {
@@ -1526,6 +1551,7 @@ void NativeOps::execScalar(Nd4jPointer *extraPointers,
                                  void *dDimension, Nd4jLong *dDimensionShape,
                                  Nd4jLong *tadShapeInfo, Nd4jLong *tadOffsets,
                                  Nd4jLong *tadShapeInfoZ, Nd4jLong *tadOffsetsZ) {
+    nd4j::graph::OpProfilerScope profiler("scalar", opNum, hXShapeInfo, hScalarShapeInfo);
 
     auto dimension = reinterpret_cast<int *>(hDimension);
     int dimensionLength = static_cast<int>(shape::length(hDimensionShape));
@@ -1560,6 +1586,7 @@ void NativeOps::execScalarBool(Nd4jPointer *extraPointers,
                            void *dDimension, Nd4jLong *dDimensionShape,
                            Nd4jLong *tadShapeInfo, Nd4jLong *tadOffsets,
                            Nd4jLong *tadShapeInfoZ, Nd4jLong *tadOffsetsZ) {
+    nd4j::graph::OpProfilerScope profiler("scalar_bool", opNum, hXShapeInfo, hScalarShapeInfo);
 
     auto dimension = reinterpret_cast<int *>(hDimension);
     int dimensionLength = static_cast<int>(shape::length(hDimensionShape));
@@ -1694,6 +1721,7 @@ void NativeOps::execRandom(Nd4jPointer *extraPointers,
                                  void *hZ, Nd4jLong *hZShapeInfo,
                                  void *dZ, Nd4jLong *dZShapeInfo,
                                  void *extraArguments) {
+    nd4j::graph::OpProfilerScope profiler("random", opNum, hZShapeInfo);
     NativeOpExcutioner::execRandom(opNum, state, hZ, hZShapeInfo, extraArguments);
 }
 
@@ -1707,6 +1735,7 @@ void NativeOps::execRandom(Nd4jPointer *extraPointers,
                                  void *hZ, Nd4jLong *hZShapeInfo,
                                  void *dZ, Nd4jLong *dZShapeInfo,
                                  void *extraArguments) {
+    nd4j::graph::OpProfilerScope profiler("random", opNum, hXShapeInfo, hYShapeInfo);
     NativeOpExcutioner::execRandom(opNum, state, hX, hXShapeInfo, hY, hYShapeInfo, hZ, hZShapeInfo, extraArguments);
 }
 
@@ -1718,6 +1747,7 @@ void NativeOps::execRandom(Nd4jPointer *extraPointers,
                                  void *hZ, Nd4jLong *hZShapeInfo,
                                  void *dZ, Nd4jLong *dZShapeInfo,
                                  void *extraArguments) {
+    nd4j::graph::OpProfilerScope profiler("random", opNum, hXShapeInfo);
     NativeOpExcutioner::execRandom(opNum, state, hX, hXShapeInfo, hZ, hZShapeInfo, extraArguments);
 }
 
@@ -1796,6 +1826,15 @@ void NativeOps::sortTad(Nd4jPointer *extraPointers,
     NativeOpExcutioner::execSort(hX, hXShapeInfo, dimension, dimensionLength, tadShapeInfo, tadOffsets, descending);
 }
 
+void NativeOps::sortByKey(Nd4jPointer *extraPointers,
+            void *hX, Nd4jLong *hXShapeInfo,
+            void *dX, Nd4jLong *dXShapeInfo,
+            void *hY, Nd4jLong *hYShapeInfo,
+            void *dY, Nd4jLong *dYShapeInfo,
+            bool descending) {
+    NativeOpExcutioner::execSortByKey(hX, hXShapeInfo, hY, hYShapeInfo, descending);
+}
+
 void NativeOps::sortCooIndices(Nd4jPointer *extraPointers,
         Nd4jLong *indices,
         void *values,
@@ -1855,6 +1894,23 @@ const char* NativeOps::getAllCustomOps() {
     return nd4j::ops::OpRegistrator::getInstance()->getAllCustomOperations();
 }
 
+void NativeOps::enableOpProfiler(bool reallyEnable) {
+    nd4j::graph::OpProfiler::getInstance()->setEnabled(reallyEnable);
+}
+
+const char* NativeOps::getOpProfilerSnapshot(bool reset) {
+    auto json = nd4j::graph::OpProfiler::getInstance()->toJson(reset);
+
+    auto result = new char[json.length() + 1];
+    std::memcpy(result, json.c_str(), json.length() + 1);
+
+    return result;
+}
+
+void NativeOps::resetOpProfiler() {
+    nd4j::graph::OpProfiler::getInstance()->reset();
+}
+
 template <typename T>
 FORCEINLINE int estimateThresholdGeneric(Nd4jPointer *extraPointers, Nd4jPointer hX, int N, T threshold) {
     auto buffer = reinterpret_cast<T *>(hX);
@@ -1969,8 +2025,12 @@ nd4j::ShapeList* NativeOps::calculateOutputShapes(Nd4jPointer* extraPointers, Nd
 }
 
 Nd4jStatus realExec(nd4j::ops::DeclarableOp* op, Nd4jPointer* extraPointers, Nd4jLong hash, Nd4jPointer* inputBuffers, Nd4jPointer* inputShapes, int numInputs, Nd4jPointer* outputBuffers, Nd4jPointer* outputShapes, int numOutputs, double* tArgs, int numTArgs, Nd4jLong *iArgs, int numIArgs, bool* bArgs, int numBArgs, bool isInplace) {
-    if (op == nullptr)
+    if (op == nullptr) {
         nd4j_printf("Can't find requested operation: [%lld]\n", hash);
+        return ND4J_STATUS_BAD_INPUT;
+    }
+
+    nd4j::graph::OpProfilerScope profiler(*op->getOpName(), inputShapes, numInputs);
 
     // we're using the same fake nodeId everywhere here
 
@@ -2083,6 +2143,7 @@ Nd4jStatus realExec(nd4j::ops::DeclarableOp* op, Nd4jPointer* extraPointers, Nd4
 
 int NativeOps::execCustomOp(Nd4jPointer* extraPointers, Nd4jLong hash, Nd4jPointer* inputBuffers, Nd4jPointer* inputShapes, int numInputs, Nd4jPointer* outputBuffers, Nd4jPointer* outputShapes, int numOutputs, double* tArgs, int numTArgs, Nd4jLong *iArgs, int numIArgs, bool* bArgs, int numBArgs, bool isInplace) {
     auto op = nd4j::ops::OpRegistrator::getInstance()->getOperation(hash);
+
     return realExec(op, extraPointers, hash, inputBuffers, inputShapes, numInputs, outputBuffers, outputShapes, numOutputs, tArgs, numTArgs, iArgs, numIArgs, bArgs, numBArgs, isInplace);
 }
 
@@ -2166,6 +2227,11 @@ void NativeOps::deleteLongArray(Nd4jPointer pointer) {
     delete[] ptr;
 }
 
+void NativeOps::deleteCharArray(Nd4jPointer pointer) {
+    auto ptr = reinterpret_cast<char *>(pointer);
+    delete[] ptr;
+}
+
 template <typename T>
 static void deleteVariablesSetT(Nd4jPointer pointer) {
     auto ptr = reinterpret_cast<nd4j::graph::VariablesSet*>(pointer);
@@ -66,6 +66,7 @@
 #include <loops/aggregates.h>
 #include <helpers/threshold.h>
 #include <ShapeList.h>
+#include <graph/profiling/OpProfiler.h>
 #include <Context.h>
 #include <ops/specials_cuda.h>
 
@@ -3081,6 +3082,15 @@ void NativeOps::sortTad(Nd4jPointer *extraPointers,
     nd4j::DebugHelper::checkErrorCode(stream, "sortTadFloat(...) failed");
 }
 
+void NativeOps::sortByKey(Nd4jPointer *extraPointers,
+            void *x, Nd4jLong *xShapeInfo,
+            void *dX, Nd4jLong *dXShapeInfo,
+            void *y, Nd4jLong *yShapeInfo,
+            void *dy, Nd4jLong *dyShapeInfo,
+            bool descending) {
+	throw std::runtime_error("sortByKey:: Not implemented yet");
+}
+
 void NativeOps::sortCooIndices(Nd4jPointer *extraPointers, Nd4jLong *indices, void *values, Nd4jLong length, int rank) {
 	throw std::runtime_error("sortCooIndices:: Not implemented yet");
 }
@@ -3140,6 +3150,23 @@ const char* NativeOps::getAllCustomOps() {
 	return nd4j::ops::OpRegistrator::getInstance()->getAllCustomOperations();
 }
 
+void NativeOps::enableOpProfiler(bool reallyEnable) {
+	nd4j::graph::OpProfiler::getInstance()->setEnabled(reallyEnable);
+}
+
+const char* NativeOps::getOpProfilerSnapshot(bool reset) {
+	auto json = nd4j::graph::OpProfiler::getInstance()->toJson(reset);
+
+	auto result = new char[json.length() + 1];
+	std::memcpy(result, json.c_str(), json.length() + 1);
+
+	return result;
+}
+
+void NativeOps::resetOpProfiler() {
+	nd4j::graph::OpProfiler::getInstance()->reset();
+}
+
 
 nd4j::ShapeList* _calculateOutputShapes(Nd4jPointer* extraPointers, nd4j::ops::DeclarableOp* op, Nd4jPointer* inputBuffers, Nd4jPointer* inputShapes, int numInputShapes, double* tArgs, int numTArgs, Nd4jLong *iArgs, int numIArgs, bool *bArgs, int numBArgs) {
     nd4j::graph::VariableSpace varSpace;
@@ -3409,6 +3436,11 @@ void NativeOps::deleteLongArray(Nd4jPointer pointer) {
 	delete[] ptr;
 }
 
+void NativeOps::deleteCharArray(Nd4jPointer pointer) {
+	auto ptr = reinterpret_cast<char *>(pointer);
+	delete[] ptr;
+}
+
 template <typename T>
 static void deleteVariablesSetT(Nd4jPointer pointer) {
 	nd4j::graph::VariablesSet* ptr = reinterpret_cast<nd4j::graph::VariablesSet*>(pointer);
@@ -0,0 +1,62 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_SHAPELISTDESCRIPTOR_H
+#define LIBND4J_SHAPELISTDESCRIPTOR_H
+
+#include <vector>
+#include <pointercast.h>
+#include <dll.h>
+#include <array/DataType.h>
+#include <array/ShapeList.h>
+
+namespace nd4j {
+    /**
+     * This class is a key for output shapes cache: it holds copies of input shapeInfos (dtypes included) and op arguments
+     */
+    class ND4J_EXPORT ShapeListDescriptor {
+    private:
+        // input shapeInfos, stored one after another
+        std::vector<Nd4jLong> _shapes;
+        std::vector<int> _iArgs;
+        // T args are compared bitwise, so NaN args don't break ordering
+        std::vector<Nd4jLong> _tArgs;
+        std::vector<bool> _bArgs;
+        std::vector<int> _axis;
+        nd4j::DataType _dataType;
+        // default floating point type might be picked by shape functions
+        nd4j::DataType _defaultType;
+
+    public:
+        explicit ShapeListDescriptor(ShapeList &inputShapes, const std::vector<int> &iArgs, const std::vector<double> &tArgs, const std::vector<bool> &bArgs, const std::vector<int> &axis, nd4j::DataType dataType, nd4j::DataType defaultType);
+        ~ShapeListDescriptor() = default;
+
+        ShapeListDescriptor(const ShapeListDescriptor &other) = default;
+        ShapeListDescriptor(ShapeListDescriptor &&other) = default;
+
+        ShapeListDescriptor& operator=(const ShapeListDescriptor &other) = default;
+        ShapeListDescriptor& operator=(ShapeListDescriptor &&other) = default;
+
+        // equal to operator
+        bool operator==(const ShapeListDescriptor &other) const;
+
+        // less than operator, used as key comparator in std::map
+        bool operator<(const ShapeListDescriptor &other) const;
+    };
+}
+
+
+#endif //LIBND4J_SHAPELISTDESCRIPTOR_H
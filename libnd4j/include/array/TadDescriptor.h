@@ -0,0 +1,56 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_TADDESCRIPTOR_H
+#define LIBND4J_TADDESCRIPTOR_H
+
+#include <vector>
+#include <pointercast.h>
+#include <dll.h>
+
+namespace nd4j {
+    /**
+     * This class is a key for TAD cache: it holds copy of original shapeInfo and dimensions TAD was built for
+     */
+    class ND4J_EXPORT TadDescriptor {
+    private:
+        std::vector<Nd4jLong> _originalShape;
+        std::vector<int> _axis;
+
+    public:
+        explicit TadDescriptor(const Nd4jLong *originalShape, const int *dimensions, const int length);
+        explicit TadDescriptor(const Nd4jLong *originalShape, const std::vector<int> &dimensions);
+        ~TadDescriptor() = default;
+
+        TadDescriptor(const TadDescriptor &other) = default;
+        TadDescriptor(TadDescriptor &&other) = default;
+
+        TadDescriptor& operator=(const TadDescriptor &other) = default;
+        TadDescriptor& operator=(TadDescriptor &&other) = default;
+
+        // equal to operator
+        bool operator==(const TadDescriptor &other) const;
+
+        // less than operator, used as key comparator in std::map
+        bool operator<(const TadDescriptor &other) const;
+
+        const std::vector<Nd4jLong>& originalShape() const;
+        const std::vector<int>& axis() const;
+    };
+}
+
+
+#endif //LIBND4J_TADDESCRIPTOR_H
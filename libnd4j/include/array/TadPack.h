@@ -0,0 +1,52 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_TADPACK_H
+#define LIBND4J_TADPACK_H
+
+#include <memory>
+#include <pointercast.h>
+#include <dll.h>
+
+namespace nd4j {
+    /**
+     * This class holds TAD-only shapeInfo and TAD offsets for some shape/dimensions pair.
+     * Buffers are shared between copies, so pack stays valid even if it was evicted from cache meanwhile
+     */
+    class ND4J_EXPORT TadPack {
+    private:
+        std::shared_ptr<Nd4jLong> _tadShape;
+        std::shared_ptr<Nd4jLong> _tadOffsets;
+        Nd4jLong _numTads = 0;
+
+    public:
+        /**
+         * PLEASE NOTE: TadPack takes ownership of both buffers, they must be allocated with new[]
+         */
+        explicit TadPack(Nd4jLong *tadShape, Nd4jLong *tadOffsets, Nd4jLong numTads);
+        TadPack() = default;
+        ~TadPack() = default;
+
+        Nd4jLong* primaryShapeInfo() const;
+        Nd4jLong* primaryOffsets() const;
+
+        Nd4jLong numberOfTads() const;
+        int shapeInfoLength() const;
+    };
+}
+
+
+#endif //LIBND4J_TADPACK_H
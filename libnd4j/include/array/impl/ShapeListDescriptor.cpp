@@ -0,0 +1,58 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <array/ShapeListDescriptor.h>
+#include <helpers/shape.h>
+#include <cstring>
+
+namespace nd4j {
+    ShapeListDescriptor::ShapeListDescriptor(ShapeList &inputShapes, const std::vector<int> &iArgs, const std::vector<double> &tArgs, const std::vector<bool> &bArgs, const std::vector<int> &axis, nd4j::DataType dataType, nd4j::DataType defaultType) : _iArgs(iArgs), _bArgs(bArgs), _axis(axis), _dataType(dataType), _defaultType(defaultType) {
+        for (int e = 0; e < inputShapes.size(); e++) {
+            auto shapeInfo = inputShapes.at(e);
+            _shapes.insert(_shapes.end(), shapeInfo, shapeInfo + shape::shapeInfoLength(shapeInfo));
+        }
+
+        _tArgs.resize(tArgs.size());
+        if (!tArgs.empty())
+            std::memcpy(_tArgs.data(), tArgs.data(), tArgs.size() * sizeof(double));
+    }
+
+    bool ShapeListDescriptor::operator==(const ShapeListDescriptor &other) const {
+        return _dataType == other._dataType && _defaultType == other._defaultType && _iArgs == other._iArgs && _tArgs == other._tArgs && _bArgs == other._bArgs && _axis == other._axis && _shapes == other._shapes;
+    }
+
+    bool ShapeListDescriptor::operator<(const ShapeListDescriptor &other) const {
+        if (_dataType != other._dataType)
+            return _dataType < other._dataType;
+
+        if (_defaultType != other._defaultType)
+            return _defaultType < other._defaultType;
+
+        if (_iArgs != other._iArgs)
+            return _iArgs < other._iArgs;
+
+        if (_tArgs != other._tArgs)
+            return _tArgs < other._tArgs;
+
+        if (_bArgs != other._bArgs)
+            return _bArgs < other._bArgs;
+
+        if (_axis != other._axis)
+            return _axis < other._axis;
+
+        return _shapes < other._shapes;
+    }
+}
@@ -0,0 +1,48 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <array/TadDescriptor.h>
+#include <helpers/shape.h>
+
+namespace nd4j {
+    TadDescriptor::TadDescriptor(const Nd4jLong *originalShape, const int *dimensions, const int length) {
+        _originalShape.assign(originalShape, originalShape + shape::shapeInfoLength(originalShape));
+        _axis.assign(dimensions, dimensions + length);
+    }
+
+    TadDescriptor::TadDescriptor(const Nd4jLong *originalShape, const std::vector<int> &dimensions) : TadDescriptor(originalShape, dimensions.data(), static_cast<int>(dimensions.size())) {
+        //
+    }
+
+    bool TadDescriptor::operator==(const TadDescriptor &other) const {
+        return _axis == other._axis && _originalShape == other._originalShape;
+    }
+
+    bool TadDescriptor::operator<(const TadDescriptor &other) const {
+        if (_axis != other._axis)
+            return _axis < other._axis;
+
+        return _originalShape < other._originalShape;
+    }
+
+    const std::vector<Nd4jLong>& TadDescriptor::originalShape() const {
+        return _originalShape;
+    }
+
+    const std::vector<int>& TadDescriptor::axis() const {
+        return _axis;
+    }
+}
@@ -0,0 +1,42 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <array/TadPack.h>
+#include <helpers/shape.h>
+
+namespace nd4j {
+    TadPack::TadPack(Nd4jLong *tadShape, Nd4jLong *tadOffsets, Nd4jLong numTads) {
+        _tadShape = std::shared_ptr<Nd4jLong>(tadShape, [] (Nd4jLong *ptr) { delete[] ptr; });
+        _tadOffsets = std::shared_ptr<Nd4jLong>(tadOffsets, [] (Nd4jLong *ptr) { delete[] ptr; });
+        _numTads = numTads;
+    }
+
+    Nd4jLong* TadPack::primaryShapeInfo() const {
+        return _tadShape.get();
+    }
+
+    Nd4jLong* TadPack::primaryOffsets() const {
+        return _tadOffsets.get();
+    }
+
+    Nd4jLong TadPack::numberOfTads() const {
+        return _numTads;
+    }
+
+    int TadPack::shapeInfoLength() const {
+        return shape::shapeInfoLength(primaryShapeInfo());
+    }
+}
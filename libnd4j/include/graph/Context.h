@@ -58,9 +58,9 @@ namespace nd4j {
             int _branch = 0;
 
             std::vector<nd4j::DataType> _dataTypes;
-#ifdef HAVE_MKLDNN
-            std::vector<nd4j::MKLDNNStream> _mkldnnStreams;
-#endif
+
+            // number of input variables requested via getVariable(), used to detect value-dependent shape functions
+            Nd4jLong _variableReads = 0;
         public:
             // TODO: maybe override new here as well?
 
@@ -118,9 +118,6 @@ namespace nd4j {
             int getBranch();
             void setBranch(int branch);
 
-#ifdef HAVE_MKLDNN
-            std::vector<nd4j::MKLDNNStream>& getMKLDNNStreams() { return _mkldnnStreams; }
-#endif
             /**
              *
              * @return
@@ -141,6 +138,11 @@ namespace nd4j {
             Variable* getVariable(int idx);
             Variable* variable(int idx);
 
+            /**
+             * This method returns number of getVariable() calls made so far for this block
+             */
+            Nd4jLong variableReads();
+
 
             /**
              * This method fetches variable from Workspace DIRECTLY
@@ -55,7 +55,7 @@ namespace nd4j {
 
         public:
             explicit ContextPrototype(nd4j::ops::OpDescriptor* opDescriptor = nullptr, int nodeId = 1, bool inPlace = false);
-            ~ContextPrototype() = default;
+            virtual ~ContextPrototype() = default;
 
             int getNodeId();
             int nodeId();
@@ -0,0 +1,59 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_EXECUTIONSESSION_H
+#define LIBND4J_EXECUTIONSESSION_H
+
+#include <dll.h>
+#include <graph/Graph.h>
+#include <graph/FlowPath.h>
+#include <graph/VariableProxy.h>
+#include <graph/MemoryPlanner.h>
+
+namespace nd4j {
+    namespace graph {
+        /**
+         * This class holds per-request execution state for a shared Graph:
+         * VariableProxy (with its own Workspace) on top of Graph VariableSpace, and FlowPath.
+         * Graph itself is never modified, so multiple sessions can execute the same Graph concurrently
+         */
+        class ND4J_EXPORT ExecutionSession {
+        protected:
+            Graph* _graph;
+            VariableProxy _variableSpace;
+            FlowPath* _flowPath = nullptr;
+            MemoryPlanner* _planner = nullptr;
+        public:
+            /**
+             * @param graph - Graph this session executes
+             * @param planner - optional MemoryPlanner shared by all sessions of the same Graph
+             */
+            explicit ExecutionSession(Graph* graph, MemoryPlanner* planner = nullptr);
+            ~ExecutionSession();
+
+            Graph* graph();
+
+            VariableSpace* variableSpace();
+
+            /**
+             * This method releases all intermediate results of previous execution, keeping Workspace memory for next one
+             */
+            void reset();
+        };
+    }
+}
+
+#endif //LIBND4J_EXECUTIONSESSION_H
@@ -37,6 +37,12 @@ namespace nd4j {
             Nd4jLong _footprintBackward = 0L;
             Direction _direction = Direction_FORWARD_ONLY;
 
+            // if true - independent nodes within the same graph layer are executed concurrently
+            bool _parallelLayers = false;
+
+            // if true - chains of elementwise legacy ops are fused during Graph::buildGraph, see Graph::fusedGroups(). Requires Environment::isElementwiseFusion() as well
+            bool _elementwiseFusion = false;
+
             explicit ExecutorConfiguration(const nd4j::graph::FlatConfiguration *conf = nullptr);
             ~ExecutorConfiguration() = default;
             
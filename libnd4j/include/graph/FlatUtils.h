@@ -35,7 +35,11 @@ namespace nd4j {
 
             static std::pair<Nd4jLong, Nd4jLong> fromLongPair(LongPair* pair);
 
-            static NDArray* fromFlatArray(const nd4j::graph::FlatArray* flatArray);
+            /**
+             * Restores NDArray from FlatArray. If inPlace is true and data has host byte order and proper alignment,
+             * NDArray points right into FlatBuffer without copying, so buffer must outlive it
+             */
+            static NDArray* fromFlatArray(const nd4j::graph::FlatArray* flatArray, bool inPlace = false);
         };
     }
 }
@@ -22,23 +22,35 @@
 #define LIBND4J_FLOWPATH_H
 
 #include <map>
+#include <memory>
+#include <vector>
 #include <pointercast.h>
 #include <graph/NodeState.h>
 #include <graph/FrameState.h>
+#include <graph/VariableIndex.h>
 #include <graph/profiling/GraphProfile.h>
 #include <dll.h>
 
 namespace nd4j {
     namespace graph {
+        class MemoryPlanner;
+
         class ND4J_EXPORT FlowPath {
         private:
             std::map<int, NodeState> _states;
             std::map<Nd4jLong, FrameState> _frames;
 
+            // states of indexed nodes are stored by slot, _states holds the rest
+            std::shared_ptr<const VariableIndex> _index;
+            std::vector<NodeState> _denseStates;
+
             void ensureNode(int nodeId);
+            NodeState& state(int nodeId);
             void ensureFrame(int nodeId);
 
             GraphProfile _profile;
+
+            MemoryPlanner* _memoryPlanner = nullptr;
         public:
             FlowPath() = default;
             ~FlowPath() = default;
@@ -77,6 +89,18 @@ namespace nd4j {
             Nd4jLong getNumberOfCycles(Nd4jLong frameId);
 
             GraphProfile* profile();
+
+            /**
+             * If MemoryPlanner is set, intermediate results of execution are placed into planned Workspace blocks
+             */
+            void setMemoryPlanner(MemoryPlanner* planner);
+            MemoryPlanner* memoryPlanner();
+
+            /**
+             * Attaches dense index of Graph ids, so node states are addressed by slot
+             */
+            void setVariableIndex(std::shared_ptr<const VariableIndex> index);
+            std::shared_ptr<const VariableIndex> variableIndex();
         };
     }
 }
@@ -34,6 +34,7 @@
 #include <graph/generated/graph_generated.h>
 #include <graph/generated/config_generated.h>
 #include <graph/ExecutorConfiguration.h>
+#include <graph/MappedFile.h>
 #include <ops/declarable/OpDescriptor.h>
 
 namespace nd4j {
@@ -62,10 +63,16 @@ namespace nd4j {
             std::vector<int> _output;
             std::vector<int> _autos;
 
+            // ids of nodes fused into single op, the last node of each group executes the whole group
+            std::vector<std::vector<int>> _fusedGroups;
+
 
             std::map<int, Scope*> _mappedScopes;
             std::vector<Scope*> _scopes;
 
+            // file this graph was mapped from, variables may point into it
+            MappedFile* _mappedFile = nullptr;
+
 ////////////////////////////////////////
             Nd4jStatus validateNode(nd4j::graph::Node *node);
 
@@ -79,9 +86,23 @@ namespace nd4j {
 
             void prepareOutputs();
 
+            // attaches dense index of all node and variable ids to VariableSpace, once graph is built
+            void indexVariables();
+
+            // replaces chains of elementwise legacy ops with single FusedElementwiseOp, once graph is built
+            void fuseElementwise();
+
+            void initialize(const FlatGraph *flatGraph, VariableSpace *variableSpace, bool inPlace);
+
         public:
             Graph(const FlatGraph *flatGraph = nullptr, VariableSpace *variableSpace = nullptr);
 
+            /**
+             * This constructor builds Graph from FlatGraph stored in given mapped file. Graph takes ownership of the file,
+             * and arrays of VARIABLE and CONSTANT variables reference file contents without copying
+             */
+            Graph(MappedFile *mappedFile, VariableSpace *variableSpace = nullptr);
+
             ~Graph();
 
             // this method applies toposort to nodes
@@ -138,6 +159,12 @@ namespace nd4j {
              */
             std::vector<nd4j::graph::Variable*> *fetchOutputs();
 
+            /**
+             * This method returns outputs of this graph, stored in given VariableSpace
+             * @return
+             */
+            std::vector<nd4j::graph::Variable*> *fetchOutputs(VariableSpace *variableSpace);
+
             /**
              * This method returns pointer to ExecutorConfiguration
              *
@@ -189,8 +216,15 @@ namespace nd4j {
 
             /**
              * This method returns clone of the graph, backed by VariableProxy instead of VariableSpace
+             * @param copyOnWrite - if true, empty Variables of this graph are never handed out to clone, see VariableProxy
+             */
+            Graph* cloneWithProxy(bool copyOnWrite = false);
+
+            /**
+             * This method returns TRUE if execution of this graph modifies the graph itself
+             * (logic ops, embedded graphs, external outputs), so it can't be shared between concurrent executions
              */
-            Graph* cloneWithProxy();
+            bool hasStatefulNodes();
 
             /**
              * This method removes reference to VariableSpace from this Graph
@@ -233,12 +267,19 @@ namespace nd4j {
                 return &_output;
             }
 
+            /**
+             * This method returns groups of node ids fused into single op during build, in order of execution within group
+             */
+            FORCEINLINE std::vector<std::vector<int>>* fusedGroups() {
+                return &_fusedGroups;
+            }
+
             FORCEINLINE std::map<int, Scope*>* scopes() {
                 return &_mappedScopes;
             }
 
             FORCEINLINE bool built() {
-                return _built.load();
+                return _built.load(std::memory_order_acquire);
             }
 
             FORCEINLINE void pullState(Graph *other) {
@@ -251,6 +292,9 @@ namespace nd4j {
                 for (int e = 0; e < other->autos()->size(); e++)
                     this->_autos.emplace_back(other->autos()->at(e));
 
+                for (auto &v: *other->fusedGroups())
+                    this->_fusedGroups.emplace_back(v);
+
                 for (auto &v: *other->scopes()) {
                     auto scp = v.second->clone();
                     this->_mappedScopes[v.first] = scp;
@@ -18,24 +18,80 @@
 //  @author raver119@gmail.com
 //
 
+#ifndef LIBND4J_GRAPHHOLDER_H
+#define LIBND4J_GRAPHHOLDER_H
+
 #include <helpers/logger.h>
 #include <pointercast.h>
 #include <map>
+#include <vector>
+#include <mutex>
+#include <memory>
+#include <atomic>
+#include <functional>
 #include <graph/Graph.h>
-#include <helpers/SimpleReadWriteLock.h>
+#include <graph/ExecutionSession.h>
+#include <graph/MemoryPlanner.h>
 #include <graph/exceptions/unknown_graph_exception.h>
 
 namespace nd4j {
     namespace graph {
         class ND4J_EXPORT GraphHolder {
         private:
+            /**
+             * This class holds registered graph together with its pooled execution states.
+             * Executions keep a reference to the entry, so replaced or dropped graph stays alive until the last of them completes
+             */
+            class Entry {
+            public:
+                Graph *_graph;
+
+                // if true, graph will be deleted together with this entry
+                std::atomic<bool> _release;
+
+                std::mutex _buildLock;
+
+                // idle per-request execution states, reused across requests to this graph
+                std::vector<ExecutionSession*> _sessions;
+                std::mutex _sessionsLock;
+
+                // static memory layout shared by all sessions of this graph
+                MemoryPlanner _planner;
+
+                explicit Entry(Graph *graph);
+                ~Entry();
+            };
+
+            typedef std::map<Nd4jLong, std::shared_ptr<Entry>> Registry;
+
             static GraphHolder *_INSTANCE;
-            std::map<Nd4jLong, Graph *> _graphF;
 
-            std::map<Nd4jLong, SimpleReadWriteLock> _locks;
+            // immutable snapshot of registered graphs. readers only load it, writers publish modified copy
+            std::atomic<const Registry*> _registry;
+
+            // readers announce themselves in counter of current epoch, writer retires previous snapshot once its epoch drains
+            std::atomic<Nd4jLong> _epoch;
+            std::atomic<int> _readers[2];
+
+            // serializes writers only
+            std::mutex _writeLock;
+
+            std::shared_ptr<Entry> lookup(Nd4jLong graphId);
+
+            // publishes new snapshot and deletes previous one once no reader can see it. must be called under _writeLock
+            void publish(const Registry *updated);
+
+            // removes graph from registry, optionally releasing it once in-flight executions are done
+            void removeGraph(Nd4jLong graphId, bool release);
 
-            GraphHolder() = default;
-            ~GraphHolder() = default;
+            ExecutionSession* acquireSession(Entry *entry);
+            void releaseSession(Entry *entry, ExecutionSession *session);
+
+            // runs given function against graph and VariableSpace isolated from other concurrent executions
+            void executeIsolated(Nd4jLong graphId, const std::function<void(Graph*, VariableSpace*)> &func);
+
+            GraphHolder();
+            ~GraphHolder();
         public:
             static GraphHolder* getInstance();
 
@@ -57,37 +113,24 @@ namespace nd4j {
 
             flatbuffers::Offset<FlatResult> execute(Nd4jLong graphId, flatbuffers::FlatBufferBuilder &builder, const FlatInferenceRequest* request);
 
-            void replaceGraph(Nd4jLong graphId, Graph *graph);
-
-            /////////////////////////////
-
-            FORCEINLINE void lockWrite(Nd4jLong graphId) {
-                if (_locks.count(graphId) == 0)
-                    return;
-
-                _locks[graphId].lockWrite();
-            }
+            /**
+             * This method executes graph with given input Variables, and returns copies of its outputs
+             * PLEASE NOTE: ownership of inputs is transferred to this method, caller takes ownership of outputs
+             */
+            std::vector<Variable*>* execute(Nd4jLong graphId, std::vector<Variable*> &inputs);
 
-            FORCEINLINE void unlockWrite(Nd4jLong graphId) {
-                if (_locks.count(graphId) == 0)
-                    return;
-
-                _locks[graphId].unlockWrite();
-            }
-
-            FORCEINLINE void lockRead(Nd4jLong graphId) {
-                if (_locks.count(graphId) == 0)
-                    return;
-
-                _locks[graphId].lockRead();
-            }
-
-            FORCEINLINE void unlockRead(Nd4jLong graphId) {
-                if (_locks.count(graphId) == 0)
-                    return;
+            /**
+             * This method atomically swaps graph stored under given id, or registers it if there's none.
+             * Executions already in progress finish on the previous graph, which is deleted afterwards
+             */
+            void replaceGraph(Nd4jLong graphId, Graph *graph);
 
-                _locks[graphId].unlockRead();
-            }
+            /**
+             * This method returns number of idle execution sessions pooled for given graph
+             */
+            int idleSessions(Nd4jLong graphId);
         };
     }
-}
\ No newline at end of file
+}
+
+#endif //LIBND4J_GRAPHHOLDER_H
@@ -0,0 +1,55 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_MAPPEDFILE_H
+#define LIBND4J_MAPPEDFILE_H
+
+#include <pointercast.h>
+#include <dll.h>
+
+namespace nd4j {
+    namespace graph {
+        /**
+         * Whole file mapped into memory, i.e. FlatBuffers graph with all its weights.
+         *
+         * Mapping is private: pages come from page cache and are shared between processes until somebody writes into them,
+         * so arrays pointing into the file stay safe for in-place ops. On platforms without mmap file is just read into memory.
+         */
+        class ND4J_EXPORT MappedFile {
+        protected:
+            uint8_t *_buffer = nullptr;
+            Nd4jLong _length = 0;
+            bool _mapped = false;
+
+        public:
+            explicit MappedFile(const char *filename);
+            ~MappedFile();
+
+            MappedFile(const MappedFile &other) = delete;
+            MappedFile& operator=(const MappedFile &other) = delete;
+
+            uint8_t* data() const;
+            Nd4jLong length() const;
+
+            /**
+             * Returns true if file is really mapped, and false if it was read into heap buffer
+             */
+            bool isMapped() const;
+        };
+    }
+}
+
+#endif //LIBND4J_MAPPEDFILE_H
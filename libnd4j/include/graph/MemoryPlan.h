@@ -0,0 +1,72 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_MEMORYPLAN_H
+#define LIBND4J_MEMORYPLAN_H
+
+#include <dll.h>
+#include <pointercast.h>
+#include <map>
+#include <vector>
+#include <graph/Graph.h>
+
+namespace nd4j {
+    namespace graph {
+        /**
+         * This class describes static memory layout of Graph execution: every node gets its own block
+         * within single Workspace arena, and nodes whose results are never alive at the same time share memory.
+         *
+         * Plan is immutable once built
+         */
+        class ND4J_EXPORT MemoryPlan {
+        protected:
+            // nodeId -> (offset, size)
+            std::map<int, std::pair<Nd4jLong, Nd4jLong>> _blocks;
+
+            Nd4jLong _arenaSize = 0L;
+            Nd4jLong _totalSize = 0L;
+        public:
+            MemoryPlan() = default;
+            ~MemoryPlan() = default;
+
+            /**
+             * This method builds plan out of liveness of node results
+             *
+             * @param graph - Graph plan is built for
+             * @param order - ids of nodes in order of execution
+             * @param bytes - number of bytes allocated by each node during execution
+             * @param aliases - nodeId -> id of node, results of which were reused by given node in-place
+             */
+            static MemoryPlan* build(Graph *graph, const std::vector<int> &order, const std::map<int, Nd4jLong> &bytes, const std::map<int, int> &aliases);
+
+            bool hasBlock(int nodeId) const;
+            Nd4jLong offset(int nodeId) const;
+            Nd4jLong size(int nodeId) const;
+
+            /**
+             * This method returns number of bytes required for the whole arena
+             */
+            Nd4jLong arenaSize() const;
+
+            /**
+             * This method returns number of bytes that would be required without buffers reuse
+             */
+            Nd4jLong totalSize() const;
+        };
+    }
+}
+
+#endif //LIBND4J_MEMORYPLAN_H
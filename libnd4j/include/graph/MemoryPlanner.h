@@ -0,0 +1,65 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_MEMORYPLANNER_H
+#define LIBND4J_MEMORYPLANNER_H
+
+#include <dll.h>
+#include <memory>
+#include <mutex>
+#include <graph/MemoryPlan.h>
+
+namespace nd4j {
+    namespace graph {
+        /**
+         * This class keeps MemoryPlan of one Graph up to date. Execution without plan records memory used by each node,
+         * and plan built out of that record is used by all subsequent executions.
+         * If some node outgrows its block, plan is invalidated and rebuilt after next recording.
+         *
+         * PLEASE NOTE: this class is thread-safe, plan can be used by multiple executions concurrently
+         */
+        class ND4J_EXPORT MemoryPlanner {
+        protected:
+            // guards _plan pointer only, so readers never wait for plan being built
+            std::shared_ptr<MemoryPlan> _plan;
+            std::mutex _planLock;
+
+            // max number of bytes ever recorded per node
+            std::map<int, Nd4jLong> _bytes;
+            std::mutex _lock;
+        public:
+            MemoryPlanner() = default;
+            ~MemoryPlanner() = default;
+
+            /**
+             * This method returns current plan, or nullptr if execution should be recorded
+             */
+            std::shared_ptr<MemoryPlan> plan();
+
+            /**
+             * This method builds new plan out of recorded execution
+             */
+            void update(Graph *graph, const std::vector<int> &order, const std::map<int, Nd4jLong> &bytes, const std::map<int, int> &aliases);
+
+            /**
+             * This method drops current plan, so next execution will be recorded
+             */
+            void invalidate();
+        };
+    }
+}
+
+#endif //LIBND4J_MEMORYPLANNER_H
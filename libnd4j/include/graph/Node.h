@@ -92,6 +92,9 @@ namespace nd4j {
 
             Nd4jLong _frameId = -1;
 
+            // id of the node this node was fused into, see Graph::fusedGroups()
+            int _fusedInto = -1;
+
         public:
             Node(nd4j::ops::DeclarableOp *customOp, int id = 0, std::initializer_list<int> input = {}, std::initializer_list<int> output = {},  std::initializer_list<int> dimensions = {}, float scalar = 0.0f, std::initializer_list<double> tArgs = {}, std::initializer_list<int> iArgs = {});
             Node(OpType opType = OpType_TRANSFORM_SAME, int opNum = 0, int id = 0, std::initializer_list<int> input = {}, std::initializer_list<int> output = {},  std::initializer_list<int> dimensions = {}, float scalar = 0.0f, std::initializer_list<double> tArgs = {}, std::initializer_list<int> iArgs = {});
@@ -137,6 +140,7 @@ namespace nd4j {
             bool hasInternalInputs();
 
             double scalar();
+            bool hasScalar();
 
             std::vector<int> * getDimensions();
             int * getDimensionsPtr();
@@ -176,6 +180,16 @@ namespace nd4j {
             bool isInplace();
             void markInplace(bool reallyInplace);
 
+            // methods related to elementwise fusion: fused nodes are not executed, node they were fused into executes their ops
+            bool isFused();
+            int fusedInto();
+            void markFused(int nodeId);
+
+            /**
+             * This method replaces op of this node with given one, executed with given inputs. Node takes ownership of the op
+             */
+            void replaceOp(nd4j::ops::DeclarableOp *op, const std::vector<std::pair<int, int>> &inputs);
+
 
             OpClass getOpClass();
 
@@ -215,6 +229,7 @@ namespace nd4j {
                 this->setScopeInfo(other->scopeId(), other->scopeName()->c_str());
                 this->setLayer(other->getLayer());
                 this->setDeductable(other->isDeductable());
+                this->_fusedInto = other->fusedInto();
 
 
                 if (this->_customOp != nullptr && _isDeductable)
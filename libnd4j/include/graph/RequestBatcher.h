@@ -0,0 +1,115 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_REQUESTBATCHER_H
+#define LIBND4J_REQUESTBATCHER_H
+
+#include <dll.h>
+#include <pointercast.h>
+#include <map>
+#include <set>
+#include <deque>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <graph/Variable.h>
+#include <graph/generated/request_generated.h>
+#include <graph/generated/result_generated.h>
+
+namespace nd4j {
+    namespace graph {
+        /**
+         * This class coalesces concurrent inference requests for the same graph along the batch (0) dimension.
+         * First caller in a queue waits for up to given latency window (or until max batch size is accumulated),
+         * executes merged batch once via GraphHolder, and splits results back to each caller.
+         * Next batch for the same graph is collected while previous one is still executed.
+         *
+         * Requests with different input shapes/types are never merged together,
+         * and if graph outputs can't be split along batch dimension, requests are executed one by one, for this batch and all later ones.
+         */
+        class ND4J_EXPORT RequestBatcher {
+        protected:
+            struct PendingRequest {
+                Nd4jLong graphId;
+                Nd4jLong rows;
+                std::vector<Variable*> inputs;
+                std::vector<Variable*> *outputs = nullptr;
+                std::exception_ptr error;
+
+                // true once request is removed from queue as part of some batch
+                bool taken = false;
+                bool done = false;
+            };
+
+            struct BatchQueue {
+                std::deque<PendingRequest*> requests;
+                bool hasLeader = false;
+            };
+
+            int _maxBatchSize;
+            Nd4jLong _windowMicros;
+
+            std::mutex _lock;
+            std::condition_variable _condition;
+            std::map<Nd4jLong, BatchQueue> _queues;
+
+            // graphs with outputs that can't be split along batch dimension, their requests aren't merged anymore
+            std::set<Nd4jLong> _unsplittable;
+
+            // histograms: index is queue depth at arrival / number of requests in executed batch
+            std::vector<Nd4jLong> _queueDepths;
+            std::vector<Nd4jLong> _batchSizes;
+
+            static bool isCompatible(PendingRequest *first, PendingRequest *other);
+            static Nd4jLong batchRows(std::vector<Variable*> &inputs);
+
+            bool isSplittable(Nd4jLong graphId);
+            Nd4jLong queuedRows(BatchQueue &queue);
+            std::vector<PendingRequest*> takeBatch(BatchQueue &queue);
+
+            void executeBatch(std::vector<PendingRequest*> &batch);
+            void executeSeparately(std::vector<PendingRequest*> &batch);
+        public:
+            /**
+             * @param maxBatchSize - max number of rows (along dimension 0) in merged batch
+             * @param windowMicros - max time first request in a batch waits for others, in microseconds
+             */
+            RequestBatcher(int maxBatchSize, Nd4jLong windowMicros);
+            ~RequestBatcher() = default;
+
+            flatbuffers::Offset<FlatResult> execute(Nd4jLong graphId, flatbuffers::FlatBufferBuilder &builder, const FlatInferenceRequest* request);
+
+            /**
+             * This method executes given input Variables, possibly merged with concurrent requests.
+             * Ownership of inputs is transferred to this method, caller takes ownership of outputs
+             */
+            std::vector<Variable*>* execute(Nd4jLong graphId, std::vector<Variable*> &inputs);
+
+            int maxBatchSize();
+            Nd4jLong windowMicros();
+
+            /**
+             * These methods return histograms: number of arrivals seen at given queue depth,
+             * and number of executed batches of given size (in requests)
+             */
+            std::vector<Nd4jLong> queueDepthHistogram();
+            std::vector<Nd4jLong> batchSizeHistogram();
+        };
+    }
+}
+
+#endif //LIBND4J_REQUESTBATCHER_H
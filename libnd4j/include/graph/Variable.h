@@ -58,7 +58,10 @@ namespace nd4j {
             Variable(bool placeHolder);
             Variable(nd4j::NDArray *arrayw, const char *name, int id, int idx = 0);
             Variable(nd4j::NDArray *array = nullptr, const char *name = nullptr);
-            Variable(const nd4j::graph::FlatVariable *flatVariable);
+            /**
+             * @param inPlace - VARIABLE and CONSTANT arrays point right into FlatBuffer, see FlatUtils::fromFlatArray
+             */
+            Variable(const nd4j::graph::FlatVariable *flatVariable, bool inPlace = false);
             ~Variable();
 
             Variable* clone();
@@ -0,0 +1,74 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_VARIABLEINDEX_H
+#define LIBND4J_VARIABLEINDEX_H
+
+#include <pointercast.h>
+#include <dll.h>
+#include <op_boilerplate.h>
+#include <vector>
+#include <unordered_map>
+
+namespace nd4j {
+    namespace graph {
+        /**
+         * Immutable mapping of node/variable ids onto contiguous slots [0, size()).
+         * It's built once, when Graph is built, and then shared by VariableSpace and FlowPath instances,
+         * so per-node state is addressed by slot instead of tree lookups
+         */
+        class ND4J_EXPORT VariableIndex {
+        private:
+            // direct table for ids within [_minId, _minId + _table.size()), -1 for ids that aren't indexed
+            Nd4jLong _minId = 0;
+            std::vector<int> _table;
+
+            // used instead of direct table if ids are too sparse
+            std::unordered_map<int, int> _sparse;
+
+            // slot -> id
+            std::vector<int> _ids;
+        public:
+            // number of output indices per node that are addressed directly, outputs beyond that are looked up via maps
+            static const int MAX_OUTPUTS = 8;
+
+            explicit VariableIndex(const std::vector<int> &ids);
+            ~VariableIndex() = default;
+
+            /**
+             * Returns slot of given id, or -1 if id isn't indexed
+             */
+            FORCEINLINE int slot(int id) const {
+                if (!_sparse.empty()) {
+                    auto it = _sparse.find(id);
+                    return it == _sparse.end() ? -1 : it->second;
+                }
+
+                auto position = (Nd4jLong) id - _minId;
+                return position < 0 || position >= (Nd4jLong) _table.size() ? -1 : _table[position];
+            }
+
+            /**
+             * Returns id stored in given slot
+             */
+            int id(int slot) const;
+
+            int size() const;
+        };
+    }
+}
+
+#endif //LIBND4J_VARIABLEINDEX_H
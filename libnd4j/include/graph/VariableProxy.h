@@ -18,6 +18,9 @@
 //  @author raver119@gmail.com
 //
 
+#ifndef LIBND4J_VARIABLEPROXY_H
+#define LIBND4J_VARIABLEPROXY_H
+
 #include <graph/VariableSpace.h>
 
 namespace nd4j {
@@ -26,10 +29,26 @@ namespace nd4j {
         protected:
             VariableSpace* _backed = nullptr;
             VariableSpace* _current = nullptr;
+
+            // if true, empty Variables of backing space are never handed out directly
+            bool _copyOnWrite = false;
+
+            Variable* localize(std::pair<int,int> &pair, Variable *variable);
+
+            // true if both spaces share dense index covering given pair
+            bool isDense(int id, int idx);
         public:
-            explicit VariableProxy(VariableSpace* reference);
+            explicit VariableProxy(VariableSpace* reference, bool copyOnWrite = false);
             ~VariableProxy();
 
+            /**
+             * This method drops all Variables stored in this proxy, and rewinds its Workspace,
+             * so proxy can be reused for next execution of the same Graph
+             */
+            void reset();
+
+            bool isCopyOnWrite();
+
             virtual VariableSpace& operator=(const VariableSpace& other);
 
             virtual int numberOfPlaceholders();
@@ -85,6 +104,14 @@ namespace nd4j {
             virtual nd4j::graph::Stash* getStash();
             virtual void setFlowPath(FlowPath* timers);
             virtual FlowPath* flowPath();
+
+            virtual void setVariableIndex(std::shared_ptr<const VariableIndex> index);
+            virtual std::shared_ptr<const VariableIndex> variableIndex();
+
+            virtual nd4j::graph::Variable* denseVariable(int id);
+            virtual nd4j::graph::Variable* denseVariable(int id, int idx);
         };
     }
-}
\ No newline at end of file
+}
+
+#endif //LIBND4J_VARIABLEPROXY_H
@@ -28,12 +28,15 @@
 #include <list>
 #include <map>
 #include <mutex>
+#include <atomic>
+#include <memory>
 #include <NDArray.h>
 #include <array/NDArrayList.h>
 #include <graph/Variable.h>
 #include <memory/Workspace.h>
 #include <graph/Stash.h>
 #include <graph/FlowPath.h>
+#include <graph/VariableIndex.h>
 
 
 namespace nd4j {
@@ -69,6 +72,27 @@ namespace nd4j {
 
             FlowPath* _flow = nullptr;
 
+            // dense mirrors of _paired and _variables/_temporary for indexed ids, read without locks
+            std::shared_ptr<const VariableIndex> _index;
+            std::unique_ptr<std::atomic<Variable*>[]> _densePaired;
+            std::unique_ptr<std::atomic<Variable*>[]> _denseIds;
+
+            void storePaired(const std::pair<int,int>& pair, Variable *variable);
+            void storeId(int id, Variable *variable);
+
+            // returns position within _densePaired, or -1 if given pair isn't indexed
+            FORCEINLINE Nd4jLong densePosition(int id, int idx) const {
+                if (_index == nullptr || idx < 0 || idx >= VariableIndex::MAX_OUTPUTS)
+                    return -1;
+
+                auto slot = _index->slot(id);
+                return slot < 0 ? -1 : (Nd4jLong) slot * VariableIndex::MAX_OUTPUTS + idx;
+            }
+
+            FORCEINLINE int denseSlot(int id) const {
+                return _index == nullptr ? -1 : _index->slot(id);
+            }
+
         public:
             VariableSpace();
             virtual ~VariableSpace();
@@ -138,6 +162,22 @@ namespace nd4j {
 
             virtual void setFlowPath(FlowPath* timers);
             virtual FlowPath* flowPath();
+
+            /**
+             * This method attaches dense index to this VariableSpace: Variables with indexed ids are mirrored into
+             * flat tables, so lookups for them take O(1) and don't need any locks. Must not be called concurrently
+             * with other methods of this VariableSpace
+             */
+            virtual void setVariableIndex(std::shared_ptr<const VariableIndex> index);
+            virtual std::shared_ptr<const VariableIndex> variableIndex();
+
+            /**
+             * These methods return the same Variable as getVariable(id) and getVariable(id, idx) would,
+             * if it can be resolved via dense index without modifying this VariableSpace. Otherwise nullptr is returned.
+             * They are lock-free, and safe to call concurrently with putVariable()
+             */
+            virtual nd4j::graph::Variable* denseVariable(int id);
+            virtual nd4j::graph::Variable* denseVariable(int id, int idx);
         };
     }
 }
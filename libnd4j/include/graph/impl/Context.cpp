@@ -99,9 +99,6 @@ namespace nd4j {
             this->_iArgs.clear();
             this->_tArgs.clear();
             this->_inputs.clear();
-#ifdef HAVE_MKLDNN
-            this->_mkldnnStreams.clear();
-#endif
         }
 
         bool Context::hasWorkspaceProvided() {
@@ -207,6 +204,7 @@ namespace nd4j {
             auto p = this->_inputs[idx];
 
             auto v = variable(p);
+            _variableReads++;
 
             if (Environment::getInstance()->isDebugAndVerbose() && v != nullptr &&  v->getNDArray() != nullptr) {
                 auto array = v->getNDArray();
@@ -229,6 +227,10 @@ namespace nd4j {
             return getVariable(idx);
         }
 
+        Nd4jLong Context::variableReads() {
+            return _variableReads;
+        }
+
         Variable* Context::variable(std::initializer_list<int> p) {
             if (p.size() != 2)
                 throw std::runtime_error("Variable address should have size of 2");
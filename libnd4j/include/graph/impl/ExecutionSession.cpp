@@ -0,0 +1,50 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <graph/ExecutionSession.h>
+
+namespace nd4j {
+    namespace graph {
+        ExecutionSession::ExecutionSession(Graph* graph, MemoryPlanner* planner) : _variableSpace(graph->getVariableSpace(), true) {
+            _graph = graph;
+            _planner = planner;
+            _flowPath = new FlowPath();
+            _flowPath->setMemoryPlanner(_planner);
+            _variableSpace.setFlowPath(_flowPath);
+        }
+
+        ExecutionSession::~ExecutionSession() {
+            delete _flowPath;
+        }
+
+        Graph* ExecutionSession::graph() {
+            return _graph;
+        }
+
+        VariableSpace* ExecutionSession::variableSpace() {
+            return &_variableSpace;
+        }
+
+        void ExecutionSession::reset() {
+            _variableSpace.reset();
+
+            delete _flowPath;
+            _flowPath = new FlowPath();
+            _flowPath->setMemoryPlanner(_planner);
+            _variableSpace.setFlowPath(_flowPath);
+        }
+    }
+}
@@ -36,7 +36,7 @@ namespace nd4j {
             return std::pair<Nd4jLong, Nd4jLong>(pair->first(), pair->second());
         }
 
-        NDArray* FlatUtils::fromFlatArray(const nd4j::graph::FlatArray *flatArray) {
+        NDArray* FlatUtils::fromFlatArray(const nd4j::graph::FlatArray *flatArray, bool inPlace) {
             auto rank = static_cast<int>(flatArray->shape()->Get(0));
             auto newShape = new Nd4jLong[shape::shapeInfoLength(rank)];
             memcpy(newShape, flatArray->shape()->data(), shape::shapeInfoByteLength(rank));
@@ -91,6 +91,22 @@ namespace nd4j {
             }
 
 
+            if (inPlace) {
+                auto rawPtr = (void *) flatArray->buffer()->data();
+                auto byteOrder = ByteOrderUtils::fromFlatByteOrder(flatArray->byteOrder());
+                bool canKeep = DataTypeUtils::sizeOf(dtype) == 1 || (BitwiseUtils::isBE() ? byteOrder == nd4j::ByteOrder::BE : byteOrder == nd4j::ByteOrder::LE);
+                bool isAligned = reinterpret_cast<Nd4jLong>(rawPtr) % DataTypeUtils::sizeOf(dtype) == 0;
+
+                if (canKeep && isAligned && flatArray->buffer()->size() >= length * DataTypeUtils::sizeOf(dtype)) {
+                    auto array = new NDArray(rawPtr, newShape);
+                    array->triggerAllocationFlag(false, true);
+
+                    return array;
+                }
+
+                nd4j_debug("FlatArray can't be used in place, copying it\n", "");
+            }
+
             auto newBuffer = new int8_t[length * DataTypeUtils::sizeOf(dtype)];
 
             BUILD_SINGLE_SELECTOR(dtype, DataTypeConversions, ::convertType(newBuffer, (void *)flatArray->buffer()->data(), dtype, ByteOrderUtils::fromFlatByteOrder(flatArray->byteOrder()),  length), LIBND4J_TYPES);
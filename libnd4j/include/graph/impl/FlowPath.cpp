@@ -30,6 +30,15 @@ namespace nd4j {
             }
         }
 
+        NodeState& FlowPath::state(int nodeId) {
+            auto slot = _index == nullptr ? -1 : _index->slot(nodeId);
+            if (slot >= 0)
+                return _denseStates[slot];
+
+            ensureNode(nodeId);
+            return _states[nodeId];
+        }
+
         void FlowPath::ensureFrame(int frameId) {
             if (_frames.count(frameId) == 0) {
                 FrameState state(frameId);
@@ -38,51 +47,35 @@ namespace nd4j {
         }
 
         void FlowPath::setInnerTime(int nodeId, Nd4jLong time) {
-            ensureNode(nodeId);
-
-            _states[nodeId].setInnerTime(time);
+            state(nodeId).setInnerTime(time);
         }
 
         void FlowPath::setOuterTime(int nodeId, Nd4jLong time) {
-            ensureNode(nodeId);
-
-            _states[nodeId].setOuterTime(time);
+            state(nodeId).setOuterTime(time);
         }
 
         Nd4jLong FlowPath::innerTime(int nodeId) {
-            ensureNode(nodeId);
-
-            return _states[nodeId].innerTime();
+            return state(nodeId).innerTime();
         }
 
         Nd4jLong FlowPath::outerTime(int nodeId) {
-            ensureNode(nodeId);
-
-            return _states[nodeId].outerTime();
+            return state(nodeId).outerTime();
         }
 
         bool FlowPath::isNodeActive(int nodeId) {
-            ensureNode(nodeId);
-
-            return _states[nodeId].isActive();
+            return state(nodeId).isActive();
         }
             
         void FlowPath::markNodeActive(int nodeId, bool isActive) {
-            ensureNode(nodeId);
-
-            _states[nodeId].markActive(isActive);
+            state(nodeId).markActive(isActive);
         }
 
         int FlowPath::branch(int nodeId){
-            ensureNode(nodeId);
-
-            return _states[nodeId].branch();
+            return state(nodeId).branch();
         }
 
         void FlowPath::markBranch(int nodeId, int index) {
-            ensureNode(nodeId);
-
-            _states[nodeId].markBranch(index);
+            state(nodeId).markBranch(index);
         }
 
         bool FlowPath::isFrameActive(Nd4jLong frameId) {
@@ -137,15 +130,48 @@ namespace nd4j {
 
 
         bool FlowPath::wasExecuted(int nodeId) {
-            return _states[nodeId].wasExecuted();
+            return state(nodeId).wasExecuted();
         }
 
         void FlowPath::markExecuted(int nodeId, bool wasExecuted) {
-            _states[nodeId].markExecuted(wasExecuted);
+            state(nodeId).markExecuted(wasExecuted);
         }
 
         GraphProfile* FlowPath::profile() {
             return &_profile;
         }
+
+        void FlowPath::setMemoryPlanner(MemoryPlanner* planner) {
+            _memoryPlanner = planner;
+        }
+
+        MemoryPlanner* FlowPath::memoryPlanner() {
+            return _memoryPlanner;
+        }
+
+        void FlowPath::setVariableIndex(std::shared_ptr<const VariableIndex> index) {
+            _index = index;
+            _denseStates.clear();
+            if (_index == nullptr)
+                return;
+
+            _denseStates.reserve(_index->size());
+            for (int e = 0; e < _index->size(); e++)
+                _denseStates.emplace_back(NodeState(_index->id(e)));
+
+            // states recorded before index was attached are moved to their slots
+            for (auto it = _states.begin(); it != _states.end();) {
+                auto slot = _index->slot(it->first);
+                if (slot >= 0) {
+                    _denseStates[slot] = it->second;
+                    it = _states.erase(it);
+                } else
+                    ++it;
+            }
+        }
+
+        std::shared_ptr<const VariableIndex> FlowPath::variableIndex() {
+            return _index;
+        }
     }
 }
\ No newline at end of file
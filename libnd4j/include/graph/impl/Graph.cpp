@@ -26,6 +26,7 @@
 #include <helpers/ShapeUtils.h>
 #include <ops/declarable/OpRegistrator.h>
 #include <graph/VariableProxy.h>
+#include <ops/declarable/FusedElementwiseOp.h>
 #include <graph/exceptions/graph_exception.h>
 #include <graph/exceptions/unresolved_input_exception.h>
 #include <graph/exceptions/unresolved_output_exception.h>
@@ -62,6 +63,10 @@ namespace nd4j {
                 for (int n = 0; n < layerSize; n++) {
                     Node* node = _onion->at(l)->at(n);
 
+                    // fused nodes produce nothing, their op is executed by the last node of the group
+                    if (node->isFused())
+                        continue;
+
                     /*
                      * Limited number of options here:
                      *
@@ -226,6 +231,10 @@ namespace nd4j {
         }
 
         std::vector<Variable *> * Graph::fetchOutputs() {
+            return fetchOutputs(_variableSpace);
+        }
+
+        std::vector<Variable *> * Graph::fetchOutputs(VariableSpace *variableSpace) {
             auto res = new std::vector<Variable *>();
 
             nd4j_debug("Graph output size: %i\n", _output.size());
@@ -234,8 +243,8 @@ namespace nd4j {
                 nd4j_debug("Output node: %i\n", nodeId);
 
                 for (int e = 0; e < DataTypeUtils::max<int>(); e++) {
-                    if (_variableSpace->hasVariable(nodeId, e)) {
-                        res->push_back(_variableSpace->getVariable(nodeId, e));
+                    if (variableSpace->hasVariable(nodeId, e)) {
+                        res->push_back(variableSpace->getVariable(nodeId, e));
                     } else {
                         if (e == 0) {
                             throw unresolved_output_exception::build("Can't find output variable", nodeId, e);
@@ -303,6 +312,9 @@ namespace nd4j {
             delete _variableSpace;
             delete _onion;
             delete _configuration;
+
+            // variables are gone already, nothing points into mapped file anymore
+            delete _mappedFile;
         }
 
         void Graph::addNode(Node *node) {
@@ -696,14 +708,178 @@ namespace nd4j {
                 }
             }
 
-            if (_unmapped.size() == 0)
-                _built.store(true);
-
             prepareOutputs();
 
+            if (_unmapped.size() == 0) {
+                indexVariables();
+
+                // fusion relies on final outputs, and built graph never gets here again, so it's done once
+                if (_configuration->_elementwiseFusion && Environment::getInstance()->isElementwiseFusion())
+                    fuseElementwise();
+
+                // other threads may execute graph as soon as they see it built, so this goes last
+                _built.store(true, std::memory_order_release);
+            }
+
             return nd4j::Status::OK();
         }
 
+        // fills step for given node, appending its Y operand to inputs if it has one. returns false if node can't be fused
+        static bool elementwiseStep(Node *node, std::vector<std::pair<int, int>> &inputs, nd4j::ops::helpers::ElementwiseStep &step) {
+            auto opType = node->opType();
+            if (opType != OpType_TRANSFORM_SAME && opType != OpType_TRANSFORM_FLOAT && opType != OpType_TRANSFORM_STRICT && opType != OpType_SCALAR && opType != OpType_PAIRWISE)
+                return false;
+
+            if (!node->hasCustomOp() || node->hasGraphEmbedded() || node->isScoped() || node->isDivergencePoint() || node->hasExternalOutputs() || node->isFused())
+                return false;
+
+            auto width = node->input()->size();
+            auto tArgs = node->getContextPrototype()->getTArguments();
+
+            step.opType = (int) opType;
+            step.opNum = (int) node->opNum();
+            step.nodeId = node->id();
+            step.input = -1;
+            step.extraParams = *tArgs;
+
+            switch (opType) {
+                case OpType_TRANSFORM_SAME:
+                case OpType_TRANSFORM_FLOAT:
+                case OpType_TRANSFORM_STRICT:
+                    if (width != 1)
+                        return false;
+                    break;
+                case OpType_PAIRWISE:
+                    if (width != 2)
+                        return false;
+
+                    step.input = (int) inputs.size();
+                    inputs.emplace_back(node->input()->at(1));
+                    break;
+                case OpType_SCALAR:
+                    // the same scalar lookup order as LegacyScalarOp has
+                    if (width == 2) {
+                        step.input = (int) inputs.size();
+                        inputs.emplace_back(node->input()->at(1));
+                    } else if (width == 1 && !tArgs->empty()) {
+                        step.scalar = tArgs->at(0);
+                        step.extraParams.erase(step.extraParams.begin());
+                    } else if (width == 1 && node->hasScalar()) {
+                        step.scalar = node->scalar();
+                    } else
+                        return false;
+                    break;
+                default:
+                    return false;
+            }
+
+            return nd4j::ops::helpers::isFusableElementwise(step.opType, step.opNum);
+        }
+
+        void Graph::fuseElementwise() {
+            // all nodes are dumped to VariableSpace in this mode, so none of them can be skipped
+            if (_configuration->_outputMode == OutputMode_VARIABLE_SPACE || !_scopes.empty())
+                return;
+
+            // number of references to each node, and its consumer if node is used as X operand of single other node
+            std::map<int, int> references;
+            std::map<int, int> consumers;
+            for (auto &v: *_mapped) {
+                Node* node = v.second;
+
+                // logic ops drive FlowPath state of the nodes around them, so graphs with them are left as is
+                if (node->opType() == OpType_LOGIC)
+                    return;
+
+                for (int e = 0; e < (int) node->input()->size(); e++) {
+                    auto &in = node->input()->at(e);
+                    references[in.first]++;
+                    consumers[in.first] = e == 0 && in.second == 0 ? node->id() : -1;
+                }
+            }
+
+            std::map<int, bool> eligible;
+            for (auto &v: *_mapped) {
+                std::vector<std::pair<int, int>> inputs;
+                nd4j::ops::helpers::ElementwiseStep step;
+                eligible[v.first] = elementwiseStep(v.second, inputs, step);
+            }
+
+            // node can be fused into its consumer if nobody else needs its result
+            std::map<int, bool> chained;
+            for (auto &v: eligible) {
+                auto id = v.first;
+                chained[id] = v.second && references[id] == 1 && consumers[id] >= 0 && eligible.count(consumers[id]) > 0 && eligible[consumers[id]]
+                              && std::find(_output.begin(), _output.end(), id) == _output.end();
+            }
+
+            for (auto v: *_nodes) {
+                if (_mapped->count(v) == 0 || !eligible[v] || chained[v])
+                    continue;
+
+                // v is the last node of chain, so we go backwards over X operands
+                std::vector<Node*> chain;
+                Node* node = _mapped->at(v);
+                chain.emplace_back(node);
+                while (true) {
+                    auto &in = chain.back()->input()->at(0);
+                    if (_mapped->count(in.first) == 0 || !chained[in.first])
+                        break;
+
+                    chain.emplace_back(_mapped->at(in.first));
+                }
+
+                if (chain.size() < 2)
+                    continue;
+
+                std::reverse(chain.begin(), chain.end());
+
+                std::vector<std::pair<int, int>> inputs;
+                inputs.emplace_back(chain.front()->input()->at(0));
+
+                std::vector<nd4j::ops::helpers::ElementwiseStep> steps(chain.size());
+                std::vector<int> group;
+                for (int e = 0; e < (int) chain.size(); e++) {
+                    elementwiseStep(chain[e], inputs, steps[e]);
+                    group.emplace_back(chain[e]->id());
+                }
+
+                for (int e = 0; e < (int) chain.size() - 1; e++)
+                    chain[e]->markFused(node->id());
+
+                node->replaceOp(new nd4j::ops::FusedElementwiseOp(steps), inputs);
+
+                // fused op overwrites X operand of the first node only if that node was allowed to do so
+                if (!chain.front()->getContextPrototype()->isInplace())
+                    node->getContextPrototype()->markInplace(false);
+
+                _fusedGroups.emplace_back(group);
+
+                nd4j_debug("Node [%i]: fused %i elementwise ops, starting at node [%i]\n", node->id(), (int) group.size(), group.front());
+            }
+        }
+
+        void Graph::indexVariables() {
+            // clones backed by VariableProxy share index of original graph
+            if (_variableSpace->variableIndex() != nullptr)
+                return;
+
+            std::vector<int> ids;
+
+            // node ids cover their outputs, input ids cover external variables and placeholders
+            for (auto &v: *_mapped) {
+                ids.emplace_back(v.first);
+
+                for (auto &in: *v.second->input())
+                    ids.emplace_back(in.first);
+            }
+
+            for (auto v: _variableSpace->getVariables())
+                ids.emplace_back(v->id());
+
+            _variableSpace->setVariableIndex(std::make_shared<const VariableIndex>(ids));
+        }
+
         void Graph::tagInplaceNodes() {
             // just calling, in case it wasn't built before
             if (!_built.load())
@@ -864,7 +1040,16 @@ namespace nd4j {
             }
         }
 
+        Graph::Graph(MappedFile *mappedFile, VariableSpace *variableSpace) {
+            _mappedFile = mappedFile;
+            initialize(GetFlatGraph(mappedFile->data()), variableSpace, true);
+        }
+
         Graph::Graph(const FlatGraph *flatGraph, VariableSpace *variableSpace) {
+            initialize(flatGraph, variableSpace, false);
+        }
+
+        void Graph::initialize(const FlatGraph *flatGraph, VariableSpace *variableSpace, bool inPlace) {
             this->_onion = new std::map<int, std::vector<Node *> *>();
             this->_mapped = new std::map<int, Node *> ();
             this->_nodes = new std::vector<int>();
@@ -891,7 +1076,7 @@ namespace nd4j {
                 for (unsigned int e = 0; e < flatGraph->variables()->size(); e++) {
                     auto flatVar = flatGraph->variables()->Get(e);
 
-                    auto var = new Variable(flatVar);
+                    auto var = new Variable(flatVar, inPlace);
                     std::pair<int, int> pair(flatVar->id()->first(), flatVar->id()->second());
                     _variableSpace->putVariable(pair, var);
 
@@ -1276,10 +1461,10 @@ namespace nd4j {
             _configuration = configuration;
         }
 
-        Graph* Graph::cloneWithProxy() {
+        Graph* Graph::cloneWithProxy(bool copyOnWrite) {
             auto clone = new Graph();
 
-            clone->replaceState(new VariableProxy(this->_variableSpace), this->_configuration->clone());
+            clone->replaceState(new VariableProxy(this->_variableSpace, copyOnWrite), this->_configuration->clone());
 
             // transfer nodes
             for (int e = 0; e < _nodes->size(); e++)
@@ -1293,6 +1478,10 @@ namespace nd4j {
             for (auto v: _autos)
                 clone->_autos.emplace_back(v);
 
+            // transfer fused groups
+            for (auto &v: _fusedGroups)
+                clone->_fusedGroups.emplace_back(v);
+
             // transfer scopes
             for (auto &v: _mappedScopes) {
                 auto scp = v.second->clone();
@@ -1310,7 +1499,7 @@ namespace nd4j {
                 for (auto x: *(ovec)) {
                     auto n = x->clone();
                     vec->emplace_back(n);
-                    _handles.emplace_back(n);
+                    clone->_handles.emplace_back(n);
                     (*clone->_mapped)[n->id()] = n;
                 }
 
@@ -1344,6 +1533,10 @@ namespace nd4j {
             for (auto v: _autos)
                 clone->_autos.emplace_back(v);
 
+            // transfer fused groups
+            for (auto &v: _fusedGroups)
+                clone->_fusedGroups.emplace_back(v);
+
             // transfer scopes
             for (auto &v: _mappedScopes) {
                 auto scp = v.second->clone();
@@ -1361,7 +1554,7 @@ namespace nd4j {
                 for (auto x: *(ovec)) {
                     auto n = x->clone();
                     vec->emplace_back(n);
-                    _handles.emplace_back(n);
+                    clone->_handles.emplace_back(n);
                     (*clone->_mapped)[n->id()] = n;
                 }
 
@@ -1378,6 +1571,19 @@ namespace nd4j {
             return clone;
         }
 
+        bool Graph::hasStatefulNodes() {
+            if (!_scopes.empty())
+                return true;
+
+            for (auto &v: *_mapped) {
+                auto node = v.second;
+                if (node->opType() == OpType_LOGIC || node->hasGraphEmbedded() || node->hasExternalOutputs())
+                    return true;
+            }
+
+            return false;
+        }
+
         bool Graph::hasNode(int id) {
             return _mapped->count(id) > 0;
         }
@@ -22,9 +22,36 @@
 #include <GraphExecutioner.h>
 #include <graph/exceptions/graph_exists_exception.h>
 #include <graph/exceptions/graph_execution_exception.h>
+#include <graph/exceptions/no_results_exception.h>
+#include <Status.h>
+#include <thread>
 
 namespace nd4j {
     namespace graph {
+        GraphHolder::Entry::Entry(Graph *graph) {
+            _graph = graph;
+            _release = false;
+        }
+
+        GraphHolder::Entry::~Entry() {
+            for (auto v: _sessions)
+                delete v;
+
+            if (_release.load())
+                delete _graph;
+        }
+
+        GraphHolder::GraphHolder() {
+            _registry = new Registry();
+            _epoch = 0;
+            _readers[0] = 0;
+            _readers[1] = 0;
+        }
+
+        GraphHolder::~GraphHolder() {
+            delete _registry.load();
+        }
+
         GraphHolder* GraphHolder::getInstance() {
             if (_INSTANCE == 0)
                 _INSTANCE = new GraphHolder();
@@ -32,60 +59,116 @@ namespace nd4j {
             return _INSTANCE;
         };
 
+        std::shared_ptr<GraphHolder::Entry> GraphHolder::lookup(Nd4jLong graphId) {
+            // entering current epoch. if writer flipped it meanwhile, we retry, so writer never misses us
+            Nd4jLong epoch;
+            while (true) {
+                epoch = _epoch.load();
+                _readers[epoch & 1]++;
+                if (_epoch.load() == epoch)
+                    break;
+
+                _readers[epoch & 1]--;
+            }
+
+            std::shared_ptr<Entry> result;
+            auto registry = _registry.load();
+            auto it = registry->find(graphId);
+            if (it != registry->end())
+                result = it->second;
+
+            _readers[epoch & 1]--;
+
+            return result;
+        }
+
+        void GraphHolder::publish(const Registry *updated) {
+            auto previous = _registry.exchange(updated);
+
+            // readers that came after this flip can only see new snapshot
+            auto epoch = _epoch++;
+            while (_readers[epoch & 1].load() > 0)
+                std::this_thread::yield();
+
+            delete previous;
+        }
+
         void GraphHolder::registerGraph(Nd4jLong graphId, Graph* graph) {
-            if (hasGraphAny(graphId))
+            std::lock_guard<std::mutex> lock(_writeLock);
+
+            auto registry = _registry.load();
+            if (registry->count(graphId) > 0)
                 throw graph_exists_exception(graphId);
 
-            _graphF[graphId] = graph;
+            auto updated = new Registry(*registry);
+            (*updated)[graphId] = std::make_shared<Entry>(graph);
+
+            publish(updated);
+        }
+
+        void GraphHolder::replaceGraph(Nd4jLong graphId, Graph* graph) {
+            std::lock_guard<std::mutex> lock(_writeLock);
+
+            auto updated = new Registry(*_registry.load());
+
+            auto it = updated->find(graphId);
+            if (it != updated->end() && it->second->_graph != graph)
+                it->second->_release = true;
 
-            nd4j::SimpleReadWriteLock lock;
-            _locks[graphId] = lock;
+            // sessions of previous graph go away together with its entry
+            (*updated)[graphId] = std::make_shared<Entry>(graph);
+
+            publish(updated);
+        }
+
+        void GraphHolder::removeGraph(Nd4jLong graphId, bool release) {
+            std::lock_guard<std::mutex> lock(_writeLock);
+
+            auto registry = _registry.load();
+            auto it = registry->find(graphId);
+            if (it == registry->end())
+                return;
+
+            it->second->_release = release;
+
+            auto updated = new Registry(*registry);
+            updated->erase(graphId);
+
+            publish(updated);
         }
 
         Graph* GraphHolder::cloneGraph(Nd4jLong graphId) {
-            if (!this->hasGraph(graphId)) {
+            auto entry = lookup(graphId);
+            if (entry == nullptr) {
                 nd4j_printf("GraphHolder doesn't have graph stored for [%lld]\n", graphId);
                 throw std::runtime_error("Bad argument");
             }
 
-            auto graph = _graphF[graphId]->cloneWithProxy();
+            auto graph = entry->_graph->cloneWithProxy();
 
             return graph;
         }
 
         Graph* GraphHolder::pullGraph(Nd4jLong graphId) {
-            if (!this->hasGraph(graphId)) {
+            auto entry = lookup(graphId);
+            if (entry == nullptr) {
                 nd4j_printf("GraphHolder doesn't have graph stored for [%lld]\n", graphId);
                 throw std::runtime_error("Bad argument");
             }
 
-            auto graph = _graphF[graphId];
-
-            return graph;
+            return entry->_graph;
         }
 
         void GraphHolder::forgetGraph(Nd4jLong graphId) {
-            if (this->hasGraph(graphId))
-                _graphF.erase(graphId);
+            removeGraph(graphId, false);
         }
 
         void GraphHolder::dropGraph(Nd4jLong graphId) {
-            if (this->hasGraph(graphId)) {
-                auto g = _graphF[graphId];
-                forgetGraph(graphId);
-                delete g;
-            }
+            removeGraph(graphId, true);
         }
 
         void GraphHolder::dropGraphAny(Nd4jLong graphId) {
-            if (!hasGraphAny(graphId))
-                return;
-
-            this->lockWrite(graphId);
-
             this->dropGraph(graphId);
-
-            this->unlockWrite(graphId);
         }
 
         bool GraphHolder::hasGraphAny(Nd4jLong graphId) {
@@ -93,40 +176,131 @@ namespace nd4j {
         }
 
         bool GraphHolder::hasGraph(Nd4jLong graphId) {
-                return _graphF.count(graphId) > 0;
+            return lookup(graphId) != nullptr;
         }
 
-        void GraphHolder::replaceGraph(Nd4jLong graphId, Graph* graph) {
-            if (!hasGraph(graphId)) {
-                registerGraph(graphId, graph);
-                return;
+        ExecutionSession* GraphHolder::acquireSession(Entry *entry) {
+            {
+                std::lock_guard<std::mutex> lock(entry->_sessionsLock);
+                auto &pool = entry->_sessions;
+                if (!pool.empty()) {
+                    auto session = pool.back();
+                    pool.pop_back();
+                    return session;
+                }
             }
 
-            this->lockWrite(graphId);
+            return new ExecutionSession(entry->_graph, &entry->_planner);
+        }
 
-            _graphF[graphId] = graph;
+        void GraphHolder::releaseSession(Entry *entry, ExecutionSession *session) {
+            session->reset();
 
-            this->unlockWrite(graphId);
+            std::lock_guard<std::mutex> lock(entry->_sessionsLock);
+            entry->_sessions.emplace_back(session);
         }
 
+        int GraphHolder::idleSessions(Nd4jLong graphId) {
+            auto entry = lookup(graphId);
+            if (entry == nullptr)
+                return 0;
 
+            std::lock_guard<std::mutex> lock(entry->_sessionsLock);
+            return (int) entry->_sessions.size();
+        }
 
-
-        flatbuffers::Offset<FlatResult> GraphHolder::execute(Nd4jLong graphId, flatbuffers::FlatBufferBuilder &builder, const FlatInferenceRequest* request) {
-            if (!hasGraph(graphId))
+        void GraphHolder::executeIsolated(Nd4jLong graphId, const std::function<void(Graph*, VariableSpace*)> &func) {
+            // this reference keeps graph alive even if it gets replaced or dropped while we're executing it
+            auto entry = lookup(graphId);
+            if (entry == nullptr)
                 throw unknown_graph_exception(graphId);
 
-            lockRead(graphId);
+            auto graph = entry->_graph;
 
-            auto graph = cloneGraph(graphId);
-            auto res = GraphExecutioner::execute(graph, builder, request);
-            delete graph;
+            // graph is built once, so concurrent executions only read its structure. built flag is published after build is complete
+            if (!graph->built()) {
+                std::lock_guard<std::mutex> lock(entry->_buildLock);
+                if (!graph->built())
+                    graph->buildGraph();
+            }
 
-            unlockRead(graphId);
+            // graphs with logic ops or embedded graphs modify nodes during execution, so they still get own copy
+            if (graph->hasStatefulNodes()) {
+                auto clone = graph->cloneWithProxy();
+                try {
+                    func(clone, clone->getVariableSpace());
+                } catch (...) {
+                    delete clone;
+                    throw;
+                }
+
+                delete clone;
+                return;
+            }
+
+            auto session = acquireSession(entry.get());
+            try {
+                func(graph, session->variableSpace());
+            } catch (...) {
+                releaseSession(entry.get(), session);
+                throw;
+            }
+
+            releaseSession(entry.get(), session);
+        }
+
+        flatbuffers::Offset<FlatResult> GraphHolder::execute(Nd4jLong graphId, flatbuffers::FlatBufferBuilder &builder, const FlatInferenceRequest* request) {
+            flatbuffers::Offset<FlatResult> res;
+
+            executeIsolated(graphId, [&](Graph *graph, VariableSpace *variableSpace) {
+                res = GraphExecutioner::execute(graph, variableSpace, builder, request);
+            });
 
             return res;
         }
 
+        std::vector<Variable*>* GraphHolder::execute(Nd4jLong graphId, std::vector<Variable*> &inputs) {
+            auto result = new std::vector<Variable*>();
+
+            try {
+                executeIsolated(graphId, [&](Graph *graph, VariableSpace *variableSpace) {
+                    for (auto v: inputs)
+                        variableSpace->replaceVariable(v);
+
+                    inputs.clear();
+
+                    auto status = GraphExecutioner::execute(graph, variableSpace);
+                    if (status != nd4j::Status::OK())
+                        throw graph_execution_exception(graphId);
+
+                    auto outputs = graph->fetchOutputs(variableSpace);
+                    if (outputs->empty()) {
+                        delete outputs;
+                        throw no_results_exception(graphId);
+                    }
+
+                    // outputs live in execution state, which is going to be reused, so we return detached copies
+                    for (auto v: *outputs)
+                        result->emplace_back(v->clone());
+
+                    delete outputs;
+                });
+            } catch (...) {
+                for (auto v: inputs)
+                    delete v;
+
+                inputs.clear();
+
+                for (auto v: *result)
+                    delete v;
+
+                delete result;
+                throw;
+            }
+
+            return result;
+        }
+
         GraphHolder* GraphHolder::_INSTANCE = 0;
     }
 }
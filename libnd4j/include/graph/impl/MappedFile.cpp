@@ -0,0 +1,102 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <graph/MappedFile.h>
+#include <helpers/logger.h>
+#include <sys/stat.h>
+#include <cstdio>
+#include <stdexcept>
+
+#if defined(_WIN32) || defined(__WIN32__) || defined(WIN32)
+#define ND4J_NO_MMAP
+#else
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace nd4j {
+    namespace graph {
+        MappedFile::MappedFile(const char *filename) {
+            struct stat stat_buf;
+            if (stat(filename, &stat_buf) != 0) {
+                nd4j_printf("File [%s] wasn't found. Please check path and permissions\n", filename);
+                throw std::runtime_error("File not found");
+            }
+
+            _length = (Nd4jLong) stat_buf.st_size;
+            if (_length == 0)
+                throw std::runtime_error("Can't map empty file");
+
+#ifndef ND4J_NO_MMAP
+            int fd = open(filename, O_RDONLY);
+            if (fd < 0) {
+                nd4j_printf("File [%s] can't be opened\n", filename);
+                throw std::runtime_error("Failed to open file for mmap");
+            }
+
+            // writable private mapping: file itself is never modified, written pages are just copied
+            auto ptr = mmap(nullptr, (size_t) _length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+
+            // mapping holds its own reference to file
+            close(fd);
+
+            if (ptr != MAP_FAILED) {
+                _buffer = reinterpret_cast<uint8_t *>(ptr);
+                _mapped = true;
+                return;
+            }
+
+            nd4j_debug("mmap failed for [%s], reading file instead\n", filename);
+#endif
+
+            FILE *in = fopen(filename, "rb");
+            if (in == nullptr)
+                throw std::runtime_error("Failed to open file");
+
+            _buffer = new uint8_t[_length];
+            auto cnt = fread(_buffer, 1, (size_t) _length, in);
+            fclose(in);
+
+            if ((Nd4jLong) cnt != _length) {
+                delete[] _buffer;
+                throw std::runtime_error("Failed to read file");
+            }
+        }
+
+        MappedFile::~MappedFile() {
+#ifndef ND4J_NO_MMAP
+            if (_mapped) {
+                munmap(_buffer, (size_t) _length);
+                return;
+            }
+#endif
+            delete[] _buffer;
+        }
+
+        uint8_t* MappedFile::data() const {
+            return _buffer;
+        }
+
+        Nd4jLong MappedFile::length() const {
+            return _length;
+        }
+
+        bool MappedFile::isMapped() const {
+            return _mapped;
+        }
+    }
+}
@@ -0,0 +1,140 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <graph/MemoryPlan.h>
+#include <algorithm>
+
+namespace nd4j {
+    namespace graph {
+        // blocks are aligned, so arrays placed into them keep alignment of fresh allocations
+        static const Nd4jLong BLOCK_ALIGNMENT = 64;
+
+        struct PlannedBlock {
+            int nodeId;
+            int start;
+            int end;
+            Nd4jLong size;
+            Nd4jLong offset;
+        };
+
+        MemoryPlan* MemoryPlan::build(Graph *graph, const std::vector<int> &order, const std::map<int, Nd4jLong> &bytes, const std::map<int, int> &aliases) {
+            auto plan = new MemoryPlan();
+            int numSteps = (int) order.size();
+
+            std::map<int, int> steps;
+            for (int e = 0; e < numSteps; e++)
+                steps[order[e]] = e;
+
+            // by default node results die right after they were produced
+            std::map<int, int> ends;
+            for (int e = 0; e < numSteps; e++)
+                ends[order[e]] = e;
+
+            // ...but they stay alive until their last consumer was executed
+            for (int e = 0; e < numSteps; e++) {
+                auto node = graph->getMapped()->at(order[e]);
+                for (auto &in: *node->input()) {
+                    if (steps.count(in.first) > 0)
+                        ends[in.first] = nd4j::math::nd4j_max<int>(ends[in.first], e);
+                }
+            }
+
+            // graph outputs are read after execution
+            for (auto id: *graph->output()) {
+                if (steps.count(id) > 0)
+                    ends[id] = numSteps;
+            }
+
+            // in-place results live in memory of their source, so source must live as long as they do.
+            // we go backwards, so chains of in-place ops are resolved in one pass
+            for (int e = numSteps - 1; e >= 0; e--) {
+                auto it = aliases.find(order[e]);
+                if (it != aliases.end() && ends.count(it->second) > 0)
+                    ends[it->second] = nd4j::math::nd4j_max<int>(ends[it->second], ends[order[e]]);
+            }
+
+            std::vector<PlannedBlock> blocks;
+            for (int e = 0; e < numSteps; e++) {
+                auto it = bytes.find(order[e]);
+                if (it == bytes.end() || it->second < 1)
+                    continue;
+
+                auto size = (it->second + BLOCK_ALIGNMENT - 1) / BLOCK_ALIGNMENT * BLOCK_ALIGNMENT;
+                blocks.emplace_back(PlannedBlock{order[e], e, ends[order[e]], size, 0L});
+                plan->_totalSize += size;
+            }
+
+            // greedy placement: biggest blocks first, each one goes into lowest gap among blocks alive at the same time
+            std::vector<int> indices(blocks.size());
+            for (int e = 0; e < (int) indices.size(); e++)
+                indices[e] = e;
+
+            std::stable_sort(indices.begin(), indices.end(), [&](int a, int b) {
+                return blocks[a].size > blocks[b].size;
+            });
+
+            std::vector<int> placed;
+            for (auto i: indices) {
+                auto &block = blocks[i];
+
+                std::vector<std::pair<Nd4jLong, Nd4jLong>> conflicts;
+                for (auto p: placed) {
+                    auto &other = blocks[p];
+                    if (other.start <= block.end && block.start <= other.end)
+                        conflicts.emplace_back(std::pair<Nd4jLong, Nd4jLong>(other.offset, other.offset + other.size));
+                }
+
+                std::sort(conflicts.begin(), conflicts.end());
+
+                Nd4jLong offset = 0L;
+                for (auto &c: conflicts) {
+                    if (c.first >= offset + block.size)
+                        break;
+
+                    offset = nd4j::math::nd4j_max<Nd4jLong>(offset, c.second);
+                }
+
+                block.offset = offset;
+                placed.emplace_back(i);
+
+                plan->_blocks[block.nodeId] = std::pair<Nd4jLong, Nd4jLong>(offset, block.size);
+                plan->_arenaSize = nd4j::math::nd4j_max<Nd4jLong>(plan->_arenaSize, offset + block.size);
+            }
+
+            return plan;
+        }
+
+        bool MemoryPlan::hasBlock(int nodeId) const {
+            return _blocks.count(nodeId) > 0;
+        }
+
+        Nd4jLong MemoryPlan::offset(int nodeId) const {
+            return _blocks.at(nodeId).first;
+        }
+
+        Nd4jLong MemoryPlan::size(int nodeId) const {
+            return _blocks.at(nodeId).second;
+        }
+
+        Nd4jLong MemoryPlan::arenaSize() const {
+            return _arenaSize;
+        }
+
+        Nd4jLong MemoryPlan::totalSize() const {
+            return _totalSize;
+        }
+    }
+}
@@ -0,0 +1,46 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <graph/MemoryPlanner.h>
+
+namespace nd4j {
+    namespace graph {
+        std::shared_ptr<MemoryPlan> MemoryPlanner::plan() {
+            std::lock_guard<std::mutex> lock(_planLock);
+            return _plan;
+        }
+
+        void MemoryPlanner::update(Graph *graph, const std::vector<int> &order, const std::map<int, Nd4jLong> &bytes, const std::map<int, int> &aliases) {
+            std::lock_guard<std::mutex> lock(_lock);
+
+            // blocks never shrink, so alternating input shapes don't cause endless re-planning
+            for (auto &v: bytes)
+                _bytes[v.first] = nd4j::math::nd4j_max<Nd4jLong>(_bytes[v.first], v.second);
+
+            std::shared_ptr<MemoryPlan> plan(MemoryPlan::build(graph, order, _bytes, aliases));
+
+            std::lock_guard<std::mutex> planLock(_planLock);
+            _plan.swap(plan);
+        }
+
+        void MemoryPlanner::invalidate() {
+            std::shared_ptr<MemoryPlan> empty;
+
+            std::lock_guard<std::mutex> lock(_planLock);
+            _plan.swap(empty);
+        }
+    }
+}
@@ -38,6 +38,7 @@
 #include <ops/declarable/LegacyScalarBoolOp.h>
 #include <ops/declarable/LegacyPairwiseTransformBoolOp.h>
 #include <ops/declarable/LegacyTransformStrictOp.h>
+#include <ops/declarable/FusedElementwiseOp.h>
 #include <ops/declarable/LegacyTransformBoolOp.h>
 #include <graph/FlatUtils.h>
 
@@ -72,6 +73,32 @@ namespace nd4j {
             }
         }
 
+        bool nd4j::graph::Node::isFused() {
+            return _fusedInto >= 0;
+        }
+
+        int nd4j::graph::Node::fusedInto() {
+            return _fusedInto;
+        }
+
+        void nd4j::graph::Node::markFused(int nodeId) {
+            _fusedInto = nodeId;
+        }
+
+        void nd4j::graph::Node::replaceOp(nd4j::ops::DeclarableOp *op, const std::vector<std::pair<int, int>> &inputs) {
+            if (_customOp != nullptr && _isDeductable)
+                delete _customOp;
+
+            _customOp = op;
+            _isDeductable = true;
+            _input = inputs;
+
+            // prototype picks new inputs on first request, in-place flag is kept
+            bool inplace = _protoContext != nullptr && _protoContext->isInplace();
+            delete _protoContext;
+            _protoContext = new ContextPrototype(op->getOpDescriptor(), _id, inplace);
+        }
+
         OpClass nd4j::graph::Node::getOpClass() {
             return _opClass;
         }
@@ -167,6 +194,10 @@ namespace nd4j {
             return  _scalar.e<double>(0);
         };
 
+        bool nd4j::graph::Node::hasScalar() {
+            return _scalar.lengthOf() > 0;
+        }
+
         void nd4j::graph::Node::pickInput(std::pair<int,int>& pair) {
             _input.push_back(pair);
         }
@@ -777,7 +808,10 @@ namespace nd4j {
                 clone->_customOp = _customOp;
             else {
                 auto c = dynamic_cast<nd4j::ops::LegacyOp*>(_customOp);
-                clone->_customOp = c->clone();
+                if (c != nullptr)
+                    clone->_customOp = c->clone();
+                else
+                    clone->_customOp = new nd4j::ops::FusedElementwiseOp(dynamic_cast<nd4j::ops::FusedElementwiseOp*>(_customOp)->steps());
             }
 
             return clone;
@@ -0,0 +1,337 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <graph/RequestBatcher.h>
+#include <graph/GraphHolder.h>
+#include <graph/ExecutionResult.h>
+#include <NDArrayFactory.h>
+#include <chrono>
+
+namespace nd4j {
+    namespace graph {
+        RequestBatcher::RequestBatcher(int maxBatchSize, Nd4jLong windowMicros) {
+            _maxBatchSize = maxBatchSize;
+            _windowMicros = windowMicros;
+        }
+
+        int RequestBatcher::maxBatchSize() {
+            return _maxBatchSize;
+        }
+
+        Nd4jLong RequestBatcher::windowMicros() {
+            return _windowMicros;
+        }
+
+        std::vector<Nd4jLong> RequestBatcher::queueDepthHistogram() {
+            std::lock_guard<std::mutex> lock(_lock);
+            return _queueDepths;
+        }
+
+        std::vector<Nd4jLong> RequestBatcher::batchSizeHistogram() {
+            std::lock_guard<std::mutex> lock(_lock);
+            return _batchSizes;
+        }
+
+        Nd4jLong RequestBatcher::batchRows(std::vector<Variable*> &inputs) {
+            if (inputs.empty())
+                return -1;
+
+            Nd4jLong rows = -1;
+            for (auto v: inputs) {
+                if (!v->hasNDArray() || v->getNDArray()->rankOf() < 1)
+                    return -1;
+
+                auto r = v->getNDArray()->sizeAt(0);
+                if (r < 1 || (rows >= 0 && r != rows))
+                    return -1;
+
+                rows = r;
+            }
+
+            return rows;
+        }
+
+        bool RequestBatcher::isCompatible(PendingRequest *first, PendingRequest *other) {
+            if (first->inputs.size() != other->inputs.size())
+                return false;
+
+            for (int e = 0; e < (int) first->inputs.size(); e++) {
+                auto a = first->inputs[e];
+                auto b = other->inputs[e];
+
+                if (a->id() != b->id() || a->index() != b->index() || *a->getName() != *b->getName())
+                    return false;
+
+                auto x = a->getNDArray();
+                auto y = b->getNDArray();
+                if (x->dataType() != y->dataType() || x->rankOf() != y->rankOf())
+                    return false;
+
+                for (int d = 1; d < x->rankOf(); d++)
+                    if (x->sizeAt(d) != y->sizeAt(d))
+                        return false;
+            }
+
+            return true;
+        }
+
+        bool RequestBatcher::isSplittable(Nd4jLong graphId) {
+            std::lock_guard<std::mutex> lock(_lock);
+
+            // unknown until first merged batch of the graph is executed
+            return _unsplittable.count(graphId) == 0;
+        }
+
+        Nd4jLong RequestBatcher::queuedRows(BatchQueue &queue) {
+            if (queue.requests.empty())
+                return 0;
+
+            // only requests that can be merged with the head one count towards next batch
+            auto first = queue.requests.front();
+            Nd4jLong rows = 0;
+            for (auto r: queue.requests)
+                if (r == first || isCompatible(first, r))
+                    rows += r->rows;
+
+            return rows;
+        }
+
+        std::vector<RequestBatcher::PendingRequest*> RequestBatcher::takeBatch(BatchQueue &queue) {
+            std::vector<PendingRequest*> batch;
+            auto first = queue.requests.front();
+            Nd4jLong rows = 0;
+
+            for (auto it = queue.requests.begin(); it != queue.requests.end(); ) {
+                auto r = *it;
+                if ((r == first || (rows + r->rows <= _maxBatchSize && isCompatible(first, r)))) {
+                    r->taken = true;
+                    batch.emplace_back(r);
+                    rows += r->rows;
+                    it = queue.requests.erase(it);
+                } else
+                    ++it;
+            }
+
+            return batch;
+        }
+
+        void RequestBatcher::executeSeparately(std::vector<PendingRequest*> &batch) {
+            for (auto r: batch) {
+                try {
+                    r->outputs = GraphHolder::getInstance()->execute(r->graphId, r->inputs);
+                } catch (...) {
+                    r->error = std::current_exception();
+                }
+            }
+        }
+
+        void RequestBatcher::executeBatch(std::vector<PendingRequest*> &batch) {
+            if (batch.size() == 1) {
+                executeSeparately(batch);
+                return;
+            }
+
+            auto first = batch.front();
+
+            // requests queued before we've learned that graph outputs can't be split
+            if (!isSplittable(first->graphId)) {
+                executeSeparately(batch);
+                return;
+            }
+
+            Nd4jLong total = 0;
+            for (auto r: batch)
+                total += r->rows;
+
+            std::vector<Variable*> *outputs = nullptr;
+            std::vector<Variable*> merged;
+            try {
+                // concatenating inputs along dimension 0
+                for (int e = 0; e < (int) first->inputs.size(); e++) {
+                    auto proto = first->inputs[e]->getNDArray();
+                    auto shape = proto->getShapeAsVector();
+                    shape[0] = total;
+
+                    auto array = NDArrayFactory::create_(proto->ordering(), shape, proto->dataType());
+                    auto name = first->inputs[e]->getName();
+                    merged.emplace_back(new Variable(array, name->empty() ? nullptr : name->c_str(), first->inputs[e]->id(), first->inputs[e]->index()));
+
+                    std::vector<Nd4jLong> idx(2 * proto->rankOf(), 0);
+
+                    Nd4jLong offset = 0;
+                    for (auto r: batch) {
+                        idx[0] = offset;
+                        idx[1] = offset + r->rows;
+
+                        auto view = (*array)(idx, true);
+                        view.assign(r->inputs[e]->getNDArray());
+
+                        offset += r->rows;
+                    }
+                }
+
+                outputs = GraphHolder::getInstance()->execute(first->graphId, merged);
+            } catch (...) {
+                // whatever wasn't handed over to GraphHolder yet
+                for (auto v: merged)
+                    delete v;
+
+                auto error = std::current_exception();
+                for (auto r: batch) {
+                    for (auto v: r->inputs)
+                        delete v;
+
+                    r->inputs.clear();
+                    r->error = error;
+                }
+
+                return;
+            }
+
+            // outputs which don't follow batch dimension can't be split back, so we execute requests one by one instead
+            bool splittable = true;
+            for (auto v: *outputs) {
+                if (!v->hasNDArray() || v->getNDArray()->rankOf() < 1 || v->getNDArray()->sizeAt(0) != total) {
+                    splittable = false;
+                    break;
+                }
+            }
+
+            if (splittable) {
+                Nd4jLong offset = 0;
+                for (auto r: batch) {
+                    r->outputs = new std::vector<Variable*>();
+
+                    for (auto v: *outputs) {
+                        auto array = v->getNDArray();
+                        std::vector<Nd4jLong> idx(2 * array->rankOf(), 0);
+                        idx[0] = offset;
+                        idx[1] = offset + r->rows;
+
+                        auto view = (*array)(idx, true);
+                        auto name = v->getName();
+                        r->outputs->emplace_back(new Variable(view.dup(array->ordering()), name->empty() ? nullptr : name->c_str(), v->id(), v->index()));
+                    }
+
+                    for (auto v: r->inputs)
+                        delete v;
+
+                    r->inputs.clear();
+                    offset += r->rows;
+                }
+            } else {
+                {
+                    std::lock_guard<std::mutex> lock(_lock);
+                    _unsplittable.insert(first->graphId);
+                }
+
+                executeSeparately(batch);
+            }
+
+            for (auto v: *outputs)
+                delete v;
+
+            delete outputs;
+        }
+
+        std::vector<Variable*>* RequestBatcher::execute(Nd4jLong graphId, std::vector<Variable*> &inputs) {
+            auto rows = batchRows(inputs);
+
+            // nothing to batch along
+            if (rows < 1 || rows >= _maxBatchSize || !isSplittable(graphId))
+                return GraphHolder::getInstance()->execute(graphId, inputs);
+
+            PendingRequest request;
+            request.graphId = graphId;
+            request.rows = rows;
+            request.inputs = inputs;
+            inputs.clear();
+
+            std::unique_lock<std::mutex> lock(_lock);
+            auto &queue = _queues[graphId];
+
+            auto depth = queue.requests.size();
+            if (_queueDepths.size() <= depth)
+                _queueDepths.resize(depth + 1, 0);
+
+            _queueDepths[depth]++;
+
+            queue.requests.emplace_back(&request);
+            _condition.notify_all();
+
+            while (!request.done) {
+                if (!request.taken && !queue.hasLeader) {
+                    // this thread collects the batch, and executes it
+                    queue.hasLeader = true;
+
+                    auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(_windowMicros);
+                    _condition.wait_until(lock, deadline, [&] { return queuedRows(queue) >= _maxBatchSize; });
+
+                    auto batch = takeBatch(queue);
+                    if (_batchSizes.size() <= batch.size())
+                        _batchSizes.resize(batch.size() + 1, 0);
+
+                    _batchSizes[batch.size()]++;
+
+                    // next leader may start collecting its batch while this one is executed
+                    queue.hasLeader = false;
+                    _condition.notify_all();
+
+                    lock.unlock();
+                    executeBatch(batch);
+                    lock.lock();
+
+                    for (auto r: batch)
+                        r->done = true;
+
+                    _condition.notify_all();
+                } else
+                    _condition.wait(lock);
+            }
+
+            lock.unlock();
+
+            if (request.error)
+                std::rethrow_exception(request.error);
+
+            return request.outputs;
+        }
+
+        flatbuffers::Offset<FlatResult> RequestBatcher::execute(Nd4jLong graphId, flatbuffers::FlatBufferBuilder &builder, const FlatInferenceRequest* request) {
+            std::vector<Variable*> inputs;
+            if (request != nullptr && request->variables() != nullptr) {
+                auto vars = request->variables();
+                for (int e = 0; e < (int) vars->size(); e++)
+                    inputs.emplace_back(new Variable(vars->Get(e)));
+            }
+
+            auto outputs = execute(graphId, inputs);
+
+            ExecutionResult result;
+            for (auto v: *outputs)
+                result.emplace_back(v);
+
+            auto offset = result.asFlatResult(builder);
+
+            for (auto v: *outputs)
+                delete v;
+
+            delete outputs;
+
+            return offset;
+        }
+    }
+}
@@ -0,0 +1,274 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <graph/SynchronizedVariableSpace.h>
+
+namespace nd4j {
+    namespace graph {
+        SynchronizedVariableSpace::SynchronizedVariableSpace(VariableSpace* reference) {
+            _backed = reference;
+        }
+
+        VariableSpace& SynchronizedVariableSpace::operator=(const VariableSpace& other) {
+            if (this == &other) return *this;
+
+            nd4j_printf("SynchronizedVariableSpace = not implemented\n","");
+
+            return *this;
+        }
+
+        nd4j::memory::Workspace* SynchronizedVariableSpace::workspace() {
+            // workspace is thread-safe on its own
+            return _backed->workspace();
+        }
+
+        int SynchronizedVariableSpace::numberOfPlaceholders() {
+            std::lock_guard<std::mutex> lock(_lock);
+            return _backed->numberOfPlaceholders();
+        }
+
+        std::vector<Variable*>* SynchronizedVariableSpace::getPlaceholders() {
+            std::lock_guard<std::mutex> lock(_lock);
+            return _backed->getPlaceholders();
+        }
+
+        nd4j::random::RandomBuffer* SynchronizedVariableSpace::getRNG() {
+            std::lock_guard<std::mutex> lock(_lock);
+            return _backed->getRNG();
+        }
+
+        void SynchronizedVariableSpace::setRNG(nd4j::random::RandomBuffer* rng) {
+            std::lock_guard<std::mutex> lock(_lock);
+            _backed->setRNG(rng);
+        }
+
+        void SynchronizedVariableSpace::setWorkspace(nd4j::memory::Workspace *workspace) {
+            std::lock_guard<std::mutex> lock(_lock);
+            _backed->setWorkspace(workspace);
+        }
+
+        bool SynchronizedVariableSpace::hasExternalVariable(int it) {
+            std::lock_guard<std::mutex> lock(_lock);
+            return _backed->hasExternalVariable(it);
+        }
+
+        bool SynchronizedVariableSpace::hasExternalVariable(std::pair<int,int>& pair) {
+            std::lock_guard<std::mutex> lock(_lock);
+            return _backed->hasExternalVariable(pair);
+        }
+
+        bool SynchronizedVariableSpace::hasExternalVariable(std::string *symbol) {
+            std::lock_guard<std::mutex> lock(_lock);
+            return _backed->hasExternalVariable(symbol);
+        }
+
+        bool SynchronizedVariableSpace::hasVariable(int id) {
+            // indexed Variables are resolved without lock
+            if (_backed->denseVariable(id) != nullptr)
+                return true;
+
+            std::lock_guard<std::mutex> lock(_lock);
+            return _backed->hasVariable(id);
+        }
+
+        bool SynchronizedVariableSpace::hasVariable(int id, int idx) {
+            if (_backed->denseVariable(id, idx) != nullptr)
+                return true;
+
+            std::lock_guard<std::mutex> lock(_lock);
+            return _backed->hasVariable(id, idx);
+        }
+
+        bool SynchronizedVariableSpace::hasVariable(std::pair<int,int>& pair) {
+            if (_backed->denseVariable(pair.first, pair.second) != nullptr)
+                return true;
+
+            std::lock_guard<std::mutex> lock(_lock);
+            return _backed->hasVariable(pair);
+        }
+
+        bool SynchronizedVariableSpace::hasVariable(std::string *symbol) {
+            std::lock_guard<std::mutex> lock(_lock);
+            return _backed->hasVariable(symbol);
+        }
+
+        nd4j::graph::Variable* SynchronizedVariableSpace::getVariable(int id) {
+            auto variable = _backed->denseVariable(id);
+            if (variable != nullptr)
+                return variable;
+
+            std::lock_guard<std::mutex> lock(_lock);
+            return _backed->getVariable(id);
+        }
+
+        nd4j::graph::Variable* SynchronizedVariableSpace::getVariable(int id, int idx) {
+            auto variable = _backed->denseVariable(id, idx);
+            if (variable != nullptr)
+                return variable;
+
+            std::lock_guard<std::mutex> lock(_lock);
+            return _backed->getVariable(id, idx);
+        }
+
+        nd4j::graph::Variable* SynchronizedVariableSpace::getVariable(std::pair<int,int>& pair) {
+            auto variable = _backed->denseVariable(pair.first, pair.second);
+            if (variable != nullptr)
+                return variable;
+
+            std::lock_guard<std::mutex> lock(_lock);
+            return _backed->getVariable(pair);
+        }
+
+        nd4j::graph::Variable* SynchronizedVariableSpace::getVariable(std::string *symbol) {
+            std::lock_guard<std::mutex> lock(_lock);
+            return _backed->getVariable(symbol);
+        }
+
+        std::vector<Variable*> SynchronizedVariableSpace::getVariables() {
+            std::lock_guard<std::mutex> lock(_lock);
+            return _backed->getVariables();
+        }
+
+        void SynchronizedVariableSpace::putVariable(std::pair<int,int>& pair, NDArray *array) {
+            std::lock_guard<std::mutex> lock(_lock);
+            _backed->putVariable(pair, array);
+        }
+
+        void SynchronizedVariableSpace::putVariable(std::pair<int,int>& pair, Variable *variable) {
+            std::lock_guard<std::mutex> lock(_lock);
+            _backed->putVariable(pair, variable);
+        }
+
+        void SynchronizedVariableSpace::putVariable(int id, Variable *variable) {
+            std::lock_guard<std::mutex> lock(_lock);
+            _backed->putVariable(id, variable);
+        }
+
+        void SynchronizedVariableSpace::putVariable(int id, NDArray *array) {
+            std::lock_guard<std::mutex> lock(_lock);
+            _backed->putVariable(id, array);
+        }
+
+        void SynchronizedVariableSpace::putVariable(int id, int idx, NDArray *array) {
+            std::lock_guard<std::mutex> lock(_lock);
+            _backed->putVariable(id, idx, array);
+        }
+
+        void SynchronizedVariableSpace::putVariable(int id, int idx, Variable *array) {
+            std::lock_guard<std::mutex> lock(_lock);
+            _backed->putVariable(id, idx, array);
+        }
+
+        void SynchronizedVariableSpace::replaceVariable(Variable *variable) {
+            std::lock_guard<std::mutex> lock(_lock);
+            _backed->replaceVariable(variable);
+        }
+
+        void SynchronizedVariableSpace::dropVariable(std::pair<int,int> &pair) {
+            std::lock_guard<std::mutex> lock(_lock);
+            _backed->dropVariable(pair);
+        }
+
+        void SynchronizedVariableSpace::dropVariable(int id, int idx) {
+            std::lock_guard<std::mutex> lock(_lock);
+            _backed->dropVariable(id, idx);
+        }
+
+        void SynchronizedVariableSpace::putOutputVariable(Variable *variable) {
+            std::lock_guard<std::mutex> lock(_lock);
+            _backed->putOutputVariable(variable);
+        }
+
+        void SynchronizedVariableSpace::trackList(nd4j::NDArrayList* list) {
+            std::lock_guard<std::mutex> lock(_lock);
+            _backed->trackList(list);
+        }
+
+        Nd4jLong SynchronizedVariableSpace::externalMemory() {
+            std::lock_guard<std::mutex> lock(_lock);
+            return _backed->externalMemory();
+        }
+
+        Nd4jLong SynchronizedVariableSpace::internalMemory() {
+            std::lock_guard<std::mutex> lock(_lock);
+            return _backed->internalMemory();
+        }
+
+        Nd4jLong SynchronizedVariableSpace::totalMemory() {
+            std::lock_guard<std::mutex> lock(_lock);
+            return _backed->totalMemory();
+        }
+
+        int SynchronizedVariableSpace::externalEntries() {
+            std::lock_guard<std::mutex> lock(_lock);
+            return _backed->externalEntries();
+        }
+
+        int SynchronizedVariableSpace::internalEntries() {
+            std::lock_guard<std::mutex> lock(_lock);
+            return _backed->internalEntries();
+        }
+
+        int SynchronizedVariableSpace::totalEntries() {
+            std::lock_guard<std::mutex> lock(_lock);
+            return _backed->totalEntries();
+        }
+
+        nd4j::graph::VariableSpace* SynchronizedVariableSpace::clone() {
+            std::lock_guard<std::mutex> lock(_lock);
+            return _backed->clone();
+        }
+
+        nd4j::graph::Stash* SynchronizedVariableSpace::getStash() {
+            std::lock_guard<std::mutex> lock(_lock);
+            return _backed->getStash();
+        }
+
+        std::vector<nd4j::graph::Variable*>* SynchronizedVariableSpace::getExternalVariables() {
+            std::lock_guard<std::mutex> lock(_lock);
+            return _backed->getExternalVariables();
+        }
+
+        void SynchronizedVariableSpace::setFlowPath(FlowPath* timers) {
+            std::lock_guard<std::mutex> lock(_lock);
+            _backed->setFlowPath(timers);
+        }
+
+        FlowPath* SynchronizedVariableSpace::flowPath() {
+            std::lock_guard<std::mutex> lock(_lock);
+            return _backed->flowPath();
+        }
+
+        void SynchronizedVariableSpace::setVariableIndex(std::shared_ptr<const VariableIndex> index) {
+            std::lock_guard<std::mutex> lock(_lock);
+            _backed->setVariableIndex(index);
+        }
+
+        std::shared_ptr<const VariableIndex> SynchronizedVariableSpace::variableIndex() {
+            std::lock_guard<std::mutex> lock(_lock);
+            return _backed->variableIndex();
+        }
+
+        nd4j::graph::Variable* SynchronizedVariableSpace::denseVariable(int id) {
+            // lock-free by design
+            return _backed->denseVariable(id);
+        }
+
+        nd4j::graph::Variable* SynchronizedVariableSpace::denseVariable(int id, int idx) {
+            return _backed->denseVariable(id, idx);
+        }
+    }
+}
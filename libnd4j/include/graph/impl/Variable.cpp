@@ -189,7 +189,7 @@ namespace nd4j {
         }
 
         
-        nd4j::graph::Variable::Variable(const nd4j::graph::FlatVariable *flatVariable) {
+        nd4j::graph::Variable::Variable(const nd4j::graph::FlatVariable *flatVariable, bool inPlace) {
             auto vid = flatVariable->id();
             this->_id = vid->first();
             this->_index = vid->second();
@@ -208,8 +208,7 @@ namespace nd4j {
                         // ?????
                         if (flatVariable->ndarray() != nullptr) {
                             auto ar = flatVariable->ndarray();
-                            _ndarray = nd4j::graph::FlatUtils::fromFlatArray(ar);
-                            _ndarray->triggerAllocationFlag(true, true);
+                            _ndarray = nd4j::graph::FlatUtils::fromFlatArray(ar, inPlace);
                         }
 
                         _variableType = VariableType::NDARRAY;
@@ -219,13 +218,9 @@ namespace nd4j {
                         if (flatVariable->ndarray() == nullptr)
                             throw std::runtime_error("CONSTANT variable must have NDArray bundled");
 
+                        // allocation flags are set by FlatUtils, in-place arrays don't own their buffers
                         auto ar = flatVariable->ndarray();
-                        if (ar->dtype() == DataType_UTF8) {
-                            _ndarray = nd4j::graph::FlatUtils::fromFlatArray(ar);
-                        } else {
-                            _ndarray = nd4j::graph::FlatUtils::fromFlatArray(ar);
-                        }
-                        _ndarray->triggerAllocationFlag(true, true);
+                        _ndarray = nd4j::graph::FlatUtils::fromFlatArray(ar, inPlace);
 
                         _variableType = VariableType::NDARRAY;
                     }
@@ -0,0 +1,54 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <graph/VariableIndex.h>
+#include <algorithm>
+
+namespace nd4j {
+    namespace graph {
+        VariableIndex::VariableIndex(const std::vector<int> &ids) {
+            std::vector<int> unique(ids);
+            std::sort(unique.begin(), unique.end());
+            unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+
+            _ids = unique;
+            if (_ids.empty())
+                return;
+
+            _minId = _ids.front();
+            auto range = (Nd4jLong) _ids.back() - _minId + 1;
+
+            // graph ids are mostly contiguous: -1..-N for variables and 1..M for nodes
+            if (range <= 4L * (Nd4jLong) _ids.size() + 1024L) {
+                _table.assign(range, -1);
+                for (int e = 0; e < (int) _ids.size(); e++)
+                    _table[(Nd4jLong) _ids[e] - _minId] = e;
+            } else {
+                _sparse.reserve(_ids.size());
+                for (int e = 0; e < (int) _ids.size(); e++)
+                    _sparse[_ids[e]] = e;
+            }
+        }
+
+        int VariableIndex::id(int slot) const {
+            return _ids.at(slot);
+        }
+
+        int VariableIndex::size() const {
+            return (int) _ids.size();
+        }
+    }
+}
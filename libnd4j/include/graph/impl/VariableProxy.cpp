@@ -24,12 +24,46 @@
 namespace nd4j {
     namespace graph {
         
-        VariableProxy::VariableProxy(VariableSpace* ref) {
+        VariableProxy::VariableProxy(VariableSpace* ref, bool copyOnWrite) {
             if (ref == nullptr)
                 _backed = new VariableSpace();
 
             _backed = ref;
             _current = new VariableSpace();
+            _current->setVariableIndex(_backed->variableIndex());
+            _copyOnWrite = copyOnWrite;
+        }
+
+
+        void VariableProxy::reset() {
+            delete _current;
+            _current = new VariableSpace();
+            _current->setVariableIndex(_backed->variableIndex());
+
+            // spills are released, and workspace is grown to cover them on next run
+            _workspace.scopeIn();
+            _workspace.scopeOut();
+        }
+
+
+        bool VariableProxy::isCopyOnWrite() {
+            return _copyOnWrite;
+        }
+
+
+        Variable* VariableProxy::localize(std::pair<int,int> &pair, Variable *variable) {
+            // Variables holding arrays (i.e. constants) are shared, empty ones are slots for outputs of this execution
+            if (!_copyOnWrite || variable->hasNDArray() || variable->hasNDArrayList())
+                return variable;
+
+            if (_current->hasVariable(pair))
+                return _current->getVariable(pair);
+
+            auto local = variable->clone();
+            local->setId(pair.first, pair.second);
+            _current->putVariable(pair, local);
+
+            return local;
         }
 
         
@@ -125,8 +159,10 @@ namespace nd4j {
             if (_current->hasVariable(id))
                 return _current->getVariable(id);
             
-            if (_backed->hasVariable(id))
-                return _backed->getVariable(id);
+            if (_backed->hasVariable(id)) {
+                std::pair<int,int> pair(id, 0);
+                return localize(pair, _backed->getVariable(id));
+            }
 
             nd4j_printf("Unable to get Variable to proxy: [%i]\n", id);
             throw std::runtime_error("Bad arguments");
@@ -137,8 +173,10 @@ namespace nd4j {
             if (_current->hasVariable(id, idx))
                 return _current->getVariable(id, idx);
             
-            if (_backed->hasVariable(id, idx))
-                return _backed->getVariable(id, idx);
+            if (_backed->hasVariable(id, idx)) {
+                std::pair<int,int> pair(id, idx);
+                return localize(pair, _backed->getVariable(id, idx));
+            }
 
             nd4j_printf("Unable to get Variable to proxy: [%i:%i]\n", id, idx);
             throw std::runtime_error("Bad arguments");
@@ -150,7 +188,7 @@ namespace nd4j {
                 return _current->getVariable(pair);
             
             if (_backed->hasVariable(pair))
-                return _backed->getVariable(pair);
+                return localize(pair, _backed->getVariable(pair));
 
             nd4j_printf("Unable to get Variable to proxy: [%i:%i]\n", pair.first, pair.second);
             throw std::runtime_error("Bad arguments");
@@ -161,8 +199,11 @@ namespace nd4j {
             if (_current->hasVariable(symbol))
                 return _current->getVariable(symbol);
             
-            if (_backed->hasVariable(symbol))
-                return _backed->getVariable(symbol);
+            if (_backed->hasVariable(symbol)) {
+                auto var = _backed->getVariable(symbol);
+                std::pair<int,int> pair(var->id(), var->index());
+                return localize(pair, var);
+            }
 
             nd4j_printf("Unable to get Variable to proxy: [%s]\n", symbol->c_str());
             throw std::runtime_error("Bad arguments");
@@ -232,6 +273,58 @@ namespace nd4j {
             return _current->flowPath();
         }
 
+
+        void VariableProxy::setVariableIndex(std::shared_ptr<const VariableIndex> index) {
+            _current->setVariableIndex(index);
+        }
+
+
+        std::shared_ptr<const VariableIndex> VariableProxy::variableIndex() {
+            return _current->variableIndex();
+        }
+
+
+        bool VariableProxy::isDense(int id, int idx) {
+            // backing space can be used only if it's indexed the same way, otherwise local Variable might be missed
+            auto index = _current->variableIndex();
+            return index != nullptr && index == _backed->variableIndex() && index->slot(id) >= 0 && idx >= 0 && idx < VariableIndex::MAX_OUTPUTS;
+        }
+
+
+        nd4j::graph::Variable* VariableProxy::denseVariable(int id) {
+            if (!isDense(id, 0))
+                return nullptr;
+
+            if (_current->hasVariable(id))
+                return _current->denseVariable(id);
+
+            // Variables that would be localized can't be handed out without modification of this proxy
+            auto variable = _backed->denseVariable(id);
+            if (variable != nullptr && _copyOnWrite && !variable->hasNDArray() && !variable->hasNDArrayList())
+                return nullptr;
+
+            return variable;
+        }
+
+
+        nd4j::graph::Variable* VariableProxy::denseVariable(int id, int idx) {
+            if (!isDense(id, idx))
+                return nullptr;
+
+            std::pair<int,int> pair(id, idx);
+            if (_current->hasVariable(pair))
+                return _current->denseVariable(id, idx);
+
+            if (!_backed->hasVariable(pair))
+                return nullptr;
+
+            auto variable = _backed->denseVariable(id, idx);
+            if (variable != nullptr && _copyOnWrite && !variable->hasNDArray() && !variable->hasNDArrayList())
+                return nullptr;
+
+            return variable;
+        }
+
         
         void VariableProxy::putOutputVariable(Variable *variable) {
             _current->putOutputVariable(variable);
@@ -269,7 +362,7 @@ namespace nd4j {
 
         
         nd4j::graph::VariableSpace* VariableProxy::clone() {
-            auto clone = new VariableProxy(_backed);
+            auto clone = new VariableProxy(_backed, _copyOnWrite);
 
             delete clone->_current;
             clone->_current = _current->clone();
@@ -33,6 +33,7 @@ namespace nd4j {
 
         nd4j::graph::VariableSpace* nd4j::graph::VariableSpace::clone() {
             auto result = new VariableSpace();
+            result->setVariableIndex(_index);
 
             for (auto const& x : _paired) {
                 std::pair<int, int> pair(x.first.first, x.first.second);
@@ -66,17 +67,13 @@ namespace nd4j {
 
         
         void nd4j::graph::VariableSpace::injectVariable(std::pair<int, int> &pair, Variable* variable) {
-            if (pair.second == 0) {
-                if (pair.first < 0)
-                    this->_variables[pair.first] = variable;
-                else
-                    this->_temporary[pair.first] = variable;
-            }
+            if (pair.second == 0)
+                storeId(pair.first, variable);
 
             if (variable->getName() != nullptr && variable->getName()->length() > 0)
                 this->_symbolic[*(variable->getName())] = variable;
 
-            this->_paired[pair] = variable;
+            storePaired(pair, variable);
 
             this->_handles->push_back(variable);
         }
@@ -139,10 +136,14 @@ namespace nd4j {
 
             if (pair.first < 0)
                 return getVariable(pair.first);
-            else if (_paired.count(pair) > 0)
-                return _paired.at(pair);
-            else {
-                if (hasVariable(pair.first) && pair.second == 0)
+
+            auto variable = denseVariable(pair.first, pair.second);
+            if (variable != nullptr)
+                return variable;
+            else if (densePosition(pair.first, pair.second) < 0) {
+                if (_paired.count(pair) > 0)
+                    return _paired.at(pair);
+                else if (hasVariable(pair.first) && pair.second == 0)
                     return getVariable(pair.first);
             }
 
@@ -152,10 +153,18 @@ namespace nd4j {
         }
 
         bool nd4j::graph::VariableSpace::hasVariable(int id) {
+            auto slot = denseSlot(id);
+            if (slot >= 0)
+                return _denseIds[slot].load(std::memory_order_acquire) != nullptr;
+
             return _variables.count(id) == 1 || _temporary.count(id) == 1;
         }
 
         bool nd4j::graph::VariableSpace::hasVariable(std::pair<int,int>& id) {
+            auto position = densePosition(id.first, id.second);
+            if (position >= 0)
+                return _densePaired[position].load(std::memory_order_acquire) != nullptr;
+
             return _paired.count(id) > 0;
         }
 
@@ -229,7 +238,7 @@ namespace nd4j {
             _varmap.lock();
 
             //std::pair<std::pair<int, int>, nd4j::graph::Variable *> p(pair, variable);
-            _paired[pair] = variable;
+            storePaired(pair, variable);
 
             _varmap.unlock();
         }
@@ -262,10 +271,10 @@ namespace nd4j {
 
         void nd4j::graph::VariableSpace::putVariable(int id, Variable *variable) {
             // we don't want to add variables more then once
-            if (_variables.count(id) > 0 || _temporary.count(id) > 0) {
+            if (hasVariable(id)) {
                 // nd4j_verbose("Trying to update variable for node_%i\n", id);
 
-                auto local = id < 0 ? _variables.at(id) : _temporary.at(id);
+                auto local = getVariable(id);
 
                 if (!local->hasNDArray() && variable->hasNDArray()) {
                     // nd4j_verbose("Saving variable for node_%i\n", id);
@@ -295,14 +304,12 @@ namespace nd4j {
             if (id < 0) {
                 //if (variable->isExternal())
                 _external.push_back(variable);
-
-                _variables[id] = variable;
             } else {
                 _internal.push_back(variable);
-
-                _temporary[id] = variable;
             }
 
+            storeId(id, variable);
+
             _varmap.unlock();
 
             std::pair<int,int> pair(id, 0);
@@ -320,6 +327,10 @@ namespace nd4j {
         }
 
         nd4j::graph::Variable * nd4j::graph::VariableSpace::getVariable(int id) {
+            auto variable = denseVariable(id);
+            if (variable != nullptr)
+                return variable;
+
 //            _varmap.lock();
 
             if (id < 0) {
@@ -379,17 +390,13 @@ namespace nd4j {
 
                 Variable* clonedVar = x.second->clone();
 
-                if (pair.second == 0) {
-                    if (pair.first < 0)
-                        this->_variables[pair.first] = clonedVar;
-                    else
-                        this->_temporary[pair.first] = clonedVar;
-                }
+                if (pair.second == 0)
+                    storeId(pair.first, clonedVar);
 
                 if (clonedVar->getName() != nullptr && clonedVar->getName()->length() > 0)
                     this->_symbolic[*(clonedVar->getName())] = clonedVar;
 
-                this->_paired[pair] = clonedVar;
+                storePaired(pair, clonedVar);
 
                 this->_handles->push_back(clonedVar);
             }
@@ -452,6 +459,86 @@ namespace nd4j {
             return _flow;
         }
 
+        void VariableSpace::storePaired(const std::pair<int,int>& pair, Variable *variable) {
+            _paired[pair] = variable;
+
+            auto position = densePosition(pair.first, pair.second);
+            if (position >= 0)
+                _densePaired[position].store(variable, std::memory_order_release);
+        }
+
+        void VariableSpace::storeId(int id, Variable *variable) {
+            if (id < 0)
+                _variables[id] = variable;
+            else
+                _temporary[id] = variable;
+
+            auto slot = denseSlot(id);
+            if (slot >= 0)
+                _denseIds[slot].store(variable, std::memory_order_release);
+        }
+
+        void VariableSpace::setVariableIndex(std::shared_ptr<const VariableIndex> index) {
+            std::lock_guard<std::mutex> lock(_varmap);
+
+            _index = index;
+            if (_index == nullptr) {
+                _densePaired.reset();
+                _denseIds.reset();
+                return;
+            }
+
+            auto numSlots = (Nd4jLong) _index->size();
+            _denseIds.reset(new std::atomic<Variable*>[numSlots]);
+            _densePaired.reset(new std::atomic<Variable*>[numSlots * VariableIndex::MAX_OUTPUTS]);
+
+            for (Nd4jLong e = 0; e < numSlots; e++)
+                _denseIds[e].store(nullptr);
+
+            for (Nd4jLong e = 0; e < numSlots * VariableIndex::MAX_OUTPUTS; e++)
+                _densePaired[e].store(nullptr);
+
+            // Variables stored before index was attached are mirrored now
+            for (auto const& v : _variables)
+                if (denseSlot(v.first) >= 0)
+                    _denseIds[denseSlot(v.first)].store(v.second);
+
+            for (auto const& v : _temporary)
+                if (denseSlot(v.first) >= 0)
+                    _denseIds[denseSlot(v.first)].store(v.second);
+
+            for (auto const& v : _paired) {
+                auto position = densePosition(v.first.first, v.first.second);
+                if (position >= 0)
+                    _densePaired[position].store(v.second);
+            }
+        }
+
+        std::shared_ptr<const VariableIndex> VariableSpace::variableIndex() {
+            return _index;
+        }
+
+        nd4j::graph::Variable* VariableSpace::denseVariable(int id) {
+            auto slot = denseSlot(id);
+            return slot < 0 ? nullptr : _denseIds[slot].load(std::memory_order_acquire);
+        }
+
+        nd4j::graph::Variable* VariableSpace::denseVariable(int id, int idx) {
+            // negative ids are resolved regardless of index, same as in getVariable()
+            if (id < 0)
+                return denseVariable(id);
+
+            auto position = densePosition(id, idx);
+            if (position < 0)
+                return nullptr;
+
+            auto variable = _densePaired[position].load(std::memory_order_acquire);
+            if (variable == nullptr && idx == 0)
+                variable = denseVariable(id);
+
+            return variable;
+        }
+
         VariableSpace::VariableSpace() {
             _handles = new std::vector<Variable *>;
         }
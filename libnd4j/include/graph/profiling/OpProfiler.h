@@ -0,0 +1,162 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_OP_PROFILER_H
+#define LIBND4J_OP_PROFILER_H
+
+#include <pointercast.h>
+#include <dll.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <memory>
+#include <chrono>
+
+namespace nd4j {
+    namespace graph {
+        /**
+         * Aggregated statistics of single op: wall time histogram, allocations and distinct input shapes
+         */
+        class ND4J_EXPORT OpStats {
+        public:
+            // log-linear histogram: 4 buckets per power of 2 nanoseconds
+            static const int NUM_BUCKETS = 256;
+
+            // number of distinct input shapes kept per op, the rest goes into single "other" entry
+            static const int MAX_SHAPES = 16;
+
+        private:
+            Nd4jLong _calls = 0L;
+            Nd4jLong _totalTime = 0L;
+            Nd4jLong _minTime = 0L;
+            Nd4jLong _maxTime = 0L;
+
+            Nd4jLong _workspaceBytes = 0L;
+            Nd4jLong _heapBytes = 0L;
+
+            // calls overlapped by other profiled ops, their memory counters cover calling thread only
+            Nd4jLong _partialMemoryCalls = 0L;
+
+            std::vector<Nd4jLong> _buckets;
+            std::map<std::string, Nd4jLong> _shapes;
+
+            static int bucketOf(Nd4jLong nanos);
+            static Nd4jLong bucketBound(int bucket);
+
+            void addShape(const std::string &shapes, Nd4jLong calls);
+        public:
+            OpStats();
+            ~OpStats() = default;
+
+            void record(Nd4jLong nanos, Nd4jLong workspaceBytes, Nd4jLong heapBytes, const std::string &shapes, bool partialMemory = false);
+            void merge(const OpStats &other);
+
+            Nd4jLong calls() const;
+            Nd4jLong totalTime() const;
+            Nd4jLong minTime() const;
+            Nd4jLong maxTime() const;
+            Nd4jLong workspaceBytes() const;
+            Nd4jLong heapBytes() const;
+            Nd4jLong partialMemoryCalls() const;
+
+            /**
+             * Returns upper bound of histogram bucket holding given percentile of calls, in nanoseconds
+             */
+            Nd4jLong percentile(double p) const;
+
+            const std::map<std::string, Nd4jLong>& shapes() const;
+        };
+
+        /**
+         * Process-wide profiler of ops executed via NativeOps. Each thread aggregates into its own stats,
+         * the lock guarding them is taken by other threads only while snapshot is built
+         */
+        class ND4J_EXPORT OpProfiler {
+        public:
+            class ThreadStats;
+
+        private:
+            static OpProfiler* _INSTANCE;
+
+            std::mutex _lock;
+            std::vector<std::shared_ptr<ThreadStats>> _threads;
+
+            // stats of threads that have finished already
+            std::map<std::string, OpStats> _retired;
+
+            OpProfiler() = default;
+
+            ThreadStats* threadStats();
+        public:
+            ~OpProfiler() = default;
+
+            static OpProfiler* getInstance();
+
+            bool isEnabled();
+            void setEnabled(bool reallyEnable);
+
+            void record(const std::string &opName, Nd4jLong nanos, Nd4jLong workspaceBytes, Nd4jLong heapBytes, const std::string &shapes, bool partialMemory = false);
+
+            /**
+             * This method merges stats of all threads, optionally resetting them
+             */
+            std::map<std::string, OpStats> snapshot(bool reset = false);
+            void reset();
+
+            /**
+             * Returns snapshot as JSON document: {"ops": [{"name": ..., "calls": ..., ...}]}
+             */
+            std::string toJson(bool reset = false);
+
+            // used by ThreadStats on thread exit
+            void retire(ThreadStats *stats);
+
+            static std::string describeShapes(const Nd4jLong **shapeInfos, int numShapes);
+        };
+
+        /**
+         * RAII helper timing single op call. Does nothing if profiling is disabled.
+         * Allocations are taken from memory::AllocationCounter: while scope is active, allocations of all threads are counted,
+         * so allocations made by OpenMP workers of the op are attributed to it. If profiled ops overlap, each of them gets only
+         * allocations of its calling thread, and is reported in partialMemoryCalls
+         */
+        class ND4J_EXPORT OpProfilerScope {
+        private:
+            bool _active = false;
+            std::string _name;
+            std::string _shapes;
+            std::chrono::time_point<std::chrono::steady_clock> _start;
+            Nd4jLong _workspaceBytes = 0L;
+            Nd4jLong _heapBytes = 0L;
+
+            // process-wide counters and scopes state at start, used if no other profiled op overlaps this one
+            Nd4jLong _sharedWorkspaceBytes = 0L;
+            Nd4jLong _sharedHeapBytes = 0L;
+            Nd4jLong _scopesState = 0L;
+            bool _exclusive = false;
+
+            void start();
+        public:
+            // legacy ops are identified by family and op number, i.e. "transform_same:12"
+            OpProfilerScope(const char *family, int opNum, const Nd4jLong *xShapeInfo, const Nd4jLong *yShapeInfo = nullptr);
+            OpProfilerScope(const std::string &opName, Nd4jPointer *shapeInfos, int numShapes);
+            ~OpProfilerScope();
+        };
+    }
+}
+
+#endif //LIBND4J_OP_PROFILER_H
@@ -0,0 +1,391 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <graph/profiling/OpProfiler.h>
+#include <memory/AllocationCounter.h>
+#include <helpers/shape.h>
+#include <templatemath.h>
+#include <Environment.h>
+#include <atomic>
+
+namespace nd4j {
+    namespace graph {
+        class OpProfiler::ThreadStats {
+        public:
+            std::mutex _lock;
+            std::map<std::string, OpStats> _ops;
+        };
+
+        // stats of the thread are handed over to profiler once thread exits
+        class ThreadStatsHolder {
+        public:
+            std::shared_ptr<OpProfiler::ThreadStats> _stats;
+
+            ~ThreadStatsHolder() {
+                if (_stats != nullptr)
+                    OpProfiler::getInstance()->retire(_stats.get());
+            }
+        };
+
+        static thread_local ThreadStatsHolder threadStatsHolder;
+
+        // low 32 bits hold number of active profiler scopes, high bits count scopes started, so overlap is detected with single load
+        static const Nd4jLong SCOPE_STARTED = 1LL << 32;
+        static const Nd4jLong SCOPE_ACTIVE_MASK = SCOPE_STARTED - 1;
+        static std::atomic<Nd4jLong> scopesState(0L);
+
+        OpProfiler* OpProfiler::_INSTANCE = nullptr;
+
+        OpStats::OpStats() : _buckets(NUM_BUCKETS, 0L) {
+            //
+        }
+
+        int OpStats::bucketOf(Nd4jLong nanos) {
+            if (nanos < 4)
+                return (int) nd4j::math::nd4j_max<Nd4jLong>(nanos, 0L);
+
+            int msb = 0;
+            while ((nanos >> (msb + 1)) > 0)
+                msb++;
+
+            // two bits below the highest one pick bucket within power of 2
+            return msb * 4 + (int) ((nanos >> (msb - 2)) & 3);
+        }
+
+        Nd4jLong OpStats::bucketBound(int bucket) {
+            if (bucket < 4)
+                return bucket;
+
+            const int msb = bucket / 4;
+            const Nd4jLong sub = bucket % 4;
+            return ((4 + sub + 1) << (msb - 2)) - 1;
+        }
+
+        void OpStats::addShape(const std::string &shapes, Nd4jLong calls) {
+            if (_shapes.count(shapes) > 0 || _shapes.size() < MAX_SHAPES)
+                _shapes[shapes] += calls;
+            else
+                _shapes["other"] += calls;
+        }
+
+        void OpStats::record(Nd4jLong nanos, Nd4jLong workspaceBytes, Nd4jLong heapBytes, const std::string &shapes, bool partialMemory) {
+            if (_calls == 0 || nanos < _minTime)
+                _minTime = nanos;
+
+            if (nanos > _maxTime)
+                _maxTime = nanos;
+
+            _calls++;
+            _totalTime += nanos;
+            _workspaceBytes += workspaceBytes;
+            _heapBytes += heapBytes;
+            _buckets[bucketOf(nanos)]++;
+
+            if (partialMemory)
+                _partialMemoryCalls++;
+
+            addShape(shapes, 1);
+        }
+
+        void OpStats::merge(const OpStats &other) {
+            if (other._calls == 0)
+                return;
+
+            if (_calls == 0 || other._minTime < _minTime)
+                _minTime = other._minTime;
+
+            if (other._maxTime > _maxTime)
+                _maxTime = other._maxTime;
+
+            _calls += other._calls;
+            _totalTime += other._totalTime;
+            _workspaceBytes += other._workspaceBytes;
+            _heapBytes += other._heapBytes;
+            _partialMemoryCalls += other._partialMemoryCalls;
+
+            for (int e = 0; e < NUM_BUCKETS; e++)
+                _buckets[e] += other._buckets[e];
+
+            for (const auto &v: other._shapes)
+                addShape(v.first, v.second);
+        }
+
+        Nd4jLong OpStats::calls() const {
+            return _calls;
+        }
+
+        Nd4jLong OpStats::totalTime() const {
+            return _totalTime;
+        }
+
+        Nd4jLong OpStats::minTime() const {
+            return _minTime;
+        }
+
+        Nd4jLong OpStats::maxTime() const {
+            return _maxTime;
+        }
+
+        Nd4jLong OpStats::workspaceBytes() const {
+            return _workspaceBytes;
+        }
+
+        Nd4jLong OpStats::heapBytes() const {
+            return _heapBytes;
+        }
+
+        Nd4jLong OpStats::partialMemoryCalls() const {
+            return _partialMemoryCalls;
+        }
+
+        Nd4jLong OpStats::percentile(double p) const {
+            if (_calls == 0)
+                return 0L;
+
+            auto rank = (Nd4jLong) (p * _calls / 100.0);
+            if (rank >= _calls)
+                rank = _calls - 1;
+
+            Nd4jLong seen = 0L;
+            for (int e = 0; e < NUM_BUCKETS; e++) {
+                seen += _buckets[e];
+                if (seen > rank)
+                    return nd4j::math::nd4j_max<Nd4jLong>(_minTime, nd4j::math::nd4j_min<Nd4jLong>(bucketBound(e), _maxTime));
+            }
+
+            return _maxTime;
+        }
+
+        const std::map<std::string, Nd4jLong>& OpStats::shapes() const {
+            return _shapes;
+        }
+
+        OpProfiler* OpProfiler::getInstance() {
+            if (_INSTANCE == nullptr)
+                _INSTANCE = new OpProfiler();
+
+            return _INSTANCE;
+        }
+
+        bool OpProfiler::isEnabled() {
+            return Environment::getInstance()->isOpProfiling();
+        }
+
+        void OpProfiler::setEnabled(bool reallyEnable) {
+            Environment::getInstance()->setOpProfiling(reallyEnable);
+        }
+
+        OpProfiler::ThreadStats* OpProfiler::threadStats() {
+            if (threadStatsHolder._stats == nullptr) {
+                threadStatsHolder._stats = std::make_shared<ThreadStats>();
+
+                std::lock_guard<std::mutex> lock(_lock);
+                _threads.emplace_back(threadStatsHolder._stats);
+            }
+
+            return threadStatsHolder._stats.get();
+        }
+
+        void OpProfiler::record(const std::string &opName, Nd4jLong nanos, Nd4jLong workspaceBytes, Nd4jLong heapBytes, const std::string &shapes, bool partialMemory) {
+            auto stats = threadStats();
+
+            std::lock_guard<std::mutex> lock(stats->_lock);
+            stats->_ops[opName].record(nanos, workspaceBytes, heapBytes, shapes, partialMemory);
+        }
+
+        void OpProfiler::retire(ThreadStats *stats) {
+            std::lock_guard<std::mutex> lock(_lock);
+
+            for (auto it = _threads.begin(); it != _threads.end(); ++it) {
+                if (it->get() != stats)
+                    continue;
+
+                std::lock_guard<std::mutex> statsLock(stats->_lock);
+                for (const auto &v: stats->_ops)
+                    _retired[v.first].merge(v.second);
+
+                _threads.erase(it);
+                break;
+            }
+        }
+
+        std::map<std::string, OpStats> OpProfiler::snapshot(bool reset) {
+            std::lock_guard<std::mutex> lock(_lock);
+
+            std::map<std::string, OpStats> result(_retired);
+            if (reset)
+                _retired.clear();
+
+            for (auto &stats: _threads) {
+                std::lock_guard<std::mutex> statsLock(stats->_lock);
+                for (const auto &v: stats->_ops)
+                    result[v.first].merge(v.second);
+
+                if (reset)
+                    stats->_ops.clear();
+            }
+
+            return result;
+        }
+
+        void OpProfiler::reset() {
+            snapshot(true);
+        }
+
+        static std::string escapeJson(const std::string &value) {
+            std::string result;
+            for (auto c: value) {
+                if (c == '"' || c == '\\')
+                    result += '\\';
+
+                result += c;
+            }
+
+            return result;
+        }
+
+        std::string OpProfiler::toJson(bool reset) {
+            auto stats = snapshot(reset);
+
+            std::string json = "{\"ops\": [";
+            bool first = true;
+            for (const auto &v: stats) {
+                const auto &op = v.second;
+
+                if (!first)
+                    json += ", ";
+                first = false;
+
+                json += "{\"name\": \"" + escapeJson(v.first) + "\"";
+                json += ", \"calls\": " + std::to_string(op.calls());
+                json += ", \"totalNanos\": " + std::to_string(op.totalTime());
+                json += ", \"minNanos\": " + std::to_string(op.minTime());
+                json += ", \"maxNanos\": " + std::to_string(op.maxTime());
+                json += ", \"p50Nanos\": " + std::to_string(op.percentile(50));
+                json += ", \"p90Nanos\": " + std::to_string(op.percentile(90));
+                json += ", \"p99Nanos\": " + std::to_string(op.percentile(99));
+                json += ", \"workspaceBytes\": " + std::to_string(op.workspaceBytes());
+                json += ", \"heapBytes\": " + std::to_string(op.heapBytes());
+                json += ", \"partialMemoryCalls\": " + std::to_string(op.partialMemoryCalls());
+                json += ", \"shapes\": [";
+
+                bool firstShape = true;
+                for (const auto &s: op.shapes()) {
+                    if (!firstShape)
+                        json += ", ";
+                    firstShape = false;
+
+                    json += "{\"shapes\": \"" + escapeJson(s.first) + "\", \"calls\": " + std::to_string(s.second) + "}";
+                }
+
+                json += "]}";
+            }
+            json += "]}";
+
+            return json;
+        }
+
+        std::string OpProfiler::describeShapes(const Nd4jLong **shapeInfos, int numShapes) {
+            std::string result;
+            for (int e = 0; e < numShapes; e++) {
+                if (e > 0)
+                    result += ";";
+
+                auto shapeInfo = shapeInfos[e];
+                if (shapeInfo == nullptr)
+                    continue;
+
+                result += "[";
+                for (int i = 0; i < shape::rank(shapeInfo); i++) {
+                    if (i > 0)
+                        result += ",";
+
+                    result += std::to_string(shape::sizeAt(shapeInfo, i));
+                }
+                result += "]";
+            }
+
+            return result;
+        }
+
+        OpProfilerScope::OpProfilerScope(const char *family, int opNum, const Nd4jLong *xShapeInfo, const Nd4jLong *yShapeInfo) {
+            if (!OpProfiler::getInstance()->isEnabled())
+                return;
+
+            _name = std::string(family) + ":" + std::to_string(opNum);
+
+            const Nd4jLong* shapeInfos[] = {xShapeInfo, yShapeInfo};
+            _shapes = OpProfiler::describeShapes(shapeInfos, yShapeInfo == nullptr ? 1 : 2);
+
+            start();
+        }
+
+        OpProfilerScope::OpProfilerScope(const std::string &opName, Nd4jPointer *shapeInfos, int numShapes) {
+            if (!OpProfiler::getInstance()->isEnabled())
+                return;
+
+            _name = opName;
+
+            std::vector<const Nd4jLong*> shapes(numShapes);
+            for (int e = 0; e < numShapes; e++)
+                shapes[e] = reinterpret_cast<const Nd4jLong*>(shapeInfos[e]);
+
+            _shapes = OpProfiler::describeShapes(shapes.data(), numShapes);
+
+            start();
+        }
+
+        void OpProfilerScope::start() {
+            _active = true;
+
+            auto previous = scopesState.fetch_add(SCOPE_STARTED + 1);
+            _scopesState = previous + SCOPE_STARTED + 1;
+            _exclusive = (previous & SCOPE_ACTIVE_MASK) == 0;
+
+            nd4j::memory::AllocationCounter::startShared();
+
+            _workspaceBytes = nd4j::memory::AllocationCounter::threadWorkspaceBytes();
+            _heapBytes = nd4j::memory::AllocationCounter::threadHeapBytes();
+            _sharedWorkspaceBytes = nd4j::memory::AllocationCounter::sharedWorkspaceBytes();
+            _sharedHeapBytes = nd4j::memory::AllocationCounter::sharedHeapBytes();
+            _start = std::chrono::steady_clock::now();
+        }
+
+        OpProfilerScope::~OpProfilerScope() {
+            if (!_active)
+                return;
+
+            auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _start).count();
+
+            // no other scope was started or active meanwhile, so process-wide counters belong to this op alone
+            bool exclusive = _exclusive && scopesState.load() == _scopesState;
+
+            Nd4jLong workspaceBytes, heapBytes;
+            if (exclusive) {
+                workspaceBytes = nd4j::memory::AllocationCounter::sharedWorkspaceBytes() - _sharedWorkspaceBytes;
+                heapBytes = nd4j::memory::AllocationCounter::sharedHeapBytes() - _sharedHeapBytes;
+            } else {
+                workspaceBytes = nd4j::memory::AllocationCounter::threadWorkspaceBytes() - _workspaceBytes;
+                heapBytes = nd4j::memory::AllocationCounter::threadHeapBytes() - _heapBytes;
+            }
+
+            nd4j::memory::AllocationCounter::stopShared();
+            scopesState.fetch_sub(1);
+
+            OpProfiler::getInstance()->record(_name, (Nd4jLong) nanos, workspaceBytes, heapBytes, _shapes, !exclusive);
+        }
+    }
+}
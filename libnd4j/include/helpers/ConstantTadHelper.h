@@ -0,0 +1,76 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_CONSTANTTADHELPER_H
+#define LIBND4J_CONSTANTTADHELPER_H
+
+#include <dll.h>
+#include <pointercast.h>
+#include <map>
+#include <list>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <array/TadPack.h>
+#include <array/TadDescriptor.h>
+
+namespace nd4j {
+    /**
+     * This class is process-wide LRU cache of TAD packs, keyed by original shapeInfo + dimensions.
+     * Cache size is bounded by Environment::tadCacheLimit(), limit of 0 disables caching.
+     */
+    class ND4J_EXPORT ConstantTadHelper {
+    private:
+        static ConstantTadHelper *_INSTANCE;
+
+        std::mutex _mutex;
+
+        // most recently used descriptors live in the head of the list
+        std::list<TadDescriptor> _lru;
+        std::map<TadDescriptor, std::pair<TadPack, std::list<TadDescriptor>::iterator>> _cache;
+
+        std::atomic<Nd4jLong> _hits;
+        std::atomic<Nd4jLong> _misses;
+
+        ConstantTadHelper();
+
+        TadPack buildPack(const TadDescriptor &descriptor);
+        void evict(Nd4jLong limit);
+    public:
+        ~ConstantTadHelper() = default;
+
+        static ConstantTadHelper* getInstance();
+
+        /**
+         * These methods return TadPack for given shapeInfo and dimensions, building it only on cache miss
+         */
+        TadPack tadForDimensions(const Nd4jLong *originalShape, const int *dimensions, int dimLength);
+        TadPack tadForDimensions(const Nd4jLong *originalShape, const std::vector<int> &dimensions);
+        TadPack tadForDimensions(const Nd4jLong *originalShape, int dimension);
+        TadPack tadForDimensions(const TadDescriptor &descriptor);
+
+        Nd4jLong cachedEntries();
+        Nd4jLong hits();
+        Nd4jLong misses();
+
+        /**
+         * This method drops all cached packs and resets counters
+         */
+        void purge();
+    };
+}
+
+#endif //LIBND4J_CONSTANTTADHELPER_H
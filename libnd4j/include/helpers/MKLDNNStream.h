@@ -23,20 +23,61 @@
 
 #ifdef HAVE_MKLDNN
 #include <mkldnn.hpp>
+#include <NDArray.h>
+#include <helpers/PrimitiveCache.h>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace nd4j {
+    /**
+     * Compiled MKL-DNN primitives together with memory objects they are bound to
+     */
+    class MKLDNNPrimitive {
+    public:
+        // engine primitives were created for, must outlive them
+        mkldnn::engine engine = mkldnn::engine(mkldnn::engine::cpu, 0);
+        std::vector<mkldnn::memory> memory;
+
+        // index of array each memory object is bound to, -1 for memory owned by MKL-DNN
+        std::vector<int> bindings;
+        std::vector<mkldnn::primitive> operations;
+    };
+
+    /**
+     * This class is process-wide cache of MKL-DNN primitives, keyed by op name + shapes, strides, dtypes of arrays + op arguments
+     */
+    class ND4J_EXPORT MKLDNNStreamCache : public PrimitiveCache<MKLDNNPrimitive> {
+    public:
+        // max number of distinct keys kept in cache
+        static const int MAX_KEYS = 256;
+
+    private:
+        MKLDNNStreamCache() : PrimitiveCache<MKLDNNPrimitive>(MAX_KEYS) { }
+    public:
+        static MKLDNNStreamCache* getInstance();
+    };
+
     class MKLDNNStream {
     protected:
         std::string _opName;
 
-        std::vector<const NDArray*> _inputs;
-        std::vector<const NDArray*> _outputs;
-        std::vector<float> _floatArguments;
-        std::vector<int> _intArguments;
-
         mkldnn::engine _engine = mkldnn::engine(mkldnn::engine::cpu, 0);
-        std::vector<mkldnn::memory> _memory;
-        mkldnn::primitive _operation;
+
+        MKLDNNStreamCache::Key _key;
+        std::vector<void*> _buffers;
+        std::shared_ptr<MKLDNNPrimitive> _primitive;
+        bool _ready = false;
+
+        void release() {
+            // primitive goes back to cache only if it was completely built
+            if (_primitive != nullptr && _ready)
+                MKLDNNStreamCache::getInstance()->release(_key, _primitive);
+
+            _primitive.reset();
+            _ready = false;
+        }
 
     public:
         template <typename X, typename Y>
@@ -53,36 +94,114 @@ namespace nd4j {
             return true;
         }
 
-        MKLDNNStream(const std::string &opName) : _opName(opName) { }
+        explicit MKLDNNStream(const std::string &opName) : _opName(opName) { }
+        ~MKLDNNStream() { release(); }
 
+        // primitive can be owned by single stream only
+        MKLDNNStream(const MKLDNNStream &other) = delete;
+        MKLDNNStream& operator=(const MKLDNNStream &other) = delete;
+        MKLDNNStream(MKLDNNStream &&other) = default;
+        MKLDNNStream& operator=(MKLDNNStream &&other) = default;
+
+        /**
+         * This method takes primitive built for the same op, shapes, strides, dtypes and arguments from cache,
+         * and rebinds its memory to buffers of given arrays. Returns true if primitive wasn't found and has to be built
+         */
         bool checkAndReset(const std::vector<const NDArray*> &inputs, const std::vector<const NDArray*> &outputs,
                 const std::vector<float> &floatArguments, const std::vector<int> &intArguments) {
-            if (inputs != _inputs || outputs != _outputs || floatArguments != _floatArguments || intArguments != _intArguments) {
-                _inputs = inputs;
-                _outputs = outputs;
-                _floatArguments = floatArguments;
-                _intArguments = intArguments;
-                _operation.reset(nullptr);
-                _memory.clear();
+            release();
+
+            std::vector<const NDArray*> arrays(inputs);
+            arrays.insert(arrays.end(), outputs.begin(), outputs.end());
+
+            std::vector<Nd4jLong> descriptor;
+            descriptor.push_back(static_cast<Nd4jLong>(inputs.size()));
+            _buffers.clear();
+
+            for (size_t e = 0; e < arrays.size(); e++) {
+                auto array = arrays[e];
+                _buffers.push_back(array == nullptr ? nullptr : array->getBuffer());
+
+                if (array == nullptr) {
+                    descriptor.push_back(-1);
+                    continue;
+                }
+
+                auto shapeInfo = array->getShapeInfo();
+                descriptor.insert(descriptor.end(), shapeInfo, shapeInfo + shape::shapeInfoLength(shapeInfo));
+
+                // arrays sharing buffer are bound to the same memory object, so that's part of the key too
+                Nd4jLong alias = static_cast<Nd4jLong>(e);
+                for (size_t j = 0; j < e; j++)
+                    if (_buffers[j] == _buffers[e]) {
+                        alias = static_cast<Nd4jLong>(j);
+                        break;
+                    }
+                descriptor.push_back(alias);
+            }
+
+            descriptor.push_back(static_cast<Nd4jLong>(floatArguments.size()));
+            for (auto v: floatArguments) {
+                int32_t bits;
+                std::memcpy(&bits, &v, sizeof(float));
+                descriptor.push_back(bits);
+            }
+
+            descriptor.push_back(static_cast<Nd4jLong>(intArguments.size()));
+            descriptor.insert(descriptor.end(), intArguments.begin(), intArguments.end());
+
+            _key = MKLDNNStreamCache::Key(_opName, descriptor);
+            _primitive = MKLDNNStreamCache::getInstance()->acquire(_key);
+
+            if (_primitive == nullptr) {
+                _primitive = std::make_shared<MKLDNNPrimitive>();
                 return true;
             }
+
+            for (size_t e = 0; e < _primitive->memory.size(); e++)
+                if (_primitive->bindings[e] >= 0)
+                    _primitive->memory[e].set_data_handle(_buffers[_primitive->bindings[e]]);
+
+            _ready = true;
             return false;
         }
 
         const mkldnn::engine &getEngine() { return _engine; }
         void setEngine(const mkldnn::engine &engine) { _engine = engine; }
 
-        const std::vector<mkldnn::memory> &getMemory() { return _memory; }
-        void setMemory(const std::vector<mkldnn::memory> &memory) { _memory = memory; }
+        const std::vector<mkldnn::memory> &getMemory() { return _primitive->memory; }
+        void setMemory(const std::vector<mkldnn::memory> &memory) {
+            _primitive->engine = _engine;
+            _primitive->memory = memory;
+            _primitive->bindings.clear();
+
+            // memory created over buffer of some array gets rebound to buffer of the same array on next calls
+            for (auto &m: memory) {
+                auto handle = m.get_data_handle();
+                int binding = -1;
+                for (size_t e = 0; e < _buffers.size(); e++)
+                    if (_buffers[e] != nullptr && _buffers[e] == handle) {
+                        binding = static_cast<int>(e);
+                        break;
+                    }
 
-        const mkldnn::primitive &getOperation() { return _operation; }
-        void setOperation(const mkldnn::primitive &operation) { _operation = operation; }
+                _primitive->bindings.push_back(binding);
+            }
+        }
+
+        const std::vector<mkldnn::primitive> &getOperations() { return _primitive->operations; }
+        void setOperation(const mkldnn::primitive &operation) { setOperations({operation}); }
+        void setOperations(const std::vector<mkldnn::primitive> &operations) {
+            _primitive->engine = _engine;
+            _primitive->operations = operations;
+            _ready = true;
+        }
 
         bool submitAndWait(mkldnn::stream::kind kind = mkldnn::stream::kind::eager) {
             nd4j_debug("Executing %s with MKL-DNN\n", _opName.c_str());
             // need to create a new one because already executed streams become unusable
             mkldnn::stream stream(kind);
-            return stream.submit({_operation}).wait();
+            return stream.submit(_primitive->operations).wait();
         }
     };
 }
@@ -61,6 +61,13 @@ namespace nd4j {
         static NDArray* simpleMMul(const nd4j::NDArray* a, const nd4j::NDArray* b, nd4j::NDArray* c , const double alpha = 1.0, const double beta = 1.0);
 
         static void matmul(const nd4j::NDArray* x, const nd4j::NDArray* y, nd4j::NDArray* z, const bool transX, const bool transY);
+
+        /**
+         *  batch of GEMMs over column-major matrices: C[i] = alphas[i] * op(A[i]) * op(B[i]) + betas[i] * C[i], all of type T, op(A[i]) is M x K, op(B[i]) is K x N
+         *  batched cblas call is used if available, otherwise either batch is split between threads, or GEMMs are done one by one with threads over tiles
+         */
+        template <typename T>
+        static void gemmBatched(const bool transA, const bool transB, const int M, const int N, const int K, const void* vAlphas, void** vA, const int lda, void** vB, const int ldb, const void* vBetas, void** vC, const int ldc, const int batchSize);
     };
 }
 
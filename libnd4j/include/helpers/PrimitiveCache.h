@@ -0,0 +1,138 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_PRIMITIVECACHE_H
+#define LIBND4J_PRIMITIVECACHE_H
+
+#include <pointercast.h>
+#include <atomic>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace nd4j {
+    /**
+     * This class is LRU cache of compiled primitives (i.e. MKL-DNN ones), keyed by op name + descriptor of op arguments.
+     * Each cached primitive is used by one thread at a time: it's taken out of cache while op runs, and put back afterwards,
+     * so several primitives may be pooled under the same key
+     */
+    template <typename T>
+    class PrimitiveCache {
+    public:
+        typedef std::pair<std::string, std::vector<Nd4jLong>> Key;
+
+    private:
+        // max number of distinct keys kept in cache
+        const int _maxKeys;
+
+        std::mutex _mutex;
+
+        // most recently used keys live in the head of the list
+        std::list<Key> _lru;
+        std::map<Key, std::pair<std::vector<std::shared_ptr<T>>, typename std::list<Key>::iterator>> _cache;
+
+        std::atomic<Nd4jLong> _hits;
+        std::atomic<Nd4jLong> _misses;
+
+    public:
+        explicit PrimitiveCache(int maxKeys) : _maxKeys(maxKeys) {
+            _hits.store(0);
+            _misses.store(0);
+        }
+
+        ~PrimitiveCache() = default;
+
+        /**
+         * This method returns idle primitive for given key, or nullptr if there's none
+         */
+        std::shared_ptr<T> acquire(const Key &key) {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            auto it = _cache.find(key);
+            if (it == _cache.end() || it->second.first.empty()) {
+                _misses++;
+                return nullptr;
+            }
+
+            // moving entry to the head of LRU list
+            _lru.splice(_lru.begin(), _lru, it->second.second);
+
+            auto primitive = it->second.first.back();
+            it->second.first.pop_back();
+
+            _hits++;
+            return primitive;
+        }
+
+        /**
+         * This method puts primitive back to cache, so other calls with the same key can use it
+         */
+        void release(const Key &key, const std::shared_ptr<T> &primitive) {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            // number of primitives per key is bounded by number of threads using them at the same time
+            auto it = _cache.find(key);
+            if (it != _cache.end()) {
+                it->second.first.push_back(primitive);
+                return;
+            }
+
+            _lru.push_front(key);
+            _cache.emplace(key, std::make_pair(std::vector<std::shared_ptr<T>>({primitive}), _lru.begin()));
+
+            // primitives still in use by someone will be put back under new entry
+            while (_lru.size() > static_cast<size_t>(_maxKeys)) {
+                _cache.erase(_lru.back());
+                _lru.pop_back();
+            }
+        }
+
+        /**
+         * This method returns number of idle primitives stored in cache
+         */
+        Nd4jLong cachedEntries() {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            Nd4jLong result = 0;
+            for (auto &entry: _cache)
+                result += static_cast<Nd4jLong>(entry.second.first.size());
+
+            return result;
+        }
+
+        Nd4jLong hits() {
+            return _hits.load();
+        }
+
+        Nd4jLong misses() {
+            return _misses.load();
+        }
+
+        void purge() {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _cache.clear();
+            _lru.clear();
+
+            _hits.store(0);
+            _misses.store(0);
+        }
+    };
+}
+
+#endif //LIBND4J_PRIMITIVECACHE_H
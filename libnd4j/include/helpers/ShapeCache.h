@@ -0,0 +1,91 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_SHAPECACHE_H
+#define LIBND4J_SHAPECACHE_H
+
+#include <dll.h>
+#include <pointercast.h>
+#include <map>
+#include <list>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <array/ShapeList.h>
+#include <array/ShapeListDescriptor.h>
+
+namespace nd4j {
+    /**
+     * This class is LRU cache of output shapes for a single op, keyed by input shapes + op arguments.
+     * Cached shapeInfos are immutable and shared, so callers must copy them before use.
+     * Cache size is bounded by Environment::shapeCacheLimit(), limit of 0 disables caching.
+     */
+    class ND4J_EXPORT ShapeCache {
+    public:
+        typedef std::shared_ptr<const std::vector<std::vector<Nd4jLong>>> ShapePack;
+
+    private:
+        std::mutex _mutex;
+
+        // most recently used descriptors live in the head of the list
+        std::list<ShapeListDescriptor> _lru;
+        std::map<ShapeListDescriptor, std::pair<ShapePack, std::list<ShapeListDescriptor>::iterator>> _cache;
+
+        std::atomic<Nd4jLong> _hits;
+        std::atomic<Nd4jLong> _misses;
+
+        // counters over all ops
+        static std::atomic<Nd4jLong> _totalHits;
+        static std::atomic<Nd4jLong> _totalMisses;
+
+        void insert(const ShapeListDescriptor &descriptor, const ShapePack &pack, Nd4jLong limit);
+        void evict(Nd4jLong limit);
+    public:
+        ShapeCache();
+        ~ShapeCache() = default;
+
+        /**
+         * This method returns cached output shapes for given descriptor, or nullptr on cache miss or rejected descriptor
+         */
+        ShapePack lookup(const ShapeListDescriptor &descriptor);
+
+        /**
+         * This method stores copies of given output shapes
+         */
+        void store(const ShapeListDescriptor &descriptor, ShapeList &shapes);
+
+        /**
+         * This method marks descriptor as value-dependent, i.e. shape function has looked into input arrays for it.
+         * Such descriptors are kept in cache, but lookups for them always miss
+         */
+        void reject(const ShapeListDescriptor &descriptor);
+
+        Nd4jLong cachedEntries();
+        Nd4jLong hits();
+        Nd4jLong misses();
+
+        /**
+         * This method drops all cached shapes and resets counters of this cache
+         */
+        void purge();
+
+        static Nd4jLong totalHits();
+        static Nd4jLong totalMisses();
+    };
+}
+
+#endif //LIBND4J_SHAPECACHE_H
@@ -0,0 +1,490 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_SORTENGINE_H
+#define LIBND4J_SORTENGINE_H
+
+#include <pointercast.h>
+#include <op_boilerplate.h>
+#include <helpers/shape.h>
+#include <helpers/OmpLaunchHelper.h>
+#include <helpers/StridedIterator.h>
+#include <templatemath.h>
+#include <type_traits>
+#include <algorithm>
+#include <vector>
+#include <cstring>
+
+namespace nd4j {
+
+/**
+ * Maps values to unsigned integers of the same order, so they can be sorted by radix sort.
+ * NaNs get the biggest key, so they always go last, and -0 gets the same key as +0, so it keeps its place among zeros.
+ *
+ * Generic version is used for float, float16 and bfloat16 values, all of them are compared as floats.
+ */
+template <typename T, typename Enable = void>
+struct RadixKey {
+    typedef uint32_t Type;
+
+    static FORCEINLINE bool isNaN(const T value) {
+        auto v = static_cast<float>(value);
+        return v != v;
+    }
+
+    static FORCEINLINE Type key(const T value) {
+        auto v = static_cast<float>(value);
+        if (v != v)
+            return 0xFFFFFFFFu;
+
+        if (v == 0.0f)
+            return 0x80000000u;
+
+        uint32_t bits;
+        memcpy(&bits, &v, sizeof(bits));
+
+        // negative values are ordered backwards
+        return (bits & 0x80000000u) != 0 ? ~bits : bits | 0x80000000u;
+    }
+};
+
+template <typename T>
+struct RadixKey<T, typename std::enable_if<std::is_same<T, double>::value>::type> {
+    typedef uint64_t Type;
+
+    static FORCEINLINE bool isNaN(const T value) {
+        return value != value;
+    }
+
+    static FORCEINLINE Type key(const T value) {
+        if (value != value)
+            return 0xFFFFFFFFFFFFFFFFULL;
+
+        if (value == 0.0)
+            return 0x8000000000000000ULL;
+
+        uint64_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+
+        return (bits & 0x8000000000000000ULL) != 0 ? ~bits : bits | 0x8000000000000000ULL;
+    }
+};
+
+template <typename T>
+struct RadixKey<T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value>::type> {
+    typedef typename std::make_unsigned<T>::type Type;
+
+    static FORCEINLINE bool isNaN(const T value) {
+        return false;
+    }
+
+    static FORCEINLINE Type key(const T value) {
+        // flipping sign bit moves negative values below positive ones
+        return std::is_signed<T>::value ? static_cast<Type>(static_cast<Type>(value) ^ (static_cast<Type>(1) << (sizeof(T) * 8 - 1))) : static_cast<Type>(value);
+    }
+};
+
+template <typename T>
+struct RadixKey<T, typename std::enable_if<std::is_same<T, bool>::value>::type> {
+    typedef uint8_t Type;
+
+    static FORCEINLINE bool isNaN(const T value) {
+        return false;
+    }
+
+    static FORCEINLINE Type key(const T value) {
+        return value ? 1 : 0;
+    }
+};
+
+/**
+ * Sorting of contiguous and strided arrays, TADs and key-value pairs.
+ *
+ * Values are sorted by LSD radix sort over 8-bit digits of RadixKey, passes where all keys share the digit are skipped.
+ * Short arrays, and so most of TADs, are sorted by stable comparison sort over the same keys, so order never depends on length.
+ * Merge sort is used where keys are compared by functor, i.e. for COO indices.
+ * Selection of top k elements and n-th element of row lives here as well.
+ */
+class SortEngine {
+    public:
+        // arrays of this length or shorter are sorted by comparison sort
+        static const Nd4jLong SMALL_SORT = 256;
+
+        template <typename T>
+        static FORCEINLINE typename RadixKey<T>::Type orderedKey(const T value, const bool descending) {
+            auto key = RadixKey<T>::key(value);
+
+            // NaNs stay last in descending order too
+            return descending && !RadixKey<T>::isNaN(value) ? static_cast<typename RadixKey<T>::Type>(~key) : key;
+        }
+
+        /**
+         * Stable LSD radix sort of keys, payload is moved together with keys
+         */
+        template <typename U, typename P>
+        static void radixSort(U *keys, P *payload, const Nd4jLong length) {
+            const int numPasses = sizeof(U);
+            const int numThreads = OmpLaunchHelper::betterThreads(length);
+            const Nd4jLong span = (length + numThreads - 1) / numThreads;
+
+            // histograms of all digits at once, to find passes that don't change anything
+            std::vector<Nd4jLong> counts(numThreads * numPasses * 256, 0);
+
+#pragma omp parallel for schedule(static, 1) num_threads(numThreads) if (numThreads > 1)
+            for (int t = 0; t < numThreads; t++) {
+                auto count = counts.data() + t * numPasses * 256;
+                const auto stop = nd4j::math::nd4j_min<Nd4jLong>(length, (t + 1) * span);
+
+                for (Nd4jLong e = t * span; e < stop; e++)
+                    for (int p = 0; p < numPasses; p++)
+                        count[p * 256 + ((keys[e] >> (p * 8)) & 0xFF)]++;
+            }
+
+            std::vector<bool> skip(numPasses, false);
+            for (int p = 0; p < numPasses; p++)
+                for (int b = 0; b < 256; b++) {
+                    Nd4jLong total = 0;
+                    for (int t = 0; t < numThreads; t++)
+                        total += counts[(t * numPasses + p) * 256 + b];
+
+                    if (total == length)
+                        skip[p] = true;
+                }
+
+            auto keysTmp = new U[length];
+            auto payloadTmp = new P[length];
+            U *srcKeys = keys, *dstKeys = keysTmp;
+            P *srcPayload = payload, *dstPayload = payloadTmp;
+            std::vector<Nd4jLong> offsets(numThreads * 256);
+
+            for (int p = 0; p < numPasses; p++) {
+                if (skip[p])
+                    continue;
+
+                const int shift = p * 8;
+
+#pragma omp parallel for schedule(static, 1) num_threads(numThreads) if (numThreads > 1)
+                for (int t = 0; t < numThreads; t++) {
+                    auto offset = offsets.data() + t * 256;
+                    std::fill(offset, offset + 256, 0);
+
+                    const auto stop = nd4j::math::nd4j_min<Nd4jLong>(length, (t + 1) * span);
+                    for (Nd4jLong e = t * span; e < stop; e++)
+                        offset[(srcKeys[e] >> shift) & 0xFF]++;
+                }
+
+                // bucket-major, thread-minor prefix sum keeps sort stable
+                Nd4jLong position = 0;
+                for (int b = 0; b < 256; b++)
+                    for (int t = 0; t < numThreads; t++) {
+                        auto count = offsets[t * 256 + b];
+                        offsets[t * 256 + b] = position;
+                        position += count;
+                    }
+
+#pragma omp parallel for schedule(static, 1) num_threads(numThreads) if (numThreads > 1)
+                for (int t = 0; t < numThreads; t++) {
+                    auto offset = offsets.data() + t * 256;
+
+                    const auto stop = nd4j::math::nd4j_min<Nd4jLong>(length, (t + 1) * span);
+                    for (Nd4jLong e = t * span; e < stop; e++) {
+                        auto pos = offset[(srcKeys[e] >> shift) & 0xFF]++;
+                        dstKeys[pos] = srcKeys[e];
+                        dstPayload[pos] = srcPayload[e];
+                    }
+                }
+
+                std::swap(srcKeys, dstKeys);
+                std::swap(srcPayload, dstPayload);
+            }
+
+            if (srcKeys != keys) {
+                std::copy(srcKeys, srcKeys + length, keys);
+                std::copy(srcPayload, srcPayload + length, payload);
+            }
+
+            delete[] keysTmp;
+            delete[] payloadTmp;
+        }
+
+        /**
+         * Stable parallel merge sort: chunks are sorted by threads independently and then merged pairwise
+         */
+        template <typename P, typename Compare>
+        static void mergeSort(P *data, const Nd4jLong length, Compare comparator) {
+            const int numThreads = OmpLaunchHelper::betterThreads(length);
+            if (numThreads <= 1 || length <= SMALL_SORT) {
+                std::stable_sort(data, data + length, comparator);
+                return;
+            }
+
+            const Nd4jLong span = (length + numThreads - 1) / numThreads;
+            auto bound = [&] (Nd4jLong chunk) -> Nd4jLong { return nd4j::math::nd4j_min<Nd4jLong>(length, chunk * span); };
+
+#pragma omp parallel for schedule(static, 1) num_threads(numThreads)
+            for (int t = 0; t < numThreads; t++)
+                std::stable_sort(data + bound(t), data + bound(t + 1), comparator);
+
+            auto tmp = new P[length];
+            P *src = data, *dst = tmp;
+
+            for (Nd4jLong width = 1; width < numThreads; width *= 2) {
+
+#pragma omp parallel for schedule(static, 1) num_threads(numThreads)
+                for (Nd4jLong c = 0; c < numThreads; c += 2 * width) {
+                    const auto lo = bound(c);
+                    const auto mid = bound(nd4j::math::nd4j_min<Nd4jLong>(c + width, numThreads));
+                    const auto hi = bound(nd4j::math::nd4j_min<Nd4jLong>(c + 2 * width, numThreads));
+
+                    std::merge(src + lo, src + mid, src + mid, src + hi, dst + lo, comparator);
+                }
+
+                std::swap(src, dst);
+            }
+
+            if (src != data)
+                std::copy(src, src + length, data);
+
+            delete[] tmp;
+        }
+
+        /**
+         * Sorts contiguous array
+         */
+        template <typename T>
+        static void sort(T *x, const Nd4jLong length, const bool descending) {
+            if (length < 2)
+                return;
+
+            if (length <= SMALL_SORT) {
+                std::stable_sort(x, x + length, [descending] (const T &a, const T &b) { return orderedKey(a, descending) < orderedKey(b, descending); });
+                return;
+            }
+
+            auto keys = new typename RadixKey<T>::Type[length];
+
+#pragma omp parallel for simd schedule(static) num_threads(OmpLaunchHelper::betterThreads(length))
+            for (Nd4jLong e = 0; e < length; e++)
+                keys[e] = orderedKey(x[e], descending);
+
+            radixSort(keys, x, length);
+
+            delete[] keys;
+        }
+
+        /**
+         * Sorts array of any strides. Elements with ews < 1 are sorted in c order of indices, like shape::getIndexOffset does
+         */
+        template <typename T>
+        static void sort(T *x, const Nd4jLong *xShapeInfo, const bool descending) {
+            const auto length = shape::length(xShapeInfo);
+            const auto ews = shape::elementWiseStride(xShapeInfo);
+
+            if (ews == 1) {
+                sort(x, length, descending);
+                return;
+            }
+
+            auto buffer = new T[length];
+            gather(x, xShapeInfo, length, ews, buffer);
+            sort(buffer, length, descending);
+            scatter(buffer, length, ews, xShapeInfo, x);
+            delete[] buffer;
+        }
+
+        /**
+         * Sorts every TAD on its own. Many TADs are distributed between threads, few long TADs are sorted one by one in parallel
+         */
+        template <typename T>
+        static void sortTads(T *x, const Nd4jLong *tadShapeInfo, const Nd4jLong *tadOffsets, const Nd4jLong numTads, const bool descending) {
+            const auto tadLength = shape::length(tadShapeInfo);
+            const auto tadEws = shape::elementWiseStride(tadShapeInfo);
+            const int numThreads = OmpLaunchHelper::betterThreads(numTads * tadLength);
+
+            if (numTads < numThreads && tadLength > SMALL_SORT) {
+                for (Nd4jLong r = 0; r < numTads; r++)
+                    sort(x + tadOffsets[r], tadShapeInfo, descending);
+
+                return;
+            }
+
+#pragma omp parallel num_threads(numThreads) if (numThreads > 1) default(shared)
+            {
+                // every thread reuses the same buffer for all its TADs
+                T *buffer = tadEws == 1 ? nullptr : new T[tadLength];
+
+#pragma omp for schedule(guided)
+                for (Nd4jLong r = 0; r < numTads; r++) {
+                    auto tad = x + tadOffsets[r];
+                    if (tadEws == 1) {
+                        sort(tad, tadLength, descending);
+                        continue;
+                    }
+
+                    gather(tad, tadShapeInfo, tadLength, tadEws, buffer);
+                    sort(buffer, tadLength, descending);
+                    scatter(buffer, tadLength, tadEws, tadShapeInfo, tad);
+                }
+
+                delete[] buffer;
+            }
+        }
+
+        /**
+         * Sorts contiguous keys, and applies the same permutation to values. Sort is stable
+         */
+        template <typename K, typename V>
+        static void sortByKey(K *keys, V *values, const Nd4jLong length, const bool descending) {
+            if (length < 2)
+                return;
+
+            auto permutation = new Nd4jLong[length];
+            for (Nd4jLong e = 0; e < length; e++)
+                permutation[e] = e;
+
+            if (length <= SMALL_SORT) {
+                std::stable_sort(permutation, permutation + length, [keys, descending] (const Nd4jLong a, const Nd4jLong b) { return orderedKey(keys[a], descending) < orderedKey(keys[b], descending); });
+            } else {
+                auto radixKeys = new typename RadixKey<K>::Type[length];
+
+#pragma omp parallel for simd schedule(static) num_threads(OmpLaunchHelper::betterThreads(length))
+                for (Nd4jLong e = 0; e < length; e++)
+                    radixKeys[e] = orderedKey(keys[e], descending);
+
+                radixSort(radixKeys, permutation, length);
+                delete[] radixKeys;
+            }
+
+            permute(keys, permutation, length);
+            permute(values, permutation, length);
+
+            delete[] permutation;
+        }
+
+        /**
+         * Selects k largest elements of contiguous row. Ties are resolved in favour of lower index, so k = 1 gives argMax.
+         * Results are ordered by value in descending order if sorted is true, or by index otherwise.
+         *
+         * For small k bounded heap of k best elements is used, and blocks of row which can't beat the worst of them
+         * are skipped after single vectorizable scan. For k close to width introselect over indices is used instead.
+         */
+        template <typename T>
+        static void topK(const T *row, const Nd4jLong width, const int k, const bool sorted, T *values, Nd4jLong *indices) {
+            auto better = [row] (const Nd4jLong a, const Nd4jLong b) { return row[a] > row[b] || (row[a] == row[b] && a < b); };
+
+            if ((Nd4jLong) k * 16 >= width) {
+                std::vector<Nd4jLong> all(width);
+                for (Nd4jLong e = 0; e < width; e++)
+                    all[e] = e;
+
+                if (k < width)
+                    std::nth_element(all.begin(), all.begin() + (k - 1), all.end(), better);
+
+                std::copy(all.begin(), all.begin() + k, indices);
+            } else {
+                // heap ordered by "better" keeps the worst selected element at front
+                for (int e = 0; e < k; e++)
+                    indices[e] = e;
+
+                std::make_heap(indices, indices + k, better);
+
+                const Nd4jLong block = 64;
+                for (Nd4jLong i = k; i < width; ) {
+                    const auto blockEnd = nd4j::math::nd4j_min<Nd4jLong>(width, i + block);
+
+                    // i is bigger than any selected index, so equal values never win
+                    const T threshold = row[indices[0]];
+                    int beats = 0;
+
+#pragma omp simd reduction(|:beats)
+                    for (Nd4jLong j = i; j < blockEnd; j++)
+                        beats |= row[j] > threshold ? 1 : 0;
+
+                    if (beats == 0) {
+                        i = blockEnd;
+                        continue;
+                    }
+
+                    for (; i < blockEnd; i++)
+                        if (row[i] > row[indices[0]]) {
+                            std::pop_heap(indices, indices + k, better);
+                            indices[k - 1] = i;
+                            std::push_heap(indices, indices + k, better);
+                        }
+                }
+            }
+
+            if (sorted)
+                std::sort(indices, indices + k, better);
+            else
+                std::sort(indices, indices + k);
+
+            for (int e = 0; e < k; e++)
+                values[e] = row[indices[e]];
+        }
+
+        /**
+         * Returns n-th smallest element of contiguous row, row is partially reordered
+         */
+        template <typename T>
+        static T nthElement(T *row, const Nd4jLong width, const Nd4jLong n) {
+            std::nth_element(row, row + n, row + width, [] (const T &a, const T &b) { return orderedKey(a, false) < orderedKey(b, false); });
+            return row[n];
+        }
+
+        /**
+         * x[e] = x[permutation[e]] for all e
+         */
+        template <typename T>
+        static void permute(T *x, const Nd4jLong *permutation, const Nd4jLong length) {
+            auto tmp = new T[length];
+
+#pragma omp parallel for simd schedule(static) num_threads(OmpLaunchHelper::betterThreads(length))
+            for (Nd4jLong e = 0; e < length; e++)
+                tmp[e] = x[permutation[e]];
+
+            std::copy(tmp, tmp + length, x);
+            delete[] tmp;
+        }
+
+        template <typename T>
+        static void gather(const T *x, const Nd4jLong *xShapeInfo, const Nd4jLong length, const Nd4jLong ews, T *z) {
+            if (ews > 0) {
+                for (Nd4jLong e = 0; e < length; e++)
+                    z[e] = x[e * ews];
+            } else {
+                StridedIterator it(xShapeInfo);
+                for (Nd4jLong e = 0; e < length; e++)
+                    z[e] = x[it.next()];
+            }
+        }
+
+        template <typename T>
+        static void scatter(const T *x, const Nd4jLong length, const Nd4jLong ews, const Nd4jLong *zShapeInfo, T *z) {
+            if (ews > 0) {
+                for (Nd4jLong e = 0; e < length; e++)
+                    z[e * ews] = x[e];
+            } else {
+                StridedIterator it(zShapeInfo);
+                for (Nd4jLong e = 0; e < length; e++)
+                    z[it.next()] = x[e];
+            }
+        }
+};
+
+}
+
+#endif //LIBND4J_SORTENGINE_H
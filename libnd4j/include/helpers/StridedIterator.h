@@ -0,0 +1,124 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_STRIDEDITERATOR_H
+#define LIBND4J_STRIDEDITERATOR_H
+
+#include <pointercast.h>
+#include <op_boilerplate.h>
+#include <helpers/shape.h>
+
+namespace nd4j {
+
+/**
+ * Odometer-style iterator over offsets of strided array, in the same c-order of indices as shape::getIndexOffset uses.
+ * Dimensions of size 1 are dropped and neighbouring dimensions contiguous to each other are collapsed into one,
+ * so moving to next element is a single add in most cases, and coordinates are decomposed only once, in constructor.
+ *
+ * Usage within thread: StridedIterator it(shapeInfo, threadOffset); for (...) z[it.next()] = ...;
+ */
+class StridedIterator {
+    private:
+        int _rank;
+        Nd4jLong _shape[MAX_RANK];
+        Nd4jLong _strides[MAX_RANK];
+        Nd4jLong _coords[MAX_RANK];
+        Nd4jLong _offset;
+
+    public:
+        StridedIterator() = delete;
+
+        /**
+         * @param shapeInfo - shape info of array (or TAD) to iterate over
+         * @param start - linear index of first element, i.e. thread offset
+         */
+        explicit StridedIterator(const Nd4jLong *shapeInfo, const Nd4jLong start = 0);
+
+        /**
+         * Returns offset of current element and moves to next one
+         */
+        FORCEINLINE Nd4jLong next();
+
+        /**
+         * Returns offset of current element
+         */
+        FORCEINLINE Nd4jLong offset() const;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+inline StridedIterator::StridedIterator(const Nd4jLong *shapeInfo, const Nd4jLong start) {
+    const int rank = shape::rank(shapeInfo);
+    const Nd4jLong *shape = shape::shapeOf(const_cast<Nd4jLong*>(shapeInfo));
+    const Nd4jLong *strides = shape::stride(const_cast<Nd4jLong*>(shapeInfo));
+
+    _rank = 0;
+    for (int e = 0; e < rank; e++) {
+        if (shape[e] == 1)
+            continue;
+
+        // previous dimension steps exactly over this one: merge them
+        if (_rank > 0 && _strides[_rank - 1] == shape[e] * strides[e]) {
+            _shape[_rank - 1] *= shape[e];
+            _strides[_rank - 1] = strides[e];
+            continue;
+        }
+
+        _shape[_rank] = shape[e];
+        _strides[_rank] = strides[e];
+        _rank++;
+    }
+
+    // scalar or array of 1s only
+    if (_rank == 0) {
+        _shape[0] = 1;
+        _strides[0] = 1;
+        _rank = 1;
+    }
+
+    _offset = 0;
+    Nd4jLong index = start;
+    for (int e = _rank - 1; e >= 0; e--) {
+        _coords[e] = index % _shape[e];
+        index /= _shape[e];
+        _offset += _coords[e] * _strides[e];
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+FORCEINLINE Nd4jLong StridedIterator::offset() const {
+    return _offset;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+FORCEINLINE Nd4jLong StridedIterator::next() {
+    const Nd4jLong current = _offset;
+
+    for (int e = _rank - 1; e >= 0; e--) {
+        if (++_coords[e] < _shape[e]) {
+            _offset += _strides[e];
+            return current;
+        }
+
+        _offset -= (_shape[e] - 1) * _strides[e];
+        _coords[e] = 0;
+    }
+
+    return current;
+}
+
+}
+
+#endif //LIBND4J_STRIDEDITERATOR_H
@@ -0,0 +1,139 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <helpers/ConstantTadHelper.h>
+#include <helpers/TAD.h>
+#include <Environment.h>
+#include <cstring>
+
+namespace nd4j {
+    ConstantTadHelper::ConstantTadHelper() {
+        _hits.store(0);
+        _misses.store(0);
+    }
+
+    ConstantTadHelper* ConstantTadHelper::getInstance() {
+        if (!_INSTANCE)
+            _INSTANCE = new nd4j::ConstantTadHelper();
+
+        return _INSTANCE;
+    }
+
+    TadPack ConstantTadHelper::tadForDimensions(const Nd4jLong *originalShape, const int *dimensions, int dimLength) {
+        TadDescriptor descriptor(originalShape, dimensions, dimLength);
+        return tadForDimensions(descriptor);
+    }
+
+    TadPack ConstantTadHelper::tadForDimensions(const Nd4jLong *originalShape, const std::vector<int> &dimensions) {
+        TadDescriptor descriptor(originalShape, dimensions);
+        return tadForDimensions(descriptor);
+    }
+
+    TadPack ConstantTadHelper::tadForDimensions(const Nd4jLong *originalShape, int dimension) {
+        TadDescriptor descriptor(originalShape, &dimension, 1);
+        return tadForDimensions(descriptor);
+    }
+
+    TadPack ConstantTadHelper::tadForDimensions(const TadDescriptor &descriptor) {
+        const Nd4jLong limit = nd4j::Environment::getInstance()->tadCacheLimit();
+
+        if (limit > 0) {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            auto it = _cache.find(descriptor);
+            if (it != _cache.end()) {
+                // moving entry to the head of LRU list
+                _lru.splice(_lru.begin(), _lru, it->second.second);
+                _hits++;
+                return it->second.first;
+            }
+        }
+
+        _misses++;
+
+        // TAD is built outside of lock, so other threads aren't blocked by this
+        auto pack = buildPack(descriptor);
+
+        if (limit > 0) {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            // another thread could have stored the same pack while we were building ours
+            auto it = _cache.find(descriptor);
+            if (it != _cache.end())
+                return it->second.first;
+
+            _lru.push_front(descriptor);
+            _cache.emplace(descriptor, std::make_pair(pack, _lru.begin()));
+
+            evict(limit);
+        }
+
+        return pack;
+    }
+
+    TadPack ConstantTadHelper::buildPack(const TadDescriptor &descriptor) {
+        // TAD works with mutable buffers, so we give it copies and keep descriptor intact
+        std::vector<Nd4jLong> shapeInfo(descriptor.originalShape());
+        std::vector<int> dimensions(descriptor.axis());
+
+        shape::TAD tad;
+        tad.init(shapeInfo.data(), dimensions.data(), static_cast<int>(dimensions.size()));
+        tad.createTadOnlyShapeInfo();
+        tad.createOffsets();
+
+        // TAD may reference original shapeInfo, so we always copy results into buffers owned by pack
+        auto sLength = shape::shapeInfoLength(tad.tadOnlyShapeInfo);
+        auto tadShape = new Nd4jLong[sLength];
+        auto tadOffsets = new Nd4jLong[tad.numTads];
+
+        std::memcpy(tadShape, tad.tadOnlyShapeInfo, sLength * sizeof(Nd4jLong));
+        std::memcpy(tadOffsets, tad.tadOffsets, tad.numTads * sizeof(Nd4jLong));
+
+        return TadPack(tadShape, tadOffsets, tad.numTads);
+    }
+
+    void ConstantTadHelper::evict(Nd4jLong limit) {
+        // packs still used by someone won't be released, since buffers are shared
+        while (static_cast<Nd4jLong>(_lru.size()) > limit) {
+            _cache.erase(_lru.back());
+            _lru.pop_back();
+        }
+    }
+
+    Nd4jLong ConstantTadHelper::cachedEntries() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return static_cast<Nd4jLong>(_cache.size());
+    }
+
+    Nd4jLong ConstantTadHelper::hits() {
+        return _hits.load();
+    }
+
+    Nd4jLong ConstantTadHelper::misses() {
+        return _misses.load();
+    }
+
+    void ConstantTadHelper::purge() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _cache.clear();
+        _lru.clear();
+
+        _hits.store(0);
+        _misses.store(0);
+    }
+
+    nd4j::ConstantTadHelper* nd4j::ConstantTadHelper::_INSTANCE = 0;
+}
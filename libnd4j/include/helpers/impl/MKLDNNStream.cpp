@@ -0,0 +1,30 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifdef HAVE_MKLDNN
+
+#include <helpers/MKLDNNStream.h>
+
+namespace nd4j {
+    MKLDNNStreamCache* MKLDNNStreamCache::getInstance() {
+        // initialization of function-local static is thread-safe. cache is never destroyed, so primitives outlive static destructors
+        static auto instance = new MKLDNNStreamCache();
+
+        return instance;
+    }
+}
+
+#endif
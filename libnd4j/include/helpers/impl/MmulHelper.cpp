@@ -24,11 +24,160 @@
 #include "../MmulHelper.h"
 #include <helpers/ShapeUtils.h>
 #include <helpers/BlasHelper.h>
+#include <helpers/ConstantTadHelper.h>
+#include <OmpLaunchHelper.h>
 #include <NDArrayFactory.h>
+#include <Environment.h>
 
 namespace nd4j { 
 
     
+//////////////////////////////////////////////////////////////////////////
+// collapses dimensions [start, end) of strided array into single one, returns false if they don't have common stride
+static bool collapseDims(const Nd4jLong* shape, const Nd4jLong* strides, const int start, const int end, Nd4jLong& length, Nd4jLong& stride) {
+
+    length = 1;
+    stride = 1;
+    Nd4jLong next = -1;
+
+    for (int e = end - 1; e >= start; e--) {
+        if (shape[e] == 1)
+            continue;
+
+        if (next < 0)
+            stride = strides[e];
+        else if (strides[e] != next)
+            return false;
+
+        length *= shape[e];
+        next = strides[e] * shape[e];
+    }
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// describes matrix [rows x cols] with given strides as column-major GEMM operand: transposed flag and leading dimension
+static bool gemmOperand(const Nd4jLong rows, const Nd4jLong cols, const Nd4jLong rowStride, const Nd4jLong colStride, bool& transposed, int& ld) {
+
+    if ((rowStride == 1 || rows == 1) && (cols == 1 || colStride >= rows)) {
+        transposed = false;
+        ld = cols == 1 ? rows : colStride;
+        return true;
+    }
+
+    if ((colStride == 1 || cols == 1) && (rows == 1 || rowStride >= cols)) {
+        transposed = true;
+        ld = rows == 1 ? cols : rowStride;
+        return true;
+    }
+
+    return false;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// matrices [rows x cols] are given by their description as GEMM operands, c-ordered z is column-major z^T, so z^T = y^T * x^T is computed then
+template <typename T>
+static void stridedGemm_(const bool xTrans, const int ldx, const bool yTrans, const int ldy, const bool zTrans, const int ldz, const int M, const int N, const int K, void** pX, void** pY, void** pZ, const int batchSize) {
+
+    std::vector<T> alphas(batchSize, (T) 1.f);
+    std::vector<T> betas(batchSize, (T) 0.f);
+
+    if (zTrans)
+        MmulHelper::gemmBatched<T>(!yTrans, !xTrans, N, M, K, alphas.data(), pY, ldy, pX, ldx, betas.data(), pZ, ldz, batchSize);
+    else
+        MmulHelper::gemmBatched<T>(xTrans, yTrans, M, N, K, alphas.data(), pX, ldx, pY, ldy, betas.data(), pZ, ldz, batchSize);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// describes array as matrix: its first rowDims dimensions are rows, the rest are columns
+static bool matrixOperand(const NDArray* arr, const int rowDims, Nd4jLong& rows, Nd4jLong& cols, bool& transposed, int& ld) {
+
+    Nd4jLong rowStride, colStride;
+    if (!collapseDims(arr->shapeOf(), arr->stridesOf(), 0, rowDims, rows, rowStride) ||
+        !collapseDims(arr->shapeOf(), arr->stridesOf(), rowDims, arr->rankOf(), cols, colStride))
+        return false;
+
+    return gemmOperand(rows, cols, rowStride, colStride, transposed, ld);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// copies array into c-ordered buffer of the same shape, strided matrices are transposed by square tiles to keep both sides in cache
+static NDArray* packOperand(const NDArray* arr, const int rowDims) {
+
+    auto packed = new NDArray('c', arr->getShapeAsVector(), arr->dataType(), arr->getWorkspace());
+
+    Nd4jLong rows, cols, rowStride, colStride;
+    if (!collapseDims(arr->shapeOf(), arr->stridesOf(), 0, rowDims, rows, rowStride) ||
+        !collapseDims(arr->shapeOf(), arr->stridesOf(), rowDims, arr->rankOf(), cols, colStride)) {
+        packed->assign(arr);
+        return packed;
+    }
+
+    const Nd4jLong TILE = 32;
+    const auto elementSize = DataTypeUtils::sizeOf(arr->dataType());
+    auto source = reinterpret_cast<const int8_t*>(arr->getBuffer());
+    auto target = reinterpret_cast<int8_t*>(packed->getBuffer());
+
+#pragma omp parallel for schedule(static) collapse(2) if(rows * cols > Environment::getInstance()->elementwiseThreshold())
+    for (Nd4jLong rt = 0; rt < rows; rt += TILE) {
+        for (Nd4jLong ct = 0; ct < cols; ct += TILE) {
+            const auto rEnd = nd4j::math::nd4j_min<Nd4jLong>(rows, rt + TILE);
+            const auto cEnd = nd4j::math::nd4j_min<Nd4jLong>(cols, ct + TILE);
+
+            for (Nd4jLong r = rt; r < rEnd; r++)
+                for (Nd4jLong c = ct; c < cEnd; c++)
+                    memcpy(target + (r * cols + c) * elementSize, source + (r * rowStride + c * colStride) * elementSize, elementSize);
+        }
+    }
+
+    return packed;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// c = a * b, where a is [M x K] matrix built of its first aRowDims dimensions and the rest ones, b is [K x N] matrix split by bRowDims and c is [M x N] matrix split by cRowDims.
+// operands which can't be described by leading dimension and transposition are packed, result is written directly into c whenever possible
+template <typename T>
+static void tensorDotGemm_(const NDArray* a, const NDArray* b, NDArray* c, const int aRowDims, const int bRowDims, const int cRowDims) {
+
+    Nd4jLong M, N, K, K2, cRows, cCols;
+    bool aTrans, bTrans, cTrans;
+    int lda, ldb, ldc;
+
+    NDArray* aP = const_cast<NDArray*>(a);
+    NDArray* bP = const_cast<NDArray*>(b);
+    NDArray* cP = c;
+
+    if (!matrixOperand(aP, aRowDims, M, K, aTrans, lda)) {
+        aP = packOperand(a, aRowDims);
+        matrixOperand(aP, aRowDims, M, K, aTrans, lda);
+    }
+
+    if (!matrixOperand(bP, bRowDims, K2, N, bTrans, ldb)) {
+        bP = packOperand(b, bRowDims);
+        matrixOperand(bP, bRowDims, K2, N, bTrans, ldb);
+    }
+
+    if (!matrixOperand(cP, cRowDims, cRows, cCols, cTrans, ldc)) {
+        cP = new NDArray('c', c->getShapeAsVector(), c->dataType(), c->getWorkspace());
+        matrixOperand(cP, cRowDims, cRows, cCols, cTrans, ldc);
+    }
+
+    void* pA = aP->getBuffer();
+    void* pB = bP->getBuffer();
+    void* pC = cP->getBuffer();
+    stridedGemm_<T>(aTrans, lda, bTrans, ldb, cTrans, ldc, M, N, K, &pA, &pB, &pC, 1);
+
+    if (cP != c) {
+        c->assign(cP);
+        delete cP;
+    }
+    if (aP != a)
+        delete aP;
+    if (bP != b)
+        delete bP;
+}
+
 //////////////////////////////////////////////////////////////////////////
 nd4j::NDArray* nd4j::MmulHelper::tensorDot(const nd4j::NDArray* A, const nd4j::NDArray* B, const std::initializer_list<int>& axesA, const std::initializer_list<int>& axesB) {
     std::vector<int> aA(axesA);
@@ -36,11 +185,31 @@ nd4j::NDArray* nd4j::MmulHelper::tensorDot(const nd4j::NDArray* A, const nd4j::N
     return tensorDot(A, B, aA, aB);
 }
 
+//////////////////////////////////////////////////////////////////////////
+// returns number of leading dimensions of arr which make up exactly rows elements, or -1 if there's no such split
+static int rowDimsOf(const NDArray* arr, const Nd4jLong rows) {
+
+    Nd4jLong length = 1;
+    int dims = 0;
+    while (dims < arr->rankOf() && length < rows)
+        length *= arr->sizeAt(dims++);
+
+    return length == rows ? dims : -1;
+}
+
 //////////////////////////////////////////////////////////////////////////
 nd4j::NDArray* nd4j::MmulHelper::tensorDot(const nd4j::NDArray* a, const nd4j::NDArray* b, const std::vector<int>& axes_0, const std::vector<int>& axes_1) {
     std::vector<int> permutAt, permutBt;
     std::vector<Nd4jLong> shapeAt, shapeBt;        
     auto outShape = ShapeUtils::evalShapeForTensorDot(a, b, axes_0, axes_1, permutAt, permutBt, shapeAt, shapeBt);
+
+    // same types go to GEMM on permuted views directly, so result is allocated in its final shape
+    if (a->dataType() == b->dataType() && a->isR()) {
+        auto c = new NDArray('c', outShape, a->dataType(), a->getWorkspace());
+        tensorDot(a, b, c, axes_0, axes_1);
+        return c;
+    }
+
     NDArray* aPR(const_cast<NDArray*>(a)), *bPR(const_cast<NDArray*>(b));
     aPR = a->permute(permutAt);        
     bPR = b->permute(permutBt);
@@ -81,6 +250,23 @@ void nd4j::MmulHelper::tensorDot(const nd4j::NDArray* a, const nd4j::NDArray* b,
     
     aPR = a->permute(permutAt);        
     bPR = b->permute(permutBt);    
+
+    // permuted views are passed to GEMM as they are, with leading dimensions and transposition flags, copies are made only for views that can't be described this way
+    const int aRowDims = a->rankOf() - (int) axes_a.size();
+    Nd4jLong M = 1;
+    for (int i = 0; i < aRowDims; ++i)
+        M *= aPR->sizeAt(i);
+    const int cRowDims = rowDimsOf(cP, M);
+    if (a->dataType() == c->dataType() && b->dataType() == c->dataType() && c->isR() && cRowDims >= 0) {
+        BUILD_SINGLE_SELECTOR(c->dataType(), tensorDotGemm_, (aPR, bPR, cP, aRowDims, (int) axes_b.size(), cRowDims), FLOAT_TYPES);
+
+        delete aPR;
+        delete bPR;
+        if(cP != c)
+            delete cP;
+        return;
+    }
+
     // check whether reshape is necessary        
     if(!aPR->isSameShape(shapeAt)) {
         if(aPR == a)
@@ -702,6 +888,100 @@ NDArray* MmulHelper::simpleMMul(const NDArray* a, const NDArray* b, NDArray* c,
     return c;
 }
 
+//////////////////////////////////////////////////////////////////////////
+// multiplies matrices of batch in place, with pointers computed from TAD offsets, returns false if some matrix isn't expressible as GEMM operand
+template <typename T>
+static bool stridedBatchedMatmul_(const NDArray* x, const NDArray* y, NDArray* z) {
+
+    const int rank = z->rankOf();
+    if (x->rankOf() != rank || y->rankOf() != rank)
+        return false;
+
+    const Nd4jLong M = z->sizeAt(-2);
+    const Nd4jLong N = z->sizeAt(-1);
+    const Nd4jLong K = x->sizeAt(-1);
+    if (M == 0 || N == 0 || K == 0)
+        return false;
+
+    bool xTrans, yTrans, zTrans;
+    int ldx, ldy, ldz;
+    if (!gemmOperand(M, K, x->stridesOf()[rank - 2], x->stridesOf()[rank - 1], xTrans, ldx) ||
+        !gemmOperand(K, N, y->stridesOf()[rank - 2], y->stridesOf()[rank - 1], yTrans, ldy) ||
+        !gemmOperand(M, N, z->stridesOf()[rank - 2], z->stridesOf()[rank - 1], zTrans, ldz))
+        return false;
+
+    int dims[2] = {rank - 2, rank - 1};
+    auto xPack = ConstantTadHelper::getInstance()->tadForDimensions(x->getShapeInfo(), dims, 2);
+    auto yPack = ConstantTadHelper::getInstance()->tadForDimensions(y->getShapeInfo(), dims, 2);
+    auto zPack = ConstantTadHelper::getInstance()->tadForDimensions(z->getShapeInfo(), dims, 2);
+
+    const Nd4jLong batchSize = zPack.numberOfTads();
+    if (xPack.numberOfTads() != batchSize || yPack.numberOfTads() != batchSize)
+        return false;
+
+    std::vector<void*> pX(batchSize), pY(batchSize), pZ(batchSize);
+    for (Nd4jLong i = 0; i < batchSize; i++) {
+        pX[i] = x->bufferAsT<T>() + xPack.primaryOffsets()[i];
+        pY[i] = y->bufferAsT<T>() + yPack.primaryOffsets()[i];
+        pZ[i] = z->bufferAsT<T>() + zPack.primaryOffsets()[i];
+    }
+
+    stridedGemm_<T>(xTrans, ldx, yTrans, ldy, zTrans, ldz, M, N, K, pX.data(), pY.data(), pZ.data(), batchSize);
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+void MmulHelper::gemmBatched(const bool transA, const bool transB, const int M, const int N, const int K, const void* vAlphas, void** vA, const int lda, void** vB, const int ldb, const void* vBetas, void** vC, const int ldc, const int batchSize) {
+
+    auto alphas = reinterpret_cast<const T*>(vAlphas);
+    auto betas  = reinterpret_cast<const T*>(vBetas);
+    auto A = reinterpret_cast<T**>(vA);
+    auto B = reinterpret_cast<T**>(vB);
+    auto C = reinterpret_cast<T**>(vC);
+
+    const CBLAS_TRANSPOSE tA = transA ? CblasTrans : CblasNoTrans;
+    const CBLAS_TRANSPOSE tB = transB ? CblasTrans : CblasNoTrans;
+    auto blas = BlasHelper::getInstance();
+
+    if ((std::is_same<T, float>::value || std::is_same<T, double>::value) && blas->template hasBatchedGEMM<T>()) {
+        // mkl requires all parameters as arrays, one group per matrix
+        std::vector<CBLAS_TRANSPOSE> vtA(batchSize, tA), vtB(batchSize, tB);
+        std::vector<int> vM(batchSize, M), vN(batchSize, N), vK(batchSize, K), vldA(batchSize, lda), vldB(batchSize, ldb), vldC(batchSize, ldc), vSize(batchSize, 1);
+
+        if (std::is_same<T, double>::value)
+            blas->dgemmBatched()(CblasColMajor, vtA.data(), vtB.data(), vM.data(), vN.data(), vK.data(), (double *) alphas, (double **) A, vldA.data(), (double **) B, vldB.data(), (double *) betas, (double **) C, vldC.data(), batchSize, vSize.data());
+        else
+            blas->sgemmBatched()(CblasColMajor, vtA.data(), vtB.data(), vM.data(), vN.data(), vK.data(), (float *) alphas, (float **) A, vldA.data(), (float **) B, vldB.data(), (float *) betas, (float **) C, vldC.data(), batchSize, vSize.data());
+
+        return;
+    }
+
+    // batch long enough to keep all threads busy goes over threads and every GEMM runs single-threaded,
+    // otherwise GEMMs go one by one and each one spreads its tiles over threads
+    const int numThreads = OmpLaunchHelper::betterThreads((Nd4jLong) batchSize * M * N * K);
+    const bool overBatch = numThreads > 1 && batchSize >= numThreads;
+
+    if (overBatch) {
+        // vendor BLAS has own thread pool we can't limit from here, so internal GEMM is used: it doesn't spawn threads within parallel region
+#pragma omp parallel for schedule(guided) num_threads(numThreads)
+        for (int i = 0; i < batchSize; i++)
+            nd4j::blas::GEMM<T, T, T>::op('f', tA, tB, M, N, K, (double) alphas[i], A[i], lda, B[i], ldb, (double) betas[i], C[i], ldc);
+
+        return;
+    }
+
+    for (int i = 0; i < batchSize; i++) {
+        if (std::is_same<T, float>::value && blas->template hasGEMM<float>())
+            blas->sgemm()(CblasColMajor, tA, tB, M, N, K, (float) alphas[i], (float *) A[i], lda, (float *) B[i], ldb, (float) betas[i], (float *) C[i], ldc);
+        else if (std::is_same<T, double>::value && blas->template hasGEMM<double>())
+            blas->dgemm()(CblasColMajor, tA, tB, M, N, K, (double) alphas[i], (double *) A[i], lda, (double *) B[i], ldb, (double) betas[i], (double *) C[i], ldc);
+        else
+            nd4j::blas::GEMM<T, T, T>::op('f', tA, tB, M, N, K, (double) alphas[i], A[i], lda, B[i], ldb, (double) betas[i], C[i], ldc);
+    }
+}
+
 //////////////////////////////////////////////////////////////////////////
     void MmulHelper::matmul(const nd4j::NDArray* x, const nd4j::NDArray* y, nd4j::NDArray* z, const bool transX, const bool transY) {
         int xRank = x->rankOf();
@@ -740,7 +1020,20 @@ NDArray* MmulHelper::simpleMMul(const NDArray* a, const NDArray* b, NDArray* c,
             mmul(xT, yT, zT, 1., 0.);
         }
         else {  // rest cases -  batched mmul
-        
+
+            bool done = false;
+            if (xT->dataType() == zT->dataType() && yT->dataType() == zT->dataType() && zT->isR()) {
+                BUILD_SINGLE_SELECTOR(zT->dataType(), done = stridedBatchedMatmul_, (xT, yT, zT), FLOAT_TYPES);
+            }
+
+            if (done) {
+                if(xT != x)
+                    delete xT;
+                if(yT != y)
+                    delete yT;
+                return;
+            }
+
             const int batchRank = xRank - 2;
             std::vector<int> dimsToExclude(batchRank);
             for(int i = 0; i < batchRank; ++i)
@@ -776,6 +1069,7 @@ NDArray* MmulHelper::simpleMMul(const NDArray* a, const NDArray* b, NDArray* c,
 
     BUILD_TRIPLE_TEMPLATE(template nd4j::NDArray* MmulHelper::mmulMxM, (nd4j::NDArray* A, nd4j::NDArray* B, nd4j::NDArray* C, double alpha, double beta), LIBND4J_TYPES, FLOAT_TYPES, FLOAT_TYPES);
     BUILD_TRIPLE_TEMPLATE(template nd4j::NDArray* MmulHelper::mmulMxV, (nd4j::NDArray* A, nd4j::NDArray* B, nd4j::NDArray* C, double alpha, double beta), LIBND4J_TYPES, FLOAT_TYPES, FLOAT_TYPES);
+    BUILD_SINGLE_TEMPLATE(template void MmulHelper::gemmBatched, (const bool transA, const bool transB, const int M, const int N, const int K, const void* vAlphas, void** vA, const int lda, void** vB, const int ldb, const void* vBetas, void** vC, const int ldc, const int batchSize), FLOAT_TYPES);
     BUILD_TRIPLE_TEMPLATE(template void MmulHelper::_dot, (void* vA, void* vB, void* vC, Nd4jLong length), LIBND4J_TYPES, FLOAT_TYPES, FLOAT_TYPES);
 }
 
@@ -0,0 +1,129 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <helpers/ShapeCache.h>
+#include <helpers/shape.h>
+#include <Environment.h>
+
+namespace nd4j {
+    ShapeCache::ShapeCache() {
+        _hits.store(0);
+        _misses.store(0);
+    }
+
+    ShapeCache::ShapePack ShapeCache::lookup(const ShapeListDescriptor &descriptor) {
+        if (nd4j::Environment::getInstance()->shapeCacheLimit() < 1)
+            return nullptr;
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            auto it = _cache.find(descriptor);
+            if (it != _cache.end()) {
+                // moving entry to the head of LRU list
+                _lru.splice(_lru.begin(), _lru, it->second.second);
+
+                if (it->second.first != nullptr) {
+                    _hits++;
+                    _totalHits++;
+                    return it->second.first;
+                }
+            }
+        }
+
+        _misses++;
+        _totalMisses++;
+
+        return nullptr;
+    }
+
+    void ShapeCache::store(const ShapeListDescriptor &descriptor, ShapeList &shapes) {
+        const Nd4jLong limit = nd4j::Environment::getInstance()->shapeCacheLimit();
+        if (limit < 1)
+            return;
+
+        // copies are made outside of lock, shape functions may return workspace-allocated shapeInfos
+        auto pack = std::make_shared<std::vector<std::vector<Nd4jLong>>>();
+        for (int e = 0; e < shapes.size(); e++) {
+            auto shapeInfo = shapes.at(e);
+            pack->emplace_back(shapeInfo, shapeInfo + shape::shapeInfoLength(shapeInfo));
+        }
+
+        insert(descriptor, pack, limit);
+    }
+
+    void ShapeCache::reject(const ShapeListDescriptor &descriptor) {
+        const Nd4jLong limit = nd4j::Environment::getInstance()->shapeCacheLimit();
+        if (limit < 1)
+            return;
+
+        insert(descriptor, nullptr, limit);
+    }
+
+    void ShapeCache::insert(const ShapeListDescriptor &descriptor, const ShapePack &pack, Nd4jLong limit) {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        // another thread could have stored the same descriptor already
+        if (_cache.find(descriptor) != _cache.end())
+            return;
+
+        _lru.push_front(descriptor);
+        _cache.emplace(descriptor, std::make_pair(pack, _lru.begin()));
+
+        evict(limit);
+    }
+
+    void ShapeCache::evict(Nd4jLong limit) {
+        // shapes still used by someone won't be released, since they are shared
+        while (static_cast<Nd4jLong>(_lru.size()) > limit) {
+            _cache.erase(_lru.back());
+            _lru.pop_back();
+        }
+    }
+
+    Nd4jLong ShapeCache::cachedEntries() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return static_cast<Nd4jLong>(_cache.size());
+    }
+
+    Nd4jLong ShapeCache::hits() {
+        return _hits.load();
+    }
+
+    Nd4jLong ShapeCache::misses() {
+        return _misses.load();
+    }
+
+    void ShapeCache::purge() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _cache.clear();
+        _lru.clear();
+
+        _hits.store(0);
+        _misses.store(0);
+    }
+
+    Nd4jLong ShapeCache::totalHits() {
+        return _totalHits.load();
+    }
+
+    Nd4jLong ShapeCache::totalMisses() {
+        return _totalMisses.load();
+    }
+
+    std::atomic<Nd4jLong> ShapeCache::_totalHits(0);
+    std::atomic<Nd4jLong> ShapeCache::_totalMisses(0);
+}
@@ -22,6 +22,8 @@
 #include <op_boilerplate.h>
 #include <types/types.h>
 #include "../legacy_ops.h"
+#include <helpers/ConstantTadHelper.h>
+#include <helpers/StridedIterator.h>
 
 using namespace simdOps;
 
@@ -82,9 +84,9 @@ Nd4jLong IndexReduce<X>::execScalar(void *vx, Nd4jLong *xShapeInfo, void *vextra
             auto local = OpType::startingIndexValue(x);
             auto threadNum = omp_get_thread_num();                    
             Nd4jLong threadOffset = info.getThreadOffset(threadNum);     
-            #pragma omp simd
+            nd4j::StridedIterator xIt(xShapeInfo, threadOffset);
             for (Nd4jLong i = 0; i < info.getItersPerThread(threadNum); i++) {            
-                IndexValue<X> curr(x[shape::getIndexOffset(threadOffset + i, xShapeInfo, len)], threadOffset + i);
+                IndexValue<X> curr(x[xIt.next()], threadOffset + i);
                 local = OpType::update(local, curr, extraParams);
             }
             #pragma omp critical
@@ -117,20 +119,15 @@ void IndexReduce<X>::exec(void *vx, Nd4jLong *xShapeInfo,
 
     auto tadOnlyShapeInfo = tadShapeInfo;
     Nd4jLong *tadOffsets = tadOffset;
-    shape::TAD *tad = nullptr;
+    nd4j::TadPack tadPack;
 
     if (tadOnlyShapeInfo == nullptr || tadOffsets == nullptr) {
-        tad = new shape::TAD(xShapeInfo, dimension, dimensionLength);
-        tad->createTadOnlyShapeInfo();
-        tad->createOffsets();
-
-        if (tad->dimensionLength < 1) {
-            delete tad;
+        if (dimensionLength < 1)
             return;
-        }
 
-        tadOnlyShapeInfo = tad->tadOnlyShapeInfo;
-        tadOffsets = tad->tadOffsets;
+        tadPack = nd4j::ConstantTadHelper::getInstance()->tadForDimensions(xShapeInfo, dimension, dimensionLength);
+        tadOnlyShapeInfo = tadPack.primaryShapeInfo();
+        tadOffsets = tadPack.primaryOffsets();
     }
 
     auto tadEws = shape::elementWiseStride(tadOnlyShapeInfo);
@@ -147,9 +144,9 @@ void IndexReduce<X>::exec(void *vx, Nd4jLong *xShapeInfo,
             auto offset = tadOffsets[i];
             auto indexValue = OpType::startingIndexValue(&x[offset]);
 
-            #pragma omp simd
+            nd4j::StridedIterator xIt(tadOnlyShapeInfo);
             for(int j = 0; j < tadLength; j++) {
-                auto xOffset = offset + shape::getIndexOffset(j, tadOnlyShapeInfo, tadLength);
+                auto xOffset = offset + xIt.next();
                 IndexValue<X> comp(x[xOffset], j);
                 indexValue = OpType::update(indexValue,comp,extraParams);
             }
@@ -25,6 +25,7 @@
 #include <helpers/shape.h>
 #include <op_boilerplate.h>
 #include <OmpLaunchHelper.h>
+#include <helpers/StridedIterator.h>
 
 using namespace simdOps;
 
@@ -165,10 +166,11 @@ namespace functions {
                         auto threadNum = omp_get_thread_num();
                         Nd4jLong threadOffset = info.getThreadOffset(threadNum);        
                      
-                        #pragma omp simd
-                        for(Nd4jLong i = 0; i < info.getItersPerThread(threadNum); i++)  {
-                            auto xOffset = shape::getIndexOffset(i+threadOffset, xShapeInfo, n);
-                            auto zOffset = shape::getIndexOffset(i+threadOffset, zShapeInfo, n);
+                        nd4j::StridedIterator xIt(xShapeInfo, threadOffset);
+                        nd4j::StridedIterator zIt(zShapeInfo, threadOffset);
+                        for (Nd4jLong i = 0; i < info.getItersPerThread(threadNum); i++)  {
+                            auto xOffset = xIt.next();
+                            auto zOffset = zIt.next();
                             z[zOffset] = OpType::op(x[xOffset], y[0], extraParams);
                         }
                     }
@@ -199,10 +201,11 @@ namespace functions {
                         auto threadNum = omp_get_thread_num();
                         Nd4jLong threadOffset = info.getThreadOffset(threadNum);        
                      
-                        #pragma omp simd
+                        nd4j::StridedIterator xIt(xShapeInfo, threadOffset);
+                        nd4j::StridedIterator yIt(yShapeInfo, threadOffset);
                         for (Nd4jLong i = 0; i < info.getItersPerThread(threadNum); i++)  {
-                            auto xOffset = shape::getIndexOffset(i+threadOffset, xShapeInfo, n);
-                            auto yOffset = shape::getIndexOffset(i+threadOffset, yShapeInfo, n);
+                            auto xOffset = xIt.next();
+                            auto yOffset = yIt.next();
                             z[xOffset] = OpType::op(x[xOffset], y[yOffset], extraParams);
                         }
                     }
@@ -214,11 +217,13 @@ namespace functions {
                         auto threadNum = omp_get_thread_num();
                         Nd4jLong threadOffset = info.getThreadOffset(threadNum);        
                      
-                        #pragma omp simd
+                        nd4j::StridedIterator xIt(xShapeInfo, threadOffset);
+                        nd4j::StridedIterator yIt(yShapeInfo, threadOffset);
+                        nd4j::StridedIterator zIt(zShapeInfo, threadOffset);
                         for (Nd4jLong i = 0; i < info.getItersPerThread(threadNum); i++)  {
-                            auto xOffset = shape::getIndexOffset(i+threadOffset, xShapeInfo, n);
-                            auto yOffset = shape::getIndexOffset(i+threadOffset, yShapeInfo, n);
-                            auto zOffset = shape::getIndexOffset(i+threadOffset, zShapeInfo, n);
+                            auto xOffset = xIt.next();
+                            auto yOffset = yIt.next();
+                            auto zOffset = zIt.next();
                             z[zOffset] = OpType::op(x[xOffset], y[yOffset], extraParams);
                         }
                     }
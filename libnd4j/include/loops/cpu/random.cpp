@@ -23,6 +23,7 @@
 #include <op_boilerplate.h>
 #include <loops/random.h>
 #include <OmpLaunchHelper.h>
+#include <helpers/StridedIterator.h>
 
 using namespace randomOps;
 
@@ -96,11 +97,13 @@ namespace functions {
                     auto threadNum = omp_get_thread_num();
                     Nd4jLong threadOffset = info.getThreadOffset(threadNum);        
                      
-                    #pragma omp simd
+                    nd4j::StridedIterator xIt(xShapeInfo, threadOffset);
+                    nd4j::StridedIterator yIt(yShapeInfo, threadOffset);
+                    nd4j::StridedIterator zIt(zShapeInfo, threadOffset);
                     for (Nd4jLong i = 0; i < info.getItersPerThread(threadNum); i++)  {
-                        auto xOffset2 = shape::getIndexOffset(i+threadOffset, xShapeInfo, length);
-                        auto yOffset2 = shape::getIndexOffset(i+threadOffset, yShapeInfo, length);
-                        auto zOffset2 = shape::getIndexOffset(i+threadOffset, zShapeInfo, length);
+                        auto xOffset2 = xIt.next();
+                        auto yOffset2 = yIt.next();
+                        auto zOffset2 = zIt.next();
 
                         z[zOffset2] = OpClass::op(x[xOffset2], y[yOffset2], i, length, rng, extraArguments);
                     }
@@ -168,10 +171,11 @@ namespace functions {
                     auto threadNum = omp_get_thread_num();
                     Nd4jLong threadOffset = info.getThreadOffset(threadNum);        
                      
-                    #pragma omp simd
+                    nd4j::StridedIterator xIt(xShapeInfo, threadOffset);
+                    nd4j::StridedIterator zIt(zShapeInfo, threadOffset);
                     for (Nd4jLong i = 0; i < info.getItersPerThread(threadNum); i++)  {
-                        auto xOffset2 = shape::getIndexOffset(i+threadOffset, xShapeInfo, length);
-                        auto zOffset2 = shape::getIndexOffset(i+threadOffset, zShapeInfo, length);
+                        auto xOffset2 = xIt.next();
+                        auto zOffset2 = zIt.next();
 
                         z[zOffset2] = OpClass::op(x[xOffset2], i, length, rng, extraArguments);
                     }
@@ -231,9 +235,9 @@ namespace functions {
                     auto threadNum = omp_get_thread_num();
                     Nd4jLong threadOffset = info.getThreadOffset(threadNum);        
                      
-                    #pragma omp simd
+                    nd4j::StridedIterator zIt(zShapeInfo, threadOffset);
                     for (Nd4jLong i = 0; i < info.getItersPerThread(threadNum); i++)  {                        
-                        auto zOffset2 = shape::getIndexOffset(i+threadOffset, zShapeInfo, length);
+                        auto zOffset2 = zIt.next();
                         z[zOffset2] = OpClass::op(i+threadOffset, length, rng, extraArguments);
                     }
                 }
@@ -24,6 +24,8 @@
 #include <loops/reduce_bool.h>
 #include <loops/legacy_ops.h>
 #include <OmpLaunchHelper.h>
+#include <helpers/ConstantTadHelper.h>
+#include "../reduce_loops.hpp"
 
 using namespace simdOps;
 
@@ -40,21 +42,7 @@ namespace functions {
             auto z = reinterpret_cast<Z *>(vz);
             auto extraParams = reinterpret_cast<X *>(vextraParams);
 
-            const Nd4jLong length = shape::length(xShapeInfo);
-            auto xEws = shape::elementWiseStride(xShapeInfo);
-            
-            if (xEws >= 1) {
-                z[0] = execScalar<OpType>(x, xEws, length, extraParams);
-            }
-            else {
-
-                X start = OpType::startingValue(x);
-
-                for(Nd4jLong i = 0; i < length; ++i)                     
-                    start = OpType::update(start, OpType::op(x[shape::getIndexOffset(i, xShapeInfo, length)], extraParams), extraParams);                
-
-                z[0] = OpType::postProcess(start, shape::length(xShapeInfo), extraParams);
-            }
+            z[0] = ReduceLoops<X, Z, X, OpType>::reduceScalar(x, xShapeInfo, shape::elementWiseStride(xShapeInfo), shape::length(xShapeInfo), extraParams);
         }
 
 
@@ -65,21 +53,7 @@ namespace functions {
                 auto x = reinterpret_cast<X *>(vx);
                 auto extraParams = reinterpret_cast<X *>(vextraParams);
 
-                const Nd4jLong length = shape::length(xShapeInfo);
-                auto xEws = shape::elementWiseStride(xShapeInfo);
-                
-                if (xEws >= 1) {
-                    return execScalar<OpType>(x, xEws, length, extraParams);
-                }
-                else {
-
-                    X start = OpType::startingValue(x);
-
-                    for(Nd4jLong i = 0; i < length; ++i)                     
-                        start = OpType::update(start, OpType::op(x[shape::getIndexOffset(i, xShapeInfo, length)], extraParams), extraParams);                                                    
-                    
-                    return OpType::postProcess(start, shape::length(xShapeInfo), extraParams);
-                }
+                return ReduceLoops<X, Z, X, OpType>::reduceScalar(x, xShapeInfo, shape::elementWiseStride(xShapeInfo), shape::length(xShapeInfo), extraParams);
             }
 
         template <typename X, typename Y>
@@ -144,71 +118,22 @@ namespace functions {
 
                 auto tadOnlyShapeInfo = tadShapeInfo;
                 auto tadOffsets = tadOffset;
-                shape::TAD *tad = nullptr;
+                nd4j::TadPack tadPack;
 
                 if (tadOnlyShapeInfo == nullptr || tadOffsets == nullptr) {
-                    tad = new shape::TAD(xShapeInfo, dimension, dimensionLength);
-                    tad->createTadOnlyShapeInfo();
-                    tad->createOffsets();
-
-                    if (tad->dimensionLength < 1) {
-                        delete tad;
+                    if (dimensionLength < 1)
                         return;
-                    }
 
-                    tadOnlyShapeInfo = tad->tadOnlyShapeInfo;
-                    tadOffsets = tad->tadOffsets;
+                    tadPack = nd4j::ConstantTadHelper::getInstance()->tadForDimensions(xShapeInfo, dimension, dimensionLength);
+                    tadOnlyShapeInfo = tadPack.primaryShapeInfo();
+                    tadOffsets = tadPack.primaryOffsets();
                 }
 
 
                 const auto tadLength = shape::tadLength(xShapeInfo, dimension, dimensionLength);
-                auto numTads = shape::length(xShapeInfo) / tadLength;
-                auto tadEWS = shape::elementWiseStride(tadOnlyShapeInfo);
-
-   //             int tadsPerThread = resultLength / TAD_THRESHOLD;
-  //              int num_threads = nd4j::math::nd4j_max<int>(1, tadsPerThread);
-    //            num_threads = nd4j::math::nd4j_min<int>(num_threads, omp_get_max_threads());
-
-                if (tadEWS > 0 && (numTads == 1 || shape::isVector(tadOnlyShapeInfo) || shape::isScalar(tadOnlyShapeInfo))) {
-
-//#pragma omp parallel for schedule(guided) num_threads(num_threads) if (num_threads > 1) proc_bind(AFFINITY) default(shared)
-                    for (int i = 0; i < resultLength; i++) {
-                        auto iter = x + tadOffsets[i];
-                        auto start = OpType::startingValue(iter);
-                        if (tadEWS == 1) {
+                const auto tadEws = resultLength == 1 || shape::isVector(tadOnlyShapeInfo) || shape::isScalar(tadOnlyShapeInfo) ? shape::elementWiseStride(tadOnlyShapeInfo) : 0;
 
-// FIXME: proper reduction should be used here
-                            for (int j = 0; j < tadLength; j++) {
-                                start = OpType::update(start, OpType::op(iter[j], extraParams), extraParams);
-
-                            }
-                        }
-                        else {
-// FIXME: proper reduction to be used here
-                            for (int j = 0; j < tadLength; j++) {
-                                start = OpType::update(start, OpType::op(iter[j * tadEWS], extraParams), extraParams);
-                            }
-                        }
-                        z[i] = OpType::postProcess(start, tadLength, extraParams);
-                    }
-                }
-                else {
-
-//#pragma omp  parallel for schedule(guided) num_threads(num_threads) if (num_threads > 1) proc_bind(AFFINITY) default(shared)
-                    for (int i = 0; i < resultLength; i++) {
-
-                        auto offset = tadOffsets[i];
-                        auto start = OpType::startingValue(x + offset);
-
-                        for (int j = 0; j < tadLength; j++) {                 
-                            auto xOffset = offset + shape::getIndexOffset(j, tadOnlyShapeInfo, tadLength);
-                            start = OpType::update(start, OpType::op(x[xOffset], extraParams), extraParams);
-                        }
-                        z[i] = OpType::postProcess(start, tadLength, extraParams);;
-                    }
-                }
-                if (tad != nullptr)
-                    delete tad;
+                ReduceLoops<X, Z, X, OpType>::reduceTads(x, tadOnlyShapeInfo, tadOffsets, tadEws, resultLength, tadLength, z, extraParams);
             }
 
 
@@ -231,44 +156,7 @@ namespace functions {
                 auto x = reinterpret_cast<X *>(vx);
                 auto extraParams = reinterpret_cast<X *>(vextraParams);
 
-                auto startingVal = OpType::startingValue(x);
-                nd4j::OmpLaunchHelper info(length);
-
-                if (xEws == 1) {
-                                           
-                    #pragma omp parallel num_threads(info._numThreads) if (info._numThreads > 1) default(shared)
-                    {                
-                        auto local = OpType::startingValue(x);
-                        auto threadNum = omp_get_thread_num();                    
-                        Nd4jLong threadOffset = info.getThreadOffset(threadNum);
-                        auto xi = x + threadOffset;
-
-                        #pragma omp simd
-                        for (Nd4jLong i = 0; i < info.getItersPerThread(threadNum); i++)                                
-                            local = OpType::update(local, OpType::op(xi[i], extraParams), extraParams);
-                            
-                        #pragma omp critical
-                        startingVal = OpType::update(startingVal, local, extraParams);        
-                    }
-                }
-                else {
-
-                    #pragma omp parallel num_threads(info._numThreads) if (info._numThreads > 1) default(shared)
-                    {                
-                        auto local = OpType::startingValue(x);
-                        auto threadNum = omp_get_thread_num();                    
-                        Nd4jLong threadOffset = info.getThreadOffset(threadNum);
-                        auto xi = x + xEws*threadOffset;
-
-                        #pragma omp simd
-                        for (Nd4jLong i = 0; i < info.getItersPerThread(threadNum); i++)                                
-                            local = OpType::update(local, OpType::op(xi[i*xEws], extraParams), extraParams);
-                            
-                        #pragma omp critical
-                        startingVal = OpType::update(startingVal, local, extraParams);        
-                    }                    
-                }
-                return OpType::postProcess(startingVal, length, extraParams);
+                return ReduceLoops<X, Z, X, OpType>::reduceScalar(x, nullptr, xEws, length, extraParams);
             }
 
 
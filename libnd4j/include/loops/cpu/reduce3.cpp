@@ -22,6 +22,8 @@
 #include <op_boilerplate.h>
 #include <loops/reduce3.h>
 #include <loops/legacy_ops.h>
+#include <helpers/ConstantTadHelper.h>
+#include <helpers/StridedIterator.h>
 
 using namespace simdOps;
 
@@ -74,9 +76,11 @@ void Reduce3<X,Z>::execScalar(void *vx, Nd4jLong *xShapeInfo,
 
     }
     else {
+        nd4j::StridedIterator xIt(xShapeInfo);
+        nd4j::StridedIterator yIt(yShapeInfo);
         for(unsigned int i = 0 ;i < length; i++) {
-            auto offset  = shape::getIndexOffset(i, xShapeInfo, length);
-            auto yOffset = shape::getIndexOffset(i, yShapeInfo, length);
+            auto offset  = xIt.next();
+            auto yOffset = yIt.next();
             startingVal = OpType::update(startingVal, OpType::op(x[offset], y[yOffset], extraParamsVals), extraParamsVals);
         }
     }
@@ -148,13 +152,8 @@ void Reduce3<X,Z>::exec(void *vx, Nd4jLong *xShapeInfo,
         
         auto startingVal = OpType::startingValue(x);        
         
-        shape::TAD xTad(xShapeInfo, dimension, dimensionLength);
-        xTad.createTadOnlyShapeInfo();
-        xTad.createOffsets();
-
-        shape::TAD yTad(yShapeInfo, dimension, dimensionLength);
-        yTad.createTadOnlyShapeInfo();
-        yTad.createOffsets();
+        auto xTad = nd4j::ConstantTadHelper::getInstance()->tadForDimensions(xShapeInfo, dimension, dimensionLength);
+        auto yTad = nd4j::ConstantTadHelper::getInstance()->tadForDimensions(yShapeInfo, dimension, dimensionLength);
 
         /**
         * The element wise stride belong longs to a reduction index.
@@ -167,8 +166,8 @@ void Reduce3<X,Z>::exec(void *vx, Nd4jLong *xShapeInfo,
         */
         int largerElementWiseStride;
         int smallerElementWiseStride;
-        auto xEws = shape::elementWiseStride(xTad.tadOnlyShapeInfo);
-        auto yEws = shape::elementWiseStride(yTad.tadOnlyShapeInfo);
+        auto xEws = shape::elementWiseStride(xTad.primaryShapeInfo());
+        auto yEws = shape::elementWiseStride(yTad.primaryShapeInfo());
         int tadLength;
         Nd4jLong xModLength;
         Nd4jLong yModLength;
@@ -176,8 +175,8 @@ void Reduce3<X,Z>::exec(void *vx, Nd4jLong *xShapeInfo,
         bool xTadBigger;
         
         if(shape::length(xShapeInfo) > shape::length(yShapeInfo)) {
-            tadLength = shape::length(xTad.tadOnlyShapeInfo);
-            iterationTadInfo = xTad.tadOnlyShapeInfo;
+            tadLength = shape::length(xTad.primaryShapeInfo());
+            iterationTadInfo = xTad.primaryShapeInfo();
             largerElementWiseStride = shape::elementWiseStride(xShapeInfo);
             smallerElementWiseStride = shape::elementWiseStride(yShapeInfo);
             xModLength = 1;
@@ -185,8 +184,8 @@ void Reduce3<X,Z>::exec(void *vx, Nd4jLong *xShapeInfo,
             xTadBigger = true;
         }
         else {
-            tadLength = shape::length(yTad.tadOnlyShapeInfo);
-            iterationTadInfo = yTad.tadOnlyShapeInfo;
+            tadLength = shape::length(yTad.primaryShapeInfo());
+            iterationTadInfo = yTad.primaryShapeInfo();
             largerElementWiseStride = shape::elementWiseStride(yShapeInfo);
             smallerElementWiseStride = shape::elementWiseStride(xShapeInfo);
             xModLength = tadLength;
@@ -209,8 +208,8 @@ void Reduce3<X,Z>::exec(void *vx, Nd4jLong *xShapeInfo,
                     for (int extraParamsIdx = 0; extraParamsIdx < OpType::extraParamsLen; extraParamsIdx++) 
                         localExtraParams[extraParamsIdx] = startingVal;
                                 
-                    Nd4jLong offset = xTad.tadOffsets[i];
-                    Nd4jLong yOffset = yTad.tadOffsets[i];
+                    Nd4jLong offset = xTad.primaryOffsets()[i];
+                    Nd4jLong yOffset = yTad.primaryOffsets()[i];
                     z[i] = OpType::op(x[offset], y[yOffset], localExtraParams);
                     
                     for (int j = 1; j < tadLength; j++) {
@@ -234,16 +233,18 @@ void Reduce3<X,Z>::exec(void *vx, Nd4jLong *xShapeInfo,
 //#pragma omp  parallel for schedule(guided) num_threads(num_threads) if (num_threads > 1) proc_bind(AFFINITY) default(shared)
                 for (int i = 0; i < zLen; i++) {
                 
-                    Nd4jLong xOffset = xTadBigger ? xTad.tadOffsets[i] : 0;
-                    Nd4jLong yOffset = !xTadBigger ? yTad.tadOffsets[i] : 0;
-                    auto xShapeInf = xTadBigger ? xTad.tadOnlyShapeInfo : xShapeInfo;
-                    auto yShapeInf = !xTadBigger ? yTad.tadOnlyShapeInfo : yShapeInfo;
+                    Nd4jLong xOffset = xTadBigger ? xTad.primaryOffsets()[i] : 0;
+                    Nd4jLong yOffset = !xTadBigger ? yTad.primaryOffsets()[i] : 0;
+                    auto xShapeInf = xTadBigger ? xTad.primaryShapeInfo() : xShapeInfo;
+                    auto yShapeInf = !xTadBigger ? yTad.primaryShapeInfo() : yShapeInfo;
                     auto start = OpType::startingValue(x);
 
+                    nd4j::StridedIterator xIt(xShapeInf);
+                    nd4j::StridedIterator yIt(yShapeInf);
                     for (int j = 0; j < tadLength; j++) {
                     
-                        int xOffset2 =  xOffset + shape::getIndexOffset(j, xShapeInf, tadLength);
-                        int yOffset2 =  yOffset + shape::getIndexOffset(j, yShapeInf, tadLength);                                    
+                        auto xOffset2 =  xOffset + xIt.next();
+                        auto yOffset2 =  yOffset + yIt.next();
                         start = OpType::update(start, OpType::op(x[xOffset2], y[yOffset2],extraParams), extraParamsVals);
                     }
 
@@ -253,13 +254,8 @@ void Reduce3<X,Z>::exec(void *vx, Nd4jLong *xShapeInfo,
         } 
         else {
         
-            shape::TAD xTad(xShapeInfo, dimension, dimensionLength);
-            xTad.createTadOnlyShapeInfo();
-            xTad.createOffsets();
-
-            shape::TAD yTad(yShapeInfo, dimension, dimensionLength);
-            yTad.createTadOnlyShapeInfo();
-            yTad.createOffsets();
+            auto xTad = nd4j::ConstantTadHelper::getInstance()->tadForDimensions(xShapeInfo, dimension, dimensionLength);
+            auto yTad = nd4j::ConstantTadHelper::getInstance()->tadForDimensions(yShapeInfo, dimension, dimensionLength);
             int tadsPerThread = zLen / TAD_THRESHOLD;
             int num_threads = nd4j::math::nd4j_max<int>(1, tadsPerThread);
             num_threads = nd4j::math::nd4j_min<int>(num_threads, omp_get_max_threads());
@@ -267,13 +263,15 @@ void Reduce3<X,Z>::exec(void *vx, Nd4jLong *xShapeInfo,
 //#pragma omp  parallel for schedule(guided) num_threads(num_threads) if (num_threads > 1) proc_bind(AFFINITY) default(shared) private(coord)
             for (int i = 0; i < zLen; i++) {
                 
-                Nd4jLong xOffset = xTad.tadOffsets[i];
-                Nd4jLong yOffset = yTad.tadOffsets[i];
+                Nd4jLong xOffset = xTad.primaryOffsets()[i];
+                Nd4jLong yOffset = yTad.primaryOffsets()[i];
                 auto start = OpType::startingValue(x + xOffset);
                 
+                nd4j::StridedIterator xIt(xTad.primaryShapeInfo());
+                nd4j::StridedIterator yIt(yTad.primaryShapeInfo());
                 for (int j = 0; j < tadLength; j++) {
-                    Nd4jLong xOffset2 = xOffset + shape::getIndexOffset(j, xTad.tadOnlyShapeInfo, tadLength);
-                    Nd4jLong yOffset2 = yOffset + shape::getIndexOffset(j, yTad.tadOnlyShapeInfo, tadLength);
+                    Nd4jLong xOffset2 = xOffset + xIt.next();
+                    Nd4jLong yOffset2 = yOffset + yIt.next();
                     start = OpType::update(start, OpType::op(x[xOffset2], y[yOffset2],extraParamsVals), extraParamsVals);
                 }
 
@@ -315,10 +313,12 @@ void Reduce3<X,Z>::exec(void *vx, Nd4jLong *xShapeInfo,
         for (int extraParamsIdx = 0; extraParamsIdx < OpType::extraParamsLen; extraParamsIdx++) 
             localExtraParams[extraParamsIdx] = startingVal;                    
 
+        nd4j::StridedIterator xIt(tadShapeInfo);
+        nd4j::StridedIterator yIt(yShapeInfo);
         for (Nd4jLong f = 0; f < tadLength; f++) {
 
-            auto xOffset = offset + shape::getIndexOffset(f, tadShapeInfo, tadLength);
-            auto yOffset = shape::getIndexOffset(f, yShapeInfo,   tadLength);                        
+            auto xOffset = offset + xIt.next();
+            auto yOffset = yIt.next();
             z[r] = OpType::update(z[r], OpType::op(x[xOffset], y[yOffset], localExtraParams), localExtraParams);
         }
 
@@ -372,9 +372,11 @@ void Reduce3<X,Z>:: execAll(void *vx, Nd4jLong *xShapeInfo,
             for (int extraParamsIdx = 0; extraParamsIdx < OpType::extraParamsLen; extraParamsIdx++) 
                 localExtraParams[extraParamsIdx] = startingVal;
 
+            nd4j::StridedIterator xIt(xTadShapeInfo);
+            nd4j::StridedIterator yIt(yTadShapeInfo);
             for (int f = 0; f < xTadLength; f++) {                            
-                auto xO = shape::getIndexOffset(f, xTadShapeInfo, xTadLength);
-                auto yO = shape::getIndexOffset(f, yTadShapeInfo, xTadLength);
+                auto xO = xIt.next();
+                auto yO = yIt.next();
                 z[ri] = OpType::update(z[ri], OpType::op(lX[xO], lY[yO], localExtraParams), localExtraParams);
             }
 
@@ -0,0 +1,152 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_REDUCE_LOOPS_HPP
+#define LIBND4J_REDUCE_LOOPS_HPP
+
+#include <op_boilerplate.h>
+#include <helpers/shape.h>
+#include <OmpLaunchHelper.h>
+#include <helpers/StridedIterator.h>
+#include <templatemath.h>
+
+namespace functions {
+    namespace reduce {
+
+        /**
+         * Reduction engine shared by ReduceFloat/Same/Bool/Long functions. E is type of extraParams of given family.
+         *
+         * Ranges are reduced with 4 independent accumulators, and ranges longer than PAIRWISE_BLOCK are split in halves
+         * which are reduced separately and combined with OpType::update, so rounding error grows with log of length.
+         * TADs are distributed between threads when there are enough of them, otherwise every TAD is split into chunks.
+         * Partial results are always combined in the same order, so result doesn't depend on thread scheduling.
+         */
+        template <typename X, typename Z, typename E, typename OpType>
+        class ReduceLoops {
+        public:
+            static const Nd4jLong PAIRWISE_BLOCK = 1024;
+
+            /**
+             * Reduces elements [start, stop) of TAD, without postProcess. TADs with tadEws < 1 are iterated via shape info
+             */
+            static Z reduceRange(X *tad, const Nd4jLong *tadShapeInfo, const Nd4jLong tadEws, const Nd4jLong tadLength, const Nd4jLong start, const Nd4jLong stop, E *extraParams) {
+                if (stop - start > PAIRWISE_BLOCK) {
+                    const auto middle = start + (stop - start) / 2;
+                    auto left = reduceRange(tad, tadShapeInfo, tadEws, tadLength, start, middle, extraParams);
+                    auto right = reduceRange(tad, tadShapeInfo, tadEws, tadLength, middle, stop, extraParams);
+
+                    return OpType::update(left, right, extraParams);
+                }
+
+                X *x = tadEws > 0 ? tad + start * tadEws : tad;
+                Z acc0 = OpType::startingValue(x);
+                Z acc1 = acc0;
+                Z acc2 = acc0;
+                Z acc3 = acc0;
+
+                const Nd4jLong length = stop - start;
+                Nd4jLong e = 0;
+
+                if (tadEws == 1) {
+                    for (; e + 4 <= length; e += 4) {
+                        acc0 = OpType::update(acc0, OpType::op(x[e], extraParams), extraParams);
+                        acc1 = OpType::update(acc1, OpType::op(x[e + 1], extraParams), extraParams);
+                        acc2 = OpType::update(acc2, OpType::op(x[e + 2], extraParams), extraParams);
+                        acc3 = OpType::update(acc3, OpType::op(x[e + 3], extraParams), extraParams);
+                    }
+
+                    for (; e < length; e++)
+                        acc0 = OpType::update(acc0, OpType::op(x[e], extraParams), extraParams);
+                }
+                else if (tadEws > 1) {
+                    for (; e + 4 <= length; e += 4) {
+                        acc0 = OpType::update(acc0, OpType::op(x[e * tadEws], extraParams), extraParams);
+                        acc1 = OpType::update(acc1, OpType::op(x[(e + 1) * tadEws], extraParams), extraParams);
+                        acc2 = OpType::update(acc2, OpType::op(x[(e + 2) * tadEws], extraParams), extraParams);
+                        acc3 = OpType::update(acc3, OpType::op(x[(e + 3) * tadEws], extraParams), extraParams);
+                    }
+
+                    for (; e < length; e++)
+                        acc0 = OpType::update(acc0, OpType::op(x[e * tadEws], extraParams), extraParams);
+                }
+                else {
+                    nd4j::StridedIterator it(tadShapeInfo, start);
+                    for (Nd4jLong i = start; i < stop; i++)
+                        acc0 = OpType::update(acc0, OpType::op(x[it.next()], extraParams), extraParams);
+                }
+
+                return OpType::update(OpType::update(acc0, acc1, extraParams), OpType::update(acc2, acc3, extraParams), extraParams);
+            }
+
+            /**
+             * Reduces numTads TADs of tadLength elements each into z. If tadOffsets is nullptr, single TAD starting at x is reduced
+             */
+            static void reduceTads(X *x, const Nd4jLong *tadShapeInfo, const Nd4jLong *tadOffsets, const Nd4jLong tadEws, const Nd4jLong numTads, const Nd4jLong tadLength, Z *z, E *extraParams) {
+                const int numThreads = nd4j::OmpLaunchHelper::betterThreads(numTads * tadLength);
+
+                // enough TADs to keep all threads busy
+                if (numThreads <= 1 || numTads >= numThreads) {
+
+#pragma omp parallel for schedule(guided) num_threads(numThreads) if (numThreads > 1) proc_bind(close) default(shared)
+                    for (Nd4jLong i = 0; i < numTads; i++) {
+                        auto tad = tadOffsets == nullptr ? x : x + tadOffsets[i];
+                        z[i] = OpType::postProcess(reduceRange(tad, tadShapeInfo, tadEws, tadLength, 0, tadLength, extraParams), tadLength, extraParams);
+                    }
+
+                    return;
+                }
+
+                // few long TADs: every TAD is split into chunks, and threads take chunks
+                const Nd4jLong chunksPerTad = (numThreads + numTads - 1) / numTads;
+                const Nd4jLong span = (tadLength + chunksPerTad - 1) / chunksPerTad;
+                const Nd4jLong numChunks = numTads * chunksPerTad;
+                auto partials = new Z[numChunks];
+
+#pragma omp parallel for schedule(static) num_threads(numThreads) proc_bind(close) default(shared)
+                for (Nd4jLong c = 0; c < numChunks; c++) {
+                    const auto i = c / chunksPerTad;
+                    const auto start = (c % chunksPerTad) * span;
+                    const auto stop = nd4j::math::nd4j_min<Nd4jLong>(tadLength, start + span);
+                    auto tad = tadOffsets == nullptr ? x : x + tadOffsets[i];
+
+                    partials[c] = start < stop ? reduceRange(tad, tadShapeInfo, tadEws, tadLength, start, stop, extraParams) : static_cast<Z>(OpType::startingValue(tad));
+                }
+
+                for (Nd4jLong i = 0; i < numTads; i++) {
+                    auto acc = partials[i * chunksPerTad];
+                    for (Nd4jLong c = 1; c < chunksPerTad; c++)
+                        acc = OpType::update(acc, partials[i * chunksPerTad + c], extraParams);
+
+                    z[i] = OpType::postProcess(acc, tadLength, extraParams);
+                }
+
+                delete[] partials;
+            }
+
+            /**
+             * Reduces whole array into single value, postProcess included
+             */
+            static Z reduceScalar(X *x, const Nd4jLong *xShapeInfo, const Nd4jLong xEws, const Nd4jLong length, E *extraParams) {
+                Z result;
+                reduceTads(x, xShapeInfo, nullptr, xEws, 1, length, &result, extraParams);
+
+                return result;
+            }
+        };
+    }
+}
+
+#endif //LIBND4J_REDUCE_LOOPS_HPP
@@ -22,6 +22,7 @@
 #include <op_boilerplate.h>
 #include <types/types.h>
 #include "../legacy_ops.h"
+#include <helpers/StridedIterator.h>
 
 using namespace simdOps;
 
@@ -147,9 +148,9 @@ void ScalarTransform<X, Y, Z>::transform(void *vx, Nd4jLong *xShapeInfo,
                 auto threadNum = omp_get_thread_num();                    
                 Nd4jLong threadOffset = info.getThreadOffset(threadNum);                            
                 auto xi = x + xEws * threadOffset;    
-                #pragma omp simd
+                nd4j::StridedIterator zIt(zShapeInfo, threadOffset);
                 for (Nd4jLong i = 0; i < info.getItersPerThread(threadNum); i++) {
-                    Nd4jLong zOffset = shape::getIndexOffset(i+threadOffset, zShapeInfo, len);
+                    Nd4jLong zOffset = zIt.next();
                     z[zOffset] = OpType::op(xi[i*xEws], scalar, extraParams);
                 }
             }
@@ -161,9 +162,9 @@ void ScalarTransform<X, Y, Z>::transform(void *vx, Nd4jLong *xShapeInfo,
                 auto threadNum = omp_get_thread_num();                    
                 Nd4jLong threadOffset = info.getThreadOffset(threadNum);                            
                 auto zi = z + zEws * threadOffset;    
-                #pragma omp simd
+                nd4j::StridedIterator xIt(xShapeInfo, threadOffset);
                 for (Nd4jLong i = 0; i < info.getItersPerThread(threadNum); i++) {
-                    Nd4jLong xOffset = shape::getIndexOffset(i+threadOffset, xShapeInfo, len);
+                    Nd4jLong xOffset = xIt.next();
                     zi[i*zEws] = OpType::op(x[xOffset], scalar, extraParams);
                 }
             }
@@ -174,9 +175,9 @@ void ScalarTransform<X, Y, Z>::transform(void *vx, Nd4jLong *xShapeInfo,
             {
                 auto threadNum = omp_get_thread_num();                    
                 Nd4jLong threadOffset = info.getThreadOffset(threadNum);                            
-                #pragma omp simd
+                nd4j::StridedIterator xIt(xShapeInfo, threadOffset);
                 for (Nd4jLong i = 0; i < info.getItersPerThread(threadNum); i++) {
-                    Nd4jLong offset = shape::getIndexOffset(i+threadOffset, xShapeInfo, len);
+                    Nd4jLong offset = xIt.next();
                     z[offset] = OpType::op(x[offset], scalar, extraParams);
                 }
             }
@@ -186,10 +187,11 @@ void ScalarTransform<X, Y, Z>::transform(void *vx, Nd4jLong *xShapeInfo,
             {
                 auto threadNum = omp_get_thread_num();                    
                 Nd4jLong threadOffset = info.getThreadOffset(threadNum);                            
-                #pragma omp simd
+                nd4j::StridedIterator xIt(xShapeInfo, threadOffset);
+                nd4j::StridedIterator zIt(zShapeInfo, threadOffset);
                 for (Nd4jLong i = 0; i < info.getItersPerThread(threadNum); i++) {
-                    Nd4jLong xOffset = shape::getIndexOffset(i+threadOffset, xShapeInfo, len);
-                    Nd4jLong zOffset = shape::getIndexOffset(i+threadOffset, zShapeInfo, len);
+                    Nd4jLong xOffset = xIt.next();
+                    Nd4jLong zOffset = zIt.next();
                     z[zOffset] = OpType::op(x[xOffset], scalar, extraParams);
                 }
             }
@@ -23,6 +23,7 @@
 #include <types/types.h>
 
 #include "../legacy_ops.h"
+#include <helpers/StridedIterator.h>
 
 using namespace simdOps;
 
@@ -153,9 +154,9 @@ namespace functions {
                     auto threadNum = omp_get_thread_num();                    
                     Nd4jLong threadOffset = info.getThreadOffset(threadNum);                            
                     auto xi = x + xEws * threadOffset;    
-                    #pragma omp simd
+                    nd4j::StridedIterator zIt(zShapeInfo, threadOffset);
                     for (Nd4jLong i = 0; i < info.getItersPerThread(threadNum); i++) {
-                        Nd4jLong zOffset = shape::getIndexOffset(i+threadOffset, zShapeInfo, len);
+                        Nd4jLong zOffset = zIt.next();
                         z[zOffset] = OpType::op(xi[i*xEws], scalar, extraParams);
                     }
                 }
@@ -167,9 +168,9 @@ namespace functions {
                     auto threadNum = omp_get_thread_num();                    
                     Nd4jLong threadOffset = info.getThreadOffset(threadNum);                            
                     auto zi = z + zEws * threadOffset;    
-                    #pragma omp simd
+                    nd4j::StridedIterator xIt(xShapeInfo, threadOffset);
                     for (Nd4jLong i = 0; i < info.getItersPerThread(threadNum); i++) {
-                        Nd4jLong xOffset = shape::getIndexOffset(i+threadOffset, xShapeInfo, len);
+                        Nd4jLong xOffset = xIt.next();
                         zi[i*zEws] = OpType::op(x[xOffset], scalar, extraParams);
                     }
                 }
@@ -180,9 +181,9 @@ namespace functions {
                 {
                     auto threadNum = omp_get_thread_num();                    
                     Nd4jLong threadOffset = info.getThreadOffset(threadNum);                            
-                    #pragma omp simd
+                    nd4j::StridedIterator xIt(xShapeInfo, threadOffset);
                     for (Nd4jLong i = 0; i < info.getItersPerThread(threadNum); i++) {
-                        Nd4jLong offset = shape::getIndexOffset(i+threadOffset, xShapeInfo, len);
+                        Nd4jLong offset = xIt.next();
                         z[offset] = OpType::op(x[offset], scalar, extraParams);
                     }
                 }
@@ -192,10 +193,11 @@ namespace functions {
                 {
                     auto threadNum = omp_get_thread_num();                    
                     Nd4jLong threadOffset = info.getThreadOffset(threadNum);                            
-                    #pragma omp simd
+                    nd4j::StridedIterator xIt(xShapeInfo, threadOffset);
+                    nd4j::StridedIterator zIt(zShapeInfo, threadOffset);
                     for (Nd4jLong i = 0; i < info.getItersPerThread(threadNum); i++) {
-                        Nd4jLong xOffset = shape::getIndexOffset(i+threadOffset, xShapeInfo, len);
-                        Nd4jLong zOffset = shape::getIndexOffset(i+threadOffset, zShapeInfo, len);
+                        Nd4jLong xOffset = xIt.next();
+                        Nd4jLong zOffset = zIt.next();
                         z[zOffset] = OpType::op(x[xOffset], scalar, extraParams);
                     }
                 }
@@ -23,6 +23,7 @@
 #include <loops/summarystatsreduce.h>
 #include <helpers/shape.h>
 #include <helpers/TAD.h>
+#include <helpers/StridedIterator.h>
 
 using namespace simdOps;
 
@@ -97,9 +98,10 @@ namespace functions {
             }
             else {
 
+                nd4j::StridedIterator xIt(xShapeInfo);
                 for (Nd4jLong i = 0; i < length; i++) {
                                         
-                    auto xOffset = shape::getIndexOffset(i, xShapeInfo, length);
+                    auto xOffset = xIt.next();
 
                     SummaryStatsData<X> curr;
                     curr.initWithValue(x[xOffset]);
@@ -235,9 +237,10 @@ namespace functions {
                         comp.initWithValue(x[tadOffsetForBlock]);
 
 // FIXME: reduction should be fixed
+                        nd4j::StridedIterator xIt(tadShapeShapeInfo, 1);
                         for (int i = 1; i < tadLength; i ++) {                            
                             
-                            auto xOffset = tadOffsetForBlock + shape::getIndexOffset(i, tadShapeShapeInfo, tadLength);
+                            auto xOffset = tadOffsetForBlock + xIt.next();
 
                             SummaryStatsData <X> indexVal2;
                             indexVal2.initWithValue(x[xOffset]);
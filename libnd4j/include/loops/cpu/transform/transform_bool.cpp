@@ -22,6 +22,7 @@
 #include <types/types.h>
 #include <loops/transform_bool.h>
 #include <loops/legacy_ops.h>
+#include <helpers/StridedIterator.h>
 
 using namespace simdOps;
 
@@ -96,9 +97,9 @@ namespace functions {
                             auto threadNum = omp_get_thread_num();                    
                             Nd4jLong threadOffset = info.getThreadOffset(threadNum);                            
                             auto xi = x + xEws * threadOffset;    
-                            #pragma omp simd
+                            nd4j::StridedIterator zIt(zShapeInfo, threadOffset);
                             for (Nd4jLong i = 0; i < info.getItersPerThread(threadNum); i++) {
-                                Nd4jLong zOffset = shape::getIndexOffset(i+threadOffset, zShapeInfo, len);
+                                Nd4jLong zOffset = zIt.next();
                                 z[zOffset] = OpType::op(xi[i*xEws], extraParams);
                             }
                         }
@@ -110,9 +111,9 @@ namespace functions {
                             auto threadNum = omp_get_thread_num();                    
                             Nd4jLong threadOffset = info.getThreadOffset(threadNum);                            
                             auto zi = z + zEws * threadOffset;    
-                            #pragma omp simd
+                            nd4j::StridedIterator xIt(xShapeInfo, threadOffset);
                             for (Nd4jLong i = 0; i < info.getItersPerThread(threadNum); i++) {
-                                Nd4jLong xOffset = shape::getIndexOffset(i+threadOffset, xShapeInfo, len);
+                                Nd4jLong xOffset = xIt.next();
                                 zi[i*zEws] = OpType::op(x[xOffset], extraParams);
                             }
                         }
@@ -123,9 +124,9 @@ namespace functions {
                         {
                             auto threadNum = omp_get_thread_num();                    
                             Nd4jLong threadOffset = info.getThreadOffset(threadNum);                            
-                            #pragma omp simd
+                            nd4j::StridedIterator xIt(xShapeInfo, threadOffset);
                             for (Nd4jLong i = 0; i < info.getItersPerThread(threadNum); i++) {
-                                Nd4jLong offset = shape::getIndexOffset(i+threadOffset, xShapeInfo, len);
+                                Nd4jLong offset = xIt.next();
                                 z[offset] = OpType::op(x[offset], extraParams);
                             }
                         }
@@ -135,10 +136,11 @@ namespace functions {
                         {
                             auto threadNum = omp_get_thread_num();                    
                             Nd4jLong threadOffset = info.getThreadOffset(threadNum);                            
-                            #pragma omp simd
+                            nd4j::StridedIterator xIt(xShapeInfo, threadOffset);
+                            nd4j::StridedIterator zIt(zShapeInfo, threadOffset);
                             for (Nd4jLong i = 0; i < info.getItersPerThread(threadNum); i++) {
-                                Nd4jLong xOffset = shape::getIndexOffset(i+threadOffset, xShapeInfo, len);
-                                Nd4jLong zOffset = shape::getIndexOffset(i+threadOffset, zShapeInfo, len);
+                                Nd4jLong xOffset = xIt.next();
+                                Nd4jLong zOffset = zIt.next();
                                 z[zOffset] = OpType::op(x[xOffset], extraParams);
                             }
                         }
@@ -0,0 +1,48 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_ALLOCATIONCOUNTER_H
+#define LIBND4J_ALLOCATIONCOUNTER_H
+
+#include <pointercast.h>
+#include <dll.h>
+
+namespace nd4j {
+    namespace memory {
+        /**
+         * Counters of bytes allocated by Workspace and ALLOCATE macro, they only grow, so consumers (i.e. OpProfiler) take deltas.
+         * Per-thread counters are always updated, process-wide ones only while at least one consumer asked for them
+         */
+        class ND4J_EXPORT AllocationCounter {
+        public:
+            static void countWorkspaceBytes(Nd4jLong bytes);
+            static void countHeapBytes(Nd4jLong bytes);
+
+            // allocations made by calling thread
+            static Nd4jLong threadWorkspaceBytes();
+            static Nd4jLong threadHeapBytes();
+
+            // allocations made by all threads between startShared() and stopShared() calls
+            static Nd4jLong sharedWorkspaceBytes();
+            static Nd4jLong sharedHeapBytes();
+
+            static void startShared();
+            static void stopShared();
+        };
+    }
+}
+
+#endif //LIBND4J_ALLOCATIONCOUNTER_H
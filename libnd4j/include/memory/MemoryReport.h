@@ -22,6 +22,7 @@
 #define LIBND4J_MEMORYREPORT_H
 
 #include <pointercast.h>
+#include <map>
 
 namespace nd4j {
     namespace memory {
@@ -30,6 +31,9 @@ namespace nd4j {
             Nd4jLong _vm = 0;
             Nd4jLong _rss = 0;
 
+            // resident bytes per NUMA node
+            std::map<int, Nd4jLong> _numa;
+
         public:
             MemoryReport() = default;
             ~MemoryReport() = default;
@@ -46,6 +50,10 @@ namespace nd4j {
 
             Nd4jLong getRSS() const;
             void setRSS(Nd4jLong rss);
+
+            const std::map<int, Nd4jLong>& getNumaBytes() const;
+            Nd4jLong getNumaBytes(int node) const;
+            void setNumaBytes(const std::map<int, Nd4jLong> &bytes);
         };
     }
 }
@@ -28,6 +28,11 @@ namespace nd4j {
         class MemoryUtils {
         public:
             static bool retrieveMemoryStatistics(MemoryReport& report);
+
+            /**
+             * Fills report with resident bytes of given memory per NUMA node. Returns false if this isn't supported
+             */
+            static bool retrieveNumaStatistics(void *ptr, Nd4jLong bytes, MemoryReport& report);
         };
     }
 }
@@ -0,0 +1,92 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_PAGEALLOCATOR_H
+#define LIBND4J_PAGEALLOCATOR_H
+
+#include <pointercast.h>
+#include <dll.h>
+#include <map>
+
+namespace nd4j {
+    namespace memory {
+        /**
+         * Placement of pages over NUMA nodes
+         */
+        enum NumaPolicy {
+            NUMA_DEFAULT = 0,       // whatever OS does, usually node of the thread touching page first
+            NUMA_INTERLEAVE = 1,    // pages are spread round-robin over all online nodes
+            NUMA_LOCAL = 2,         // pages are bound to node of the thread allocating memory
+        };
+
+        enum HugePagesPolicy {
+            HUGE_PAGES_NONE = 0,
+            HUGE_PAGES_TRANSPARENT = 1, // 2MB aligned memory advised for transparent huge pages
+            HUGE_PAGES_EXPLICIT = 2,    // MAP_HUGETLB mapping, falls back to transparent huge pages if pool is empty
+        };
+
+        class ND4J_EXPORT AllocationPolicy {
+        public:
+            NumaPolicy numa = NUMA_DEFAULT;
+            HugePagesPolicy hugePages = HUGE_PAGES_NONE;
+
+            // memory is first touched by all OpenMP threads, each one touching its own contiguous part
+            bool parallelFirstTouch = false;
+
+            AllocationPolicy() = default;
+            AllocationPolicy(NumaPolicy numaPolicy, HugePagesPolicy hugePagesPolicy, bool parallelTouch = false);
+
+            bool isDefault() const;
+        };
+
+        /**
+         * Allocation of big page-aligned buffers with given NUMA and huge pages policy.
+         * Policies are Linux-only, elsewhere memory is just aligned to pages
+         */
+        class ND4J_EXPORT PageAllocator {
+        public:
+            static const Nd4jLong HUGE_PAGE_SIZE = 2L * 1024L * 1024L;
+
+            /**
+             * Allocates memory and optionally zeroes it. Zeroing is done according to policy, so it's the first touch as well.
+             * @param mapped - set to true if memory must be released with mapped = true
+             */
+            static void* allocate(Nd4jLong bytes, const AllocationPolicy &policy, bool zero, bool &mapped);
+            static void release(void *ptr, Nd4jLong bytes, bool mapped);
+
+            /**
+             * Applies policy to memory that's allocated already, i.e. to external workspace. Pages touched already are moved
+             */
+            static void applyPolicy(void *ptr, Nd4jLong bytes, const AllocationPolicy &policy);
+
+            /**
+             * Writes zeroes over given memory, optionally from all OpenMP threads
+             */
+            static void touch(void *ptr, Nd4jLong bytes, bool parallel);
+
+            static int numberOfNodes();
+            static int currentNode();
+
+            /**
+             * Fills result with number of resident bytes of given memory per NUMA node. Pages not touched yet aren't reported.
+             * Returns false if page locations can't be queried on this system
+             */
+            static bool bytesPerNode(void *ptr, Nd4jLong bytes, std::map<int, Nd4jLong> &result);
+        };
+    }
+}
+
+#endif //LIBND4J_PAGEALLOCATOR_H
@@ -26,11 +26,14 @@
 
 #include <atomic>
 #include <vector>
+#include <map>
 #include <mutex>
 #include <dll.h>
 #include <pointercast.h>
 #include <types/float16.h>
 #include <memory/ExternalWorkspace.h>
+#include <memory/PageAllocator.h>
+#include <memory/MemoryReport.h>
 
 namespace nd4j {
     namespace memory {
@@ -42,7 +45,15 @@ namespace nd4j {
             DEVICE,
         };
 
+        /**
+         * Arena allocator. Allocations are 64-byte aligned bump allocations done with atomic CAS on the offset,
+         * so concurrent allocations don't take locks. Whatever doesn't fit goes to spills, which are pooled
+         * and reused in the next cycle instead of being freed
+         */
         class ND4J_EXPORT Workspace {
+        public:
+            static const Nd4jLong ALIGNMENT = 64;
+
         protected:
             char* _ptrHost = nullptr;
             char* _ptrDevice = nullptr;
@@ -50,26 +61,39 @@ namespace nd4j {
             bool _allocatedHost = false;
             bool _allocatedDevice = false;
 
+            // host buffer came from mmap, see PageAllocator
+            bool _mappedHost = false;
+
+            AllocationPolicy _policy;
+
             std::atomic<Nd4jLong> _offset;
 
+            // if non-negative, allocations beyond this offset go to spills
+            std::atomic<Nd4jLong> _limit{-1L};
+
             Nd4jLong _initialSize = 0L;
             Nd4jLong _currentSize = 0L;
 
-            std::mutex _mutexAllocation;
             std::mutex _mutexSpills;
 
             bool _externalized = false;
 
-            std::vector<void*> _spills;
+            // spills of current cycle: pointer and size of chunk
+            std::vector<std::pair<void*, Nd4jLong>> _spills;
+
+            // spills released by previous cycle, available for reuse: size of chunk -> pointer
+            std::multimap<Nd4jLong, void*> _spillsPool;
 
             std::atomic<Nd4jLong> _spillsSize;
             std::atomic<Nd4jLong> _cycleAllocations;
 
             void init(Nd4jLong bytes);
             void freeSpills();
+            void recycleSpills();
+            void* allocateSpill(Nd4jLong numBytes);
         public:
-            explicit Workspace(ExternalWorkspace *external);
-            explicit Workspace(Nd4jLong initialSize = 0);
+            explicit Workspace(ExternalWorkspace *external, const AllocationPolicy &policy = AllocationPolicy());
+            explicit Workspace(Nd4jLong initialSize = 0, const AllocationPolicy &policy = AllocationPolicy());
             ~Workspace();
 
             Nd4jLong getAllocatedSize();
@@ -81,6 +105,17 @@ namespace nd4j {
             void expandBy(Nd4jLong numBytes);
             void expandTo(Nd4jLong numBytes);
 
+            /**
+             * NUMA placement and huge pages policy of workspace buffer. New policy is used once buffer is reallocated
+             */
+            AllocationPolicy getAllocationPolicy();
+            void setAllocationPolicy(const AllocationPolicy &policy);
+
+            /**
+             * Fills report with resident bytes of workspace buffer per NUMA node
+             */
+            bool retrieveNumaStatistics(MemoryReport &report);
+
 //            bool resizeSupported();
 
             void* allocateBytes(Nd4jLong numBytes);
@@ -89,6 +124,13 @@ namespace nd4j {
             void scopeIn();
             void scopeOut();
 
+            /**
+             * This method moves allocation pointer to given offset, and limits workspace allocations to given offset.
+             * Everything that doesn't fit below the limit is served from spills. Negative limit means no limit.
+             * Used to place allocations into planned blocks of workspace memory
+             */
+            void scopeTo(Nd4jLong offset, Nd4jLong limit);
+
             /*
              * This method creates NEW workspace of the same memory size and returns pointer to it
              */
@@ -0,0 +1,68 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include "../AllocationCounter.h"
+#include <atomic>
+
+namespace nd4j {
+    namespace memory {
+        static thread_local Nd4jLong threadWorkspace = 0L;
+        static thread_local Nd4jLong threadHeap = 0L;
+
+        // number of consumers interested in process-wide counters
+        static std::atomic<int> sharedConsumers(0);
+        static std::atomic<Nd4jLong> sharedWorkspace(0L);
+        static std::atomic<Nd4jLong> sharedHeap(0L);
+
+        void AllocationCounter::countWorkspaceBytes(Nd4jLong bytes) {
+            threadWorkspace += bytes;
+
+            if (sharedConsumers.load(std::memory_order_relaxed) > 0)
+                sharedWorkspace.fetch_add(bytes, std::memory_order_relaxed);
+        }
+
+        void AllocationCounter::countHeapBytes(Nd4jLong bytes) {
+            threadHeap += bytes;
+
+            if (sharedConsumers.load(std::memory_order_relaxed) > 0)
+                sharedHeap.fetch_add(bytes, std::memory_order_relaxed);
+        }
+
+        Nd4jLong AllocationCounter::threadWorkspaceBytes() {
+            return threadWorkspace;
+        }
+
+        Nd4jLong AllocationCounter::threadHeapBytes() {
+            return threadHeap;
+        }
+
+        Nd4jLong AllocationCounter::sharedWorkspaceBytes() {
+            return sharedWorkspace.load();
+        }
+
+        Nd4jLong AllocationCounter::sharedHeapBytes() {
+            return sharedHeap.load();
+        }
+
+        void AllocationCounter::startShared() {
+            sharedConsumers++;
+        }
+
+        void AllocationCounter::stopShared() {
+            sharedConsumers--;
+        }
+    }
+}
@@ -59,3 +59,16 @@ Nd4jLong nd4j::memory::MemoryReport::getRSS() const {
 void nd4j::memory::MemoryReport::setRSS(Nd4jLong _rss) {
     MemoryReport::_rss = _rss;
 }
+
+const std::map<int, Nd4jLong>& nd4j::memory::MemoryReport::getNumaBytes() const {
+    return _numa;
+}
+
+Nd4jLong nd4j::memory::MemoryReport::getNumaBytes(int node) const {
+    auto it = _numa.find(node);
+    return it == _numa.end() ? 0L : it->second;
+}
+
+void nd4j::memory::MemoryReport::setNumaBytes(const std::map<int, Nd4jLong> &bytes) {
+    _numa = bytes;
+}
@@ -19,6 +19,7 @@
 //
 
 #include "../MemoryUtils.h"
+#include "../PageAllocator.h"
 #include <helpers/logger.h>
 
 #if defined(__APPLE__)
@@ -94,3 +95,12 @@ bool nd4j::memory::MemoryUtils::retrieveMemoryStatistics(nd4j::memory::MemoryRep
 
     return false;
 }
+
+bool nd4j::memory::MemoryUtils::retrieveNumaStatistics(void *ptr, Nd4jLong bytes, nd4j::memory::MemoryReport &report) {
+    std::map<int, Nd4jLong> numa;
+    if (!PageAllocator::bytesPerNode(ptr, bytes, numa))
+        return false;
+
+    report.setNumaBytes(numa);
+    return true;
+}
@@ -0,0 +1,262 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include "../PageAllocator.h"
+#include <helpers/logger.h>
+#include <templatemath.h>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fstream>
+
+#if defined(_WIN32) || defined(__WIN32__) || defined(WIN32)
+#include <malloc.h>
+#else
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+// values from linux/mempolicy.h, so we don't depend on libnuma headers
+#define ND4J_MPOL_PREFERRED 1
+#define ND4J_MPOL_INTERLEAVE 3
+#define ND4J_MPOL_MF_MOVE (1 << 1)
+
+namespace nd4j {
+    namespace memory {
+        AllocationPolicy::AllocationPolicy(NumaPolicy numaPolicy, HugePagesPolicy hugePagesPolicy, bool parallelTouch) {
+            numa = numaPolicy;
+            hugePages = hugePagesPolicy;
+            parallelFirstTouch = parallelTouch;
+        }
+
+        bool AllocationPolicy::isDefault() const {
+            return numa == NUMA_DEFAULT && hugePages == HUGE_PAGES_NONE && !parallelFirstTouch;
+        }
+
+        static Nd4jLong pageSize() {
+#if defined(_WIN32) || defined(__WIN32__) || defined(WIN32)
+            return 4096L;
+#else
+            return (Nd4jLong) sysconf(_SC_PAGESIZE);
+#endif
+        }
+
+        // bit mask of online nodes, parsed from list like "0-1,3"
+        static unsigned long onlineNodesMask() {
+            unsigned long mask = 0;
+#if defined(__linux__)
+            std::ifstream file("/sys/devices/system/node/online");
+            std::string list;
+            if (!(file >> list))
+                return 1UL;
+
+            size_t pos = 0;
+            while (pos < list.size()) {
+                auto next = list.find(',', pos);
+                if (next == std::string::npos)
+                    next = list.size();
+
+                auto range = list.substr(pos, next - pos);
+                auto dash = range.find('-');
+                int first = std::atoi(range.substr(0, dash).c_str());
+                int last = dash == std::string::npos ? first : std::atoi(range.substr(dash + 1).c_str());
+
+                for (int e = first; e <= last && e < (int) sizeof(unsigned long) * 8; e++)
+                    mask |= 1UL << e;
+
+                pos = next + 1;
+            }
+#endif
+            return mask == 0 ? 1UL : mask;
+        }
+
+        int PageAllocator::numberOfNodes() {
+            auto mask = onlineNodesMask();
+
+            int count = 0;
+            for (; mask != 0; mask >>= 1)
+                count += (int) (mask & 1UL);
+
+            return count;
+        }
+
+        int PageAllocator::currentNode() {
+#if defined(__linux__) && defined(SYS_getcpu)
+            unsigned cpu = 0, node = 0;
+            if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0)
+                return (int) node;
+#endif
+            return 0;
+        }
+
+        static void bindPages(void *ptr, Nd4jLong bytes, NumaPolicy policy, bool moveExisting) {
+#if defined(__linux__) && defined(SYS_mbind)
+            if (policy == NUMA_DEFAULT || PageAllocator::numberOfNodes() < 2)
+                return;
+
+            // only whole pages within given memory are bound
+            const auto page = pageSize();
+            auto start = ((Nd4jLong) ptr + page - 1) / page * page;
+            auto end = ((Nd4jLong) ptr + bytes) / page * page;
+            if (end <= start)
+                return;
+
+            unsigned long mask = policy == NUMA_INTERLEAVE ? onlineNodesMask() : 1UL << PageAllocator::currentNode();
+            int mode = policy == NUMA_INTERLEAVE ? ND4J_MPOL_INTERLEAVE : ND4J_MPOL_PREFERRED;
+
+            if (syscall(SYS_mbind, (void *) start, (unsigned long) (end - start), mode, &mask, sizeof(mask) * 8 + 1, moveExisting ? ND4J_MPOL_MF_MOVE : 0) != 0)
+                nd4j_debug("mbind failed for %lld bytes, NUMA policy is ignored\n", end - start);
+#endif
+        }
+
+        static void adviseHugePages(void *ptr, Nd4jLong bytes) {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+            auto start = ((Nd4jLong) ptr + PageAllocator::HUGE_PAGE_SIZE - 1) / PageAllocator::HUGE_PAGE_SIZE * PageAllocator::HUGE_PAGE_SIZE;
+            auto end = ((Nd4jLong) ptr + bytes) / PageAllocator::HUGE_PAGE_SIZE * PageAllocator::HUGE_PAGE_SIZE;
+            if (end > start)
+                madvise((void *) start, end - start, MADV_HUGEPAGE);
+#endif
+        }
+
+        void* PageAllocator::allocate(Nd4jLong bytes, const AllocationPolicy &policy, bool zero, bool &mapped) {
+            void *ptr = nullptr;
+            mapped = false;
+
+#if defined(__linux__) && defined(MAP_HUGETLB)
+            if (policy.hugePages == HUGE_PAGES_EXPLICIT) {
+                auto size = (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+                ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+                if (ptr == MAP_FAILED) {
+                    nd4j_debug("No explicit huge pages available for %lld bytes, falling back to transparent ones\n", bytes);
+                    ptr = nullptr;
+                } else
+                    mapped = true;
+            }
+#endif
+
+            if (ptr == nullptr) {
+                const auto alignment = policy.hugePages != HUGE_PAGES_NONE ? HUGE_PAGE_SIZE : pageSize();
+#if defined(_WIN32) || defined(__WIN32__) || defined(WIN32)
+                ptr = _aligned_malloc(bytes, alignment);
+#else
+                if (posix_memalign(&ptr, alignment, bytes) != 0)
+                    ptr = nullptr;
+#endif
+                if (ptr == nullptr)
+                    return nullptr;
+
+                if (policy.hugePages != HUGE_PAGES_NONE)
+                    adviseHugePages(ptr, bytes);
+            }
+
+            // policy must be set before pages are touched
+            bindPages(ptr, bytes, policy.numa, false);
+
+            if (zero || policy.parallelFirstTouch)
+                touch(ptr, bytes, policy.parallelFirstTouch);
+
+            return ptr;
+        }
+
+        void PageAllocator::release(void *ptr, Nd4jLong bytes, bool mapped) {
+            if (ptr == nullptr)
+                return;
+
+#if defined(__linux__)
+            if (mapped) {
+                munmap(ptr, (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE);
+                return;
+            }
+#endif
+
+#if defined(_WIN32) || defined(__WIN32__) || defined(WIN32)
+            _aligned_free(ptr);
+#else
+            free(ptr);
+#endif
+        }
+
+        void PageAllocator::applyPolicy(void *ptr, Nd4jLong bytes, const AllocationPolicy &policy) {
+            if (ptr == nullptr || bytes < 1)
+                return;
+
+            if (policy.hugePages != HUGE_PAGES_NONE)
+                adviseHugePages(ptr, bytes);
+
+            bindPages(ptr, bytes, policy.numa, true);
+        }
+
+        void PageAllocator::touch(void *ptr, Nd4jLong bytes, bool parallel) {
+            if (!parallel) {
+                memset(ptr, 0, bytes);
+                return;
+            }
+
+            // static schedule, so each thread touches the same part that it gets in static loops over this memory
+            auto buffer = reinterpret_cast<int8_t *>(ptr);
+            const auto page = pageSize();
+            const auto numPages = (bytes + page - 1) / page;
+
+#pragma omp parallel for schedule(static)
+            for (Nd4jLong e = 0; e < numPages; e++) {
+                const auto start = e * page;
+                memset(buffer + start, 0, nd4j::math::nd4j_min<Nd4jLong>(page, bytes - start));
+            }
+        }
+
+        bool PageAllocator::bytesPerNode(void *ptr, Nd4jLong bytes, std::map<int, Nd4jLong> &result) {
+#if defined(__linux__) && defined(SYS_move_pages)
+            const auto page = pageSize();
+            const auto begin = (Nd4jLong) ptr;
+            const auto start = begin / page * page;
+            const auto end = begin + bytes;
+
+            // pages are queried in batches: move_pages without target nodes only reports where pages are
+            const int batch = 1024;
+            std::vector<void *> pages(batch);
+            std::vector<int> status(batch);
+
+            for (auto p = start; p < end; p += batch * page) {
+                int count = 0;
+                for (; count < batch && p + count * page < end; count++)
+                    pages[count] = (void *) (p + count * page);
+
+                // i.e. seccomp profile or missing CAP_SYS_NICE may forbid this call
+                if (syscall(SYS_move_pages, 0, (unsigned long) count, pages.data(), nullptr, status.data(), 0) != 0)
+                    return false;
+
+                // first and last pages may be shared with neighbouring memory, so only our part of them is counted
+                for (int e = 0; e < count; e++)
+                    if (status[e] >= 0) {
+                        auto pageStart = (Nd4jLong) pages[e];
+                        auto pageEnd = pageStart + page;
+                        result[status[e]] += nd4j::math::nd4j_min<Nd4jLong>(pageEnd, end) - nd4j::math::nd4j_max<Nd4jLong>(pageStart, begin);
+                    }
+            }
+
+            return true;
+#else
+            return false;
+#endif
+        }
+    }
+}
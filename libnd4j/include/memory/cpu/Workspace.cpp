@@ -26,14 +26,43 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "../Workspace.h"
+#include "../MemoryUtils.h"
+#include "../AllocationCounter.h"
 #include <helpers/logger.h>
 #include <templatemath.h>
+#include <Environment.h>
 #include <cstring>
 
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
 
 namespace nd4j {
     namespace memory {
-        Workspace::Workspace(ExternalWorkspace *external) {
+        static void* alignedMalloc(Nd4jLong bytes) {
+#ifdef _WIN32
+            return _aligned_malloc(bytes, Workspace::ALIGNMENT);
+#else
+            void *ptr = nullptr;
+            if (posix_memalign(&ptr, Workspace::ALIGNMENT, bytes) != 0)
+                return nullptr;
+
+            return ptr;
+#endif
+        }
+
+        static void alignedFree(void *ptr) {
+#ifdef _WIN32
+            _aligned_free(ptr);
+#else
+            free(ptr);
+#endif
+        }
+
+        Workspace::Workspace(ExternalWorkspace *external, const AllocationPolicy &policy) {
+            _policy = policy;
+
             if (external->sizeHost() > 0) {
                 _ptrHost = (char *) external->pointerHost();
                 _ptrDevice = (char *) external->pointerDevice();
@@ -45,16 +74,19 @@ namespace nd4j {
                 this->_spillsSize = 0;
 
                 _externalized = true;
+
+                PageAllocator::applyPolicy(_ptrHost, _currentSize, _policy);
             }
         };
 
-        Workspace::Workspace(Nd4jLong initialSize) {
+        Workspace::Workspace(Nd4jLong initialSize, const AllocationPolicy &policy) {
+            _policy = policy;
+
             if (initialSize > 0) {
-                this->_ptrHost = (char *) malloc(initialSize);
+                this->_ptrHost = (char *) PageAllocator::allocate(initialSize, _policy, Environment::getInstance()->isWorkspaceZeroing(), _mappedHost);
 
                 CHECK_ALLOC(this->_ptrHost, "Failed to allocate new workspace");
 
-                memset(this->_ptrHost, 0, initialSize);
                 this->_allocatedHost = true;
             } else
                 this->_allocatedHost = false;
@@ -69,15 +101,18 @@ namespace nd4j {
         void Workspace::init(Nd4jLong bytes) {
             if (this->_currentSize < bytes) {
                 if (this->_allocatedHost && !_externalized)
-                    free((void *)this->_ptrHost);
+                    PageAllocator::release(this->_ptrHost, this->_currentSize, _mappedHost);
 
-                this->_ptrHost =(char *) malloc(bytes);
+                // without zeroing pages of new buffer are committed by OS only once they are touched
+                this->_ptrHost = (char *) PageAllocator::allocate(bytes, _policy, Environment::getInstance()->isWorkspaceZeroing(), _mappedHost);
 
                 CHECK_ALLOC(this->_ptrHost, "Failed to allocate new workspace");
 
-                memset(this->_ptrHost, 0, bytes);
                 this->_currentSize = bytes;
                 this->_allocatedHost = true;
+
+                // grown buffer is ours, even if workspace started with external memory
+                this->_externalized = false;
             }
         }
 
@@ -90,20 +125,38 @@ namespace nd4j {
         }
 
         void Workspace::freeSpills() {
+            std::lock_guard<std::mutex> lock(_mutexSpills);
             _spillsSize = 0;
 
-            if (_spills.size() < 1)
-                return;
+            for (auto &v:_spills)
+                alignedFree(v.first);
 
-            for (auto v:_spills)
-                free(v);
+            for (auto &v:_spillsPool)
+                alignedFree(v.second);
+
+            _spills.clear();
+            _spillsPool.clear();
+        }
+
+        void Workspace::recycleSpills() {
+            std::lock_guard<std::mutex> lock(_mutexSpills);
+            _spillsSize = 0;
+
+            // chunks that weren't reused during whole cycle aren't needed anymore
+            for (auto &v:_spillsPool)
+                alignedFree(v.second);
+
+            _spillsPool.clear();
+
+            for (auto &v:_spills)
+                _spillsPool.emplace(v.second, v.first);
 
             _spills.clear();
         }
 
         Workspace::~Workspace() {
             if (this->_allocatedHost && !_externalized)
-                free((void *)this->_ptrHost);
+                PageAllocator::release(this->_ptrHost, this->_currentSize, _mappedHost);
 
             freeSpills();
         }
@@ -121,41 +174,56 @@ namespace nd4j {
         }
 
 
-        void* Workspace::allocateBytes(Nd4jLong numBytes) {
-            if (numBytes < 1) {
-                nd4j_printf("Bad number of bytes requested for allocation: %i\n", numBytes);
-                throw std::invalid_argument("Number of bytes for allocation should be positive");
-            }
-
-            //numBytes += 32;
-            void* result = nullptr;
-            this->_cycleAllocations += numBytes;
-            this->_mutexAllocation.lock();
+        void* Workspace::allocateSpill(Nd4jLong numBytes) {
+            nd4j_debug("Allocating %lld bytes in spills\n", numBytes);
 
-            if (_offset.load() + numBytes > _currentSize) {
-                nd4j_debug("Allocating %lld bytes in spills\n", numBytes);
-                this->_mutexAllocation.unlock();
+            std::lock_guard<std::mutex> lock(_mutexSpills);
 
-                void *p = malloc(numBytes);
+            // pooled chunk is reused only if it isn't much bigger than requested
+            void *p = nullptr;
+            Nd4jLong chunkSize = numBytes;
+            auto it = _spillsPool.lower_bound(numBytes);
+            if (it != _spillsPool.end() && it->first <= numBytes * 2) {
+                chunkSize = it->first;
+                p = it->second;
+                _spillsPool.erase(it);
+            } else {
+                p = alignedMalloc(numBytes);
 
                 CHECK_ALLOC(p, "Failed to allocate new workspace");
+            }
 
-                _mutexSpills.lock();
-                _spills.push_back(p);
-                _mutexSpills.unlock();
+            _spills.emplace_back(std::pair<void*, Nd4jLong>(p, chunkSize));
 
-                _spillsSize += numBytes;
+            _spillsSize += numBytes;
+            AllocationCounter::countHeapBytes(numBytes);
+
+            return p;
+        }
 
-                return p;
+        void* Workspace::allocateBytes(Nd4jLong numBytes) {
+            if (numBytes < 1) {
+                nd4j_printf("Bad number of bytes requested for allocation: %i\n", numBytes);
+                throw std::invalid_argument("Number of bytes for allocation should be positive");
             }
 
-            result = (void *)(_ptrHost + _offset.load());
-            _offset += numBytes;
-            //memset(result, 0, (int) numBytes);
+            numBytes = (numBytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+
+            // planned allocations are sized by planner, so they don't affect size of the next cycle
+            if (_limit.load() < 0)
+                this->_cycleAllocations += numBytes;
 
-            nd4j_debug("Allocating %lld bytes from workspace; Current PTR: %p; Current offset: %lld\n", numBytes, result, _offset.load());
+            auto offset = _offset.load();
+            do {
+                const auto limit = _limit.load();
+                if (offset + numBytes > _currentSize || (limit >= 0 && offset + numBytes > limit))
+                    return allocateSpill(numBytes);
+            } while (!_offset.compare_exchange_weak(offset, offset + numBytes));
 
-            this->_mutexAllocation.unlock();
+            auto result = (void *)(_ptrHost + offset);
+            AllocationCounter::countWorkspaceBytes(numBytes);
+
+            nd4j_debug("Allocating %lld bytes from workspace; Current PTR: %p; Current offset: %lld\n", numBytes, result, offset + numBytes);
 
             return result;
         }
@@ -165,13 +233,19 @@ namespace nd4j {
         }
 
         void Workspace::scopeIn() {
-            freeSpills();
+            recycleSpills();
             init(_cycleAllocations.load());
             _cycleAllocations = 0;
         }
 
         void Workspace::scopeOut() {
             _offset = 0;
+            _limit = -1L;
+        }
+
+        void Workspace::scopeTo(Nd4jLong offset, Nd4jLong limit) {
+            _offset = offset;
+            _limit = limit;
         }
 
         Nd4jLong Workspace::getSpilledSize() {
@@ -187,7 +261,19 @@ namespace nd4j {
 
         Workspace* Workspace::clone() {
             // for clone we take whatever is higher: current allocated size, or allocated size of current loop
-            return new Workspace(nd4j::math::nd4j_max<Nd4jLong >(this->getCurrentSize(), this->_cycleAllocations.load()));
+            return new Workspace(nd4j::math::nd4j_max<Nd4jLong >(this->getCurrentSize(), this->_cycleAllocations.load()), _policy);
+        }
+
+        AllocationPolicy Workspace::getAllocationPolicy() {
+            return _policy;
+        }
+
+        void Workspace::setAllocationPolicy(const AllocationPolicy &policy) {
+            _policy = policy;
+        }
+
+        bool Workspace::retrieveNumaStatistics(MemoryReport &report) {
+            return MemoryUtils::retrieveNumaStatistics(_ptrHost, _currentSize, report);
         }
     }
 }
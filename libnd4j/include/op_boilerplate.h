@@ -66,6 +66,7 @@
 #define OP_BOILERPLATE_HH
 
 #include <type_boilerplate.h>
+#include <memory/AllocationCounter.h>
 
 #ifdef __CUDACC__
 #define meta_def inline __device__
@@ -1447,7 +1448,7 @@
 
 
 
-#define ALLOCATE(VARIABLE, WORKSPACE, LENGTH, TT)   if (WORKSPACE == nullptr) {VARIABLE = new TT[LENGTH]; } else {VARIABLE = reinterpret_cast<TT *>(WORKSPACE->allocateBytes(LENGTH * sizeof(TT))); }
+#define ALLOCATE(VARIABLE, WORKSPACE, LENGTH, TT)   if (WORKSPACE == nullptr) {VARIABLE = new TT[LENGTH]; nd4j::memory::AllocationCounter::countHeapBytes((LENGTH) * sizeof(TT)); } else {VARIABLE = reinterpret_cast<TT *>(WORKSPACE->allocateBytes(LENGTH * sizeof(TT))); }
 #define RELEASE(VARIABLE, WORKSPACE)    if (WORKSPACE == nullptr) delete[] VARIABLE;
 
 
@@ -31,6 +31,7 @@
 #include <array/ShapeList.h>
 #include <array/ResultSet.h>
 #include <helpers/OpArgsHolder.h>
+#include <helpers/ShapeCache.h>
 #include <dll.h>
 //#include <ops/declarable/declarable_ops.h>
 
@@ -68,6 +69,9 @@ namespace nd4j {
             std::mutex _registrator;
             bool _registered = false;
 
+            // output shapes of previous invocations, keyed by input shapes and arguments
+            ShapeCache _shapeCache;
+
         protected:
             OpDescriptor *_descriptor;
             NDArray _scalar;
@@ -127,11 +131,14 @@ namespace nd4j {
             DeclarableOp(const char *name, bool isLogical);
 
             // default testructor
-            ~DeclarableOp();
+            virtual ~DeclarableOp();
 
             // this method returns OpDescriptor, describing this Op instance
             OpDescriptor *getOpDescriptor();
 
+            // this method returns output shapes cache of this Op instance
+            ShapeCache *shapeCache();
+
             Nd4jStatus validateDataTypes(Context& block);
 
             /**
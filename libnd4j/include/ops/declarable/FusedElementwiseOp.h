@@ -0,0 +1,45 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_FUSEDELEMENTWISEOP_H
+#define LIBND4J_FUSEDELEMENTWISEOP_H
+
+#include <ops/declarable/DeclarableOp.h>
+#include <ops/declarable/helpers/fused_elementwise.h>
+
+namespace nd4j {
+    namespace ops {
+        /**
+        *   This class executes chain of elementwise legacy ops (i.e. add -> relu -> mul) as single op, built by Graph.
+        *   Input 0 is X operand of the first step, other inputs are Y operands of scalar/pairwise steps.
+        */
+        class ND4J_EXPORT FusedElementwiseOp : public DeclarableOp {
+        protected:
+            std::vector<nd4j::ops::helpers::ElementwiseStep> _steps;
+
+            Nd4jStatus validateAndExecute(Context& block);
+        public:
+            explicit FusedElementwiseOp(const std::vector<nd4j::ops::helpers::ElementwiseStep> &steps);
+
+            const std::vector<nd4j::ops::helpers::ElementwiseStep>& steps() const;
+
+            ShapeList* calculateOutputShape(ShapeList* inputShape, nd4j::graph::Context& block);
+        };
+    }
+}
+
+
+#endif //LIBND4J_FUSEDELEMENTWISEOP_H
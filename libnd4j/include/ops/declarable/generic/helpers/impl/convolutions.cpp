@@ -23,6 +23,9 @@
 #include <ops/declarable/helpers/col2im.h>
 #include <NDArrayFactory.h>
 #include <MmulHelper.h>
+#include <Environment.h>
+#include <array/DataTypeUtils.h>
+#include <vector>
 
 namespace nd4j {
 namespace ops  {
@@ -567,6 +570,548 @@ void ConvolutionUtils::getMKLDNNMemoryDescConv3d(
 }
 #endif
 
+//////////////////////////////////////////////////////////////////////////
+// Winograd F(m x m, 3 x 3) transformation matrices (Lavin & Gray), input tile size is a = m + 2
+static const double winogradBT2[16] = { 1.,  0., -1.,  0.,
+                                       0.,  1.,  1.,  0.,
+                                       0., -1.,  1.,  0.,
+                                       0.,  1.,  0., -1.};
+
+static const double winogradG2[12]  = { 1.,   0.,  0.,
+                                       0.5,  0.5, 0.5,
+                                       0.5, -0.5, 0.5,
+                                       0.,   0.,  1.};
+
+static const double winogradAT2[8]  = { 1.,  1.,  1.,  0.,
+                                       0.,  1., -1., -1.};
+
+static const double winogradBT4[36] = { 4.,  0., -5.,  0.,  1.,  0.,
+                                       0., -4., -4.,  1.,  1.,  0.,
+                                       0.,  4., -4., -1.,  1.,  0.,
+                                       0., -2., -1.,  2.,  1.,  0.,
+                                       0.,  2., -1., -2.,  1.,  0.,
+                                       0.,  4.,  0., -5.,  0.,  1.};
+
+static const double winogradG4[18]  = { 1./4.,   0.,        0.,
+                                      -1./6.,  -1./6.,   -1./6.,
+                                      -1./6.,   1./6.,   -1./6.,
+                                       1./24.,  1./12.,   1./6.,
+                                       1./24., -1./12.,   1./6.,
+                                       0.,       0.,        1.};
+
+static const double winogradAT4[24] = { 1.,  1.,  1.,  1.,  1.,  0.,
+                                       0.,  1., -1.,  2., -2.,  0.,
+                                       0.,  1.,  1.,  4.,  4.,  0.,
+                                       0.,  1., -1.,  8., -8.,  1.};
+
+//////////////////////////////////////////////////////////////////////////
+// z[r x n] = l[r x k] * x[k x k] * transpose(l), all matrices are row-major
+template <typename T>
+static FORCEINLINE void winogradSandwich(const T* l, const T* x, T* z, const int r, const int k, T* tmp) {
+
+    // tmp[r x k] = l * x
+    for (int i = 0; i < r; ++i)
+        for (int j = 0; j < k; ++j) {
+            T sum = static_cast<T>(0.f);
+            for (int e = 0; e < k; ++e)
+                sum += l[i * k + e] * x[e * k + j];
+            tmp[i * k + j] = sum;
+        }
+
+    // z[r x r] = tmp * transpose(l)
+    for (int i = 0; i < r; ++i)
+        for (int j = 0; j < r; ++j) {
+            T sum = static_cast<T>(0.f);
+            for (int e = 0; e < k; ++e)
+                sum += tmp[i * k + e] * l[j * k + e];
+            z[i * r + j] = sum;
+        }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Winograd convolution for 3x3 kernels with unit strides and dilations, m is output tile size (2 or 4)
+// input   [bS, iC, iH, iW] (NCHW) or [bS, iH, iW, iC] (NHWC), accessed via strides
+// weights [kH, kW, iC, oC]
+// output  [bS, oC, oH, oW] (NCHW) or [bS, oH, oW, oC] (NHWC), accessed via strides, biases aren't applied here
+template <typename X, typename Y>
+static void conv2dWinograd_(const NDArray* input, const NDArray* weights, NDArray* output, const int m, const int pH, const int pW, const int isNCHW) {
+
+    const int a  = m + 2;
+    const int a2 = a * a;
+
+    const int bS = input->sizeAt(0);
+    const int iC = input->sizeAt(isNCHW ? 1 : 3);
+    const int iH = input->sizeAt(isNCHW ? 2 : 1);
+    const int iW = input->sizeAt(isNCHW ? 3 : 2);
+    const int oC = output->sizeAt(isNCHW ? 1 : 3);
+    const int oH = output->sizeAt(isNCHW ? 2 : 1);
+    const int oW = output->sizeAt(isNCHW ? 3 : 2);
+
+    const Nd4jLong inStrB = input->stridesOf()[0], inStrC = input->stridesOf()[isNCHW ? 1 : 3], inStrH = input->stridesOf()[isNCHW ? 2 : 1], inStrW = input->stridesOf()[isNCHW ? 3 : 2];
+    const Nd4jLong outStrB = output->stridesOf()[0], outStrC = output->stridesOf()[isNCHW ? 1 : 3], outStrH = output->stridesOf()[isNCHW ? 2 : 1], outStrW = output->stridesOf()[isNCHW ? 3 : 2];
+
+    const int tH = (oH + m - 1) / m;
+    const int tW = (oW + m - 1) / m;
+    const int numTiles = tH * tW;
+
+    Y bt[36], g[18], at[24];
+    for (int e = 0; e < a2; ++e)
+        bt[e] = static_cast<Y>(m == 2 ? winogradBT2[e] : winogradBT4[e]);
+    for (int e = 0; e < a * 3; ++e)
+        g[e] = static_cast<Y>(m == 2 ? winogradG2[e] : winogradG4[e]);
+    for (int e = 0; e < m * a; ++e)
+        at[e] = static_cast<Y>(m == 2 ? winogradAT2[e] : winogradAT4[e]);
+
+    const X* in = const_cast<NDArray*>(input)->bufferAsT<X>();
+    Y* out = output->bufferAsT<Y>();
+
+    // weights in output data type, c order: [kH, kW, iC, oC]
+    NDArray w('c', {3, 3, iC, oC}, output->dataType(), output->getWorkspace());
+    w.assign(weights);
+    const Y* wBuff = w.bufferAsT<Y>();
+
+    // transformed weights U = G * g * G^T, stored as [a*a, iC, oC]
+    NDArray uArr('c', {a2, iC, oC}, output->dataType(), output->getWorkspace());
+    Y* u = uArr.bufferAsT<Y>();
+
+#pragma omp parallel for schedule(static) collapse(2)
+    for (int c = 0; c < iC; ++c) {
+        for (int o = 0; o < oC; ++o) {
+            Y kernel[9], tmp[18], tile[36];
+            for (int e = 0; e < 9; ++e)
+                kernel[e] = wBuff[(e * iC + c) * oC + o];
+
+            // G is [a x 3], so sandwich is computed in two explicit steps here
+            for (int i = 0; i < a; ++i)
+                for (int j = 0; j < 3; ++j)
+                    tmp[i * 3 + j] = g[i * 3] * kernel[j] + g[i * 3 + 1] * kernel[3 + j] + g[i * 3 + 2] * kernel[6 + j];
+
+            for (int i = 0; i < a; ++i)
+                for (int j = 0; j < a; ++j)
+                    tile[i * a + j] = tmp[i * 3] * g[j * 3] + tmp[i * 3 + 1] * g[j * 3 + 1] + tmp[i * 3 + 2] * g[j * 3 + 2];
+
+            for (int e = 0; e < a2; ++e)
+                u[(e * iC + c) * oC + o] = tile[e];
+        }
+    }
+
+    // transformed input tiles V = B^T * d * B, stored as [a*a, numTiles, iC], and products M = V x U as [a*a, numTiles, oC]
+    NDArray vArr('c', {a2, numTiles, iC}, output->dataType(), output->getWorkspace());
+    NDArray mArr('c', {a2, numTiles, oC}, output->dataType(), output->getWorkspace());
+    Y* v = vArr.bufferAsT<Y>();
+    Y* mm = mArr.bufferAsT<Y>();
+
+    // batch is processed sample by sample, so transformed data stays bounded
+    for (int b = 0; b < bS; ++b) {
+
+#pragma omp parallel for schedule(static) collapse(2)
+        for (int t = 0; t < numTiles; ++t) {
+            for (int c = 0; c < iC; ++c) {
+                Y d[36], tmp[36], tile[36];
+                const int h0 = (t / tW) * m - pH;
+                const int w0 = (t % tW) * m - pW;
+
+                for (int i = 0; i < a; ++i)
+                    for (int j = 0; j < a; ++j) {
+                        const int h = h0 + i;
+                        const int ww = w0 + j;
+                        d[i * a + j] = (static_cast<unsigned>(h) >= static_cast<unsigned>(iH) || static_cast<unsigned>(ww) >= static_cast<unsigned>(iW)) ? static_cast<Y>(0.f) : static_cast<Y>(in[b * inStrB + c * inStrC + h * inStrH + ww * inStrW]);
+                    }
+
+                winogradSandwich<Y>(bt, d, tile, a, a, tmp);
+
+                for (int e = 0; e < a2; ++e)
+                    v[(e * numTiles + t) * iC + c] = tile[e];
+            }
+        }
+
+        // a*a independent element-wise products, each one is [numTiles x iC] x [iC x oC]
+#pragma omp parallel for schedule(static) collapse(2)
+        for (int e = 0; e < a2; ++e) {
+            for (int t = 0; t < numTiles; ++t) {
+                Y* mRow = mm + (e * numTiles + t) * oC;
+                const Y* vRow = v + (e * numTiles + t) * iC;
+                const Y* uMat = u + e * iC * oC;
+
+                for (int o = 0; o < oC; ++o)
+                    mRow[o] = static_cast<Y>(0.f);
+
+                for (int c = 0; c < iC; ++c) {
+                    const Y val = vRow[c];
+                    const Y* uRow = uMat + c * oC;
+#pragma omp simd
+                    for (int o = 0; o < oC; ++o)
+                        mRow[o] += val * uRow[o];
+                }
+            }
+        }
+
+        // output tiles Y = A^T * M * A
+#pragma omp parallel for schedule(static) collapse(2)
+        for (int t = 0; t < numTiles; ++t) {
+            for (int o = 0; o < oC; ++o) {
+                Y tile[36], tmp[36], res[16];
+                for (int e = 0; e < a2; ++e)
+                    tile[e] = mm[(e * numTiles + t) * oC + o];
+
+                winogradSandwich<Y>(at, tile, res, m, a, tmp);
+
+                const int h0 = (t / tW) * m;
+                const int w0 = (t % tW) * m;
+                for (int i = 0; i < m && h0 + i < oH; ++i)
+                    for (int j = 0; j < m && w0 + j < oW; ++j)
+                        out[b * outStrB + o * outStrC + (h0 + i) * outStrH + (w0 + j) * outStrW] = res[i * m + j];
+            }
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// direct convolution without im2col buffer, meant for layers with few input channels
+// for every input element whole contiguous row of oC weights is applied, so inner loop is vectorized along oC
+template <typename X, typename Y>
+static void conv2dDirect_(const NDArray* input, const NDArray* weights, NDArray* output, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW, const int isNCHW) {
+
+    const int bS = input->sizeAt(0);
+    const int iC = input->sizeAt(isNCHW ? 1 : 3);
+    const int iH = input->sizeAt(isNCHW ? 2 : 1);
+    const int iW = input->sizeAt(isNCHW ? 3 : 2);
+    const int oC = output->sizeAt(isNCHW ? 1 : 3);
+    const int oH = output->sizeAt(isNCHW ? 2 : 1);
+    const int oW = output->sizeAt(isNCHW ? 3 : 2);
+
+    const Nd4jLong inStrB = input->stridesOf()[0], inStrC = input->stridesOf()[isNCHW ? 1 : 3], inStrH = input->stridesOf()[isNCHW ? 2 : 1], inStrW = input->stridesOf()[isNCHW ? 3 : 2];
+    const Nd4jLong outStrB = output->stridesOf()[0], outStrC = output->stridesOf()[isNCHW ? 1 : 3], outStrH = output->stridesOf()[isNCHW ? 2 : 1], outStrW = output->stridesOf()[isNCHW ? 3 : 2];
+
+    const X* in = const_cast<NDArray*>(input)->bufferAsT<X>();
+    Y* out = output->bufferAsT<Y>();
+
+    NDArray w('c', {kH, kW, iC, oC}, output->dataType(), output->getWorkspace());
+    w.assign(weights);
+    const Y* wBuff = w.bufferAsT<Y>();
+
+#pragma omp parallel
+    {
+        std::vector<Y> acc(oC);
+
+#pragma omp for schedule(static) collapse(3)
+        for (int b = 0; b < bS; ++b) {
+            for (int oh = 0; oh < oH; ++oh) {
+                for (int ow = 0; ow < oW; ++ow) {
+                    for (int o = 0; o < oC; ++o)
+                        acc[o] = static_cast<Y>(0.f);
+
+                    for (int kh = 0; kh < kH; ++kh) {
+                        const int h = oh * sH - pH + kh * dH;
+                        if (static_cast<unsigned>(h) >= static_cast<unsigned>(iH))
+                            continue;
+
+                        for (int kw = 0; kw < kW; ++kw) {
+                            const int ww = ow * sW - pW + kw * dW;
+                            if (static_cast<unsigned>(ww) >= static_cast<unsigned>(iW))
+                                continue;
+
+                            for (int c = 0; c < iC; ++c) {
+                                const Y val = static_cast<Y>(in[b * inStrB + c * inStrC + h * inStrH + ww * inStrW]);
+                                const Y* wRow = wBuff + ((kh * kW + kw) * iC + c) * oC;
+#pragma omp simd
+                                for (int o = 0; o < oC; ++o)
+                                    acc[o] += val * wRow[o];
+                            }
+                        }
+                    }
+
+                    Y* z = out + b * outStrB + oh * outStrH + ow * outStrW;
+                    for (int o = 0; o < oC; ++o)
+                        z[o * outStrC] = acc[o];
+                }
+            }
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// picks conv2d algorithm for given layer, Environment may force specific one
+static Conv2dAlgorithm chooseConv2dAlgorithm(const nd4j::DataType dtype, const int kH, const int kW, const int sH, const int sW, const int dH, const int dW, const int iC, const int oC) {
+
+    const bool isFloat = DataTypeUtils::isR(dtype);
+    const bool winogradApplicable = isFloat && kH == 3 && kW == 3 && sH == 1 && sW == 1 && dH == 1 && dW == 1;
+
+    switch (Environment::getInstance()->conv2dAlgorithm()) {
+        case CONV2D_IM2COL:
+            return CONV2D_IM2COL;
+        case CONV2D_WINOGRAD:
+            return winogradApplicable ? CONV2D_WINOGRAD : CONV2D_IM2COL;
+        case CONV2D_DIRECT:
+            return isFloat ? CONV2D_DIRECT : CONV2D_IM2COL;
+        default:
+            break;
+    }
+
+    // transforms are amortized over channels, and half precision loses too much accuracy in them
+    if (winogradApplicable && (dtype == nd4j::DataType::FLOAT32 || dtype == nd4j::DataType::DOUBLE) && iC >= 8 && oC >= 8)
+        return CONV2D_WINOGRAD;
+
+    // with few input channels im2col buffer is mostly overhead
+    if (isFloat && iC <= 4)
+        return CONV2D_DIRECT;
+
+    return CONV2D_IM2COL;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// returns true if full im2col buffer of layer doesn't fit into Environment budget, then layer is computed tile by tile
+static bool useConvTiles(const int bS, const int iC, const int kH, const int kW, const int oH, const int oW, const int sizeOfT) {
+
+    const Nd4jLong budget = Environment::getInstance()->convTileBytes();
+    return budget > 0 && (Nd4jLong) bS * iC * kH * kW * oH * oW * sizeOfT > budget;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// picks tile of (batch, output rows): whole samples if at least one fits into budget, otherwise rows of single sample
+static void calcConvTiles(const int bS, const int oH, const Nd4jLong bytesPerRow, const bool splitRows, int& bTile, int& rTile) {
+
+    const Nd4jLong budget = Environment::getInstance()->convTileBytes();
+    const Nd4jLong bytesPerSample = bytesPerRow * oH;
+
+    if (bytesPerSample <= budget || !splitRows) {
+        rTile = oH;
+        bTile = (int) nd4j::math::nd4j_max<Nd4jLong>(1, nd4j::math::nd4j_min<Nd4jLong>(bS, budget / bytesPerSample));
+    }
+    else {
+        bTile = 1;
+        rTile = (int) nd4j::math::nd4j_max<Nd4jLong>(1, nd4j::math::nd4j_min<Nd4jLong>(oH, budget / bytesPerRow));
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// weights [kH, kW, iC, oC] are rearranged into [iC, kH, kW, oC], so that each input channel owns contiguous [kH*kW, oC] block
+static NDArray* convWeightsMatrix(const NDArray* weights) {
+
+    auto wMatrix = new NDArray('c', {weights->sizeAt(2), weights->sizeAt(0), weights->sizeAt(1), weights->sizeAt(3)}, weights->dataType(), weights->getWorkspace());
+    auto weightsP = weights->permute({2, 0, 1, 3});
+    wMatrix->assign(weightsP);
+    delete weightsP;
+
+    return wMatrix;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// rows of input [s0, s1) and top padding pT required to produce output rows [r0, r0 + rN)
+static void calcConvInputRows(const int r0, const int rN, const int iH, const int kH, const int sH, const int pH, const int dH, int& s0, int& s1, int& pT) {
+
+    s0 = nd4j::math::nd4j_max<int>(0, r0 * sH - pH);
+    s1 = nd4j::math::nd4j_min<int>(iH, (r0 + rN - 1) * sH - pH + (kH - 1) * dH + 1);
+
+    // tile consisting of padding only still needs non-empty input
+    if (s1 <= s0) {
+        s0 = 0;
+        s1 = 1;
+    }
+
+    pT = pH - r0 * sH + s0;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// conv2d as implicit GEMM: im2col is applied to one tile of (batch, output rows) at a time, column buffer is shared by all tiles
+static void conv2dTiled(const NDArray* input, const NDArray* weights, NDArray* output, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW, const int isNCHW) {
+
+    // input   [bS, iC, iH, iW], NHWC input is passed as permuted view
+    // weights [kH, kW, iC, oC]
+    // output  [bS, oH, oW, oC] (NHWC) or [bS, oC, oH, oW] (NCHW)
+
+    const int bS = input->sizeAt(0), iC = input->sizeAt(1), iH = input->sizeAt(2);
+    const int oC = weights->sizeAt(3);
+    const int oH = output->sizeAt(isNCHW ? 2 : 1), oW = output->sizeAt(isNCHW ? 3 : 2);
+    const Nd4jLong K = (Nd4jLong) iC * kH * kW;
+    auto workspace = input->getWorkspace();
+
+    int bTile, rTile;
+    calcConvTiles(bS, oH, oW * (K * input->sizeOfT() + oC * output->sizeOfT()), true, bTile, rTile);
+
+    auto wMatrix = convWeightsMatrix(weights);
+    wMatrix->reshapei('c', {K, oC});
+
+    NDArray colBuffer('c', {(Nd4jLong) bTile * rTile * oW * K}, input->dataType(), workspace);
+    NDArray outBuffer('c', {(Nd4jLong) bTile * rTile * oW * oC}, output->dataType(), workspace);
+    auto zero = NDArrayFactory::create(0.f, workspace);
+    graph::LaunchContext ctx;
+
+    for (int b0 = 0; b0 < bS; b0 += bTile) {
+        for (int r0 = 0; r0 < oH; r0 += rTile) {
+
+            const int bN = nd4j::math::nd4j_min<int>(bTile, bS - b0);
+            const int rN = nd4j::math::nd4j_min<int>(rTile, oH - r0);
+            const Nd4jLong M = (Nd4jLong) bN * rN * oW;
+
+            int s0, s1, pT;
+            calcConvInputRows(r0, rN, iH, kH, sH, pH, dH, s0, s1, pT);
+            auto inSlab = (*input)({b0, b0 + bN, 0, 0, s0, s1, 0, 0});
+
+            // columns are filled as [bN, rN, oW, iC, kH, kW], so they are [M, K] matrix without any copy
+            NDArray columns(colBuffer.getBuffer(), 'c', {bN, rN, oW, iC, kH, kW}, input->dataType());
+            auto columnsP = columns.permute({0, 3, 4, 5, 1, 2});
+            helpers::im2col(ctx, inSlab, *columnsP, kH, kW, sH, sW, pT, pW, dH, dW, zero);
+            delete columnsP;
+
+            NDArray colMatrix(colBuffer.getBuffer(), 'c', {M, K}, input->dataType());
+            NDArray outMatrix(outBuffer.getBuffer(), 'f', {M, oC}, output->dataType());
+            MmulHelper::mmul(&colMatrix, wMatrix, &outMatrix, 1.0, 0.0);              // [M, K] x [K, oC] = [M, oC]
+
+            // [M, oC] in f order is [oC, bN, rN, oW] in c order
+            NDArray outTile(outBuffer.getBuffer(), 'c', {oC, bN, rN, oW}, output->dataType());
+            auto outTileP = isNCHW ? outTile.permute({1, 0, 2, 3}) : outTile.permute({1, 2, 3, 0});
+            auto outSlab = isNCHW ? (*output)({b0, b0 + bN, 0, 0, r0, r0 + rN, 0, 0}) : (*output)({b0, b0 + bN, r0, r0 + rN, 0, 0, 0, 0});
+            outSlab.assign(outTileP);
+            delete outTileP;
+        }
+    }
+
+    delete wMatrix;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// depthwise counterpart of conv2dTiled, every input channel is multiplied by its own [kH*kW, mC] weights block
+static void depthwiseConv2dTiled(const NDArray* input, const NDArray* weights, NDArray* output, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW, const int isNCHW) {
+
+    // input   [bS, iC, iH, iW], NHWC input is passed as permuted view
+    // weights [kH, kW, iC, mC]
+    // output  [bS, oH, oW, iC*mC] (NHWC) or [bS, iC*mC, oH, oW] (NCHW)
+
+    const int bS = input->sizeAt(0), iC = input->sizeAt(1), iH = input->sizeAt(2);
+    const int mC = weights->sizeAt(3), oC = iC * mC;
+    const int oH = output->sizeAt(isNCHW ? 2 : 1), oW = output->sizeAt(isNCHW ? 3 : 2);
+    const Nd4jLong K = (Nd4jLong) kH * kW;
+    auto workspace = input->getWorkspace();
+
+    int bTile, rTile;
+    calcConvTiles(bS, oH, oW * (iC * K * input->sizeOfT() + oC * output->sizeOfT()), true, bTile, rTile);
+
+    auto wMatrix = convWeightsMatrix(weights);
+
+    NDArray colBuffer('c', {(Nd4jLong) bTile * rTile * oW * iC * K}, input->dataType(), workspace);
+    NDArray outBuffer('c', {(Nd4jLong) bTile * rTile * oW * oC}, output->dataType(), workspace);
+    auto zero = NDArrayFactory::create(0.f, workspace);
+    graph::LaunchContext ctx;
+
+    for (int b0 = 0; b0 < bS; b0 += bTile) {
+        for (int r0 = 0; r0 < oH; r0 += rTile) {
+
+            const int bN = nd4j::math::nd4j_min<int>(bTile, bS - b0);
+            const int rN = nd4j::math::nd4j_min<int>(rTile, oH - r0);
+            const Nd4jLong M = (Nd4jLong) bN * rN * oW;
+
+            int s0, s1, pT;
+            calcConvInputRows(r0, rN, iH, kH, sH, pH, dH, s0, s1, pT);
+            auto inSlab = (*input)({b0, b0 + bN, 0, 0, s0, s1, 0, 0});
+
+            // columns are filled as [iC, bN, rN, oW, kH, kW], i.e. iC matrices [M, kH*kW]
+            NDArray columns(colBuffer.getBuffer(), 'c', {iC, bN, rN, oW, kH, kW}, input->dataType());
+            auto columnsP = columns.permute({1, 0, 4, 5, 2, 3});
+            helpers::im2col(ctx, inSlab, *columnsP, kH, kW, sH, sW, pT, pW, dH, dW, zero);
+            delete columnsP;
+
+            for (int c = 0; c < iC; ++c) {
+                NDArray colMatrix(colBuffer.bufferWithOffset(c * M * K), 'c', {M, K}, input->dataType());
+                NDArray wChannel(wMatrix->bufferWithOffset(c * K * mC), 'c', {K, mC}, weights->dataType());
+                NDArray outMatrix(outBuffer.bufferWithOffset(c * M * mC), 'f', {M, mC}, output->dataType());
+                MmulHelper::mmul(&colMatrix, &wChannel, &outMatrix, 1.0, 0.0);        // [M, kH*kW] x [kH*kW, mC] = [M, mC]
+            }
+
+            // iC blocks [M, mC] in f order are [iC*mC, bN, rN, oW] in c order
+            NDArray outTile(outBuffer.getBuffer(), 'c', {oC, bN, rN, oW}, output->dataType());
+            auto outTileP = isNCHW ? outTile.permute({1, 0, 2, 3}) : outTile.permute({1, 2, 3, 0});
+            auto outSlab = isNCHW ? (*output)({b0, b0 + bN, 0, 0, r0, r0 + rN, 0, 0}) : (*output)({b0, b0 + bN, r0, r0 + rN, 0, 0, 0, 0});
+            outSlab.assign(outTileP);
+            delete outTileP;
+        }
+    }
+
+    delete wMatrix;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// conv2d_bp as implicit GEMM over batch tiles, gradW is accumulated across tiles
+// output rows are not split here: col2im of neighbouring row tiles would overlap in gradI
+static void conv2dBPTiled(const NDArray* input, const NDArray* weights, const NDArray* gradO, NDArray* gradI, NDArray* gradW, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW, const int isNCHW) {
+
+    // input   [bS, iC, iH, iW], NHWC input is passed as permuted view
+    // weights [kH, kW, iC, oC]
+    // gradO   [bS, oH, oW, oC] (NHWC) or [bS, oC, oH, oW] (NCHW)
+    // gradI   [bS, iC, iH, iW], NHWC gradI is passed as permuted view
+    // gradW   [kH, kW, iC, oC], may be nullptr
+
+    const int bS = input->sizeAt(0), iC = input->sizeAt(1), iH = input->sizeAt(2), iW = input->sizeAt(3);
+    const int oC = weights->sizeAt(3);
+    const int oH = gradO->sizeAt(isNCHW ? 2 : 1), oW = gradO->sizeAt(isNCHW ? 3 : 2);
+    const Nd4jLong K = (Nd4jLong) iC * kH * kW;
+    auto workspace = input->getWorkspace();
+
+    int bTile, rTile;
+    calcConvTiles(bS, oH, oW * (K * input->sizeOfT() + oC * gradO->sizeOfT()), false, bTile, rTile);
+
+    auto wMatrix = convWeightsMatrix(weights);
+    wMatrix->reshapei('c', {K, oC});
+    auto wMatrixT = wMatrix->transpose();
+
+    NDArray* gradWMatrix = gradW != nullptr ? new NDArray('f', {K, oC}, gradW->dataType(), workspace) : nullptr;
+    NDArray colBuffer('c', {(Nd4jLong) bTile * oH * oW * K}, input->dataType(), workspace);
+    NDArray gradOBuffer('c', {(Nd4jLong) bTile * oH * oW * oC}, gradO->dataType(), workspace);
+    auto zero = NDArrayFactory::create(0.f, workspace);
+    graph::LaunchContext ctx;
+
+    for (int b0 = 0; b0 < bS; b0 += bTile) {
+
+        const int bN = nd4j::math::nd4j_min<int>(bTile, bS - b0);
+        const Nd4jLong M = (Nd4jLong) bN * oH * oW;
+
+        // gradO tile is gathered as [M, oC] in f order, i.e. [oC, bN, oH, oW] in c order
+        NDArray gradOTile(gradOBuffer.getBuffer(), 'c', {oC, bN, oH, oW}, gradO->dataType());
+        auto gradOSlab = (*gradO)({b0, b0 + bN, 0, 0, 0, 0, 0, 0});
+        auto gradOSlabP = isNCHW ? gradOSlab.permute({1, 0, 2, 3}) : gradOSlab.permute({3, 0, 1, 2});
+        gradOTile.assign(gradOSlabP);
+        delete gradOSlabP;
+        NDArray gradOMatrix(gradOBuffer.getBuffer(), 'f', {M, oC}, gradO->dataType());
+
+        // ----- calculation of gradW ----- //
+        if (gradW) {
+            auto inSlab = (*input)({b0, b0 + bN, 0, 0, 0, 0, 0, 0});
+            NDArray columns(colBuffer.getBuffer(), 'c', {bN, oH, oW, iC, kH, kW}, input->dataType());
+            auto columnsP = columns.permute({0, 3, 4, 5, 1, 2});
+            helpers::im2col(ctx, inSlab, *columnsP, kH, kW, sH, sW, pH, pW, dH, dW, zero);
+            delete columnsP;
+
+            NDArray colMatrix(colBuffer.getBuffer(), 'c', {M, K}, input->dataType());
+            auto colMatrixT = colMatrix.transpose();
+            MmulHelper::mmul(colMatrixT, &gradOMatrix, gradWMatrix, 1.0, b0 == 0 ? 0.0 : 1.0);    // [K, M] x [M, oC] = [K, oC]
+            delete colMatrixT;
+        }
+
+        //----- calculation of gradI -----//
+        NDArray colMatrix(colBuffer.getBuffer(), 'f', {M, K}, input->dataType());
+        MmulHelper::mmul(&gradOMatrix, wMatrixT, &colMatrix, 1.0, 0.0);              // [M, oC] x [oC, K] = [M, K]
+
+        // [M, K] in f order is [iC, kH, kW, bN, oH, oW] in c order
+        NDArray columns(colBuffer.getBuffer(), 'c', {iC, kH, kW, bN, oH, oW}, input->dataType());
+        auto columnsP = columns.permute({3, 0, 1, 2, 4, 5});
+        auto gradISlab = (*gradI)({b0, b0 + bN, 0, 0, 0, 0, 0, 0});
+        helpers::col2im(ctx, *columnsP, gradISlab, sH, sW, pH, pW, iH, iW, dH, dW);
+        delete columnsP;
+    }
+
+    if (gradW) {
+        // [K, oC] in f order is [oC, iC, kH, kW] in c order
+        NDArray gradWTile(gradWMatrix->getBuffer(), 'c', {oC, iC, kH, kW}, gradW->dataType());
+        auto gradWTileP = gradWTile.permute({2, 3, 1, 0});
+        gradW->assign(gradWTileP);
+        delete gradWTileP;
+        delete gradWMatrix;
+    }
+
+    delete wMatrixT;
+    delete wMatrix;
+}
+
 //////////////////////////////////////////////////////////////////////////
 template <typename X, typename Y>
 static void conv2d_(nd4j::graph::Context& block, const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const int kH, const int kW, const int sH, const int sW, int pH, int pW, const int dH, const int dW, const int isSameMode, const int isNCHW) {
@@ -594,12 +1139,13 @@ static void conv2d_(nd4j::graph::Context& block, const NDArray* input, const NDA
     if(isSameMode)                       // SAME
         ConvolutionUtils::calcPadding2D(pH, pW, oH, oW, iH, iW, kH, kW, sH, sW, dH, dW);
 
+    const auto algorithm = chooseConv2dAlgorithm(output->dataType(), kH, kW, sH, sW, dH, dW, iC, oC);
+
 #ifdef HAVE_MKLDNN
-    if (block.isUseMKLDNN() && nd4j::MKLDNNStream::isSupported<X, Y>()) {
-        std::vector<nd4j::MKLDNNStream>& streams = block.getMKLDNNStreams();
-        if (streams.empty()) {
-            streams.push_back(MKLDNNStream("conv2d"));
-        }
+    // explicitly forced algorithm takes precedence over MKL-DNN
+    if (block.isUseMKLDNN() && nd4j::MKLDNNStream::isSupported<X, Y>() && Environment::getInstance()->conv2dAlgorithm() == CONV2D_AUTO) {
+        std::vector<nd4j::MKLDNNStream> streams;
+        streams.push_back(MKLDNNStream("conv2d"));
 
         if (streams[0].checkAndReset({input, weights, bias}, {output}, {}, {kH, kW, sH, sW, pH, pW, dH, dW, isSameMode, isNCHW})) {
             mkldnn_memory_desc_t empty;
@@ -639,18 +1185,40 @@ static void conv2d_(nd4j::graph::Context& block, const NDArray* input, const NDA
 #endif
     nd4j_debug("MKL-DNN is not used for conv2d!\n", 0);
 
+    if (algorithm == CONV2D_WINOGRAD || algorithm == CONV2D_DIRECT) {
+        if (algorithm == CONV2D_WINOGRAD) {
+            // bigger tiles save more multiplications, but only if output has room for them
+            const int m = oH >= 8 && oW >= 8 ? 4 : 2;
+            nd4j_debug("Using Winograd F(%ix%i, 3x3) for conv2d\n", m, m);
+            conv2dWinograd_<X, Y>(input, weights, output, m, pH, pW, isNCHW);
+        } else {
+            nd4j_debug("Using direct convolution for conv2d\n", 0);
+            conv2dDirect_<X, Y>(input, weights, output, kH, kW, sH, sW, pH, pW, dH, dW, isNCHW);
+        }
+
+        if(bias)
+            output->applyBroadcast(broadcast::Add, {indIOioC}, bias);
+
+        return;
+    }
+
     std::vector<int> permutForOutput;
     if(!isNCHW)
         input = input->permute({0, 3, 1, 2});                                       // [bS, iH, iW, iC] -> [bS, iC, iH, iW] if NHWC
     else
         permutForOutput = {0, indOoH, indOoH+1, indIOioC};                          // [bS, oC, oH, oW] -> [bS, oH, oW, oC]
 
-    NDArray columns(input->ordering(), {bS, iC, kH, kW, oH, oW}, input->dataType(), input->getWorkspace());
-
     //----- calculation of output -----//
-    graph::LaunchContext ctx;
-    helpers::im2col(ctx, *input, columns, kH, kW, sH, sW, pH, pW, dH, dW, NDArrayFactory::create(0.f, input->getWorkspace()));  // [bS, iC, iH, iW] is convoluted to [bS, iC, kH, kW, oH, oW]
-    MmulHelper::tensorDot(&columns, weights, output, {1,2,3}, {indWiC, indWkH, indWkH+1}, permutForOutput); // [bS, iC, kH, kW, oH, oW] x [kH, kW, iC, oC]/[oC, iC, kH, kW] = [bS, oH, oW, oC]
+    if(useConvTiles(bS, iC, kH, kW, oH, oW, input->sizeOfT())) {
+        nd4j_debug("Using tiled im2col for conv2d\n", 0);
+        conv2dTiled(input, weights, output, kH, kW, sH, sW, pH, pW, dH, dW, isNCHW);
+    }
+    else {
+        NDArray columns(input->ordering(), {bS, iC, kH, kW, oH, oW}, input->dataType(), input->getWorkspace());
+        graph::LaunchContext ctx;
+        helpers::im2col(ctx, *input, columns, kH, kW, sH, sW, pH, pW, dH, dW, NDArrayFactory::create(0.f, input->getWorkspace()));  // [bS, iC, iH, iW] is convoluted to [bS, iC, kH, kW, oH, oW]
+        MmulHelper::tensorDot(&columns, weights, output, {1,2,3}, {indWiC, indWkH, indWkH+1}, permutForOutput); // [bS, iC, kH, kW, oH, oW] x [kH, kW, iC, oC]/[oC, iC, kH, kW] = [bS, oH, oW, oC]
+    }
 
     //----- add biases if required -----//
     if(bias)
@@ -693,14 +1261,12 @@ static void conv2dBP_(nd4j::graph::Context& block, const NDArray* input, const N
 
 #ifdef HAVE_MKLDNN
     if (block.isUseMKLDNN() && nd4j::MKLDNNStream::isSupported<X, Y>()) {
-        std::vector<nd4j::MKLDNNStream>& streams = block.getMKLDNNStreams();
-        if (streams.empty()) {
-            streams.push_back(MKLDNNStream("conv2d_bp_weights"));
-            streams.push_back(MKLDNNStream("conv2d_bp_data"));
-        }
+        std::vector<nd4j::MKLDNNStream> streams;
+        streams.push_back(MKLDNNStream("conv2d_bp_weights"));
+        streams.push_back(MKLDNNStream("conv2d_bp_data"));
 
-        bool resetW = streams[0].checkAndReset({input, weights, bias, gradO}, {gradI, gradW, gradB}, {}, {kH, kW, sH, sW, pH, pW, dH, dW, isSameMode, isNCHW});
-        bool resetI = streams[1].checkAndReset({input, weights, bias, gradO}, {gradI, gradW, gradB}, {}, {kH, kW, sH, sW, pH, pW, dH, dW, isSameMode, isNCHW});
+        bool resetW = gradW != nullptr && streams[0].checkAndReset({input, weights, bias, gradO}, {gradI, gradW, gradB}, {}, {kH, kW, sH, sW, pH, pW, dH, dW, isSameMode, isNCHW});
+        bool resetI = gradI != nullptr && streams[1].checkAndReset({input, weights, bias, gradO}, {gradI, gradW, gradB}, {}, {kH, kW, sH, sW, pH, pW, dH, dW, isSameMode, isNCHW});
         if (resetW || resetI) {
             mkldnn_memory_desc_t empty;
             mkldnn::memory::desc conv_src_md(empty), conv_diff_src_md(empty), conv_weights_md(empty),
@@ -781,15 +1347,6 @@ static void conv2dBP_(nd4j::graph::Context& block, const NDArray* input, const N
     else
         gradOaxesForDot  = {0, 2, 3};                                           // bS, oH, oW
 
-    NDArray columns(input->ordering(), {bS, iC, kH, kW, oH, oW}, input->dataType(), input->getWorkspace());
-
-    // ----- calculation of gradW ----- //
-    if(gradW) {
-        graph::LaunchContext ctx;
-        helpers::im2col(ctx, *input, columns, kH, kW, sH, sW, pH, pW, dH, dW, NDArrayFactory::create(0.f, input->getWorkspace()));   // [bS, iC, iH, iW] is convoluted to [bS, iC, kH, kW, oH, oW]
-        nd4j::MmulHelper::tensorDot(&columns, gradO, gradW, {0,4,5}, gradOaxesForDot, {2, 0, 1, 3});       // [bS, iC, kH, kW, oH, oW] x [bS, oH, oW, oC]/[bS, oC, oH, oW] = [iC, kH, kW, oC]
-    }
-
     // ----- calculation of gradB ----- //
     if(gradB) {
         NDArray* gradBR = gradB;
@@ -800,10 +1357,24 @@ static void conv2dBP_(nd4j::graph::Context& block, const NDArray* input, const N
             delete gradBR;
     }
 
-    //----- calculation of gradI -----//
-    nd4j::MmulHelper::tensorDot(weights, gradO, &columns, {indWoC}, {indIOioC}, {2, 3, 1, 0, 4, 5});  // [kH, kW, iC, oC]/[oC, iC, kH, kW]] x [bS, oH, oW, oC]/[bS, oC, oH, oW] = [kH, kW, iC, bS, oH, oW]
-    graph::LaunchContext ctx;
-    helpers::col2im(ctx, columns, *gradI, sH, sW, pH, pW, iH, iW, dH, dW);                          // [bS, iC, kH, kW, oH, oW] is de-convoluted to [bS, iC, iH, iW]
+    if(useConvTiles(bS, iC, kH, kW, oH, oW, input->sizeOfT())) {
+        nd4j_debug("Using tiled im2col for conv2d_bp\n", 0);
+        conv2dBPTiled(input, weights, gradO, gradI, gradW, kH, kW, sH, sW, pH, pW, dH, dW, isNCHW);
+    }
+    else {
+        NDArray columns(input->ordering(), {bS, iC, kH, kW, oH, oW}, input->dataType(), input->getWorkspace());
+        graph::LaunchContext ctx;
+
+        // ----- calculation of gradW ----- //
+        if(gradW) {
+            helpers::im2col(ctx, *input, columns, kH, kW, sH, sW, pH, pW, dH, dW, NDArrayFactory::create(0.f, input->getWorkspace()));   // [bS, iC, iH, iW] is convoluted to [bS, iC, kH, kW, oH, oW]
+            nd4j::MmulHelper::tensorDot(&columns, gradO, gradW, {0,4,5}, gradOaxesForDot, {2, 0, 1, 3});       // [bS, iC, kH, kW, oH, oW] x [bS, oH, oW, oC]/[bS, oC, oH, oW] = [iC, kH, kW, oC]
+        }
+
+        //----- calculation of gradI -----//
+        nd4j::MmulHelper::tensorDot(weights, gradO, &columns, {indWoC}, {indIOioC}, {2, 3, 1, 0, 4, 5});  // [kH, kW, iC, oC]/[oC, iC, kH, kW]] x [bS, oH, oW, oC]/[bS, oC, oH, oW] = [kH, kW, iC, bS, oH, oW]
+        helpers::col2im(ctx, columns, *gradI, sH, sW, pH, pW, iH, iW, dH, dW);                          // [bS, iC, kH, kW, oH, oW] is de-convoluted to [bS, iC, iH, iW]
+    }
 
     if(!isNCHW) {
         delete input;
@@ -853,20 +1424,26 @@ static void depthwiseConv2d_(const NDArray* input, const NDArray* weights, const
     if(isSameMode)                       // SAME
         ConvolutionUtils::calcPadding2D(pH, pW, oH, oW, iH, iW, kH, kW, sH, sW, dH, dW);
 
-    NDArray columns(input->ordering(), {bS, iC, kH, kW, oH, oW}, input->dataType(), input->getWorkspace());
-    NDArray* outputReshaped = output->reshape(output->ordering(), outReShape);
+    if(useConvTiles(bS, iC, kH, kW, oH, oW, input->sizeOfT())) {
+        nd4j_debug("Using tiled im2col for depthwise_conv2d\n", 0);
+        depthwiseConv2dTiled(input, weights, output, kH, kW, sH, sW, pH, pW, dH, dW, isNCHW);
+    }
+    else {
+        NDArray columns(input->ordering(), {bS, iC, kH, kW, oH, oW}, input->dataType(), input->getWorkspace());
+        NDArray* outputReshaped = output->reshape(output->ordering(), outReShape);
 
-    graph::LaunchContext ctx;
-    helpers::im2col(ctx, *input, columns, kH, kW, sH, sW, pH, pW, dH, dW, NDArrayFactory::create(0.f, input->getWorkspace()));  // [bS, iC, iH, iW] is convoluted to [bS, iC, kH, kW, oH, oW]
-    MmulHelper::tensorDot(&columns, weights, outputReshaped, modifColumns, {{2,0,1,3},{iC,kH*kW,mC}}, modifOutput);              // [iC, bS*oH*oW, kW*kH] x [iC, kH*kW, mC] = [iC, bS*oH*oW, mC]
+        graph::LaunchContext ctx;
+        helpers::im2col(ctx, *input, columns, kH, kW, sH, sW, pH, pW, dH, dW, NDArrayFactory::create(0.f, input->getWorkspace()));  // [bS, iC, iH, iW] is convoluted to [bS, iC, kH, kW, oH, oW]
+        MmulHelper::tensorDot(&columns, weights, outputReshaped, modifColumns, {{2,0,1,3},{iC,kH*kW,mC}}, modifOutput);              // [iC, bS*oH*oW, kW*kH] x [iC, kH*kW, mC] = [iC, bS*oH*oW, mC]
+
+        delete outputReshaped;
+    }
 
     if(bias)
         output->applyBroadcast(broadcast::Add, {indIOioC}, bias);
 
     if(!isNCHW)
         delete input;
-
-    delete outputReshaped;
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -1270,10 +1847,8 @@ static void pooling2d_(nd4j::graph::Context& block, const NDArray& input, NDArra
 
 #ifdef HAVE_MKLDNN
     if (poolingMode < 2 && block.isUseMKLDNN() && nd4j::MKLDNNStream::isSupported<T, T>()) {
-        std::vector<nd4j::MKLDNNStream>& streams = block.getMKLDNNStreams();
-        if (streams.empty()) {
-            streams.push_back(MKLDNNStream("pooling2d"));
-        }
+        std::vector<nd4j::MKLDNNStream> streams;
+        streams.push_back(MKLDNNStream("pooling2d"));
 
         if (streams[0].checkAndReset({&input}, {&output}, {}, {kH, kW, sH, sW, pH, pW, dH, dW, poolingMode, extraParam0})) {
             mkldnn_memory_desc_t empty;
@@ -1490,10 +2065,8 @@ static void pooling3d_(nd4j::graph::Context& block, const NDArray& input, NDArra
 
 #ifdef HAVE_MKLDNN
     if (poolingMode < 2 && block.isUseMKLDNN() && nd4j::MKLDNNStream::isSupported<T, T>()) {
-        std::vector<nd4j::MKLDNNStream>& streams = block.getMKLDNNStreams();
-        if (streams.empty()) {
-            streams.push_back(MKLDNNStream("pooling3d"));
-        }
+        std::vector<nd4j::MKLDNNStream> streams;
+        streams.push_back(MKLDNNStream("pooling3d"));
 
         if (streams[0].checkAndReset({&input}, {&output}, {}, {kD, kH, kW, sD, sH, sW, pD, pH, pW, dD, dH, dW, poolingMode, extraParam0})) {
             mkldnn_memory_desc_t empty;
@@ -1753,10 +2326,8 @@ static void pooling2dBP_(nd4j::graph::Context& block, const NDArray& input, cons
 
 #ifdef HAVE_MKLDNN
     if (poolingMode < 2 && block.isUseMKLDNN() && nd4j::MKLDNNStream::isSupported<T, T>()) {
-        std::vector<nd4j::MKLDNNStream>& streams = block.getMKLDNNStreams();
-        if (streams.empty()) {
-            streams.push_back(MKLDNNStream("pooling2d_bp"));
-        }
+        std::vector<nd4j::MKLDNNStream> streams;
+        streams.push_back(MKLDNNStream("pooling2d_bp"));
 
         if (streams[0].checkAndReset({&input, &gradO}, {&gradI}, {}, {kH, kW, sH, sW, pH, pW, dH, dW, poolingMode, extraParam0})) {
             mkldnn_memory_desc_t empty;
@@ -1784,25 +2355,19 @@ static void pooling2dBP_(nd4j::graph::Context& block, const NDArray& input, cons
             auto poolB_dst_memory = mkldnn::memory(poolB_prim_desc.diff_dst_primitive_desc(), const_cast<NDArray&>(gradO).buffer());
             if (algorithm == mkldnn::pooling_max) {
                 auto pool_workspace_memory = mkldnn::memory(pool_prim_desc.workspace_primitive_desc());
-                if (streams.size() < 2) {
-                    streams.push_back(MKLDNNStream("pooling2d"));
-                }
                 auto pool_src_memory = mkldnn::memory(pool_prim_desc.src_primitive_desc(), const_cast<NDArray&>(input).buffer());
                 auto pool_dst_memory = mkldnn::memory(pool_prim_desc.dst_primitive_desc());
-                streams[1].setMemory({pool_src_memory, pool_dst_memory});
-                streams[1].setOperation(pooling_forward(pool_prim_desc, pool_src_memory, pool_dst_memory, pool_workspace_memory));
 
-                streams[0].setMemory({poolB_dst_memory, pool_workspace_memory, poolB_src_memory});
-                streams[0].setOperation(pooling_backward(poolB_prim_desc, poolB_dst_memory, pool_workspace_memory, poolB_src_memory));
+                // forward pass fills workspace used by backward one, so both live in the same primitive
+                streams[0].setMemory({pool_src_memory, pool_dst_memory, poolB_dst_memory, pool_workspace_memory, poolB_src_memory});
+                streams[0].setOperations({pooling_forward(pool_prim_desc, pool_src_memory, pool_dst_memory, pool_workspace_memory),
+                                          pooling_backward(poolB_prim_desc, poolB_dst_memory, pool_workspace_memory, poolB_src_memory)});
             } else {
                 streams[0].setMemory({poolB_dst_memory, poolB_src_memory});
                 streams[0].setOperation(pooling_backward(poolB_prim_desc, poolB_dst_memory, poolB_src_memory));
             }
         }
 
-        if (streams.size() > 1) {
-            streams[1].submitAndWait();
-        }
         streams[0].submitAndWait();
         return;
     }
@@ -2013,10 +2578,8 @@ static void pooling3dBP_(nd4j::graph::Context& block, const NDArray& input, cons
 
 #ifdef HAVE_MKLDNN
     if (poolingMode < 2 && block.isUseMKLDNN() && nd4j::MKLDNNStream::isSupported<T, T>()) {
-        std::vector<nd4j::MKLDNNStream>& streams = block.getMKLDNNStreams();
-        if (streams.empty()) {
-            streams.push_back(MKLDNNStream("pooling3d_bp"));
-        }
+        std::vector<nd4j::MKLDNNStream> streams;
+        streams.push_back(MKLDNNStream("pooling3d_bp"));
 
         if (streams[0].checkAndReset({&input, &gradO}, {&gradI}, {}, {kD, kH, kW, sD, sH, sW, pD, pH, pW, dD, dH, dW, poolingMode, extraParam0})) {
             mkldnn_memory_desc_t empty;
@@ -2044,25 +2607,19 @@ static void pooling3dBP_(nd4j::graph::Context& block, const NDArray& input, cons
             auto poolB_dst_memory = mkldnn::memory(poolB_prim_desc.diff_dst_primitive_desc(), const_cast<NDArray&>(gradO).buffer());
             if (algorithm == mkldnn::pooling_max) {
                 auto pool_workspace_memory = mkldnn::memory(pool_prim_desc.workspace_primitive_desc());
-                if (streams.size() < 2) {
-                    streams.push_back(MKLDNNStream("pooling3d"));
-                }
                 auto pool_src_memory = mkldnn::memory(pool_prim_desc.src_primitive_desc(), const_cast<NDArray&>(input).buffer());
                 auto pool_dst_memory = mkldnn::memory(pool_prim_desc.dst_primitive_desc());
-                streams[1].setMemory({pool_src_memory, pool_dst_memory});
-                streams[1].setOperation(pooling_forward(pool_prim_desc, pool_src_memory, pool_dst_memory, pool_workspace_memory));
 
-                streams[0].setMemory({poolB_dst_memory, pool_workspace_memory, poolB_src_memory});
-                streams[0].setOperation(pooling_backward(poolB_prim_desc, poolB_dst_memory, pool_workspace_memory, poolB_src_memory));
+                // forward pass fills workspace used by backward one, so both live in the same primitive
+                streams[0].setMemory({pool_src_memory, pool_dst_memory, poolB_dst_memory, pool_workspace_memory, poolB_src_memory});
+                streams[0].setOperations({pooling_forward(pool_prim_desc, pool_src_memory, pool_dst_memory, pool_workspace_memory),
+                                          pooling_backward(poolB_prim_desc, poolB_dst_memory, pool_workspace_memory, poolB_src_memory)});
             } else {
                 streams[0].setMemory({poolB_dst_memory, poolB_src_memory});
                 streams[0].setOperation(pooling_backward(poolB_prim_desc, poolB_dst_memory, poolB_src_memory));
             }
         }
 
-        if (streams.size() > 1) {
-            streams[1].submitAndWait();
-        }
         streams[0].submitAndWait();
         return;
     }
@@ -193,17 +193,16 @@ CUSTOM_OP_IMPL(batchnorm_new, 3, 1, false, 1, 2) {
 
 #ifdef HAVE_MKLDNN
     if (block.isUseMKLDNN() && nd4j::MKLDNNStream::isSupported({input, mean, variance, gamma, beta, output}) && numOfAxes == 1) {
-        std::vector<nd4j::MKLDNNStream>& streams = block.getMKLDNNStreams();
-        if (streams.empty()) {
-            streams.push_back(MKLDNNStream("batchnorm_new"));
-        }
+        std::vector<nd4j::MKLDNNStream> streams;
+        streams.push_back(MKLDNNStream("batchnorm_new"));
 
         std::vector<Nd4jLong> shape({2, mean->lengthOf()});
         NDArray weights = NDArrayFactory::create<float>('c', shape, block.getWorkspace());
         weights({0, 1, 0, 0}).assign(1.0f);
         weights({1, 2, 0, 0}).assign(0.0f);
 
-        if (streams[0].checkAndReset({input, mean, variance, gamma, beta}, {output}, {epsilon}, axes)) {
+        // weights are passed as well, so that cached primitive gets rebound to this temporary array
+        if (streams[0].checkAndReset({input, mean, variance, gamma, beta, &weights}, {output}, {epsilon}, axes)) {
             mkldnn_memory_desc_t empty;
             mkldnn::memory::desc batchnorm_src_md(empty);
 
@@ -60,10 +60,7 @@ CONFIGURABLE_OP_IMPL(softmax_bp, 2, 1, true, 0, 0) {
 
     REQUIRE_TRUE(dim < rank, 0, "SOFTMAX_BP OP: the value of input integer parameter (dimension) must be less than input array rank %i, but got dimension = %i instead !", rank, dim);
     
-    helpers::softmax(*input, *gradI, dim);
-
-    auto sumAlongDim = (*gradI * *gradO).reduceAlongDims(reduce::Sum, {dim}, true);
-    gradI->assign(*gradI * (*gradO - sumAlongDim));
+    helpers::softmaxBP(*input, *gradO, *gradI, dim);
 
     return Status::OK();
 }
@@ -37,7 +37,16 @@ namespace helpers {
 
     void logSoftMaxForVector(const NDArray &input, NDArray &output);
 
-    void softmax(const NDArray &input, NDArray &output, const int dimension);
+    /**
+     * Fused softmax and log-softmax along given dimension, and their backprop: input is read once for max and sum of exponents
+     */
+    void softmax(const NDArray &input, NDArray &output, int dimension);
+
+    void logSoftmax(const NDArray &input, NDArray &output, int dimension);
+
+    void softmaxBP(const NDArray &input, const NDArray &gradO, NDArray &gradI, int dimension);
+
+    void logSoftmaxBP(const NDArray &input, const NDArray &gradO, NDArray &gradI, int dimension);
 
     void prelu(const NDArray &input, const NDArray &alpha, NDArray &output);
 
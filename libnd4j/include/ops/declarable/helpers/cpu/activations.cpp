@@ -21,7 +21,11 @@
 
 #include <ops/declarable/helpers/activations.h>
 #include <ShapeUtils.h>
+#include <helpers/ConstantTadHelper.h>
+#include <OmpLaunchHelper.h>
 #include <numeric>
+#include <limits>
+#include <type_traits>
 
 namespace nd4j    {
 namespace ops     {
@@ -88,7 +92,7 @@ namespace helpers {
         if (inEWS == 1) {
 #pragma omp simd reduction(maxT:max)
             for (int i = 0; i < length; i++)
-                max = nd4j::math::nd4j_max<T>(max, outBuff[i]);
+                max = nd4j::math::nd4j_max<T>(max, inBuff[i]);
 
 #pragma omp simd reduction(sumT:sum)
             for (int i = 0; i < length; i++) {
@@ -105,7 +109,7 @@ namespace helpers {
 
 #pragma omp simd reduction(maxT:max)
             for (int i = 0; i < length; i++)
-                max = nd4j::math::nd4j_max<T>(max, outBuff[i * inEWS]);
+                max = nd4j::math::nd4j_max<T>(max, inBuff[i * inEWS]);
 
 #pragma omp simd reduction(sumT:sum)
             for (int i = 0; i < length; i++) {
@@ -142,25 +146,381 @@ namespace helpers {
     }
 
     //////////////////////////////////////////////////////////////////////////
-    void softmax(const NDArray& input, NDArray& output, const int dimension) {
+    // half precision types are accumulated in float
+    template <typename T>
+    using SoftmaxAcc = typename std::conditional<sizeof(T) < sizeof(float), float, T>::type;
+
+    // online max + sum of exponents over [start, stop) of strided line: sum is rescaled whenever max grows,
+    // so input is streamed from memory once. Blocks are small enough to be read twice from L1
+    template <typename T, typename A>
+    static FORCEINLINE void softmaxStats_(const T *x, const Nd4jLong stride, const Nd4jLong start, const Nd4jLong stop, A &max, A &sum) {
+        const Nd4jLong block = 1024;
+
+        for (Nd4jLong b = start; b < stop; b += block) {
+            const Nd4jLong e = nd4j::math::nd4j_min<Nd4jLong>(stop, b + block);
+
+            A blockMax = max;
+#pragma omp simd reduction(maxT:blockMax)
+            for (Nd4jLong i = b; i < e; i++)
+                blockMax = nd4j::math::nd4j_max<A>(blockMax, static_cast<A>(x[i * stride]));
+
+            if (blockMax > max) {
+                sum *= nd4j::math::nd4j_exp<A, A>(max - blockMax);
+                max = blockMax;
+            }
+
+            A blockSum = 0;
+#pragma omp simd reduction(sumT:blockSum)
+            for (Nd4jLong i = b; i < e; i++)
+                blockSum += nd4j::math::nd4j_exp<A, A>(static_cast<A>(x[i * stride]) - max);
+
+            sum += blockSum;
+        }
+    }
+
+    // merges stats of two parts of the same line
+    template <typename A>
+    static FORCEINLINE void softmaxMerge_(A &max, A &sum, const A otherMax, const A otherSum) {
+        if (otherMax > max) {
+            sum = sum * nd4j::math::nd4j_exp<A, A>(max - otherMax) + otherSum;
+            max = otherMax;
+        } else if (otherSum != static_cast<A>(0))
+            sum += otherSum * nd4j::math::nd4j_exp<A, A>(otherMax - max);
+    }
+
+    // writes softmax or log-softmax over [start, stop) of line
+    template <typename T, typename A>
+    static FORCEINLINE void softmaxWrite_(const T *x, const Nd4jLong xStride, T *z, const Nd4jLong zStride, const Nd4jLong start, const Nd4jLong stop, const A max, const A sum, const bool isLog) {
+        if (isLog) {
+            const A shift = max + nd4j::math::nd4j_log<A, A>(sum);
+#pragma omp simd
+            for (Nd4jLong i = start; i < stop; i++)
+                z[i * zStride] = static_cast<T>(static_cast<A>(x[i * xStride]) - shift);
+        } else {
+            const A factor = static_cast<A>(1) / sum;
+#pragma omp simd
+            for (Nd4jLong i = start; i < stop; i++)
+                z[i * zStride] = static_cast<T>(nd4j::math::nd4j_exp<A, A>(static_cast<A>(x[i * xStride]) - max) * factor);
+        }
+    }
+
+    // writes softmax over [start, stop) of line, and returns its dot product with gradient
+    template <typename T, typename A>
+    static FORCEINLINE A softmaxDot_(const T *x, const Nd4jLong xStride, const T *g, const Nd4jLong gStride, T *z, const Nd4jLong zStride, const Nd4jLong start, const Nd4jLong stop, const A max, const A sum) {
+        const A factor = static_cast<A>(1) / sum;
+        A dot = 0;
+
+#pragma omp simd reduction(sumT:dot)
+        for (Nd4jLong i = start; i < stop; i++) {
+            const A sm = nd4j::math::nd4j_exp<A, A>(static_cast<A>(x[i * xStride]) - max) * factor;
+            z[i * zStride] = static_cast<T>(sm);
+            dot += sm * static_cast<A>(g[i * gStride]);
+        }
+
+        return dot;
+    }
+
+    // turns softmax stored in z into gradient
+    template <typename T, typename A>
+    static FORCEINLINE void softmaxGrad_(const T *g, const Nd4jLong gStride, T *z, const Nd4jLong zStride, const Nd4jLong start, const Nd4jLong stop, const A dot, const bool isLog) {
+        if (isLog) {
+#pragma omp simd
+            for (Nd4jLong i = start; i < stop; i++)
+                z[i * zStride] = static_cast<T>(static_cast<A>(g[i * gStride]) - dot);
+        } else {
+#pragma omp simd
+            for (Nd4jLong i = start; i < stop; i++)
+                z[i * zStride] = static_cast<T>(static_cast<A>(z[i * zStride]) * (static_cast<A>(g[i * gStride]) - dot));
+        }
+    }
+
+    // processes lines along dimension, one line per thread, or single line split between threads
+    template <typename T>
+    static void softmaxLines_(const T *x, const Nd4jLong *xOffsets, const Nd4jLong xStride, const T *g, const Nd4jLong *gOffsets, const Nd4jLong gStride, T *z, const Nd4jLong *zOffsets, const Nd4jLong zStride, const Nd4jLong numLines, const Nd4jLong n, const bool isLog) {
+        typedef SoftmaxAcc<T> A;
+        const A lowest = -std::numeric_limits<A>::infinity();
+
+        if (numLines == 1) {
+            OmpLaunchHelper info(n);
+            std::vector<A> maxs(info._numThreads, lowest), sums(info._numThreads, 0), dots(info._numThreads, 0);
+
+#pragma omp parallel num_threads(info._numThreads) if (info._numThreads > 1) default(shared)
+            {
+                // runtime may give us fewer threads than requested (i.e. within other parallel region), so line is split by actual team size
+                const int numThreads = omp_get_num_threads();
+                const int t = omp_get_thread_num();
+                const Nd4jLong span = (n + numThreads - 1) / numThreads;
+                const Nd4jLong start = nd4j::math::nd4j_min<Nd4jLong>(n, t * span);
+                const Nd4jLong stop = nd4j::math::nd4j_min<Nd4jLong>(n, start + span);
+
+                softmaxStats_<T, A>(x, xStride, start, stop, maxs[t], sums[t]);
+#pragma omp barrier
+
+                // every thread merges partial stats on its own, there are just a few of them
+                A max = maxs[0], sum = sums[0];
+                for (int e = 1; e < numThreads; e++)
+                    softmaxMerge_<A>(max, sum, maxs[e], sums[e]);
+
+                if (g == nullptr)
+                    softmaxWrite_<T, A>(x, xStride, z, zStride, start, stop, max, sum, isLog);
+                else {
+                    dots[t] = softmaxDot_<T, A>(x, xStride, g, gStride, z, zStride, start, stop, max, sum);
+#pragma omp barrier
+
+                    A dot = 0;
+                    for (int e = 0; e < numThreads; e++)
+                        dot += dots[e];
+
+                    softmaxGrad_<T, A>(g, gStride, z, zStride, start, stop, dot, isLog);
+                }
+            }
+
+            return;
+        }
+
+        const int numThreads = OmpLaunchHelper::betterThreads(numLines * n, (int) nd4j::math::nd4j_min<Nd4jLong>(numLines, omp_get_max_threads()));
+
+#pragma omp parallel for num_threads(numThreads) if (numThreads > 1) schedule(guided)
+        for (Nd4jLong e = 0; e < numLines; e++) {
+            // lines without offsets are contiguous rows
+            auto xLine = x + (xOffsets == nullptr ? e * n : xOffsets[e]);
+            auto zLine = z + (zOffsets == nullptr ? e * n : zOffsets[e]);
+
+            A max = lowest, sum = 0;
+            softmaxStats_<T, A>(xLine, xStride, 0, n, max, sum);
+
+            if (g == nullptr)
+                softmaxWrite_<T, A>(xLine, xStride, zLine, zStride, 0, n, max, sum, isLog);
+            else {
+                auto gLine = g + (gOffsets == nullptr ? e * n : gOffsets[e]);
+                auto dot = softmaxDot_<T, A>(xLine, xStride, gLine, gStride, zLine, zStride, 0, n, max, sum);
+                softmaxGrad_<T, A>(gLine, gStride, zLine, zStride, 0, n, dot, isLog);
+            }
+        }
+    }
+
+    // processes c-ordered contiguous arrays viewed as [outer, n, inner], along middle dimension.
+    // Rows of inner elements are read contiguously, and stats are kept per chunk of inner elements
+    template <typename T>
+    static void softmaxInner_(const T *x, const T *g, T *z, const Nd4jLong outer, const Nd4jLong n, const Nd4jLong inner, const bool isLog) {
+        typedef SoftmaxAcc<T> A;
+        const int chunk = 256;
+        const Nd4jLong numChunks = (inner + chunk - 1) / chunk;
+        const Nd4jLong numTasks = outer * numChunks;
 
+        const int numThreads = OmpLaunchHelper::betterThreads(outer * n * inner, (int) nd4j::math::nd4j_min<Nd4jLong>(numTasks, omp_get_max_threads()));
+
+#pragma omp parallel for num_threads(numThreads) if (numThreads > 1) schedule(guided)
+        for (Nd4jLong t = 0; t < numTasks; t++) {
+            A max[chunk], sum[chunk], dot[chunk];
+
+            const Nd4jLong first = (t / numChunks) * n * inner + (t % numChunks) * chunk;
+            const int len = (int) nd4j::math::nd4j_min<Nd4jLong>(chunk, inner - (t % numChunks) * chunk);
+
+            for (int i = 0; i < len; i++) {
+                max[i] = static_cast<A>(x[first + i]);
+                sum[i] = static_cast<A>(1);
+            }
+
+            // online max + sum, single exponent per element
+            for (Nd4jLong k = 1; k < n; k++) {
+                auto row = x + first + k * inner;
+                for (int i = 0; i < len; i++) {
+                    const A v = static_cast<A>(row[i]);
+                    if (v > max[i]) {
+                        sum[i] = sum[i] * nd4j::math::nd4j_exp<A, A>(max[i] - v) + static_cast<A>(1);
+                        max[i] = v;
+                    } else
+                        sum[i] += nd4j::math::nd4j_exp<A, A>(v - max[i]);
+                }
+            }
+
+            if (g == nullptr) {
+                for (int i = 0; i < len; i++) {
+                    if (isLog)
+                        max[i] += nd4j::math::nd4j_log<A, A>(sum[i]);
+                    else
+                        sum[i] = static_cast<A>(1) / sum[i];
+                }
+
+                for (Nd4jLong k = 0; k < n; k++) {
+                    auto xRow = x + first + k * inner;
+                    auto zRow = z + first + k * inner;
+
+                    if (isLog) {
+#pragma omp simd
+                        for (int i = 0; i < len; i++)
+                            zRow[i] = static_cast<T>(static_cast<A>(xRow[i]) - max[i]);
+                    } else {
+#pragma omp simd
+                        for (int i = 0; i < len; i++)
+                            zRow[i] = static_cast<T>(nd4j::math::nd4j_exp<A, A>(static_cast<A>(xRow[i]) - max[i]) * sum[i]);
+                    }
+                }
+            } else {
+                for (int i = 0; i < len; i++) {
+                    sum[i] = static_cast<A>(1) / sum[i];
+                    dot[i] = static_cast<A>(0);
+                }
+
+                for (Nd4jLong k = 0; k < n; k++) {
+                    auto xRow = x + first + k * inner;
+                    auto gRow = g + first + k * inner;
+                    auto zRow = z + first + k * inner;
+
+#pragma omp simd
+                    for (int i = 0; i < len; i++) {
+                        const A sm = nd4j::math::nd4j_exp<A, A>(static_cast<A>(xRow[i]) - max[i]) * sum[i];
+                        zRow[i] = static_cast<T>(sm);
+                        dot[i] += sm * static_cast<A>(gRow[i]);
+                    }
+                }
+
+                for (Nd4jLong k = 0; k < n; k++) {
+                    auto gRow = g + first + k * inner;
+                    auto zRow = z + first + k * inner;
+
+                    if (isLog) {
+#pragma omp simd
+                        for (int i = 0; i < len; i++)
+                            zRow[i] = static_cast<T>(static_cast<A>(gRow[i]) - dot[i]);
+                    } else {
+#pragma omp simd
+                        for (int i = 0; i < len; i++)
+                            zRow[i] = static_cast<T>(static_cast<A>(zRow[i]) * (static_cast<A>(gRow[i]) - dot[i]));
+                    }
+                }
+            }
+        }
+    }
+
+    template <typename T>
+    static void softmax_(const NDArray &input, const NDArray *gradO, NDArray &output, const int dimension, const bool isLog) {
         const int rank = input.rankOf();
+        const Nd4jLong n = rank == 0 ? 1 : input.sizeAt(dimension);
+        const Nd4jLong numLines = input.lengthOf() / n;
+
+        auto x = reinterpret_cast<T *>(input.getBuffer());
+        auto g = gradO == nullptr ? nullptr : reinterpret_cast<T *>(gradO->getBuffer());
+        auto z = reinterpret_cast<T *>(output.getBuffer());
+
+        bool contiguous = input.ordering() == 'c' && input.ews() == 1 && output.ordering() == 'c' && output.ews() == 1;
+        if (gradO != nullptr)
+            contiguous &= gradO->ordering() == 'c' && gradO->ews() == 1;
+
+        // scalar is a single line of length 1
+        if (contiguous || rank == 0) {
+            Nd4jLong inner = 1;
+            for (int e = dimension + 1; e < rank; e++)
+                inner *= input.sizeAt(e);
 
-        if(input.isVector()) {
-        
-            if(rank == 1 || input.sizeAt(dimension) != 1)
-                softMaxForVector(input, output);
+            if (inner == 1)
+                softmaxLines_<T>(x, nullptr, 1, g, nullptr, 1, z, nullptr, 1, numLines, n, isLog);
             else
-                output = 1.;
+                softmaxInner_<T>(x, g, z, numLines / inner, n, inner, isLog);
+
+            return;
         }
-        else {
-            auto maxAlongDim = const_cast<NDArray&>(input).reduceAlongDims(reduce::Max, {dimension}, true);
-            auto exponents = (input - maxAlongDim).transform(transform::Exp);
-            auto sumAlongDim = exponents.reduceAlongDims(reduce::Sum, {dimension}, true);
 
-            // FIXME: assign?
-            output.assign(exponents / sumAlongDim);
+        // anything else goes line by line, using TAD offsets and stride along dimension
+        auto packX = ConstantTadHelper::getInstance()->tadForDimensions(input.getShapeInfo(), dimension);
+        auto packZ = ConstantTadHelper::getInstance()->tadForDimensions(output.getShapeInfo(), dimension);
+
+        const Nd4jLong *gOffsets = nullptr;
+        Nd4jLong gStride = 0;
+        TadPack packG;
+        if (gradO != nullptr) {
+            packG = ConstantTadHelper::getInstance()->tadForDimensions(gradO->getShapeInfo(), dimension);
+            gOffsets = packG.primaryOffsets();
+            gStride = gradO->stridesOf()[dimension];
         }
+
+        softmaxLines_<T>(x, packX.primaryOffsets(), input.stridesOf()[dimension], g, gOffsets, gStride, z, packZ.primaryOffsets(), output.stridesOf()[dimension], numLines, n, isLog);
+    }
+
+    // fused kernels work on arrays of the same floating point type only
+    static bool softmaxFusable(const NDArray &input, const NDArray *gradO, const NDArray &output) {
+        if (!input.isR() || input.dataType() != output.dataType() || !input.isSameShape(output))
+            return false;
+
+        if (gradO != nullptr && (gradO->dataType() != input.dataType() || !input.isSameShape(gradO)))
+            return false;
+
+        return true;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void softmax(const NDArray& input, NDArray& output, int dimension) {
+        if (input.isEmpty())
+            return;
+
+        if (dimension < 0)
+            dimension += input.rankOf();
+
+        if (softmaxFusable(input, nullptr, output)) {
+            BUILD_SINGLE_SELECTOR(input.dataType(), softmax_, (input, nullptr, output, dimension, false), FLOAT_TYPES);
+            return;
+        }
+
+        auto maxAlongDim = const_cast<NDArray&>(input).reduceAlongDims(reduce::Max, {dimension}, true);
+        auto exponents = (input - maxAlongDim).transform(transform::Exp);
+        auto sumAlongDim = exponents.reduceAlongDims(reduce::Sum, {dimension}, true);
+
+        output.assign(exponents / sumAlongDim);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void logSoftmax(const NDArray& input, NDArray& output, int dimension) {
+        if (input.isEmpty())
+            return;
+
+        if (dimension < 0)
+            dimension += input.rankOf();
+
+        if (softmaxFusable(input, nullptr, output)) {
+            BUILD_SINGLE_SELECTOR(input.dataType(), softmax_, (input, nullptr, output, dimension, true), FLOAT_TYPES);
+            return;
+        }
+
+        softmax(input, output, dimension);
+        output.applyTransform(transform::Log);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void softmaxBP(const NDArray& input, const NDArray& gradO, NDArray& gradI, int dimension) {
+        if (input.isEmpty())
+            return;
+
+        if (dimension < 0)
+            dimension += input.rankOf();
+
+        if (softmaxFusable(input, &gradO, gradI)) {
+            BUILD_SINGLE_SELECTOR(input.dataType(), softmax_, (input, &gradO, gradI, dimension, false), FLOAT_TYPES);
+            return;
+        }
+
+        softmax(input, gradI, dimension);
+
+        auto sumAlongDim = (gradI * gradO).reduceAlongDims(reduce::Sum, {dimension}, true);
+        gradI.assign(gradI * (gradO - sumAlongDim));
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void logSoftmaxBP(const NDArray& input, const NDArray& gradO, NDArray& gradI, int dimension) {
+        if (input.isEmpty())
+            return;
+
+        if (dimension < 0)
+            dimension += input.rankOf();
+
+        if (softmaxFusable(input, &gradO, gradI)) {
+            BUILD_SINGLE_SELECTOR(input.dataType(), softmax_, (input, &gradO, gradI, dimension, true), FLOAT_TYPES);
+            return;
+        }
+
+        softmax(input, gradI, dimension);
+
+        gradI.assign(gradO - (gradI * gradO).reduceAlongDims(reduce::Sum, {dimension}, true));
     }
 
     //////////////////////////////////////////////////////////////////////////
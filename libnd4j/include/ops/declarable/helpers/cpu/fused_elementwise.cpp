@@ -0,0 +1,234 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <ops/declarable/helpers/fused_elementwise.h>
+#include <graph/generated/utils_generated.h>
+#include <ops/ops.h>
+#include <ops/special_ops.h>
+#include <loops/legacy_ops.h>
+#include <NDArrayFactory.h>
+#include <NativeOpExcutioner.h>
+#include <Environment.h>
+
+using namespace simdOps;
+
+namespace nd4j {
+namespace ops {
+namespace helpers {
+
+    // number of elements processed by all steps at once, 16KB for floats, so block stays in L1/L2 between steps
+    static const Nd4jLong FUSED_BLOCK = 4096;
+
+    template <typename X>
+    class FusedBlock {
+    public:
+        // all operands of fused ops share the same type, names are expected by dispatch macros
+        typedef X Y;
+        typedef X Z;
+
+        template <typename OpType>
+        static void special(bool &result) {
+            result = OpType::requiresSpecial;
+        }
+
+        template <typename OpType>
+        static void transform(const X *x, X *z, Nd4jLong length, X *extras) {
+#pragma omp simd
+            for (Nd4jLong e = 0; e < length; e++)
+                z[e] = OpType::op(x[e], extras);
+        }
+
+        template <typename OpType>
+        static void scalar(const X *x, const X y, X *z, Nd4jLong length, X *extras) {
+#pragma omp simd
+            for (Nd4jLong e = 0; e < length; e++)
+                z[e] = OpType::op(x[e], y, extras);
+        }
+
+        template <typename OpType>
+        static void pairwise(const X *x, const X *y, X *z, Nd4jLong length, X *extras) {
+#pragma omp simd
+            for (Nd4jLong e = 0; e < length; e++)
+                z[e] = OpType::op(x[e], y[e], extras);
+        }
+
+        static bool requiresSpecial(int opType, int opNum) {
+            bool result = true;
+            switch (opType) {
+                case nd4j::graph::OpType_TRANSFORM_SAME: {
+                        DISPATCH_BY_OPNUM_T(special, PARAMS(result), TRANSFORM_SAME_OPS);
+                    }
+                    break;
+                case nd4j::graph::OpType_TRANSFORM_FLOAT: {
+                        DISPATCH_BY_OPNUM_TT(special, PARAMS(result), TRANSFORM_FLOAT_OPS);
+                    }
+                    break;
+                case nd4j::graph::OpType_TRANSFORM_STRICT: {
+                        DISPATCH_BY_OPNUM_T(special, PARAMS(result), TRANSFORM_STRICT_OPS);
+                    }
+                    break;
+                case nd4j::graph::OpType_SCALAR:
+                case nd4j::graph::OpType_PAIRWISE:
+                    result = false;
+                    break;
+                default:
+                    break;
+            }
+
+            return result;
+        }
+
+        static void apply(int opType, int opNum, const X *x, const X *y, const X scalarY, X *z, Nd4jLong length, X *extras) {
+            switch (opType) {
+                case nd4j::graph::OpType_TRANSFORM_SAME: {
+                        DISPATCH_BY_OPNUM_T(transform, PARAMS(x, z, length, extras), TRANSFORM_SAME_OPS);
+                    }
+                    break;
+                case nd4j::graph::OpType_TRANSFORM_FLOAT: {
+                        DISPATCH_BY_OPNUM_TT(transform, PARAMS(x, z, length, extras), TRANSFORM_FLOAT_OPS);
+                    }
+                    break;
+                case nd4j::graph::OpType_TRANSFORM_STRICT: {
+                        DISPATCH_BY_OPNUM_T(transform, PARAMS(x, z, length, extras), TRANSFORM_STRICT_OPS);
+                    }
+                    break;
+                case nd4j::graph::OpType_SCALAR: {
+                        DISPATCH_BY_OPNUM_TTT(scalar, PARAMS(x, scalarY, z, length, extras), SCALAR_OPS);
+                    }
+                    break;
+                case nd4j::graph::OpType_PAIRWISE: {
+                        DISPATCH_BY_OPNUM_TTT(pairwise, PARAMS(x, y, z, length, extras), PAIRWISE_TRANSFORM_OPS);
+                    }
+                    break;
+                default:
+                    throw std::runtime_error("fusedElementwise: unsupported op type");
+            }
+        }
+    };
+
+    bool isFusableElementwise(int opType, int opNum) {
+        return !FusedBlock<float>::requiresSpecial(opType, opNum);
+    }
+
+    template <typename X>
+    static void fusedElementwise_(const std::vector<ElementwiseStep> &steps, const std::vector<NDArray*> &inputs, NDArray *output) {
+        const auto numSteps = (int) steps.size();
+        const auto length = output->lengthOf();
+
+        auto x = reinterpret_cast<X *>(inputs[0]->getBuffer());
+        auto z = reinterpret_cast<X *>(output->getBuffer());
+
+        std::vector<X *> sides(numSteps, nullptr);
+        std::vector<X> scalars(numSteps, (X) 0.f);
+        for (int s = 0; s < numSteps; s++) {
+            auto &step = steps[s];
+            if (step.input < 0)
+                scalars[s] = static_cast<X>(step.scalar);
+            else if (step.opType == nd4j::graph::OpType_SCALAR)
+                scalars[s] = inputs[step.input]->e<X>(0);
+            else
+                sides[s] = reinterpret_cast<X *>(inputs[step.input]->getBuffer());
+        }
+
+        const auto numBlocks = (length + FUSED_BLOCK - 1) / FUSED_BLOCK;
+
+        // every step of a block reads and writes output block, so intermediate results never leave cache
+#pragma omp parallel for schedule(static) if (length > Environment::getInstance()->elementwiseThreshold() && numBlocks > 1) default(shared)
+        for (Nd4jLong b = 0; b < numBlocks; b++) {
+            const auto start = b * FUSED_BLOCK;
+            const auto span = nd4j::math::nd4j_min<Nd4jLong>(FUSED_BLOCK, length - start);
+
+            const X *current = x + start;
+            for (int s = 0; s < numSteps; s++) {
+                auto &step = steps[s];
+                auto extras = reinterpret_cast<X *>(const_cast<double *>(step.extraParams.data()));
+                FusedBlock<X>::apply(step.opType, step.opNum, current, sides[s] == nullptr ? nullptr : sides[s] + start, scalars[s], z + start, span, extras);
+                current = z + start;
+            }
+        }
+    }
+
+    // arrays of any layout and type: each step is executed by legacy loops, output holds intermediate results
+    static void sequentialElementwise(const std::vector<ElementwiseStep> &steps, const std::vector<NDArray*> &inputs, NDArray *output) {
+        auto current = inputs[0];
+        for (auto &step : steps) {
+            auto extras = const_cast<double *>(step.extraParams.data());
+
+            switch (step.opType) {
+                case nd4j::graph::OpType_TRANSFORM_SAME:
+                    NativeOpExcutioner::execTransformSame(step.opNum, current->getBuffer(), current->getShapeInfo(), output->getBuffer(), output->getShapeInfo(), extras, nullptr, nullptr);
+                    break;
+                case nd4j::graph::OpType_TRANSFORM_FLOAT:
+                    NativeOpExcutioner::execTransformFloat(step.opNum, current->getBuffer(), current->getShapeInfo(), output->getBuffer(), output->getShapeInfo(), extras, nullptr, nullptr);
+                    break;
+                case nd4j::graph::OpType_TRANSFORM_STRICT:
+                    NativeOpExcutioner::execTransformStrict(step.opNum, current->getBuffer(), current->getShapeInfo(), output->getBuffer(), output->getShapeInfo(), extras, nullptr, nullptr);
+                    break;
+                case nd4j::graph::OpType_SCALAR: {
+                        if (step.input < 0) {
+                            auto y = NDArrayFactory::create(output->dataType(), step.scalar, output->getWorkspace());
+                            NativeOpExcutioner::execScalar(step.opNum, current->getBuffer(), current->getShapeInfo(), output->getBuffer(), output->getShapeInfo(), y.buffer(), y.shapeInfo(), extras);
+                        } else {
+                            auto y = inputs[step.input];
+                            NativeOpExcutioner::execScalar(step.opNum, current->getBuffer(), current->getShapeInfo(), output->getBuffer(), output->getShapeInfo(), y->getBuffer(), y->getShapeInfo(), extras);
+                        }
+                    }
+                    break;
+                case nd4j::graph::OpType_PAIRWISE: {
+                        auto y = inputs[step.input];
+                        NativeOpExcutioner::execPairwiseTransform(step.opNum, current->getBuffer(), current->getShapeInfo(), y->getBuffer(), y->getShapeInfo(), output->getBuffer(), output->getShapeInfo(), extras);
+                    }
+                    break;
+                default:
+                    throw std::runtime_error("fusedElementwise: unsupported op type");
+            }
+
+            current = output;
+        }
+    }
+
+    static bool isDirect(const NDArray *array, const NDArray *output) {
+        return array->dataType() == output->dataType() && array->lengthOf() == output->lengthOf() && array->ordering() == output->ordering() && array->ews() == 1;
+    }
+
+    void fusedElementwise(const std::vector<ElementwiseStep> &steps, const std::vector<NDArray*> &inputs, NDArray *output) {
+        if (steps.empty() || inputs.empty())
+            throw std::runtime_error("fusedElementwise: at least one step and one input are required");
+
+        bool direct = output->isR() && output->ews() == 1 && isDirect(inputs[0], output);
+        for (auto &step : steps) {
+            if (!direct || step.input < 0)
+                continue;
+
+            auto y = inputs[step.input];
+            if (step.opType == nd4j::graph::OpType_SCALAR)
+                direct = y->dataType() == output->dataType() && y->lengthOf() >= 1;
+            else
+                direct = isDirect(y, output);
+        }
+
+        if (!direct) {
+            sequentialElementwise(steps, inputs, output);
+            return;
+        }
+
+        BUILD_SINGLE_SELECTOR(output->dataType(), fusedElementwise_, (steps, inputs, output), FLOAT_TYPES);
+    }
+
+    BUILD_SINGLE_TEMPLATE(template void fusedElementwise_, (const std::vector<ElementwiseStep> &steps, const std::vector<NDArray*> &inputs, NDArray *output), FLOAT_TYPES);
+}
+}
+}
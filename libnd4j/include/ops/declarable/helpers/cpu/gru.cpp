@@ -25,6 +25,9 @@
 
 
 #include<ops/declarable/helpers/gru.h>
+#include <ops/declarable/helpers/rnn_utils.h>
+#include <helpers/MmulHelper.h>
+#include <Environment.h>
 
 namespace nd4j 	  {
 namespace ops 	  {
@@ -72,6 +75,92 @@ void gruCell(const NDArray* x, const NDArray* h0, const NDArray* Wx, const NDArr
     h->assign( u * (*h0) + (1.f - u) * n );
 }
 
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void gruTimeLoop_(const NDArray* x, const NDArray* h0, const NDArray* Wx, const NDArray* Wh, const NDArray* b, NDArray* h) {
+
+    const Nd4jLong time = x->sizeAt(0);
+    const Nd4jLong bS   = x->sizeAt(1);
+    const Nd4jLong iS   = x->sizeAt(2);
+    const Nd4jLong nU   = h0->sizeAt(1);
+    const Nd4jLong rows = time * bS;
+    auto workspace = h->getWorkspace();
+
+    auto xC  = contiguous(x);
+    auto h0C = contiguous(h0);
+    auto bC  = contiguous(b);
+
+    // input projection of all time steps at once: [time*bS x iS] * [iS x 3*nU]
+    NDArray xFlat(xC->buffer(), 'c', {rows, iS}, x->dataType(), workspace);
+    NDArray xW('f', {rows, 3*nU}, x->dataType(), workspace);
+    MmulHelper::mmul(&xFlat, const_cast<NDArray*>(Wx), &xW, 1., 0.);
+
+    // recurrent weights of gates and of candidate are used separately, so they are split once
+    auto WhRU = (*Wh)({0,0, 0,2*nU}).dup('f');
+    auto WhN  = (*Wh)({0,0, 2*nU,3*nU}).dup('f');
+
+    // buffers reused at every time step
+    NDArray hPrev(h0C->buffer(), 'c', {bS, nU}, x->dataType(), workspace);
+    NDArray hRU('f', {bS, 2*nU}, x->dataType(), workspace);
+    NDArray hN('f', {bS, nU}, x->dataType(), workspace);
+    NDArray rh('c', {bS, nU}, x->dataType(), workspace);
+    NDArray u('c', {bS, nU}, x->dataType(), workspace);
+
+    const T* pXW   = xW.bufferAsT<T>();
+    const T* pHRU  = hRU.bufferAsT<T>();
+    const T* pHN   = hN.bufferAsT<T>();
+    const T* pBias = bC->bufferAsT<T>();
+    T* pRH = rh.bufferAsT<T>();
+    T* pU  = u.bufferAsT<T>();
+    T* pH  = h->bufferAsT<T>();
+    const bool parallel = bS * nU > Environment::getInstance()->elementwiseThreshold();
+
+    for (Nd4jLong t = 0; t < time; ++t) {
+
+        // previous output is read in place: initial one or output of previous step
+        if (t > 0)
+            hPrev.setBuffer(pH + (t - 1) * bS * nU);
+        const T* ht_1 = hPrev.bufferAsT<T>();
+        T* ht = pH + t * bS * nU;
+
+        MmulHelper::mmul(&hPrev, WhRU, &hRU, 1., 0.);
+
+        // reset and update gates
+#pragma omp parallel for if(parallel) schedule(static) collapse(2)
+        for (Nd4jLong e = 0; e < bS; e++) {
+            for (Nd4jLong j = 0; j < nU; j++) {
+                const Nd4jLong row = t * bS + e;
+                const T r = nd4j::math::nd4j_sigmoid<T, T>(pXW[j * rows + row]        + pHRU[j * bS + e]        + pBias[j]);
+                pU[e * nU + j] = nd4j::math::nd4j_sigmoid<T, T>(pXW[(nU + j) * rows + row] + pHRU[(nU + j) * bS + e] + pBias[nU + j]);
+                pRH[e * nU + j] = r * ht_1[e * nU + j];
+            }
+        }
+
+        MmulHelper::mmul(&rh, WhN, &hN, 1., 0.);
+
+        // candidate and current output
+#pragma omp parallel for if(parallel) schedule(static) collapse(2)
+        for (Nd4jLong e = 0; e < bS; e++) {
+            for (Nd4jLong j = 0; j < nU; j++) {
+                const Nd4jLong row = t * bS + e;
+                const T n  = nd4j::math::nd4j_tanh<T, T>(pXW[(2 * nU + j) * rows + row] + pHN[j * bS + e] + pBias[2 * nU + j]);
+                const T ue = pU[e * nU + j];
+                ht[e * nU + j] = ue * ht_1[e * nU + j] + ((T) 1.f - ue) * n;
+            }
+        }
+    }
+
+    delete WhRU;
+    delete WhN;
+
+    if (xC != x)
+        delete xC;
+    if (h0C != h0)
+        delete h0C;
+    if (bC != b)
+        delete bC;
+}
+
 //////////////////////////////////////////////////////////////////////////
 void gruTimeLoop(const NDArray* x, const NDArray* h0, const NDArray* Wx, const NDArray* Wh, const NDArray* b, NDArray* h) {
 
@@ -83,6 +172,17 @@ void gruTimeLoop(const NDArray* x, const NDArray* h0, const NDArray* Wx, const N
     
     // h is cell outputs at each time step [time, bS, nU]
 
+    // fused loop works over raw buffers of output, so it must be c-ordered and all types must be the same
+    const auto dtype = x->dataType();
+    bool fused = x->isR() && h->ordering() == 'c' && h->ews() == 1;
+    for (auto arr : {h0, Wx, Wh, b, (const NDArray*) h})
+        fused &= arr->dataType() == dtype;
+
+    if (fused) {
+        BUILD_SINGLE_SELECTOR(dtype, gruTimeLoop_, (x, h0, Wx, Wh, b, h), FLOAT_TYPES);
+        return;
+    }
+
     const int time = x->sizeAt(0);    
 
     NDArray ht_1(*h0);
@@ -258,7 +358,9 @@ void gruCellBP(const NDArray* x, const NDArray* h0, const NDArray* Wx, const NDA
 // }
 
 
+
+BUILD_SINGLE_TEMPLATE(template void gruTimeLoop_, (const NDArray* x, const NDArray* h0, const NDArray* Wx, const NDArray* Wh, const NDArray* b, NDArray* h), FLOAT_TYPES);
+
 }
 }
 }
-
@@ -60,9 +60,10 @@ static void im2col_(graph::LaunchContext& context, const NDArray& input,  NDArra
     T *col, *im;
     int imRow, imCol;
             
+    // loops are collapsed, so that small batch (i.e. single image or one tile of implicit GEMM conv) still keeps all threads busy
     if (shape::order(imShapeBuffer) == 'c' &&  shape::order(colShapeBuffer) == 'c' && shape::strideDescendingCAscendingF(imShapeBuffer) && shape::strideDescendingCAscendingF(colShapeBuffer)) {
 
-#pragma omp parallel for schedule(static) proc_bind(close) private(col, im, imRow, imCol)
+#pragma omp parallel for schedule(static) proc_bind(close) private(col, im, imRow, imCol) collapse(4)
     	for (int b = 0; b < bS; b++) {
         	for (int c = 0; c < iC; ++c) {        
             	for (int kRow = 0; kRow < kH; ++kRow) {                        
@@ -89,7 +90,7 @@ static void im2col_(graph::LaunchContext& context, const NDArray& input,  NDArra
     }
     else {
  
-#pragma omp parallel for schedule(static) proc_bind(close) private(im, col, imRow, imCol)    
+#pragma omp parallel for schedule(static) proc_bind(close) private(im, col, imRow, imCol) collapse(3)
     	for (int b = 0; b < bS; b++) {
         	for (int colH = 0; colH < oH; ++colH) {
             	for (int colW = 0; colW < oW; ++colW) {
@@ -71,10 +71,8 @@ static void getMKLDNNMemoryDescLrn(const NDArray* src, const NDArray* diff_src,
 
 #ifdef HAVE_MKLDNN
     if (block.isUseMKLDNN() && nd4j::MKLDNNStream::isSupported({input, output})) {
-        std::vector<nd4j::MKLDNNStream>& streams = block.getMKLDNNStreams();
-        if (streams.empty()) {
-            streams.push_back(MKLDNNStream("lrn"));
-        }
+        std::vector<nd4j::MKLDNNStream> streams;
+        streams.push_back(MKLDNNStream("lrn"));
 
         if (streams[0].checkAndReset({input}, {output}, {bias, alpha, beta}, {depth})) {
             mkldnn_memory_desc_t empty;
@@ -130,10 +128,8 @@ static void getMKLDNNMemoryDescLrn(const NDArray* src, const NDArray* diff_src,
 #ifdef HAVE_MKLDNN_DISABLED
 //XXX: need to get output to match exactly with MKL-DNN
     if (block.isUseMKLDNN() && nd4j::MKLDNNStream::isSupported({input, scale, output})) {
-        std::vector<nd4j::MKLDNNStream>& streams = block.getMKLDNNStreams();
-        if (streams.empty()) {
-            streams.push_back(MKLDNNStream("lrn_bp"));
-        }
+        std::vector<nd4j::MKLDNNStream> streams;
+        streams.push_back(MKLDNNStream("lrn_bp"));
 
         if (streams[0].checkAndReset({input, scale}, {output}, {bias, alpha, beta}, {depth})) {
             mkldnn_memory_desc_t empty;
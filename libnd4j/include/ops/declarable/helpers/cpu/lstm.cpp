@@ -27,6 +27,9 @@
 
 
 #include<ops/declarable/helpers/lstm.h>
+#include <ops/declarable/helpers/rnn_utils.h>
+#include <helpers/MmulHelper.h>
+#include <Environment.h>
 
 namespace nd4j 	  {
 namespace ops 	  {
@@ -129,6 +132,118 @@ void lstmCell(const NDArray* xt, const NDArray* ht_1, const NDArray* ct_1, const
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void lstmTimeLoop_(const NDArray* x, const NDArray* h0, const NDArray* c0, const NDArray* Wx, const NDArray* Wh, const NDArray* Wc, const NDArray* Wp, const NDArray* b,
+                          NDArray* h, NDArray* c, const std::vector<double>& params) {
+
+    const bool peephole   = (bool)params[0];
+    const bool projection = (bool)params[1];
+    const T clippingCellValue = nd4j::math::nd4j_abs<T>(static_cast<T>(params[2]));
+    const T clippingProjValue = nd4j::math::nd4j_abs<T>(static_cast<T>(params[3]));
+    const T forgetBias        = static_cast<T>(params[4]);
+
+    const Nd4jLong time     = x->sizeAt(0);
+    const Nd4jLong bS       = x->sizeAt(1);
+    const Nd4jLong inSize   = x->sizeAt(2);
+    const Nd4jLong numProj  = h->sizeAt(2);
+    const Nd4jLong numUnits = c->sizeAt(2);
+    const Nd4jLong rows     = time * bS;
+    auto workspace = h->getWorkspace();
+
+    auto xC  = contiguous(x);
+    auto c0C = contiguous(c0);
+    auto bC  = contiguous(b);
+    auto WcC = peephole ? contiguous(Wc) : nullptr;
+
+    // input projection of all time steps at once: [time*bS x inSize] * [inSize x 4*numUnits]
+    NDArray xFlat(xC->buffer(), 'c', {rows, inSize}, x->dataType(), workspace);
+    NDArray xW('f', {rows, 4*numUnits}, x->dataType(), workspace);
+    MmulHelper::mmul(&xFlat, const_cast<NDArray*>(Wx), &xW, 1., 0.);
+
+    // buffers reused at every time step
+    NDArray hW('f', {bS, 4*numUnits}, x->dataType(), workspace);
+    NDArray hPrev(h->buffer(), 'c', {bS, numProj}, x->dataType(), workspace);
+    NDArray* hNoProj = projection ? new NDArray('c', {bS, numUnits}, x->dataType(), workspace) : nullptr;
+    NDArray* hProj   = projection ? new NDArray('f', {bS, numProj},  x->dataType(), workspace) : nullptr;
+
+    const T* pXW   = xW.bufferAsT<T>();
+    const T* pHW   = hW.bufferAsT<T>();
+    const T* pBias = bC->bufferAsT<T>();
+    const T* pWc   = peephole ? WcC->bufferAsT<T>() : nullptr;
+    T* pH = h->bufferAsT<T>();
+    T* pC = c->bufferAsT<T>();
+    const bool parallel = bS * numUnits > Environment::getInstance()->elementwiseThreshold();
+
+    for (Nd4jLong t = 0; t < time; ++t) {
+
+        // previous state is read in place: initial one or outputs of previous step
+        const T* cPrev = t == 0 ? c0C->bufferAsT<T>() : pC + (t - 1) * bS * numUnits;
+        if (t > 0)
+            hPrev.setBuffer(pH + (t - 1) * bS * numProj);
+
+        // recurrent projection: [bS x numProj] * [numProj x 4*numUnits]
+        MmulHelper::mmul(t == 0 ? const_cast<NDArray*>(h0) : &hPrev, const_cast<NDArray*>(Wh), &hW, 1., 0.);
+
+        T* ct = pC + t * bS * numUnits;
+        T* ht = projection ? hNoProj->bufferAsT<T>() : pH + t * bS * numProj;
+
+        // all gates, cell state and output in single pass
+#pragma omp parallel for if(parallel) schedule(static) collapse(2)
+        for (Nd4jLong e = 0; e < bS; e++) {
+            for (Nd4jLong u = 0; u < numUnits; u++) {
+                const Nd4jLong row = t * bS + e;
+                T zi = pXW[u * rows + row]                  + pHW[u * bS + e]                  + pBias[u];
+                T zf = pXW[(numUnits + u) * rows + row]     + pHW[(numUnits + u) * bS + e]     + pBias[numUnits + u];
+                T zc = pXW[(2 * numUnits + u) * rows + row] + pHW[(2 * numUnits + u) * bS + e] + pBias[2 * numUnits + u];
+                T zo = pXW[(3 * numUnits + u) * rows + row] + pHW[(3 * numUnits + u) * bS + e] + pBias[3 * numUnits + u];
+
+                const T cp = cPrev[e * numUnits + u];
+                if (peephole) {
+                    zi += cp * pWc[u];
+                    zf += cp * pWc[numUnits + u];
+                }
+
+                T cs = nd4j::math::nd4j_sigmoid<T, T>(zf + forgetBias) * cp + nd4j::math::nd4j_sigmoid<T, T>(zi) * nd4j::math::nd4j_tanh<T, T>(zc);
+                if (clippingCellValue != (T) 0.f)
+                    cs = simdOps::LstmClip<T, T, T>::op(cs, clippingCellValue, nullptr);
+
+                if (peephole)
+                    zo += cs * pWc[2 * numUnits + u];
+
+                ct[e * numUnits + u] = cs;
+                ht[e * numUnits + u] = nd4j::math::nd4j_sigmoid<T, T>(zo) * nd4j::math::nd4j_tanh<T, T>(cs);
+            }
+        }
+
+        if (projection) {
+            MmulHelper::mmul(hNoProj, const_cast<NDArray*>(Wp), hProj, 1., 0.);
+
+            // f-ordered projection is moved into c-ordered output, with clipping if required
+            const T* pProj = hProj->bufferAsT<T>();
+            T* hOut = pH + t * bS * numProj;
+
+            for (Nd4jLong e = 0; e < bS; e++)
+                for (Nd4jLong p = 0; p < numProj; p++) {
+                    const T value = pProj[p * bS + e];
+                    hOut[e * numProj + p] = clippingProjValue != (T) 0.f ? simdOps::LstmClip<T, T, T>::op(value, clippingProjValue, nullptr) : value;
+                }
+        }
+    }
+
+    delete hNoProj;
+    delete hProj;
+
+    if (xC != x)
+        delete xC;
+    if (c0C != c0)
+        delete c0C;
+    if (bC != b)
+        delete bC;
+    if (WcC != nullptr && WcC != Wc)
+        delete WcC;
+}
+
 //////////////////////////////////////////////////////////////////////////
 void lstmTimeLoop(const NDArray* x, const NDArray* h0, const NDArray* c0, const NDArray* Wx, const NDArray* Wh, const NDArray* Wc, const NDArray* Wp, const NDArray* b,
                   NDArray* h, NDArray* c, const std::vector<double>& params) {
@@ -146,6 +261,21 @@ void lstmTimeLoop(const NDArray* x, const NDArray* h0, const NDArray* c0, const
     // h cell outputs [time x bS x numProj], that is per each time step
     // c cell states  [time x bS x numUnits] that is per each time step
 
+    // fused loop works over raw buffers of outputs, so they must be c-ordered and all types must be the same
+    const auto dtype = x->dataType();
+    bool fused = x->isR() && h->ordering() == 'c' && h->ews() == 1 && c->ordering() == 'c' && c->ews() == 1;
+    for (auto arr : {h0, c0, Wx, Wh, b, (const NDArray*) h, (const NDArray*) c})
+        fused &= arr->dataType() == dtype;
+    if ((bool)params[0])
+        fused &= Wc->dataType() == dtype;
+    if ((bool)params[1])
+        fused &= Wp->dataType() == dtype;
+
+    if (fused) {
+        BUILD_SINGLE_SELECTOR(dtype, lstmTimeLoop_, (x, h0, c0, Wx, Wh, Wc, Wp, b, h, c, params), FLOAT_TYPES);
+        return;
+    }
+
     const int time  = x->sizeAt(0);
 
     NDArray currentH(*h0);
@@ -163,6 +293,7 @@ void lstmTimeLoop(const NDArray* x, const NDArray* h0, const NDArray* c0, const
     }    
 }
 
+BUILD_SINGLE_TEMPLATE(template void lstmTimeLoop_, (const NDArray* x, const NDArray* h0, const NDArray* c0, const NDArray* Wx, const NDArray* Wh, const NDArray* Wc, const NDArray* Wp, const NDArray* b, NDArray* h, NDArray* c, const std::vector<double>& params), FLOAT_TYPES);
 
 }
 }
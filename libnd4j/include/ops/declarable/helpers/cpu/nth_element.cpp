@@ -19,6 +19,8 @@
 //
 
 #include <ops/declarable/helpers/nth_element.h>
+#include <helpers/ConstantTadHelper.h>
+#include <helpers/SortEngine.h>
 
 namespace nd4j {
 namespace ops {
@@ -27,37 +29,30 @@ namespace helpers {
     template <typename T>
     void nthElementFunctor_(NDArray* input, NDArray* nVal, NDArray* output) {
         Nd4jLong n = nVal->e<Nd4jLong>(0);
-        // TODO: fix using std::nth_element to use typename T instead float or avoid use double with this op.
-        if (input->isVector()) {
-            std::vector<float> data(input->lengthOf());
-            //memcpy(&data[0], input->getBuffer(), sizeof(T) * data.size());
-            size_t l = 0;
-            for (size_t l = 0; l < data.size(); ++l)
-                data[l] = input->e<float>(l);
-            auto nthPos = data.begin();
-            nthPos += n;
-            std::nth_element(data.begin(), nthPos, data.end());
-            output->p<float>(0, data[n]);
-        }
-        else { // rank greater than 1
-            std::vector<int> lastDims({input->rankOf() - 1});
-            std::unique_ptr<ResultSet> rows(input->allTensorsAlongDimension(lastDims));
-#pragma omp parallel for
-            for (Nd4jLong e = 0; e < output->lengthOf(); e++) {
-                auto row = rows->at(e);
-                std::vector<float> internalData(row->lengthOf());
-                //T* internalP = const_cast<T*>(internalData.data());
-                for (size_t l = 0; l < internalData.size(); ++l)
-                    internalData[l] = row->e<float>(l);
+        const Nd4jLong width = input->sizeAt(-1);
+
+        auto packX = ConstantTadHelper::getInstance()->tadForDimensions(input->getShapeInfo(), input->rankOf() - 1);
+        const Nd4jLong numOfSubArrs = packX.numberOfTads();
+        const Nd4jLong xEws = shape::elementWiseStride(packX.primaryShapeInfo());
+        auto x = reinterpret_cast<T *>(input->getBuffer());
+
+        const int numThreads = OmpLaunchHelper::betterThreads(numOfSubArrs * width, (int) nd4j::math::nd4j_min<Nd4jLong>(numOfSubArrs, omp_get_max_threads()));
 
-                //memcpy(&internalData[0], row->getBuffer(), sizeof(T) * internalData.size());
-                auto nthPos = internalData.begin();
-                nthPos += n;
-                std::nth_element(internalData.begin(), nthPos, internalData.end());
-                output->p<float>(e, internalData[n]);
+#pragma omp parallel num_threads(numThreads) if (numThreads > 1) default(shared)
+        {
+            // selection reorders elements, so every row is copied
+            auto row = new T[width];
+
+#pragma omp for schedule(guided)
+            for (Nd4jLong e = 0; e < numOfSubArrs; e++) {
+                SortEngine::gather(x + packX.primaryOffsets()[e], packX.primaryShapeInfo(), width, xEws, row);
+                output->p<T>(e, SortEngine::nthElement(row, width, n));
             }
+
+            delete[] row;
         }
     }
+
     void nthElementFunctor(NDArray* input, NDArray* n, NDArray* output) {
     BUILD_SINGLE_SELECTOR(input->dataType(), nthElementFunctor_, (input, n, output), LIBND4J_TYPES);
 
@@ -21,7 +21,10 @@
 //
 
 #include<ops/declarable/helpers/sru.h>
+#include <ops/declarable/helpers/rnn_utils.h>
 #include <NDArrayFactory.h>
+#include <helpers/MmulHelper.h>
+#include <Environment.h>
 
 namespace nd4j    {
 namespace ops     {
@@ -146,6 +149,70 @@ void sruCell(const NDArray* x, const NDArray* c0, const NDArray* w, const NDArra
 //     dLdX->assign((*dLdH) * (oneMinusR + dHdR * (*w)({{},{2*inSize, 3*inSize}}) + dHdC * dCdX) + (*dLdC) * dCdX);   
 // }
 
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void sruTimeLoop_(const NDArray* x, const NDArray* c0, const NDArray* w, const NDArray* b, NDArray* h, NDArray* c) {
+
+    const Nd4jLong bS     = x->sizeAt(0);
+    const Nd4jLong inSize = x->sizeAt(1);
+    const Nd4jLong time   = x->sizeAt(2);
+    const Nd4jLong rows   = bS * time;
+    auto workspace = h->getWorkspace();
+
+    // x is [bS x inSize x time], so rows of projection are ordered by batch and then by time step
+    auto xPermuted = const_cast<NDArray*>(x)->permute({0, 2, 1});
+    auto xT = xPermuted->dup('c');                                                          // [bS x time x inSize]
+    auto xC  = contiguous(x);
+    auto c0C = contiguous(c0);
+    auto bC  = contiguous(b);
+    auto wT = const_cast<NDArray*>(w)->transpose();                                        // [inSize x 3*inSize]
+
+    // projection of all time steps at once, there's no recurrent matrix product in SRU
+    NDArray xFlat(xT->buffer(), 'c', {rows, inSize}, x->dataType(), workspace);
+    NDArray xW('f', {rows, 3*inSize}, x->dataType(), workspace);
+    MmulHelper::mmul(&xFlat, wT, &xW, 1., 0.);
+
+    const T* pXW   = xW.bufferAsT<T>();
+    const T* pX    = xC->bufferAsT<T>();
+    const T* pInit = c0C->bufferAsT<T>();
+    const T* pBias = bC->bufferAsT<T>();
+    T* pH = h->bufferAsT<T>();
+    T* pC = c->bufferAsT<T>();
+
+    // every feature of every batch element is independent recurrence over time, state is kept in register
+#pragma omp parallel for if(bS * inSize * time > Environment::getInstance()->elementwiseThreshold()) schedule(static) collapse(2)
+    for (Nd4jLong e = 0; e < bS; e++) {
+        for (Nd4jLong k = 0; k < inSize; k++) {
+            const T bF = pBias[k];
+            const T bR = pBias[inSize + k];
+            T cur = pInit[e * inSize + k];
+
+            for (Nd4jLong t = 0; t < time; t++) {
+                const Nd4jLong row = e * time + t;
+                const Nd4jLong idx = (e * inSize + k) * time + t;
+                const T z  = pXW[k * rows + row];
+                const T ft = nd4j::math::nd4j_sigmoid<T, T>(pXW[(inSize + k) * rows + row] + bF);
+                const T rt = nd4j::math::nd4j_sigmoid<T, T>(pXW[(2 * inSize + k) * rows + row] + bR);
+
+                cur = ft * cur + ((T) 1.f - ft) * z;
+                pC[idx] = cur;
+                pH[idx] = rt * nd4j::math::nd4j_tanh<T, T>(cur) + ((T) 1.f - rt) * pX[idx];
+            }
+        }
+    }
+
+    delete xPermuted;
+    delete xT;
+    delete wT;
+
+    if (xC != x)
+        delete xC;
+    if (c0C != c0)
+        delete c0C;
+    if (bC != b)
+        delete bC;
+}
+
 //////////////////////////////////////////////////////////////////////////
 void sruTimeLoop(const NDArray* x, const NDArray* c0, const NDArray* w, const NDArray* b, NDArray* h, NDArray* c) {
     
@@ -157,6 +224,17 @@ void sruTimeLoop(const NDArray* x, const NDArray* c0, const NDArray* w, const ND
     // h   cell outputs [bS x inSize x time]
     // c   cell states  [bS x inSize x time]
 
+    // fused loop works over raw buffers of outputs, so they must be c-ordered and all types must be the same
+    const auto dtype = x->dataType();
+    bool fused = x->isR() && h->ordering() == 'c' && h->ews() == 1 && c->ordering() == 'c' && c->ews() == 1;
+    for (auto arr : {c0, w, b, (const NDArray*) h, (const NDArray*) c})
+        fused &= arr->dataType() == dtype;
+
+    if (fused) {
+        BUILD_SINGLE_SELECTOR(dtype, sruTimeLoop_, (x, c0, w, b, h, c), FLOAT_TYPES);
+        return;
+    }
+
     w = w->transpose();                             // [3*inSize x inSize] -> [inSize x 3*inSize] 
 
     const int time  = x->sizeAt(2);
@@ -387,6 +465,7 @@ void sruBIBP(NDArray* x, const NDArray* w, const NDArray* b, const NDArray* c0,
 }
 
 
+BUILD_SINGLE_TEMPLATE(template void sruTimeLoop_, (const NDArray* x, const NDArray* c0, const NDArray* w, const NDArray* b, NDArray* h, NDArray* c), FLOAT_TYPES);
 BUILD_SINGLE_TEMPLATE(template void sruBI_,   (NDArray* x, const NDArray* w, const NDArray* b, const NDArray* c0, const NDArray* mask, NDArray* ht, NDArray* ct), FLOAT_TYPES);
 BUILD_SINGLE_TEMPLATE(template void sruBIBP_, (NDArray* x, const NDArray* w, const NDArray* b, const NDArray* c0, const NDArray* ct, const NDArray* inGradC0, const NDArray* inGradH, const NDArray* mask, NDArray* gradI, NDArray* gradW, NDArray* gradB, NDArray* gradC0), FLOAT_TYPES);
 
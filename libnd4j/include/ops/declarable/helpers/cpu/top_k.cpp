@@ -21,6 +21,8 @@
 #include <ops/declarable/helpers/top_k.h>
 #include <ops/declarable/headers/parity_ops.h>
 #include <NDArrayFactory.h>
+#include <helpers/ConstantTadHelper.h>
+#include <helpers/SortEngine.h>
 
 namespace nd4j {
 namespace ops {
@@ -28,154 +30,95 @@ namespace helpers {
 
     template <typename T>
     static int topKFunctor_(NDArray* input, NDArray* values, NDArray* indeces, int k, bool needSort) {
-        Nd4jLong width = input->sizeAt(-1);
-//        Nd4jLong lastDim = input->rankOf() - 1;
-//      FIX ME: lastDim should be Nd4Long not int only?
-        int lastDim = input->rankOf() - 1;
-//        std::unique_ptr<ResultSet> lastDimList(input->allTensorsAlongDimension({lastDim}));
-// ----------------------------------------------------------------------------------------------- //
-// this assumption is right:
-//        if (values->lengthOf() != k * lastDimList->size()) {
-//            nd4j_printf("top_k: something is wrong. %i expected, but %i given.\n",
-//                values->lengthOf(), k * lastDimList->size());
-//        }
-// ----------------------------------------------------------------------------------------------- //
-        std::vector<int> dimsToExclude(input->rankOf() - 1);
-        for (int d = 0; d < dimsToExclude.size(); ++d)
-            dimsToExclude[d] = d;
-
-        const Nd4jLong numOfSubArrs = ShapeUtils::getNumOfSubArrs(input->getShapeInfo(), dimsToExclude);
-
-            if (k == 1) {
-                int pos = 0;
-//#pragma omp parallel for if(numOfSubArrs > Environment::getInstance()->elementwiseThreshold()) schedule(static)
-                for (Nd4jLong e = 0; e < numOfSubArrs; ++e) {
-                    auto trial = (*input)(e, dimsToExclude);
-                    //int maxPos = //lastDimList->at(e)->argMax();
-                    Nd4jLong maxPos = 0;
-                    //trial.printIndexedBuffer("TRIAL:");
-                    T maxVal = trial.e<T>(0);
-                    for (Nd4jLong pos = 1; pos < trial.lengthOf(); pos++)
-                        if (maxVal < trial.e<T>(pos)) {
-                            maxPos = pos;
-                            maxVal = trial.e<T>(pos);
-                        }
-                    if (indeces)
-                        indeces->p(e, maxPos); //topIndex;
-                    if (values)
-                        values->p(e, maxVal);
+        const Nd4jLong width = input->sizeAt(-1);
+        const int lastDim = input->rankOf() - 1;
+
+        auto packX = ConstantTadHelper::getInstance()->tadForDimensions(input->getShapeInfo(), lastDim);
+        const Nd4jLong numOfSubArrs = packX.numberOfTads();
+        const Nd4jLong xEws = shape::elementWiseStride(packX.primaryShapeInfo());
+        auto x = reinterpret_cast<T *>(input->getBuffer());
+
+        // outputs of expected type and layout are written directly, anything else goes through conversion
+        const bool directValues = values != nullptr && values->dataType() == input->dataType() && values->ordering() == 'c' && values->ews() == 1;
+        const bool directIndices = indeces != nullptr && indeces->dataType() == nd4j::DataType::INT64 && indeces->ordering() == 'c' && indeces->ews() == 1;
+
+        const int numThreads = OmpLaunchHelper::betterThreads(numOfSubArrs * width, (int) nd4j::math::nd4j_min<Nd4jLong>(numOfSubArrs, omp_get_max_threads()));
+
+#pragma omp parallel num_threads(numThreads) if (numThreads > 1) default(shared)
+        {
+            T *row = xEws == 1 ? nullptr : new T[width];
+            auto topValues = new T[k];
+            auto topIndices = new Nd4jLong[k];
+
+#pragma omp for schedule(guided)
+            for (Nd4jLong e = 0; e < numOfSubArrs; ++e) {
+                T *data = x + packX.primaryOffsets()[e];
+                if (xEws != 1) {
+                    SortEngine::gather(data, packX.primaryShapeInfo(), width, xEws, row);
+                    data = row;
                 }
+
+                SortEngine::topK(data, width, k, needSort, topValues, topIndices);
+
+                if (directValues)
+                    memcpy(reinterpret_cast<T *>(values->getBuffer()) + e * k, topValues, k * sizeof(T));
+                else if (values != nullptr)
+                    for (int j = 0; j < k; j++)
+                        values->p(e * k + j, topValues[j]);
+
+                if (directIndices)
+                    memcpy(reinterpret_cast<Nd4jLong *>(indeces->getBuffer()) + e * k, topIndices, k * sizeof(Nd4jLong));
+                else if (indeces != nullptr)
+                    for (int j = 0; j < k; j++)
+                        indeces->p(e * k + j, topIndices[j]);
             }
-            else { 
-                int nextPos = 0;
-
-//#pragma omp parallel for if(lastDimList->size() > Environment::getInstance()->elementwiseThreshold()) schedule(static)
-                for (Nd4jLong e = 0; e < numOfSubArrs; ++e) {
-                    auto trial = (*input)(e, dimsToExclude);
-
-                    //auto trialTo = lastDimList->at(e); // a vector to be search
-                    //nd4j_printf("%i: ", e);
-                    //trial.printIndexedBuffer("TRIAL:");
-                    //trialTo->printIndexedBuffer("TOTRI:");
-                    //std::vector<Nd4jLong> topIndices(k);
-                    //std::vector<T> topValues(k);
-
-                    // fill up the first k elements
-                    NDArray topValues = NDArrayFactory::create<T>('c', {k});
-                    NDArray sortedVals = NDArrayFactory::create<T>('c', {k});
-                    NDArray topIndices = NDArrayFactory::create<Nd4jLong>('c', {k});
-                    for (Nd4jLong pos = 0; pos < k; ++pos) {
-                        topIndices.t<Nd4jLong>(pos) = pos;
-                        topValues.t<T>(pos) = trial.t<T>(pos);
-                    }
-                    //std::vector<T> sortedVals(topValues);
-                    sortedVals.assign(topValues);// = NDArrayFactory::create<T>('c', {k});
-                    //std::sort(sortedVals.begin(), sortedVals.end()); // sorted in ascending order
-                    SpecialMethods<T>::sortGeneric(sortedVals.buffer(), sortedVals.shapeInfo(), false);
-                    for (int i = k; i < width; ++i) {
-                        T val = trial.e<T>(i);
-                        T minTopVal = sortedVals.t<T>(0);
-                        if (minTopVal < val) { // value should be inserted to top k
-                            // only if it is not contained in
-                            T* begin = reinterpret_cast<T*>(sortedVals.buffer());
-                            T* end = begin + k;
-                            bool exists = std::binary_search(begin, end, val);
-                            if (!exists) {
-                                //exchangePos - a distance between begin and minimal existed to be suppressed by val
-                                T* topBegin = reinterpret_cast<T*>(topValues.buffer());
-                                T* topEnd = topBegin + k;
-                                auto exchangePos = std::distance(topBegin, std::find(topBegin, topEnd, sortedVals.t<T>(0)));
-                                topValues.t<T>(exchangePos) = val; //*exchangeIt = val;
-                                topIndices.t<Nd4jLong>(exchangePos) = i;
-                                sortedVals.t<T>(0) = val; // suppress in sorted
-                                //std::sort(sortedVals.begin(), sortedVals.end()); // sorted in ascending order
-                                SpecialMethods<T>::sortGeneric(sortedVals.buffer(), sortedVals.shapeInfo(), false);
-                            }
-                        }
-                    }
-                    if (needSort) {
-                        SpecialMethods<T>::sortGeneric(topValues.buffer(), topValues.shapeInfo(), true);
-
-                        for (int j = 0; j < width; j++)
-                            for (int pos = 0; pos < k; ++pos)
-                                if (topValues.t<T>(pos) == trial.t<T>(j))
-                                    topIndices.t<Nd4jLong>(pos) = j;
-                    }
-                    else { // else sort by indices
-                        std::map<Nd4jLong, T> sortValsMap;
-                        //std::vector<std::pair<int, T>> data(topValues.lengthOf());
-                        for (size_t e = 0; e < topValues.lengthOf(); ++e) {
-                            sortValsMap[topIndices.t<Nd4jLong>(e)] = topValues.t<T>(e);
-                        }
-
-                        //std::sort(data.begin(), data.end(), [](std::pair<int, T> const& a, std::pair<int, T> const& b) {
-                        //    return a.first < b.first;
-                        //});
-                        Nd4jLong e = 0;
-                        for (auto it = sortValsMap.begin(); it != sortValsMap.end(); ++it, e++) {
-                            topIndices.t<Nd4jLong>(e) = it->first;
-                            topValues.t<T>(e) = it->second;
-                        }
-
-                    }
-                    if (values)
-                    (*values)(e, dimsToExclude).assign(topValues);
-                    if (indeces)
-                    (*indeces)(e, dimsToExclude).assign(topIndices);
-                }
-                //indeces->printIndexedBuffer("Indices as is");
+
+            delete[] row;
+            delete[] topValues;
+            delete[] topIndices;
         }
+
         return Status::OK();
     }
 // ----------------------------------------------------------------------------------------------- //
 
     template <typename T>
     static int inTopKFunctor_(NDArray* input, NDArray* target, NDArray* result, int k) {
-
-            std::vector<Nd4jLong> shapeI(input->rankOf());
-            for (int i = 0; i < input->rankOf() - 1; i++)
-                shapeI[i] = input->sizeAt(i);
-            shapeI[input->rankOf() - 1] = k;
-            std::unique_ptr<NDArray> indices(NDArrayFactory::create_<Nd4jLong>(input->ordering(), shapeI));
-            NDArray* values = nullptr;
-            int status = topKFunctor(input, values, indices.get(), k, true);
-
-            if (status == ND4J_STATUS_OK) {
-#pragma omp parallel for if(target->lengthOf() > Environment::getInstance()->elementwiseThreshold()) schedule(static)
-                for (int e = 0; e < target->lengthOf(); e++) {
-                    bool found = false;
-                    for (int j = 0; j < k; j++) {
-                        if (target->e<Nd4jLong>(e) == indices->e<Nd4jLong>(e * k + j)) {
-                            found = true;
-                            break;
-                        }
-                    }
-                    if (found)
-                        result->p<bool>(e, true);
+        const Nd4jLong width = input->sizeAt(-1);
+        k = (int) nd4j::math::nd4j_min<Nd4jLong>(k, width);
+
+        auto packX = ConstantTadHelper::getInstance()->tadForDimensions(input->getShapeInfo(), input->rankOf() - 1);
+        const Nd4jLong numOfSubArrs = packX.numberOfTads();
+        const Nd4jLong xEws = shape::elementWiseStride(packX.primaryShapeInfo());
+        auto x = reinterpret_cast<T *>(input->getBuffer());
+
+        const int numThreads = OmpLaunchHelper::betterThreads(numOfSubArrs * width, (int) nd4j::math::nd4j_min<Nd4jLong>(numOfSubArrs, omp_get_max_threads()));
+
+#pragma omp parallel num_threads(numThreads) if (numThreads > 1) default(shared)
+        {
+            T *row = xEws == 1 ? nullptr : new T[width];
+            auto topValues = new T[k];
+            auto topIndices = new Nd4jLong[k];
+
+#pragma omp for schedule(guided)
+            for (Nd4jLong e = 0; e < numOfSubArrs; ++e) {
+                T *data = x + packX.primaryOffsets()[e];
+                if (xEws != 1) {
+                    SortEngine::gather(data, packX.primaryShapeInfo(), width, xEws, row);
+                    data = row;
                 }
+
+                // unsorted selection comes ordered by index
+                SortEngine::topK(data, width, k, false, topValues, topIndices);
+                result->p<bool>(e, std::binary_search(topIndices, topIndices + k, target->e<Nd4jLong>(e)));
             }
-            return status; 
 
+            delete[] row;
+            delete[] topValues;
+            delete[] topIndices;
+        }
+
+        return Status::OK();
     }
 
         int topKFunctor(NDArray* input, NDArray* values, NDArray* indeces, int k, bool needSort) {
@@ -0,0 +1,62 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_FUSED_ELEMENTWISE_H
+#define LIBND4J_FUSED_ELEMENTWISE_H
+
+#include <op_boilerplate.h>
+#include <NDArray.h>
+#include <vector>
+
+namespace nd4j {
+namespace ops {
+namespace helpers {
+
+    /**
+     * Single legacy op within fused chain. Result of previous step (or first input for the first step) is its X operand
+     */
+    struct ElementwiseStep {
+        // one of OpType_TRANSFORM_SAME, OpType_TRANSFORM_FLOAT, OpType_TRANSFORM_STRICT, OpType_SCALAR, OpType_PAIRWISE
+        int opType = 0;
+        int opNum = 0;
+
+        // index of input used as Y operand, -1 for scalar ops that use scalar value below
+        int input = -1;
+        double scalar = 0.0;
+
+        // passed to op as is, the same way legacy ops pass their T arguments
+        std::vector<double> extraParams;
+
+        // id of the graph node this step comes from
+        int nodeId = 0;
+    };
+
+    /**
+     * Returns true if given legacy op is a plain elementwise op, i.e. has no special execution path
+     */
+    bool isFusableElementwise(int opType, int opNum);
+
+    /**
+     * Applies all steps in one pass over memory: data is processed in blocks small enough to stay in cache
+     * while all steps are applied to them. Arrays of other layouts or types are processed step by step
+     */
+    void fusedElementwise(const std::vector<ElementwiseStep> &steps, const std::vector<NDArray*> &inputs, NDArray *output);
+
+}
+}
+}
+
+#endif //LIBND4J_FUSED_ELEMENTWISE_H
@@ -0,0 +1,38 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_RNN_UTILS_H
+#define LIBND4J_RNN_UTILS_H
+
+#include <ops/declarable/helpers/helpers.h>
+
+namespace nd4j    {
+namespace ops     {
+namespace helpers {
+
+//////////////////////////////////////////////////////////////////////////
+// returns arr itself if it is contiguous c-ordered, otherwise its c-ordered copy, which is to be deleted by caller
+FORCEINLINE NDArray* contiguous(const NDArray* arr) {
+
+    return arr->ordering() == 'c' && arr->ews() == 1 ? const_cast<NDArray*>(arr) : const_cast<NDArray*>(arr)->dup('c');
+}
+
+}
+}
+}
+
+
+#endif //LIBND4J_RNN_UTILS_H
@@ -77,6 +77,10 @@ namespace nd4j {
             return _descriptor;
         }
 
+        ShapeCache* DeclarableOp::shapeCache() {
+            return &_shapeCache;
+        }
+
         std::string *DeclarableOp::getOpName() {
             return _descriptor->getOpName();
         }
@@ -141,6 +145,9 @@ namespace nd4j {
                 ShapeList inSha;
                 int results = 0;
 
+                // output shapes can be cached only if all inputs are arrays
+                bool cacheable = true;
+
                 if (Environment::getInstance()->isProfiling() && node != nullptr)
                     inputStart = std::chrono::system_clock::now();
 
@@ -155,7 +162,9 @@ namespace nd4j {
 
                         inSha.push_back(array->getShapeInfo());
 
-                    }
+                    } else
+                        cacheable = false;
+
                     cntIn++;
                 }
 
@@ -168,7 +177,31 @@ namespace nd4j {
                     shapeStart = std::chrono::system_clock::now();
                 }
 
-                auto outSha = this->calculateOutputShape(&inSha, ctx);
+                ShapeList *outSha = nullptr;
+                ShapeCache::ShapePack cached;
+
+                if (cacheable && Environment::getInstance()->shapeCacheLimit() > 0) {
+                    ShapeListDescriptor descriptor(inSha, *ctx.getIArguments(), *ctx.getTArguments(), *ctx.getBArguments(), *ctx.getAxis(), ctx.dataType(), Environment::getInstance()->defaultFloatDataType());
+                    cached = _shapeCache.lookup(descriptor);
+
+                    if (cached == nullptr) {
+                        auto reads = ctx.variableReads();
+                        outSha = this->calculateOutputShape(&inSha, ctx);
+
+                        // shape function has looked into input arrays, so output shapes might depend on values and can't be reused
+                        if (ctx.variableReads() != reads)
+                            _shapeCache.reject(descriptor);
+                        else
+                            _shapeCache.store(descriptor, *outSha);
+                    } else {
+                        // cached shapes are shared, so this list doesn't own them
+                        outSha = new ShapeList({}, true);
+                        for (auto &shapeInfo: *cached)
+                            outSha->push_back(const_cast<Nd4jLong *>(shapeInfo.data()));
+                    }
+                } else
+                    outSha = this->calculateOutputShape(&inSha, ctx);
+
                 results = outSha->size();
 
                 // optionally saving shapeTime
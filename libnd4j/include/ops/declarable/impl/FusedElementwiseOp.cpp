@@ -0,0 +1,63 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <ops/declarable/FusedElementwiseOp.h>
+#include <helpers/ShapeUtils.h>
+#include <Status.h>
+
+namespace nd4j {
+    namespace ops {
+        FusedElementwiseOp::FusedElementwiseOp(const std::vector<nd4j::ops::helpers::ElementwiseStep> &steps) : DeclarableOp::DeclarableOp(-1, 1, "FusedElementwiseOp", true) {
+            _steps = steps;
+        }
+
+        const std::vector<nd4j::ops::helpers::ElementwiseStep>& FusedElementwiseOp::steps() const {
+            return _steps;
+        }
+
+        ShapeList *FusedElementwiseOp::calculateOutputShape(ShapeList *inputShape, nd4j::graph::Context &block) {
+            auto inShape = inputShape->at(0);
+
+            Nd4jLong *newShape;
+            COPY_SHAPE(inShape, newShape);
+
+            return SHAPELIST(newShape);
+        }
+
+        Nd4jStatus FusedElementwiseOp::validateAndExecute(Context &block) {
+            auto z = OUTPUT_VARIABLE(0);
+
+            std::vector<NDArray*> inputs(block.width());
+            for (int e = 0; e < (int) inputs.size(); e++)
+                inputs[e] = INPUT_VARIABLE(e);
+
+            for (auto &step : _steps) {
+                REQUIRE_TRUE(step.input < (int) inputs.size(), 0, "Node_%i: fused step of node %i expects input %i, but only %i inputs available", block.getNodeId(), step.nodeId, step.input, (int) inputs.size());
+
+                if (step.opType == nd4j::graph::OpType_PAIRWISE) {
+                    auto y = inputs[step.input];
+                    REQUIRE_TRUE(inputs[0]->isSameShape(y) || y->isScalar(), 0, "Node_%i: For Pairwise transforms shapes of both operands should be equal, but node %i got %s vs %s", block.getNodeId(), step.nodeId, ShapeUtils::shapeAsString(inputs[0]).c_str(), ShapeUtils::shapeAsString(y).c_str());
+                }
+            }
+
+            nd4j::ops::helpers::fusedElementwise(_steps, inputs, z);
+
+            STORE_RESULT(*z);
+
+            return Status::OK();
+        }
+    }
+}
@@ -28,9 +28,6 @@
 
 namespace nd4j {
      namespace blas {
-         template <typename T>
-         static void * transpose(int orderSource, int orderTarget, int rows, int cols, void *source);
-
          static inline int linearIndexC(int rows, int cols, int r, int c);
          static inline int linearIndexF(int rows, int cols, int r, int c);
 
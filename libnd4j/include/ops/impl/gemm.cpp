@@ -21,27 +21,94 @@
 
 #include <gemm.h>
 #include <types/types.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace nd4j {
     namespace blas {
 
-        template <typename T>
-        void* transpose(int orderSource, int orderTarget, int rows, int cols, void *vsource) {
-            auto ret = new T[rows * cols];
-            auto source = reinterpret_cast<T *>(vsource);
+        // GEMM blocking parameters: MC x KC panel of A and KC x NC panel of B are packed into contiguous buffers,
+        // and C is updated by MR x NR micro-tiles
+        static const int GEMM_MC = 64;
+        static const int GEMM_NC = 256;
+        static const int GEMM_KC = 256;
+        static const int GEMM_MR = 8;
+        static const int GEMM_NR = 4;
 
-            // handle transpose in parallel
-#pragma omp parallel for proc_bind(close)
-            for (int r = 0; r < rows; r++) {
-                for (int c = 0; c < cols; c++) {
-                    int zIdx = orderTarget == CblasRowMajor ? linearIndexC(rows, cols, r, c) : linearIndexF(rows, cols, r, c);
-                    int xIdx = orderSource == CblasColMajor ? linearIndexF(rows, cols, r, c) : linearIndexC(rows, cols, r, c);
+        // GEMV processes this many rows per block for column-major A
+        static const int GEMV_RB = 256;
+
+        /**
+         * This method packs mc x kc block of A, starting at (row, k), into micro-panels of GEMM_MR rows,
+         * converting values to Z along the way. Edge panels are zero-padded
+         */
+        template <typename X, typename Z>
+        static void packA(const X *A, Nd4jLong rowStride, Nd4jLong colStride, int row, int k, int mc, int kc, Z *packed) {
+            for (int ir = 0; ir < mc; ir += GEMM_MR) {
+                int mr = nd4j::math::nd4j_min<int>(GEMM_MR, mc - ir);
+                for (int p = 0; p < kc; p++) {
+                    auto a = A + (row + ir) * rowStride + (k + p) * colStride;
+                    for (int i = 0; i < mr; i++)
+                        packed[i] = static_cast<Z>(a[i * rowStride]);
+
+                    for (int i = mr; i < GEMM_MR; i++)
+                        packed[i] = static_cast<Z>(0.0f);
+
+                    packed += GEMM_MR;
+                }
+            }
+        }
+
+        /**
+         * This method packs kc x nc block of B, starting at (k, col), into micro-panels of GEMM_NR columns
+         */
+        template <typename Y, typename Z>
+        static void packB(const Y *B, Nd4jLong rowStride, Nd4jLong colStride, int k, int col, int kc, int nc, Z *packed) {
+            for (int jr = 0; jr < nc; jr += GEMM_NR) {
+                int nr = nd4j::math::nd4j_min<int>(GEMM_NR, nc - jr);
+                for (int p = 0; p < kc; p++) {
+                    auto b = B + (k + p) * rowStride + (col + jr) * colStride;
+                    for (int j = 0; j < nr; j++)
+                        packed[j] = static_cast<Z>(b[j * colStride]);
+
+                    for (int j = nr; j < GEMM_NR; j++)
+                        packed[j] = static_cast<Z>(0.0f);
+
+                    packed += GEMM_NR;
+                }
+            }
+        }
+
+        /**
+         * Micro-kernel: C[mr x nr] += alpha * packedA[MR x kc] * packedB[kc x NR], C is column-major with leading dimension ldc
+         */
+        template <typename Z>
+        static FORCEINLINE void microKernel(int kc, int mr, int nr, Z alpha, const Z *packedA, const Z *packedB, Z *C, int ldc) {
+            Z acc[GEMM_MR * GEMM_NR];
 
-                    ret[zIdx] = source[xIdx];
+            for (int e = 0; e < GEMM_MR * GEMM_NR; e++)
+                acc[e] = static_cast<Z>(0.0f);
+
+            for (int p = 0; p < kc; p++) {
+                auto a = packedA + p * GEMM_MR;
+                auto b = packedB + p * GEMM_NR;
+
+                for (int j = 0; j < GEMM_NR; j++) {
+                    auto bj = b[j];
+                    auto cj = acc + j * GEMM_MR;
+#pragma omp simd
+                    for (int i = 0; i < GEMM_MR; i++)
+                        cj[i] += a[i] * bj;
                 }
             }
 
-            return ret;
+            for (int j = 0; j < nr; j++) {
+                auto c = C + j * ldc;
+                auto cj = acc + j * GEMM_MR;
+                for (int i = 0; i < mr; i++)
+                    c[i] += alpha * cj[i];
+            }
         }
 
         template <typename X, typename Y, typename Z>
@@ -60,44 +127,84 @@ namespace nd4j {
             bool transAFlag = TransA == CblasTrans;
             bool transBFlag = TransB == CblasTrans;
 
+            // when called from parallel region (i.e. batched GEMM spread over batch), this GEMM stays on calling thread
+#ifdef _OPENMP
+            const bool nested = omp_in_parallel();
+#else
+            const bool nested = false;
+#endif
+
+            Nd4jLong length = (Nd4jLong) M * N;
             if (beta == 0.0) {
-                int length = M*N;
-                if (length <= 8192) {
+#pragma omp parallel for if (length > 8192 && !nested)
+                for (int c = 0; c < N; c++) {
+                    auto column = C + (Nd4jLong) c * ldc;
+#pragma omp simd
+                    for (int r = 0; r < M; r++)
+                        column[r] = static_cast<Z>(0.0f);
+                }
+            } else if (beta != 1.0) {
+                auto b = static_cast<Z>(beta);
+#pragma omp parallel for if (length > 8192 && !nested)
+                for (int c = 0; c < N; c++) {
+                    auto column = C + (Nd4jLong) c * ldc;
 #pragma omp simd
-                    for (int r = 0; r < length; r++)
-                        C[r] = static_cast<Z>(0.0f);
-                } else {
-#pragma omp parallel for simd
-                    for (int r = 0; r < length; r++)
-                        C[r] = static_cast<Z>(0.0f);
+                    for (int r = 0; r < M; r++)
+                        column[r] *= b;
                 }
             }
 
+            if (alpha == 0.0 || K == 0)
+                return;
 
-#pragma omp parallel for simd collapse(2) proc_bind(close)
-            for (int r = 0; r < M; r++) {
-                for (int c = 0; c < N; c++) {
-                    int zIdx = linearIndexF(M, N, r, c);
+            // A is M x K, B is K x N, C is M x N column-major, all with leading dimensions given. transposed inputs are stored in c order
+            Nd4jLong aRowStride = transAFlag ? lda : 1;
+            Nd4jLong aColStride = transAFlag ? 1 : lda;
+            Nd4jLong bRowStride = transBFlag ? ldb : 1;
+            Nd4jLong bColStride = transBFlag ? 1 : ldb;
 
-                    Z dot = static_cast<Z>(0.0f);
+            auto z = static_cast<Z>(alpha);
+            int mBlocks = (M + GEMM_MC - 1) / GEMM_MC;
+            int nBlocks = (N + GEMM_NC - 1) / GEMM_NC;
+            int kPanel = nd4j::math::nd4j_min<int>(K, GEMM_KC);
 
-                    if (alpha != 0.0) {
-                        int bIdx; // = linearIndexF(K, N, 0, c);
-                        int aIdx;
+#pragma omp parallel if (mBlocks * nBlocks > 1 && !nested)
+            {
+                // per-thread packing buffers
+                auto packedA = new Z[GEMM_MC * kPanel];
+                auto packedB = new Z[GEMM_NC * kPanel];
 
-                        for (int k = 0; k < K; k++) {
-                            aIdx = (transAFlag ? linearIndexC(M, K, r, k) : linearIndexF(M, K, r, k));
-                            bIdx = (transBFlag ? linearIndexC(K, N, k, c) : linearIndexF(K,N, k, c));
-                            dot += static_cast<Z>(alpha) * static_cast<Z>(A[aIdx]) * static_cast<Z>(B[bIdx]);//A[aIdx]nd4j::math::nd4j_dot<T>(aX, bX, K) * alpha;
-                        }
-                    }
+#pragma omp for collapse(2) schedule(dynamic)
+                for (int jb = 0; jb < nBlocks; jb++) {
+                    for (int ib = 0; ib < mBlocks; ib++) {
+                        int jc = jb * GEMM_NC;
+                        int ic = ib * GEMM_MC;
+                        int nc = nd4j::math::nd4j_min<int>(GEMM_NC, N - jc);
+                        int mc = nd4j::math::nd4j_min<int>(GEMM_MC, M - ic);
+
+                        for (int pc = 0; pc < K; pc += GEMM_KC) {
+                            int kc = nd4j::math::nd4j_min<int>(GEMM_KC, K - pc);
 
-                    if (beta != 0.0) {
-                        C[zIdx] = static_cast<Z>(dot + beta * C[zIdx]);
-                    } else {
-                        C[zIdx] = static_cast<Z>(dot);
+                            packA<X, Z>(A, aRowStride, aColStride, ic, pc, mc, kc, packedA);
+                            packB<Y, Z>(B, bRowStride, bColStride, pc, jc, kc, nc, packedB);
+
+                            for (int jr = 0; jr < nc; jr += GEMM_NR) {
+                                int nr = nd4j::math::nd4j_min<int>(GEMM_NR, nc - jr);
+                                auto pB = packedB + (jr / GEMM_NR) * GEMM_NR * kc;
+
+                                for (int ir = 0; ir < mc; ir += GEMM_MR) {
+                                    int mr = nd4j::math::nd4j_min<int>(GEMM_MR, mc - ir);
+                                    auto pA = packedA + (ir / GEMM_MR) * GEMM_MR * kc;
+
+                                    microKernel<Z>(kc, mr, nr, z, pA, pB, C + (ic + ir) + (Nd4jLong) (jc + jr) * ldc, ldc);
+                                }
+                            }
+                        }
                     }
                 }
+
+                delete[] packedA;
+                delete[] packedB;
             }
         }
 
@@ -117,19 +224,45 @@ namespace nd4j {
             auto y = reinterpret_cast<Y *>(vY);
             auto z = reinterpret_cast<Z *>(vZ);
 
-            auto aT = TRANS == CblasTrans ? reinterpret_cast<X *>(nd4j::blas::transpose<X>(CblasColMajor, CblasRowMajor, M, N, reinterpret_cast<void *>(x))) : x;
+            if (TRANS == CblasTrans) {
+                // A is stored in f order: walking columns keeps memory access sequential, so no transposed copy is needed
+                int blocks = (M + GEMV_RB - 1) / GEMV_RB;
 
+#pragma omp parallel for if (blocks > 1) proc_bind(close)
+                for (int b = 0; b < blocks; b++) {
+                    int r0 = b * GEMV_RB;
+                    int rows = nd4j::math::nd4j_min<int>(GEMV_RB, M - r0);
+
+                    Z acc[GEMV_RB];
+                    for (int r = 0; r < rows; r++)
+                        acc[r] = static_cast<Z>(0.0f);
+
+                    for (int k = 0; k < lda; k++) {
+                        auto yk = static_cast<Z>(y[k * incx]);
+                        auto column = x + (Nd4jLong) k * M + r0;
+#pragma omp simd
+                        for (int r = 0; r < rows; r++)
+                            acc[r] += static_cast<Z>(column[r]) * yk;
+                    }
+
+                    for (int r = 0; r < rows; r++) {
+                        auto dot = acc[r] * static_cast<Z>(alpha);
+                        z[(r0 + r) * incy] = beta == 0.0f ? dot : static_cast<Z>(dot + beta * z[(r0 + r) * incy]);
+                    }
+                }
+            } else {
 #pragma omp parallel for proc_bind(close)
-            for (int r = 0; r < M; r++) {
-                int aIdx = linearIndexC(M, N, r, 0);
-                auto aX = aT + aIdx;
+                for (int r = 0; r < M; r++) {
+                    auto aX = x + (Nd4jLong) r * N;
 
-                auto dot = nd4j::math::nd4j_dot<X, Y, Z>(aX, y, lda) * alpha;
-                z[r] =  beta == 0.0f ? dot : dot + beta * z[r];
-            }
+                    Z dot = static_cast<Z>(0.0f);
+                    for (int k = 0; k < lda; k++)
+                        dot += static_cast<Z>(aX[k]) * static_cast<Z>(y[k * incx]);
 
-            if (TRANS == CblasTrans)
-                delete[] aT;
+                    dot *= static_cast<Z>(alpha);
+                    z[r * incy] = beta == 0.0f ? dot : static_cast<Z>(dot + beta * z[r * incy]);
+                }
+            }
         }
 
         BUILD_TRIPLE_TEMPLATE(template class  GEMV, , LIBND4J_TYPES, FLOAT_TYPES, FLOAT_TYPES);
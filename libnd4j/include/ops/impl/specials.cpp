@@ -28,6 +28,7 @@
 #include <NDArray.h>
 #include <ops/declarable/CustomOperations.h>
 #include <types/types.h>
+#include <helpers/SortEngine.h>
 
 namespace nd4j {
 
@@ -275,24 +276,18 @@ void SpecialMethods<T>::concatCpuGeneric(int dimension, int numArrays, Nd4jPoint
     void SpecialMethods<T>::sortGeneric(void *vx, Nd4jLong *xShapeInfo, bool descending) {
         auto x = reinterpret_cast<T *>(vx);
 
-        quickSort_parallel(x, xShapeInfo, shape::length(xShapeInfo), omp_get_max_threads(), descending);
+        SortEngine::sort(x, xShapeInfo, descending);
     }
 
     template<typename T>
     void SpecialMethods<T>::sortTadGeneric(void *vx, Nd4jLong *xShapeInfo, int *dimension, int dimensionLength, Nd4jLong *tadShapeInfo, Nd4jLong *tadOffsets, bool descending) {
         auto x = reinterpret_cast<T *>(vx);
 
-        //quickSort_parallel(x, xShapeInfo, shape::length(xShapeInfo), omp_get_max_threads(), descending);
         Nd4jLong xLength = shape::length(xShapeInfo);
         Nd4jLong xTadLength = shape::tadLength(xShapeInfo, dimension, dimensionLength);
-        int numTads = xLength / xTadLength;
+        Nd4jLong numTads = xLength / xTadLength;
 
-#pragma omp parallel for
-        for (int r = 0; r < numTads; r++) {
-            T *dx = x + tadOffsets[r];
-
-            quickSort_parallel(dx, tadShapeInfo, xTadLength, 1, descending);
-        }
+        SortEngine::sortTads(x, tadShapeInfo, tadOffsets, numTads, descending);
     }
 
 
@@ -0,0 +1,62 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <pointercast.h>
+#include <helpers/shape.h>
+#include <specials.h>
+#include <dll.h>
+#include <types/types.h>
+#include <helpers/SortEngine.h>
+#include <stdexcept>
+
+namespace nd4j {
+
+    template <typename X, typename Y>
+    void DoubleMethods<X, Y>::sortByKey(void *vx, Nd4jLong *xShapeInfo, void *vy, Nd4jLong *yShapeInfo, bool descending) {
+        auto x = reinterpret_cast<X *>(vx);
+        auto y = reinterpret_cast<Y *>(vy);
+
+        const auto length = shape::length(xShapeInfo);
+        if (length != shape::length(yShapeInfo))
+            throw std::runtime_error("sortByKey: keys and values must have the same length");
+
+        const auto xEws = shape::elementWiseStride(xShapeInfo);
+        const auto yEws = shape::elementWiseStride(yShapeInfo);
+
+        auto keys = xEws == 1 ? x : new X[length];
+        auto values = yEws == 1 ? y : new Y[length];
+
+        if (xEws != 1)
+            SortEngine::gather(x, xShapeInfo, length, xEws, keys);
+
+        if (yEws != 1)
+            SortEngine::gather(y, yShapeInfo, length, yEws, values);
+
+        SortEngine::sortByKey(keys, values, length, descending);
+
+        if (xEws != 1) {
+            SortEngine::scatter(keys, length, xEws, xShapeInfo, x);
+            delete[] keys;
+        }
+
+        if (yEws != 1) {
+            SortEngine::scatter(values, length, yEws, yShapeInfo, y);
+            delete[] values;
+        }
+    }
+
+    BUILD_DOUBLE_TEMPLATE(template class ND4J_EXPORT DoubleMethods, , LIBND4J_TYPES, LIBND4J_TYPES);
+}
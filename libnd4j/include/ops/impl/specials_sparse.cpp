@@ -28,6 +28,7 @@
 #endif
 #include <types/float16.h>
 #include <types/types.h>
+#include <helpers/SortEngine.h>
 
 namespace nd4j {
     namespace sparse {
@@ -210,11 +211,24 @@ namespace nd4j {
 
         template <typename T>
         void SparseUtils<T>::sortCooIndicesGeneric(Nd4jLong *indices, T *values, Nd4jLong length, int rank) {
-#ifdef _OPENMP
-            coo_quickSort_parallel(indices, values, length, omp_get_max_threads(), rank);
-#else
-            coo_quickSort_parallel(indices, values, length, 1, rank);
-#endif
+            // indices are compared as rows, so permutation is sorted first, and rows with values are moved once
+            auto permutation = new Nd4jLong[length];
+            for (Nd4jLong e = 0; e < length; e++)
+                permutation[e] = e;
+
+            SortEngine::mergeSort(permutation, length, [indices, rank] (const Nd4jLong x, const Nd4jLong y) { return ltIndices(indices, rank, x, y); });
+
+            auto sortedIndices = new Nd4jLong[length * rank];
+
+#pragma omp parallel for schedule(static)
+            for (Nd4jLong e = 0; e < length; e++)
+                memcpy(sortedIndices + e * rank, indices + permutation[e] * rank, rank * sizeof(Nd4jLong));
+
+            memcpy(indices, sortedIndices, length * rank * sizeof(Nd4jLong));
+            SortEngine::permute(values, permutation, length);
+
+            delete[] sortedIndices;
+            delete[] permutation;
         }
 
         BUILD_SINGLE_TEMPLATE(template class ND4J_EXPORT SparseUtils, , LIBND4J_TYPES);
@@ -59,6 +59,15 @@ namespace nd4j {
         static void decodeBitmapGeneric(void *dx, Nd4jLong N, void *dz, Nd4jLong *zShapeInfo);
         static Nd4jLong encodeBitmapGeneric(void *dx, Nd4jLong *zShapeInfo, Nd4jLong N, int *dz, float threshold);
     };
+
+    template <typename X, typename Y>
+    class DoubleMethods {
+    public:
+        /**
+         * Sorts keys x, and applies the same permutation to values y. Sort is stable
+         */
+        static void sortByKey(void *vx, Nd4jLong *xShapeInfo, void *vy, Nd4jLong *yShapeInfo, bool descending);
+    };
 }
 
 
@@ -40,10 +40,9 @@ namespace nd4j {
 
                 try {
                     // building our graph
-                    auto graph = new Graph<float>(flat_graph);
+                    auto graph = new Graph(flat_graph);
 
-                    // single data type for now
-                    GraphHolder::getInstance()->registerGraph<float>(flat_graph->id(), graph);
+                    GraphHolder::getInstance()->registerGraph(flat_graph->id(), graph);
 
                     // sending out OK response
                     auto response_offset = CreateFlatResponse(mb_, 0);
@@ -63,9 +62,8 @@ namespace nd4j {
 
                 try {
                     // building our graph
-                    auto graph = new Graph<float>(flat_graph);
+                    auto graph = new Graph(flat_graph);
 
-                    // single data type for now
                     GraphHolder::getInstance()->replaceGraph(flat_graph->id(), graph);
 
                     // sending out OK response
@@ -106,15 +104,27 @@ namespace nd4j {
                 }
             }
 
+            GraphInferenceServerImpl::~GraphInferenceServerImpl() {
+                delete batcher_;
+            }
+
+            void GraphInferenceServerImpl::enableBatching(int maxBatchSize, Nd4jLong windowMicros) {
+                delete batcher_;
+                batcher_ = new RequestBatcher(maxBatchSize, windowMicros);
+            }
+
             grpc::Status GraphInferenceServerImpl::InferenceRequest( grpc::ServerContext *context, const flatbuffers::grpc::Message<FlatInferenceRequest> *request_msg, flatbuffers::grpc::Message<FlatResult> *response_msg) {
                 auto request = request_msg->GetRoot();
 
+                // requests are served concurrently, so each one gets its own builder
+                flatbuffers::grpc::MessageBuilder mb;
+
                 try {
-                    // GraphHolder
-                    auto response_offset = GraphHolder::getInstance()->execute(request->id(), mb_, request);
+                    // GraphHolder, optionally through batching stage
+                    auto response_offset = batcher_ != nullptr ? batcher_->execute(request->id(), mb, request) : GraphHolder::getInstance()->execute(request->id(), mb, request);
 
-                    mb_.Finish(response_offset);
-                    *response_msg = mb_.ReleaseMessage<FlatResult>();
+                    mb.Finish(response_offset);
+                    *response_msg = mb.ReleaseMessage<FlatResult>();
                     assert(response_msg->Verify());
 
                     return grpc::Status::OK;
@@ -135,13 +145,16 @@ namespace nd4j {
     }
 }
 
-void RunServer(int port) {
+void RunServer(int port, int maxBatchSize, Nd4jLong windowMicros) {
   assert(port > 0 && port < 65535);
 
   std::string server_address("0.0.0.0:");
   server_address += nd4j::StringUtils::valueToString<int>(port);
 
   nd4j::graph::GraphInferenceServerImpl service;
+  if (maxBatchSize > 1)
+      service.enableBatching(maxBatchSize, windowMicros);
+
   auto registrator = nd4j::ops::OpRegistrator::getInstance();
 
   grpc::ServerBuilder builder;
@@ -178,13 +191,26 @@ int main(int argc, char *argv[]) {
         port = atoi(sPort);
      }
 
+     // micro-batching is disabled by default
+     int maxBatchSize = 0;
+     if(cmdOptionExists(argv, argv+argc, "-b")) {
+        auto sBatch = getCmdOption(argv, argv + argc, "-b");
+        maxBatchSize = atoi(sBatch);
+     }
+
+     Nd4jLong windowMicros = 1000;
+     if(cmdOptionExists(argv, argv+argc, "-w")) {
+        auto sWindow = getCmdOption(argv, argv + argc, "-w");
+        windowMicros = atol(sWindow);
+     }
+
     if(cmdOptionExists(argv, argv+argc, "-f")) {
         auto file = getCmdOption(argv, argv + argc, "-f");
-        auto graph = GraphExecutioner<float>::importFromFlatBuffers(file);
-        nd4j::graph::GraphHolder::getInstance()->registerGraph<float>(0L, graph);
+        auto graph = GraphExecutioner::importFromFlatBuffers(file);
+        nd4j::graph::GraphHolder::getInstance()->registerGraph(0L, graph);
     }
 
-    RunServer(port);
+    RunServer(port, maxBatchSize, windowMicros);
 
     return 0;
 }
\ No newline at end of file
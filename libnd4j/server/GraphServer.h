@@ -22,6 +22,7 @@
 #include <grpc++/grpc++.h>
 #include <NDArray.h>
 #include <graph/Graph.h>
+#include <graph/RequestBatcher.h>
 #include <ops/declarable/CustomOperations.h>
 
 #include <graph/generated/graph.grpc.fb.h>
@@ -31,7 +32,19 @@ namespace nd4j {
         class GraphInferenceServerImpl final : public GraphInferenceServer::Service {
         private:
             flatbuffers::grpc::MessageBuilder mb_;
+
+            // optional micro-batching stage for inference requests
+            RequestBatcher *batcher_ = nullptr;
         public:
+            ~GraphInferenceServerImpl();
+
+            /**
+             * This method enables coalescing of concurrent inference requests for the same graph
+             * @param maxBatchSize - max number of rows along batch dimension
+             * @param windowMicros - max time request waits for others, in microseconds
+             */
+            void enableBatching(int maxBatchSize, Nd4jLong windowMicros);
+
             virtual grpc::Status RegisterGraph( grpc::ServerContext *context, const flatbuffers::grpc::Message<FlatGraph> *request_msg, flatbuffers::grpc::Message<FlatResponse> *response_msg);
 
             virtual grpc::Status ForgetGraph( grpc::ServerContext *context, const flatbuffers::grpc::Message<FlatDropRequest> *request_msg, flatbuffers::grpc::Message<FlatResponse> *response_msg);
@@ -30,6 +30,7 @@
 #include <ops/declarable/CustomOperations.h>
 #include <ops/declarable/generic/helpers/convolutions.h>
 #include <ops/declarable/helpers/col2im.h>
+#include <Environment.h>
 
 using namespace nd4j;
 using namespace nd4j::graph;
@@ -2715,5 +2716,225 @@ TEST_F(ConvolutionTests, depthwise_conv2d_test5) {
         ASSERT_EQ(output.e<float>(i) != unique, true);
 }
 
+//////////////////////////////////////////////////////////////////////
+static NDArray* conv2dWithAlgorithm(Conv2dAlgorithm algorithm, NDArray &input, NDArray &weights, NDArray &bias, const std::vector<Nd4jLong> &iArgs) {
+    Environment::getInstance()->setConv2dAlgorithm(algorithm);
+
+    nd4j::ops::conv2d op;
+    auto result = op.execute({&input, &weights, &bias}, {}, iArgs);
+
+    Environment::getInstance()->setConv2dAlgorithm(CONV2D_AUTO);
+
+    if (result->status() != ND4J_STATUS_OK) {
+        delete result;
+        return nullptr;
+    }
+
+    auto z = result->at(0)->dup();
+    delete result;
+
+    return z;
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConvolutionTests, conv2d_algorithms_1) {
+    int bS=2, iH=11,iW=11,  iC=9,oC=10,  kH=3,kW=3,  sH=1,sW=1,  pH=0,pW=0,  dH=1,dW=1;
+
+    // NCHW and NHWC, VALID and SAME modes, both Winograd tile sizes
+    for (int dataFormat = 0; dataFormat < 2; dataFormat++) {
+        for (int paddingMode = 0; paddingMode < 2; paddingMode++) {
+            for (int size = 11; size >= 5; size -= 6) {
+                iH = iW = size;
+
+                auto input = dataFormat == 0 ? NDArrayFactory::create<double>('c', {bS, iC, iH, iW}) : NDArrayFactory::create<double>('c', {bS, iH, iW, iC});
+                auto weights = NDArrayFactory::create<double>('c', {kH, kW, iC, oC});
+                auto bias = NDArrayFactory::create<double>('c', {oC});
+
+                input.linspace(-5., 0.01);
+                weights.linspace(-0.4, 0.001);
+                bias.linspace(1.);
+
+                std::vector<Nd4jLong> iArgs = {kH,kW, sH,sW, pH,pW, dH,dW, paddingMode, dataFormat};
+
+                auto exp = conv2dWithAlgorithm(CONV2D_IM2COL, input, weights, bias, iArgs);
+                auto winograd = conv2dWithAlgorithm(CONV2D_WINOGRAD, input, weights, bias, iArgs);
+                auto direct = conv2dWithAlgorithm(CONV2D_DIRECT, input, weights, bias, iArgs);
+
+                ASSERT_TRUE(exp != nullptr && winograd != nullptr && direct != nullptr);
+
+                ASSERT_TRUE(exp->isSameShape(winograd));
+                ASSERT_TRUE(exp->equalsTo(winograd));
+
+                ASSERT_TRUE(exp->isSameShape(direct));
+                ASSERT_TRUE(exp->equalsTo(direct));
+
+                delete exp;
+                delete winograd;
+                delete direct;
+            }
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConvolutionTests, conv2d_algorithms_2) {
+    // strided and dilated layer with few input channels: Winograd isn't applicable here, so forcing it falls back to im2col
+    int bS=2, iH=9,iW=8,  iC=3,oC=5,  kH=3,kW=2,  sH=2,sW=1,  pH=1,pW=0,  dH=1,dW=2;
+
+    auto input = NDArrayFactory::create<float>('c', {bS, iH, iW, iC});
+    auto weights = NDArrayFactory::create<float>('c', {kH, kW, iC, oC});
+    auto bias = NDArrayFactory::create<float>('c', {oC});
+
+    input.linspace(-1.f, 0.01f);
+    weights.linspace(-0.1f, 0.01f);
+    bias.linspace(1.f);
+
+    std::vector<Nd4jLong> iArgs = {kH,kW, sH,sW, pH,pW, dH,dW, 0, 1};
+
+    auto exp = conv2dWithAlgorithm(CONV2D_IM2COL, input, weights, bias, iArgs);
+    auto winograd = conv2dWithAlgorithm(CONV2D_WINOGRAD, input, weights, bias, iArgs);
+    auto direct = conv2dWithAlgorithm(CONV2D_DIRECT, input, weights, bias, iArgs);
+
+    ASSERT_TRUE(exp != nullptr && winograd != nullptr && direct != nullptr);
+
+    ASSERT_TRUE(exp->equalsTo(winograd));
+    ASSERT_TRUE(exp->equalsTo(direct, 1e-4));
+
+    delete exp;
+    delete winograd;
+    delete direct;
+}
+
+//////////////////////////////////////////////////////////////////////
+static ResultSet* executeWithConvTiles(nd4j::ops::DeclarableOp &op, const std::vector<NDArray*> &inputs, const std::vector<Nd4jLong> &iArgs, Nd4jLong tileBytes) {
+    // im2col is forced, so MKL-DNN doesn't take over conv2d
+    Environment::getInstance()->setConv2dAlgorithm(CONV2D_IM2COL);
+    Environment::getInstance()->setConvTileBytes(tileBytes);
+
+    auto result = op.execute(inputs, {}, iArgs);
+
+    Environment::getInstance()->setConv2dAlgorithm(CONV2D_AUTO);
+    Environment::getInstance()->setConvTileBytes(8 * 1024 * 1024);
+
+    return result;
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConvolutionTests, conv2d_tiled_1) {
+    int bS=3, iH=10,iW=9,  iC=4,oC=5,  kH=3,kW=2,  sH=2,sW=1,  pH=1,pW=0,  dH=1,dW=2;
+
+    nd4j::ops::conv2d op;
+
+    // budget of 512 bytes splits samples into rows, 4096 bytes takes a few samples per tile
+    for (Nd4jLong tileBytes : {512, 4096}) {
+        for (int dataFormat = 0; dataFormat < 2; dataFormat++) {
+            for (int paddingMode = 0; paddingMode < 2; paddingMode++) {
+                auto input = dataFormat == 0 ? NDArrayFactory::create<float>('c', {bS, iC, iH, iW}) : NDArrayFactory::create<float>('c', {bS, iH, iW, iC});
+                auto weights = NDArrayFactory::create<float>('c', {kH, kW, iC, oC});
+                auto bias = NDArrayFactory::create<float>('c', {oC});
+
+                input.linspace(-1.f, 0.01f);
+                weights.linspace(-0.1f, 0.01f);
+                bias.linspace(1.f);
+
+                std::vector<Nd4jLong> iArgs = {kH,kW, sH,sW, pH,pW, dH,dW, paddingMode, dataFormat};
+
+                auto exp = executeWithConvTiles(op, {&input, &weights, &bias}, iArgs, 0);
+                auto result = executeWithConvTiles(op, {&input, &weights, &bias}, iArgs, tileBytes);
+
+                ASSERT_EQ(ND4J_STATUS_OK, exp->status());
+                ASSERT_EQ(ND4J_STATUS_OK, result->status());
+
+                ASSERT_TRUE(exp->at(0)->isSameShape(result->at(0)));
+                ASSERT_TRUE(exp->at(0)->equalsTo(result->at(0)));
+
+                delete exp;
+                delete result;
+            }
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConvolutionTests, depthwise_conv2d_tiled_1) {
+    int bS=2, iH=8,iW=7,  iC=3,mC=2,  kH=3,kW=3,  sH=1,sW=2,  pH=0,pW=0,  dH=2,dW=1;
+
+    nd4j::ops::depthwise_conv2d op;
+
+    for (int dataFormat = 0; dataFormat < 2; dataFormat++) {
+        for (int paddingMode = 0; paddingMode < 2; paddingMode++) {
+            auto input = dataFormat == 0 ? NDArrayFactory::create<double>('c', {bS, iC, iH, iW}) : NDArrayFactory::create<double>('c', {bS, iH, iW, iC});
+            auto weights = NDArrayFactory::create<double>('c', {kH, kW, iC, mC});
+            auto bias = NDArrayFactory::create<double>('c', {iC*mC});
+
+            input.linspace(-2., 0.05);
+            weights.linspace(-0.3, 0.02);
+            bias.linspace(1.);
+
+            std::vector<Nd4jLong> iArgs = {kH,kW, sH,sW, pH,pW, dH,dW, paddingMode, dataFormat};
+
+            auto exp = executeWithConvTiles(op, {&input, &weights, &bias}, iArgs, 0);
+            auto result = executeWithConvTiles(op, {&input, &weights, &bias}, iArgs, 1024);
+
+            ASSERT_EQ(ND4J_STATUS_OK, exp->status());
+            ASSERT_EQ(ND4J_STATUS_OK, result->status());
+
+            ASSERT_TRUE(exp->at(0)->isSameShape(result->at(0)));
+            ASSERT_TRUE(exp->at(0)->equalsTo(result->at(0)));
+
+            delete exp;
+            delete result;
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConvolutionTests, conv2d_bp_tiled_1) {
+    int bS=3, iH=7,iW=6,  iC=3,oC=4,  kH=3,kW=2,  sH=1,sW=2,  pH=0,pW=0,  dH=1,dW=1;
+
+    nd4j::ops::conv2d_bp op;
+
+    for (int dataFormat = 0; dataFormat < 2; dataFormat++) {
+        for (int paddingMode = 0; paddingMode < 2; paddingMode++) {
+            int oH, oW;
+            if (paddingMode) {
+                oH = (iH + sH - 1) / sH;
+                oW = (iW + sW - 1) / sW;
+            }
+            else {
+                oH = (iH - (kH - 1) * dH - 1) / sH + 1;
+                oW = (iW - (kW - 1) * dW - 1) / sW + 1;
+            }
+
+            auto input = dataFormat == 0 ? NDArrayFactory::create<double>('c', {bS, iC, iH, iW}) : NDArrayFactory::create<double>('c', {bS, iH, iW, iC});
+            auto gradO = dataFormat == 0 ? NDArrayFactory::create<double>('c', {bS, oC, oH, oW}) : NDArrayFactory::create<double>('c', {bS, oH, oW, oC});
+            auto weights = NDArrayFactory::create<double>('c', {kH, kW, iC, oC});
+            auto bias = NDArrayFactory::create<double>('c', {oC});
+
+            input.linspace(-1., 0.02);
+            gradO.linspace(0.5, -0.01);
+            weights.linspace(-0.2, 0.01);
+            bias.linspace(1.);
+
+            std::vector<Nd4jLong> iArgs = {kH,kW, sH,sW, pH,pW, dH,dW, paddingMode, dataFormat};
+
+            // one sample per tile
+            auto exp = executeWithConvTiles(op, {&input, &weights, &bias, &gradO}, iArgs, 0);
+            auto result = executeWithConvTiles(op, {&input, &weights, &bias, &gradO}, iArgs, 64);
+
+            ASSERT_EQ(ND4J_STATUS_OK, exp->status());
+            ASSERT_EQ(ND4J_STATUS_OK, result->status());
+
+            for (int e = 0; e < 3; e++) {
+                ASSERT_TRUE(exp->at(e)->isSameShape(result->at(e)));
+                ASSERT_TRUE(exp->at(e)->equalsTo(result->at(e)));
+            }
+
+            delete exp;
+            delete result;
+        }
+    }
+}
+
 #endif //LIBND4J_CONVOLUTIONTESTS_H
 
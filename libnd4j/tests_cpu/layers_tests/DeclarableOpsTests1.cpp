@@ -1625,6 +1625,53 @@ TEST_F(DeclarableOpsTests1, TestGemv1) {
 
 }
 
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests1, TestGemv2) {
+    // same matrix as above, stored in f order
+    float xBuffer[15] = {1.f, 4.f, 7.f, 10.f, 13.f, 2.f, 5.f, 8.f, 11.f, 14.f, 3.f, 6.f, 9.f, 12.f, 15.f};
+    float yBuffer[3] = {2.f, 4.f, 6.f};
+    float zBuffer[5] = {1.f, 1.f, 1.f, 1.f, 1.f};
+    float expBuffer[5] = {57.f, 129.f, 201.f, 273.f, 345.f};
+
+    nd4j::blas::GEMV<float, float, float>::op(CblasTrans, 5, 3, 2.0, xBuffer, 3, yBuffer, 1, 1.0, zBuffer, 1);
+
+    for (int e = 0; e < 5; e++)
+        ASSERT_NEAR(expBuffer[e], zBuffer[e], 1e-5);
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests1, TestGemm1) {
+    // dimensions span more than one block in every direction
+    const int M = 70, N = 260, K = 300;
+
+    std::vector<int> a(M * K);
+    std::vector<float> b(K * N), c(M * N), exp(M * N);
+
+    for (int e = 0; e < M * K; e++)
+        a[e] = e % 7 - 3;
+
+    for (int e = 0; e < K * N; e++)
+        b[e] = (e % 11) * 0.25f;
+
+    for (int e = 0; e < M * N; e++)
+        c[e] = 1.f;
+
+    // A is c ordered (transposed), B and C are f ordered
+    for (int r = 0; r < M; r++)
+        for (int col = 0; col < N; col++) {
+            double sum = 0.0;
+            for (int k = 0; k < K; k++)
+                sum += a[r * K + k] * b[col * K + k];
+
+            exp[col * M + r] = (float) (2.0 * sum + 0.5);
+        }
+
+    nd4j::blas::GEMM<int, float, float>::op(CblasColMajor, CblasTrans, CblasNoTrans, M, N, K, 2.0, a.data(), K, b.data(), K, 0.5, c.data(), M);
+
+    for (int e = 0; e < M * N; e++)
+        ASSERT_NEAR(exp[e], c[e], 1e-3);
+}
+
 //////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests1, Reshape1) {
     const std::vector<Nd4jLong> xShape = {5,4,3};
@@ -134,4 +134,53 @@ TEST_F(DeclarableOpsTests15, test_avgpooling_edge_1) {
     ASSERT_EQ(m, *z);
 
     delete result;
-}
\ No newline at end of file
+}
+
+TEST_F(DeclarableOpsTests15, Test_ShapeCache_1) {
+    auto x = NDArrayFactory::create<float>('c', {2, 3}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+    auto exp = NDArrayFactory::create<float>('c', {2, 6}, {1.f, 2.f, 3.f, 1.f, 2.f, 3.f,   4.f, 5.f, 6.f, 4.f, 5.f, 6.f});
+
+    nd4j::ops::tile op;
+    auto hits = op.shapeCache()->hits();
+
+    for (int e = 0; e < 3; e++) {
+        auto result = op.execute({&x}, {}, {1, 2});
+        ASSERT_EQ(Status::OK(), result->status());
+        ASSERT_EQ(exp, *result->at(0));
+
+        delete result;
+    }
+
+    // first invocation calls shape function, others are served from cache
+    ASSERT_EQ(hits + 2, op.shapeCache()->hits());
+
+    // different IArgs give different shape
+    auto result = op.execute({&x}, {}, {2, 1});
+    ASSERT_EQ(Status::OK(), result->status());
+    ASSERT_TRUE(result->at(0)->isSameShape({4, 3}));
+    ASSERT_EQ(hits + 2, op.shapeCache()->hits());
+
+    delete result;
+}
+
+TEST_F(DeclarableOpsTests15, Test_ShapeCache_2) {
+    auto x = NDArrayFactory::create<float>('c', {2, 3});
+    auto repsA = NDArrayFactory::create<int>('c', {2}, {1, 2});
+    auto repsB = NDArrayFactory::create<int>('c', {2}, {3, 1});
+
+    // output shape depends on values of second input, so it can't be reused
+    nd4j::ops::tile op;
+    auto hits = op.shapeCache()->hits();
+
+    auto resultA = op.execute({&x, &repsA}, {}, {});
+    auto resultB = op.execute({&x, &repsB}, {}, {});
+
+    ASSERT_EQ(Status::OK(), resultA->status());
+    ASSERT_EQ(Status::OK(), resultB->status());
+    ASSERT_TRUE(resultA->at(0)->isSameShape({2, 6}));
+    ASSERT_TRUE(resultB->at(0)->isSameShape({6, 3}));
+    ASSERT_EQ(hits, op.shapeCache()->hits());
+
+    delete resultA;
+    delete resultB;
+}
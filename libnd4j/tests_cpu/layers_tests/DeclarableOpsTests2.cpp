@@ -19,6 +19,7 @@
 #include <helpers/helper_hash.h>
 #include <NDArray.h>
 #include <array/NDArrayList.h>
+#include <helpers/MmulHelper.h>
 
 
 using namespace nd4j;
@@ -595,6 +596,32 @@ TEST_F(DeclarableOpsTests2, TestTensorDot15) {
 
 }
 
+////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests2, TestTensorDot16) {
+
+    auto x = NDArrayFactory::create<double>('f', {2,3,4});
+    auto y = NDArrayFactory::create<double>('c', {3,5,4});
+    auto z = NDArrayFactory::create<double>('c', {5,2});
+    auto expected = NDArrayFactory::create<double>('c', {5,2});
+    x.linspace(1);
+    y.linspace(0.5, 0.25);
+
+    for (int i = 0; i < 2; i++)
+        for (int j = 0; j < 5; j++) {
+            double sum = 0.;
+            for (int k = 0; k < 3; k++)
+                for (int l = 0; l < 4; l++)
+                    sum += x.e<double>(i, k, l) * y.e<double>(k, j, l);
+            expected.p(j, i, sum);
+        }
+
+    // f-ordered x and y contracted over its outer and inner axes, result written into transposed z
+    MmulHelper::tensorDot(&x, &y, &z, {1,2}, {0,2}, {1,0});
+
+    ASSERT_TRUE(expected.isSameShape(z));
+    ASSERT_TRUE(expected.equalsTo(z));
+}
+
 ////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests2, absolute_difference_loss_test_1) {
     
@@ -1456,6 +1456,108 @@ TEST_F(DeclarableOpsTests4, gru_test1) {
     delete results;
 } 
 
+///////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests4, lstm_test2) {
+
+    const int time      = 4;
+    const int batchSize = 3;
+    const int inSize    = 5;
+    const int numProj   = 2;
+    const int numUnits  = 6;
+
+    auto x   = NDArrayFactory::create<double>('c', {time, batchSize, inSize});
+    auto h0  = NDArrayFactory::create<double>('c', {batchSize, numProj});
+    auto c0  = NDArrayFactory::create<double>('c', {batchSize, numUnits});
+    auto Wx  = NDArrayFactory::create<double>('c', {inSize, 4*numUnits});
+    auto Wh  = NDArrayFactory::create<double>('c', {numProj, 4*numUnits});
+    auto Wc  = NDArrayFactory::create<double>('c', {3*numUnits});
+    auto Wp  = NDArrayFactory::create<double>('c', {numUnits, numProj});
+    auto b   = NDArrayFactory::create<double>('c', {4*numUnits});
+
+    x.linspace(-1., 0.05);
+    h0.linspace(0.1, 0.1);
+    c0.linspace(-0.3, 0.07);
+    Wx.linspace(-0.4, 0.01);
+    Wh.linspace(0.3, -0.02);
+    Wc.linspace(0.1, 0.03);
+    Wp.linspace(-0.2, 0.05);
+    b.linspace(0.01, 0.02);
+
+    // peephole connections and projection, fused time loop must match cell applied step by step
+    nd4j::ops::lstm op;
+    auto results = op.execute({&x, &h0, &c0, &Wx, &Wh, &Wc, &Wp, &b}, {0., 0., 0.5}, {1, 1});
+    ASSERT_EQ(ND4J_STATUS_OK, results->status());
+
+    auto h = results->at(0);
+    auto c = results->at(1);
+
+    nd4j::ops::lstmCell opCell;
+    NDArray ht_1(h0);
+    NDArray ct_1(c0);
+
+    for (int t = 0; t < time; ++t) {
+        auto xt = x({t,t+1, 0,0, 0,0});
+        auto cellResults = opCell.execute({&xt, &ht_1, &ct_1, &Wx, &Wh, &Wc, &Wp, &b}, {0., 0., 0.5}, {1, 1});
+        ASSERT_EQ(ND4J_STATUS_OK, cellResults->status());
+
+        auto expHt = (*h)({t,t+1, 0,0, 0,0});
+        auto expCt = (*c)({t,t+1, 0,0, 0,0});
+
+        ASSERT_TRUE(expHt.equalsTo(cellResults->at(0)));
+        ASSERT_TRUE(expCt.equalsTo(cellResults->at(1)));
+
+        ht_1.assign(cellResults->at(0));
+        ct_1.assign(cellResults->at(1));
+        delete cellResults;
+    }
+
+    delete results;
+}
+
+///////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests4, gru_test2) {
+
+    const int time      = 4;
+    const int batchSize = 3;
+    const int inSize    = 5;
+    const int numUnits  = 4;
+
+    auto x   = NDArrayFactory::create<float>('c', {time, batchSize, inSize});
+    auto h0  = NDArrayFactory::create<float>('c', {batchSize, numUnits});
+    auto Wx  = NDArrayFactory::create<float>('c', {inSize, 3*numUnits});
+    auto Wh  = NDArrayFactory::create<float>('c', {numUnits, 3*numUnits});
+    auto b   = NDArrayFactory::create<float>('c', {3*numUnits});
+
+    x.linspace(-1., 0.05);
+    h0.linspace(0.1, 0.1);
+    Wx.linspace(-0.4, 0.02);
+    Wh.linspace(0.3, -0.03);
+    b.linspace(0.01, 0.02);
+
+    nd4j::ops::gru op;
+    auto results = op.execute({&x, &h0, &Wx, &Wh, &b}, {}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, results->status());
+
+    auto h = results->at(0);
+
+    nd4j::ops::gruCell opCell;
+    NDArray ht_1(h0);
+
+    for (int t = 0; t < time; ++t) {
+        auto xt = x({t,t+1, 0,0, 0,0});
+        auto cellResults = opCell.execute({&xt, &ht_1, &Wx, &Wh, &b}, {}, {});
+        ASSERT_EQ(ND4J_STATUS_OK, cellResults->status());
+
+        auto expHt = (*h)({t,t+1, 0,0, 0,0});
+        ASSERT_TRUE(expHt.equalsTo(cellResults->at(0)));
+
+        ht_1.assign(cellResults->at(0));
+        delete cellResults;
+    }
+
+    delete results;
+}
+
 ///////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests4, relu6_test1) {
     
@@ -1117,6 +1117,40 @@ TEST_F(DeclarableOpsTests5, Test_TopK_5) {
     delete result;
 }
 
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests5, Test_TopK_6) {
+    // rows wide enough for heap selection, with ties
+    auto x = NDArrayFactory::create<float>('c', {2, 2000});
+    x.assign(0.5f);
+    x.p(0, 100, 10.f);
+    x.p(0, 1500, 10.f);
+    x.p(0, 700, 9.f);
+    x.p(1, 5, 7.f);
+    x.p(1, 1999, 8.f);
+    x.p(1, 6, 7.f);
+
+    auto expV = NDArrayFactory::create<float>('c', {2, 3}, {10.f, 10.f, 9.f,   8.f, 7.f, 7.f});
+    auto expI = NDArrayFactory::create<Nd4jLong>('c', {2, 3}, {100, 1500, 700,   1999, 5, 6});
+    auto expUnsortedV = NDArrayFactory::create<float>('c', {2, 3}, {10.f, 9.f, 10.f,   7.f, 7.f, 8.f});
+    auto expUnsortedI = NDArrayFactory::create<Nd4jLong>('c', {2, 3}, {100, 700, 1500,   5, 6, 1999});
+
+    nd4j::ops::top_k op;
+    auto result = op.execute({&x}, {}, {3}, {true});
+
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+    ASSERT_EQ(expV, *result->at(0));
+    ASSERT_EQ(expI, *result->at(1));
+
+    auto result2 = op.execute({&x}, {}, {3}, {false});
+
+    ASSERT_EQ(ND4J_STATUS_OK, result2->status());
+    ASSERT_EQ(expUnsortedV, *result2->at(0));
+    ASSERT_EQ(expUnsortedI, *result2->at(1));
+
+    delete result;
+    delete result2;
+}
+
 //////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests5, Test_InTopK_1) {
     auto x = NDArrayFactory::create<double>('c', {2, 3}, {1.0, 11.0, 3.0, 14.0, 5.0, 6.0});
@@ -2436,6 +2470,91 @@ TEST_F(DeclarableOpsTests5, log_softmax_bp_test2) {
     delete results;
 }
 
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests5, softmax_strided_axis_1) {
+
+    auto input = NDArrayFactory::create<double>('c', {2, 3, 4});
+    auto fInput = NDArrayFactory::create<double>('f', {2, 3, 4});
+    auto gradO = NDArrayFactory::create<double>('c', {2, 3, 4});
+    for (int e = 0; e < input.lengthOf(); e++) {
+        input.p(e, (e * 7 % 11) - 5.);
+        gradO.p(e, (e % 5) * 0.1);
+    }
+    fInput.assign(input);
+
+    // reference values via separate reductions along dimension 1
+    auto maxAlongDim = input.reduceAlongDims(reduce::Max, {1}, true);
+    auto exponents = (input - maxAlongDim).transform(transform::Exp);
+    auto expSoftmax = exponents / exponents.reduceAlongDims(reduce::Sum, {1}, true);
+    auto expLogSoftmax = expSoftmax.transform(transform::Log);
+    auto expGrad = expSoftmax * (gradO - (expSoftmax * gradO).reduceAlongDims(reduce::Sum, {1}, true));
+
+    nd4j::ops::softmax op;
+    nd4j::ops::log_softmax logOp;
+    nd4j::ops::softmax_bp bpOp;
+
+    // c-ordered input goes via contiguous kernel, f-ordered one via strided lines
+    for (auto in: {&input, &fInput}) {
+        auto results = op.execute({in}, {}, {1});
+        ASSERT_EQ(Status::OK(), results->status());
+        ASSERT_TRUE(expSoftmax.equalsTo(results->at(0)));
+        delete results;
+
+        results = logOp.execute({in}, {}, {1});
+        ASSERT_EQ(Status::OK(), results->status());
+        ASSERT_TRUE(expLogSoftmax.equalsTo(results->at(0)));
+        delete results;
+
+        results = bpOp.execute({in, &gradO}, {}, {1});
+        ASSERT_EQ(Status::OK(), results->status());
+        ASSERT_TRUE(expGrad.equalsTo(results->at(0)));
+        delete results;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests5, softmax_long_line_1) {
+
+    // single line, long enough to be split between threads
+    auto input = NDArrayFactory::create<float>('c', {1, 100000});
+    auto gradO = NDArrayFactory::create<float>('c', {1, 100000});
+    for (int e = 0; e < input.lengthOf(); e++) {
+        input.p(e, (e % 13) * 0.5f - 3.f);
+        gradO.p(e, (e % 7) * 0.1f);
+    }
+
+    auto exponents = (input - input.reduceAlongDims(reduce::Max, {1}, true)).transform(transform::Exp);
+    auto expSoftmax = exponents / exponents.reduceAlongDims(reduce::Sum, {1}, true);
+    auto expGrad = expSoftmax * (gradO - (expSoftmax * gradO).reduceAlongDims(reduce::Sum, {1}, true));
+
+    nd4j::ops::softmax op;
+    nd4j::ops::softmax_bp bpOp;
+
+    auto results = op.execute({&input}, {}, {1});
+    ASSERT_EQ(Status::OK(), results->status());
+    ASSERT_TRUE(expSoftmax.equalsTo(results->at(0)));
+    delete results;
+
+    results = bpOp.execute({&input, &gradO}, {}, {1});
+    ASSERT_EQ(Status::OK(), results->status());
+    ASSERT_TRUE(expGrad.equalsTo(results->at(0)));
+    delete results;
+
+    // within outer parallel region inner team has fewer threads than requested
+    bool nestedOk = false;
+#pragma omp parallel num_threads(2)
+    {
+#pragma omp master
+        {
+            auto nested = op.execute({&input}, {}, {1});
+            nestedOk = nested->status() == Status::OK() && expSoftmax.equalsTo(nested->at(0));
+
+            delete nested;
+        }
+    }
+    ASSERT_TRUE(nestedOk);
+}
+
 //////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests5, ELU_1) {
 
@@ -25,6 +25,7 @@
 #include <ops/ops.h>
 #include <GradCheck.h>
 #include <loops/random.h>
+#include <helpers/MmulHelper.h>
 
 
 using namespace nd4j;
@@ -1251,6 +1252,31 @@ TEST_F(DeclarableOpsTests9, matmul_test24) {
     delete results;
 }
 
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests9, matmul_test25) {
+
+    // batch of 6 matrices, x is f-ordered and y is transposed, so every operand is strided
+    auto x  = NDArrayFactory::create<float>('f', {2, 3, 5, 4});
+    auto y  = NDArrayFactory::create<float>('c', {2, 3, 7, 4});
+    auto z  = NDArrayFactory::create<float>('c', {2, 3, 5, 7});
+    auto exp = NDArrayFactory::create<float>('c', {2, 3, 5, 7});
+
+    x.linspace(-1., 0.01);
+    y.linspace(0.5, -0.02);
+
+    MmulHelper::matmul(&x, &y, &z, false, true);
+
+    for (int i = 0; i < 6; ++i) {
+        auto xSubArr = x(i, {0, 1});
+        auto ySubArr = y(i, {0, 1});
+        auto expSubArr = exp(i, {0, 1});
+        auto yT = ySubArr.transp();
+        MmulHelper::mmul(&xSubArr, &yT, &expSubArr, 1., 0.);
+    }
+
+    ASSERT_TRUE(exp.equalsTo(&z));
+}
+
 TEST_F(DeclarableOpsTests9, test_range_int_1) {
     auto x0 = NDArrayFactory::create<int>(0);
     auto x1 = NDArrayFactory::create<int>(2);
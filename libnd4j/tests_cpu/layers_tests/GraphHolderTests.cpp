@@ -20,6 +20,9 @@
 
 #include "testlayers.h"
 #include <graph/GraphHolder.h>
+#include <graph/MemoryPlan.h>
+#include <thread>
+#include <atomic>
 
 using namespace nd4j;
 using namespace nd4j::ops;
@@ -83,4 +86,140 @@ TEST_F(GraphHolderTests, SimpleTests_3) {
 
 
     delete graph2;
-}
\ No newline at end of file
+}
+
+static Graph* buildTransformGraph(int opNum, nd4j::DataType dtype) {
+    auto graph = new Graph();
+    graph->getVariableSpace()->putVariable(-1, NDArrayFactory::create_('c', {2, 2}, dtype));
+    graph->addNode(new Node(OpType_TRANSFORM_SAME, opNum, 1, {-1}, {}));
+
+    return graph;
+}
+
+static NDArray* executeTransformGraph(Nd4jLong graphId, NDArray *input) {
+    std::vector<Variable*> inputs = {new Variable(input, nullptr, -1, 0)};
+    auto outputs = GraphHolder::getInstance()->execute(graphId, inputs);
+
+    auto result = outputs->at(0)->getNDArray()->dup();
+
+    for (auto v: *outputs)
+        delete v;
+
+    delete outputs;
+    return result;
+}
+
+TEST_F(GraphHolderTests, HotSwap_1) {
+    Nd4jLong graphId = 118;
+    GraphHolder::getInstance()->registerGraph(graphId, buildTransformGraph(transform::Abs, nd4j::DataType::DOUBLE));
+
+    auto input = NDArrayFactory::create_<double>('c', {2, 2}, {-1.0, 2.0, -3.0, 4.0});
+    auto result = executeTransformGraph(graphId, input);
+    auto expAbs = NDArrayFactory::create<double>('c', {2, 2}, {1.0, 2.0, 3.0, 4.0});
+    ASSERT_TRUE(expAbs.equalsTo(result));
+    delete result;
+
+    // graphs of different data types can be stored in the same holder
+    GraphHolder::getInstance()->replaceGraph(graphId, buildTransformGraph(transform::Neg, nd4j::DataType::INT32));
+    ASSERT_EQ(0, GraphHolder::getInstance()->idleSessions(graphId));
+
+    input = NDArrayFactory::create_<int>('c', {2, 2}, {-1, 2, -3, 4});
+    result = executeTransformGraph(graphId, input);
+    auto expNeg = NDArrayFactory::create<int>('c', {2, 2}, {1, -2, 3, -4});
+    ASSERT_TRUE(expNeg.equalsTo(result));
+    delete result;
+
+    GraphHolder::getInstance()->dropGraphAny(graphId);
+    ASSERT_FALSE(GraphHolder::getInstance()->hasGraph(graphId));
+}
+
+TEST_F(GraphHolderTests, HotSwap_2) {
+    Nd4jLong graphId = 116;
+    GraphHolder::getInstance()->registerGraph(graphId, buildTransformGraph(transform::Abs, nd4j::DataType::FLOAT32));
+
+    auto expAbs = NDArrayFactory::create<float>('c', {2, 2}, {1.f, 2.f, 3.f, 4.f});
+    auto expNeg = NDArrayFactory::create<float>('c', {2, 2}, {1.f, -2.f, 3.f, -4.f});
+
+    std::atomic<int> failures(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back(std::thread([&] {
+            for (int e = 0; e < 50; e++) {
+                auto input = NDArrayFactory::create_<float>('c', {2, 2}, {-1.f, 2.f, -3.f, 4.f});
+                auto result = executeTransformGraph(graphId, input);
+
+                // every execution sees either previous or next graph, never a mix of them
+                if (!expAbs.equalsTo(result) && !expNeg.equalsTo(result))
+                    failures++;
+
+                delete result;
+            }
+        }));
+    }
+
+    // in-flight executions aren't blocked by replacement, and replaced graphs are released once they're done
+    for (int e = 0; e < 20; e++)
+        GraphHolder::getInstance()->replaceGraph(graphId, buildTransformGraph(e % 2 == 0 ? transform::Neg : transform::Abs, nd4j::DataType::FLOAT32));
+
+    for (auto &t: threads)
+        t.join();
+
+    ASSERT_EQ(0, failures.load());
+
+    GraphHolder::getInstance()->dropGraphAny(graphId);
+}
+
+static Graph* buildChainGraph(int length) {
+    auto graph = new Graph();
+    graph->getVariableSpace()->putVariable(-1, NDArrayFactory::create_<float>('c', {10, 10}));
+
+    for (int e = 1; e <= length; e++)
+        graph->addNode(new Node(OpType_TRANSFORM_SAME, e % 2 == 0 ? transform::Abs : transform::Neg, e, {e == 1 ? -1 : e - 1}, {}));
+
+    return graph;
+}
+
+TEST_F(GraphHolderTests, MemoryPlan_1) {
+    auto graph = buildChainGraph(4);
+    graph->buildGraph();
+
+    std::vector<int> order = {1, 2, 3, 4};
+    std::map<int, Nd4jLong> bytes = {{1, 400}, {2, 400}, {3, 400}, {4, 400}};
+    std::map<int, int> aliases;
+
+    std::unique_ptr<MemoryPlan> plan(MemoryPlan::build(graph, order, bytes, aliases));
+
+    // node 3 can reuse memory of node 1, node 4 reuses memory of node 2
+    ASSERT_EQ(4 * 448, plan->totalSize());
+    ASSERT_EQ(2 * 448, plan->arenaSize());
+    ASSERT_EQ(plan->offset(1), plan->offset(3));
+
+    // if node 2 works in-place, results of node 1 stay alive as long as node 2 results
+    aliases[2] = 1;
+    plan.reset(MemoryPlan::build(graph, order, bytes, aliases));
+    ASSERT_EQ(3 * 448, plan->arenaSize());
+    ASSERT_NE(plan->offset(1), plan->offset(3));
+
+    delete graph;
+}
+
+TEST_F(GraphHolderTests, MemoryPlan_2) {
+    Nd4jLong graphId = 115;
+    GraphHolder::getInstance()->registerGraph(graphId, buildChainGraph(6));
+
+    auto exp = NDArrayFactory::create<float>('c', {10, 10});
+    exp.linspace(1.f);
+
+    // first execution is recorded, next ones are using planned workspace blocks
+    for (int e = 0; e < 3; e++) {
+        auto input = NDArrayFactory::create_<float>('c', {10, 10});
+        input->linspace(1.f);
+
+        auto result = executeTransformGraph(graphId, input);
+        ASSERT_TRUE(exp.equalsTo(result));
+
+        delete result;
+    }
+
+    GraphHolder::getInstance()->dropGraphAny(graphId);
+}
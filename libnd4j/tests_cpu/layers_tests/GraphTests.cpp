@@ -332,6 +332,88 @@ TEST_F(GraphTests, QuadInput1) {
     delete graph;
 }
 
+TEST_F(GraphTests, QuadInput2) {
+    auto graph = new Graph();
+    graph->getExecutorConfiguration()->_parallelLayers = true;
+
+    for (int e = 0; e < 4; e++) {
+        auto x = NDArrayFactory::create_<float>('c', {5, 5});
+        x->assign((float) -e);
+        graph->getVariableSpace()->putVariable(-(e + 1), x);
+    }
+
+    auto nodeA = new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1}, {11});
+    auto nodeB = new Node(OpType_TRANSFORM_SAME, transform::Abs, 2, {-2}, {11});
+    auto nodeC = new Node(OpType_TRANSFORM_SAME, transform::Abs, 3, {-3}, {21});
+    auto nodeD = new Node(OpType_TRANSFORM_SAME, transform::Abs, 4, {-4}, {21});
+
+    auto nodeP1 = new Node(OpType_PAIRWISE, pairwise::Add, 11, {1, 2}, {31});
+    auto nodeP2 = new Node(OpType_PAIRWISE, pairwise::Add, 21, {3, 4}, {31});
+
+    auto nodeZ = new Node(OpType_PAIRWISE, pairwise::Add, 31, {11, 21}, {});
+
+    graph->addNode(nodeA);
+    graph->addNode(nodeB);
+    graph->addNode(nodeC);
+    graph->addNode(nodeD);
+    graph->addNode(nodeP1);
+    graph->addNode(nodeP2);
+    graph->addNode(nodeZ);
+
+    ASSERT_EQ(4, graph->rootNodes());
+    ASSERT_EQ(7, graph->totalNodes());
+
+    auto status = GraphExecutioner::execute(graph);
+    ASSERT_EQ(Status::OK(), status);
+
+    ASSERT_NEAR(1.0, graph->getVariableSpace()->getVariable(11)->getNDArray()->reduceNumber(reduce::Mean).e<float>(0), 1e-5);
+    ASSERT_NEAR(5.0, graph->getVariableSpace()->getVariable(21)->getNDArray()->reduceNumber(reduce::Mean).e<float>(0), 1e-5);
+    ASSERT_NEAR(6.0, graph->getVariableSpace()->getVariable(31)->getNDArray()->reduceNumber(reduce::Mean).e<float>(0), 1e-5);
+
+    delete graph;
+}
+
+TEST_F(GraphTests, QuadInput3) {
+    auto graph = new Graph();
+    graph->getExecutorConfiguration()->_parallelLayers = true;
+
+    // arrays are above elementwise threshold, so each node would split its work over threads if it could
+    for (int e = 0; e < 4; e++) {
+        auto x = NDArrayFactory::create_<float>('c', {100, 100});
+        x->assign((float) -e);
+        graph->getVariableSpace()->putVariable(-(e + 1), x);
+    }
+
+    auto exp = NDArrayFactory::create<float>('c', {100, 100});
+    exp.assign(6.0f);
+
+    auto nodeA = new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1}, {11});
+    auto nodeB = new Node(OpType_TRANSFORM_SAME, transform::Abs, 2, {-2}, {11});
+    auto nodeC = new Node(OpType_TRANSFORM_SAME, transform::Abs, 3, {-3}, {21});
+    auto nodeD = new Node(OpType_TRANSFORM_SAME, transform::Abs, 4, {-4}, {21});
+
+    auto nodeP1 = new Node(OpType_PAIRWISE, pairwise::Add, 11, {1, 2}, {31});
+    auto nodeP2 = new Node(OpType_PAIRWISE, pairwise::Add, 21, {3, 4}, {31});
+
+    auto nodeZ = new Node(OpType_PAIRWISE, pairwise::Add, 31, {11, 21}, {});
+
+    graph->addNode(nodeA);
+    graph->addNode(nodeB);
+    graph->addNode(nodeC);
+    graph->addNode(nodeD);
+    graph->addNode(nodeP1);
+    graph->addNode(nodeP2);
+    graph->addNode(nodeZ);
+
+    auto status = GraphExecutioner::execute(graph);
+    ASSERT_EQ(Status::OK(), status);
+
+    auto z = graph->getVariableSpace()->getVariable(31)->getNDArray();
+    ASSERT_TRUE(exp.equalsTo(z));
+
+    delete graph;
+}
+
 TEST_F(GraphTests, InternalBranching1) {
     auto graph = new Graph();
 
@@ -1602,6 +1684,93 @@ TEST_F(GraphTests, Test_Inplace_Outputs_2) {
 #endif
 }
 
+TEST_F(GraphTests, Test_Elementwise_Fusion_1) {
+    auto graph = new Graph();
+
+    // fusion is opt-in
+    graph->getExecutorConfiguration()->_elementwiseFusion = true;
+    Environment::getInstance()->setElementwiseFusion(true);
+
+    // long enough for a few fused blocks
+    auto x = NDArrayFactory::create_<float>('c', {100, 100});
+    auto y = NDArrayFactory::create_<float>('c', {100, 100});
+    x->linspace(-50.0, 0.01);
+    y->assign(0.5f);
+
+    auto exp = *x + *y;
+    exp.applyScalar(scalar::RELU, 0.0f);
+    exp *= 2.0f;
+
+    graph->getVariableSpace()->putVariable(-1, x);
+    graph->getVariableSpace()->putVariable(-2, y);
+
+    // add -> relu -> mul, each one is the only consumer of previous one
+    auto nodeA = new Node(OpType_PAIRWISE, pairwise::Add, 1, {-1, -2}, {2});
+    auto nodeB = new Node(OpType_SCALAR, scalar::RELU, 2, {1}, {3}, {}, 0.0f);
+    auto nodeC = new Node(OpType_SCALAR, scalar::Multiply, 3, {2}, {}, {}, 2.0f);
+
+    graph->addNode(nodeA);
+    graph->addNode(nodeB);
+    graph->addNode(nodeC);
+
+    graph->buildGraph();
+    Environment::getInstance()->setElementwiseFusion(false);
+
+    ASSERT_EQ(1, graph->fusedGroups()->size());
+    ASSERT_EQ(std::vector<int>({1, 2, 3}), graph->fusedGroups()->at(0));
+    ASSERT_TRUE(nodeA->isFused());
+    ASSERT_TRUE(nodeB->isFused());
+    ASSERT_FALSE(nodeC->isFused());
+    ASSERT_EQ(3, nodeB->fusedInto());
+
+    auto status = GraphExecutioner::execute(graph);
+    ASSERT_EQ(Status::OK(), status);
+
+    auto z = graph->getVariableSpace()->getVariable(3)->getNDArray();
+
+    ASSERT_TRUE(exp.isSameShape(z));
+    ASSERT_TRUE(exp.equalsTo(z));
+
+    delete graph;
+}
+
+TEST_F(GraphTests, Test_Elementwise_Fusion_2) {
+    auto graph = new Graph();
+
+    auto x = NDArrayFactory::create_<float>('c', {5, 5});
+    x->linspace(-12.0);
+
+    auto exp = NDArrayFactory::create<float>('c', {5, 5});
+    exp.linspace(-12.0);
+    exp.applyTransform(transform::Abs, nullptr, nullptr);
+    exp.applyScalar(scalar::Subtract, 1.0f);
+
+    graph->getVariableSpace()->putVariable(-1, x);
+
+    auto nodeA = new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1}, {2});
+    auto nodeB = new Node(OpType_SCALAR, scalar::Subtract, 2, {1}, {}, {}, 1.0f);
+
+    graph->addNode(nodeA);
+    graph->addNode(nodeB);
+
+    graph->buildGraph();
+
+    // fusion is disabled by default, so both nodes are executed as is
+    ASSERT_EQ(0, graph->fusedGroups()->size());
+    ASSERT_FALSE(nodeA->isFused());
+
+    auto status = GraphExecutioner::execute(graph);
+    ASSERT_EQ(Status::OK(), status);
+
+    ASSERT_TRUE(graph->getVariableSpace()->getVariable(1)->hasNDArray());
+
+    auto z = graph->getVariableSpace()->getVariable(2)->getNDArray();
+
+    ASSERT_TRUE(exp.equalsTo(z));
+
+    delete graph;
+}
+
 TEST_F(GraphTests, Test_Minifier_1) {
     // run preprocessor to produce single header
     // if all ok - return value is 0, if error - non-zero value will be returned
@@ -26,6 +26,7 @@
 #include <ops/declarable/helpers/rnn.h>
 #include <ops/declarable/helpers/sg_cb.h>
 #include <MmulHelper.h>
+#include <helpers/PrimitiveCache.h>
 #include <GradCheck.h>
 #include <ops/declarable/CustomOperations.h>
 
@@ -2055,4 +2056,59 @@ TEST_F(HelpersTests1, mmulMxV_7) {
 
     nd4j::MmulHelper::mmul(&a, &x, &y, 1., 0.);    
     ASSERT_TRUE(y.equalsTo(&exp));    
-}
\ No newline at end of file
+}
+
+//////////////////////////////////////////////////////////////////////////
+TEST_F(HelpersTests1, PrimitiveCache_1) {
+
+    PrimitiveCache<int> cache(4);
+    PrimitiveCache<int>::Key key("conv2d", {1, 2, 3});
+
+    ASSERT_TRUE(cache.acquire(key) == nullptr);
+    ASSERT_EQ(1, cache.misses());
+
+    // two threads used the same key at once, so both primitives are pooled
+    auto first = std::make_shared<int>(1);
+    auto second = std::make_shared<int>(2);
+    cache.release(key, first);
+    cache.release(key, second);
+    ASSERT_EQ(2, cache.cachedEntries());
+
+    auto a = cache.acquire(key);
+    auto b = cache.acquire(key);
+    ASSERT_TRUE(a != nullptr && b != nullptr && a != b);
+    ASSERT_TRUE(cache.acquire(key) == nullptr);
+
+    ASSERT_EQ(2, cache.hits());
+    ASSERT_EQ(2, cache.misses());
+    ASSERT_EQ(0, cache.cachedEntries());
+
+    cache.purge();
+    ASSERT_EQ(0, cache.hits());
+    ASSERT_EQ(0, cache.misses());
+}
+
+//////////////////////////////////////////////////////////////////////////
+TEST_F(HelpersTests1, PrimitiveCache_2) {
+
+    PrimitiveCache<int> cache(2);
+    PrimitiveCache<int>::Key keyA("matmul", {1});
+    PrimitiveCache<int>::Key keyB("matmul", {2});
+    PrimitiveCache<int>::Key keyC("matmul", {3});
+
+    cache.release(keyA, std::make_shared<int>(1));
+    auto checkedOut = cache.acquire(keyA);
+
+    // key A is least recently used one, so it's evicted while its primitive is checked out
+    cache.release(keyB, std::make_shared<int>(2));
+    cache.release(keyC, std::make_shared<int>(3));
+    ASSERT_EQ(2, cache.cachedEntries());
+
+    // checked out primitive is put back under new entry, which evicts key B now
+    cache.release(keyA, checkedOut);
+    ASSERT_EQ(2, cache.cachedEntries());
+
+    ASSERT_TRUE(cache.acquire(keyB) == nullptr);
+    ASSERT_TRUE(cache.acquire(keyA) == checkedOut);
+    ASSERT_TRUE(cache.acquire(keyC) != nullptr);
+}
@@ -24,6 +24,8 @@
 #include <ops/declarable/OpRegistrator.h>
 #include <graph/GraphHolder.h>
 #include <graph/FlatUtils.h>
+#include <graph/profiling/OpProfiler.h>
+#include <memory/AllocationCounter.h>
 #include "testlayers.h"
 #include <array>
 
@@ -1174,4 +1176,85 @@ TEST_F(JavaInteropTests, Test_Results_Conversion_1) {
 
 
 //     ops.execAggregateBatchFloat(nullptr, numAggregates, opNum, maxArgs, maxShapes, maxIntArrays, maxIntArraySize, maxIndexArguments, maxRealArguments, pointer.data());
-// }
\ No newline at end of file
+// }
+
+TEST_F(JavaInteropTests, Test_OpProfiler_1) {
+    auto x = NDArrayFactory::create<float>('c', {1, 6}, {1, 2, 3, 4, 5, 6});
+    auto z = NDArrayFactory::create<float>('c', {6});
+    auto t = NDArrayFactory::create<float>('c', {1, 6});
+
+    nd4j::ops::squeeze op;
+
+    Nd4jPointer ptrsInBuffer[] = {(Nd4jPointer) x.getBuffer()};
+    Nd4jPointer ptrsInShapes[] = {(Nd4jPointer) x.getShapeInfo()};
+
+    Nd4jPointer ptrsOutBuffers[] = {(Nd4jPointer) z.getBuffer()};
+    Nd4jPointer ptrsOutShapes[] = {(Nd4jPointer) z.getShapeInfo()};
+
+    NativeOps nativeOps;
+    nativeOps.enableOpProfiler(true);
+    nativeOps.resetOpProfiler();
+
+    for (int e = 0; e < 3; e++) {
+        auto status = nativeOps.execCustomOp(nullptr, op.getOpHash(), ptrsInBuffer, ptrsInShapes, 1, ptrsOutBuffers, ptrsOutShapes, 1, nullptr, 0, nullptr, 0, nullptr, 0, false);
+        ASSERT_EQ(Status::OK(), status);
+    }
+
+    nativeOps.execTransformSame(nullptr, transform::Neg, x.getBuffer(), x.getShapeInfo(), nullptr, nullptr, t.getBuffer(), t.getShapeInfo(), nullptr, nullptr, nullptr);
+
+    // calls made while profiler is disabled aren't recorded
+    nativeOps.enableOpProfiler(false);
+    nativeOps.execCustomOp(nullptr, op.getOpHash(), ptrsInBuffer, ptrsInShapes, 1, ptrsOutBuffers, ptrsOutShapes, 1, nullptr, 0, nullptr, 0, nullptr, 0, false);
+
+    auto json = nativeOps.getOpProfilerSnapshot(true);
+    std::string profile(json);
+    nativeOps.deleteCharArray((Nd4jPointer) json);
+
+    ASSERT_NE(std::string::npos, profile.find("{\"name\": \"squeeze\", \"calls\": 3,"));
+    ASSERT_NE(std::string::npos, profile.find("{\"shapes\": \"[1,6]\", \"calls\": 3}"));
+    ASSERT_NE(std::string::npos, profile.find("{\"name\": \"transform_same:" + std::to_string(transform::Neg) + "\", \"calls\": 1,"));
+
+    // snapshot above has reset stats
+    ASSERT_TRUE(nd4j::graph::OpProfiler::getInstance()->snapshot().empty());
+}
+
+TEST_F(JavaInteropTests, Test_OpProfiler_2) {
+    nd4j::graph::OpStats stats;
+
+    for (int e = 1; e <= 100; e++)
+        stats.record(e * 1000L, 0L, 16L, "[]");
+
+    ASSERT_EQ(100, stats.calls());
+    ASSERT_EQ(1000, stats.minTime());
+    ASSERT_EQ(100000, stats.maxTime());
+    ASSERT_EQ(1600, stats.heapBytes());
+
+    // histogram buckets are 25% wide at most
+    auto p50 = stats.percentile(50);
+    ASSERT_TRUE(p50 >= 51000 && p50 <= 63750);
+    ASSERT_EQ(100000, stats.percentile(99));
+}
+
+TEST_F(JavaInteropTests, Test_OpProfiler_3) {
+    auto x = NDArrayFactory::create<float>('c', {8});
+
+    auto profiler = nd4j::graph::OpProfiler::getInstance();
+    profiler->setEnabled(true);
+    profiler->reset();
+
+    {
+        nd4j::graph::OpProfilerScope scope("test", 1, x.getShapeInfo());
+
+        // allocations made by worker threads belong to the op too
+#pragma omp parallel for num_threads(4)
+        for (int e = 0; e < 8; e++)
+            nd4j::memory::AllocationCounter::countHeapBytes(100);
+    }
+
+    profiler->setEnabled(false);
+
+    auto stats = profiler->snapshot(true);
+    ASSERT_EQ(1, stats.count("test:1"));
+    ASSERT_EQ(800, stats["test:1"].heapBytes());
+    ASSERT_EQ(0, stats["test:1"].partialMemoryCalls());
+}
@@ -321,6 +321,35 @@ TEST_F(LegacyOpsTests, ReduceTests_8) {
 }
 
 
+TEST_F(LegacyOpsTests, ReduceTests_9) {
+    // few long TADs, each of them is reduced by several threads
+    auto x = NDArrayFactory::create<float>('c', {2, 50000});
+    x.linspace(1);
+
+    auto sum = x.reduceAlongDims(reduce::Sum, {1});
+    auto max = x.reduceAlongDims(reduce::Max, {1});
+    auto mean = x.reduceAlongDims(reduce::Mean, {1});
+
+    auto expSum = NDArrayFactory::create<float>('c', {2}, {1250025000.f, 3750025000.f});
+    auto expMax = NDArrayFactory::create<float>('c', {2}, {50000.f, 100000.f});
+    auto expMean = NDArrayFactory::create<float>('c', {2}, {25000.5f, 75000.5f});
+
+    ASSERT_TRUE(expSum.equalsTo(sum));
+    ASSERT_TRUE(expMax.equalsTo(max));
+    ASSERT_TRUE(expMean.equalsTo(mean));
+}
+
+TEST_F(LegacyOpsTests, ReduceTests_10) {
+    // many strided TADs
+    auto x = NDArrayFactory::create<float>('c', {2000, 3});
+    x.linspace(1);
+
+    auto sum = x.reduceAlongDims(reduce::Sum, {0});
+    auto exp = NDArrayFactory::create<float>('c', {3}, {5999000.f, 6001000.f, 6003000.f});
+
+    ASSERT_TRUE(exp.equalsTo(sum));
+}
+
 TEST_F(LegacyOpsTests, IndexReduceTests_1) {
     auto x = NDArrayFactory::create<float>('c', {5, 5});
     x.linspace(1);
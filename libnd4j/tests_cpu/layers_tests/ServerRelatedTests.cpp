@@ -22,6 +22,8 @@
 #include <GraphExecutioner.h>
 #include <graph/GraphHolder.h>
 #include <graph/InferenceRequest.h>
+#include <graph/RequestBatcher.h>
+#include <thread>
 
 using namespace nd4j;
 using namespace nd4j::graph;
@@ -80,6 +82,108 @@ TEST_F(ServerRelatedTests, Basic_Output_Test_1) {
     ASSERT_EQ(*array2, *restored.byId("second")->getNDArray());
     ASSERT_EQ(*array3, *restored.byId("second indexed")->getNDArray());
 }
+
+TEST_F(ServerRelatedTests, Batching_Test_1) {
+    auto graph = new Graph();
+    graph->getVariableSpace()->putVariable(-1, NDArrayFactory::create_<float>('c', {2, 3}));
+    graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1}, {}));
+
+    GraphHolder::getInstance()->registerGraph(11910L, graph);
+
+    RequestBatcher batcher(8, 200000);
+
+    const int numThreads = 4;
+    std::vector<bool> results(numThreads, false);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; t++) {
+        threads.emplace_back(std::thread([&, t] {
+            auto input = NDArrayFactory::create_<float>('c', {2, 3});
+            input->assign((float) -(t + 1));
+
+            std::vector<Variable*> inputs = {new Variable(input, nullptr, -1, 0)};
+            auto outputs = batcher.execute(11910L, inputs);
+
+            auto exp = NDArrayFactory::create<float>('c', {2, 3});
+            exp.assign((float) (t + 1));
+
+            results[t] = outputs->size() == 1 && exp.equalsTo(outputs->at(0)->getNDArray());
+
+            for (auto v: *outputs)
+                delete v;
+
+            delete outputs;
+        }));
+    }
+
+    for (auto &t: threads)
+        t.join();
+
+    for (int t = 0; t < numThreads; t++)
+        ASSERT_TRUE(results[t]);
+
+    // every request was executed exactly once, either separately or within some batch
+    auto histogram = batcher.batchSizeHistogram();
+    Nd4jLong executed = 0;
+    for (int e = 0; e < (int) histogram.size(); e++)
+        executed += e * histogram[e];
+
+    ASSERT_EQ(numThreads, executed);
+
+    GraphHolder::getInstance()->dropGraphAny(11910L);
+}
+
+TEST_F(ServerRelatedTests, Batching_Test_2) {
+    // full reduction: output doesn't follow batch dimension, so merged batch can't be split back
+    auto graph = new Graph();
+    graph->getVariableSpace()->putVariable(-1, NDArrayFactory::create_<float>('c', {2, 3}));
+    graph->addNode(new Node(OpType_REDUCE_SAME, reduce::Sum, 1, {-1}, {}, {}));
+
+    GraphHolder::getInstance()->registerGraph(11911L, graph);
+
+    RequestBatcher batcher(8, 200000);
+
+    auto request = [&](int t) -> bool {
+        auto input = NDArrayFactory::create_<float>('c', {2, 3});
+        input->assign((float) (t + 1));
+
+        std::vector<Variable*> inputs = {new Variable(input, nullptr, -1, 0)};
+        auto outputs = batcher.execute(11911L, inputs);
+
+        bool result = outputs->size() == 1 && outputs->at(0)->getNDArray()->e<float>(0) == 6.f * (t + 1);
+
+        for (auto v: *outputs)
+            delete v;
+
+        delete outputs;
+        return result;
+    };
+
+    const int numThreads = 4;
+    std::vector<bool> results(numThreads, false);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; t++)
+        threads.emplace_back(std::thread([&, t] { results[t] = request(t); }));
+
+    for (auto &t: threads)
+        t.join();
+
+    for (int t = 0; t < numThreads; t++)
+        ASSERT_TRUE(results[t]);
+
+    // once some batch has shown outputs can't be split, later requests aren't queued anymore
+    auto histogram = batcher.batchSizeHistogram();
+    bool wasMerged = false;
+    for (int e = 2; e < (int) histogram.size(); e++)
+        wasMerged |= histogram[e] > 0;
+
+    ASSERT_TRUE(request(numThreads));
+
+    if (wasMerged)
+        ASSERT_EQ(histogram, batcher.batchSizeHistogram());
+
+    GraphHolder::getInstance()->dropGraphAny(11911L);
+}
+
 #if GRAPH_FILES_OK
 TEST_F(ServerRelatedTests, Basic_Execution_Test_1) {
     flatbuffers::FlatBufferBuilder builder(4096);
@@ -184,4 +288,46 @@ TEST_F(ServerRelatedTests, BasicExecutionTests_3) {
 
     GraphHolder::getInstance()->dropGraphAny(11903L);
 }
+
+TEST_F(ServerRelatedTests, BasicExecutionTests_4) {
+    auto oGraph = GraphExecutioner::importFromFlatBuffers("./resources/reduce_dim_false.fb");
+
+    GraphHolder::getInstance()->registerGraph(11904L, oGraph);
+
+    for (int e = 1; e <= 3; e++) {
+        flatbuffers::FlatBufferBuilder builder(4096);
+        flatbuffers::FlatBufferBuilder otherBuilder(4096);
+
+        auto input0 = NDArrayFactory::create<float>('c', {3, 3});
+        input0.assign((float) e);
+        auto exp = NDArrayFactory::create<float>('c', {3}, {3.f * e, 3.f * e, 3.f * e});
+
+        InferenceRequest ir(11904L);
+        ir.appendVariable(1, 0, &input0);
+
+        auto af = ir.asFlatInferenceRequest(otherBuilder);
+        otherBuilder.Finish(af);
+        auto fir = GetFlatInferenceRequest(otherBuilder.GetBufferPointer());
+
+        auto flatResult = GraphHolder::getInstance()->execute(fir->id(), builder, fir);
+        builder.Finish(flatResult);
+
+        ExecutionResult restored(GetFlatResult(builder.GetBufferPointer()));
+        ASSERT_EQ(1, restored.size());
+        ASSERT_EQ(exp, *restored.at(0)->getNDArray());
+
+        // execution state goes back to the pool, and shared graph isn't touched
+        ASSERT_EQ(1, GraphHolder::getInstance()->idleSessions(11904L));
+    }
+
+    auto outputs = oGraph->fetchOutputs();
+    for (auto v: *outputs)
+        ASSERT_FALSE(v->hasNDArray());
+
+    delete outputs;
+
+    GraphHolder::getInstance()->dropGraphAny(11904L);
+
+    ASSERT_EQ(0, GraphHolder::getInstance()->idleSessions(11904L));
+}
 #endif
@@ -19,6 +19,7 @@
 //
 
 #include <helpers/shape.h>
+#include <helpers/StridedIterator.h>
 #include "testlayers.h"
 #include <ops/declarable/headers/shape.h>
 
@@ -359,4 +360,35 @@ TEST_F(ShapeTests, Tests_Transpose_119_3) {
     ASSERT_TRUE(exp->equalsTo(z));
 
     delete exp;
-}
\ No newline at end of file
+}
+
+TEST_F(ShapeTests, Test_StridedIterator_1) {
+    auto x = NDArrayFactory::create<float>('c', {2, 3, 1, 4});
+    auto p = x.permute({3, 0, 2, 1});
+    auto shapeInfo = p->getShapeInfo();
+    auto length = p->lengthOf();
+
+    for (Nd4jLong start = 0; start < length; start += 5) {
+        nd4j::StridedIterator it(shapeInfo, start);
+        for (Nd4jLong e = start; e < length; e++)
+            ASSERT_EQ(shape::getIndexOffset(e, shapeInfo, length), it.next());
+    }
+
+    delete p;
+}
+
+TEST_F(ShapeTests, Test_StridedIterator_2) {
+    auto x = NDArrayFactory::create<float>('c', {4, 3, 5});
+    x.linspace(1.f);
+
+    auto p = x.permute({2, 0, 1});
+    auto exp = p->dup('c');
+    exp->applyScalar(scalar::Add, 1.f);
+
+    p->applyScalar(scalar::Add, 1.f);
+
+    ASSERT_TRUE(exp->equalsTo(p));
+
+    delete p;
+    delete exp;
+}
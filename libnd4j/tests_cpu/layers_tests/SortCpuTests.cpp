@@ -0,0 +1,109 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include "testlayers.h"
+#include <NDArray.h>
+#include <NativeOps.h>
+#include <helpers/ConstantTadHelper.h>
+#include <helpers/SortEngine.h>
+#include <cmath>
+
+using namespace nd4j;
+
+class SortCpuTests : public testing::Test {
+public:
+
+};
+
+
+TEST_F(SortCpuTests, test_sort_1) {
+    auto x = NDArrayFactory::create<float>('c', {7}, {3.f, NAN, -0.f, 1.f, -2.f, 0.f, INFINITY});
+
+    NativeOps nativeOps;
+    nativeOps.sort(nullptr, x.buffer(), x.shapeInfo(), nullptr, nullptr, false);
+
+    ASSERT_EQ(-2.f, x.e<float>(0));
+    ASSERT_TRUE(std::signbit(x.e<float>(1)));
+    ASSERT_EQ(0.f, x.e<float>(2));
+    ASSERT_FALSE(std::signbit(x.e<float>(2)));
+    ASSERT_EQ(1.f, x.e<float>(3));
+    ASSERT_EQ(3.f, x.e<float>(4));
+    ASSERT_EQ(INFINITY, x.e<float>(5));
+    ASSERT_TRUE(std::isnan(x.e<float>(6)));
+
+    // NaNs stay at the end in descending order
+    nativeOps.sort(nullptr, x.buffer(), x.shapeInfo(), nullptr, nullptr, true);
+
+    ASSERT_EQ(INFINITY, x.e<float>(0));
+    ASSERT_EQ(-2.f, x.e<float>(5));
+    ASSERT_TRUE(std::isnan(x.e<float>(6)));
+}
+
+TEST_F(SortCpuTests, test_sort_2) {
+    // long enough for radix sort
+    auto x = NDArrayFactory::create<int>('c', {4096});
+    auto e = NDArrayFactory::create<int>('c', {4096});
+    for (int i = 0; i < 4096; i++) {
+        x.p(i, ((i * 1031) % 4096) - 2048);
+        e.p(i, i - 2048);
+    }
+
+    NativeOps nativeOps;
+    nativeOps.sort(nullptr, x.buffer(), x.shapeInfo(), nullptr, nullptr, false);
+
+    ASSERT_EQ(e, x);
+}
+
+TEST_F(SortCpuTests, test_sort_tad_1) {
+    auto x = NDArrayFactory::create<double>('c', {3, 4}, {4., 2., 3., 1.,   -1., 8., 0., 5.,   2., 2., 7., -3.});
+    auto e = NDArrayFactory::create<double>('c', {3, 4}, {-1., 2., 0., -3.,   2., 2., 3., 1.,   4., 8., 7., 5.});
+
+    // columns are strided TADs
+    int dimension = 0;
+    auto packX = ConstantTadHelper::getInstance()->tadForDimensions(x.shapeInfo(), &dimension, 1);
+
+    NativeOps nativeOps;
+    nativeOps.sortTad(nullptr, x.buffer(), x.shapeInfo(), nullptr, nullptr, &dimension, 1, packX.primaryShapeInfo(), packX.primaryOffsets(), false);
+
+    ASSERT_EQ(e, x);
+}
+
+TEST_F(SortCpuTests, test_sort_by_key_1) {
+    auto k = NDArrayFactory::create<Nd4jLong>('c', {6}, {5, 1, 3, 1, 0, 3});
+    auto v = NDArrayFactory::create<float>('c', {6}, {0.f, 1.f, 2.f, 3.f, 4.f, 5.f});
+
+    auto ek = NDArrayFactory::create<Nd4jLong>('c', {6}, {0, 1, 1, 3, 3, 5});
+    auto ev = NDArrayFactory::create<float>('c', {6}, {4.f, 1.f, 3.f, 2.f, 5.f, 0.f});
+
+    NativeOps nativeOps;
+    nativeOps.sortByKey(nullptr, k.buffer(), k.shapeInfo(), nullptr, nullptr, v.buffer(), v.shapeInfo(), nullptr, nullptr, false);
+
+    ASSERT_EQ(ek, k);
+    ASSERT_EQ(ev, v);
+}
+
+TEST_F(SortCpuTests, test_merge_sort_1) {
+    std::vector<Nd4jLong> x(100000);
+    for (Nd4jLong e = 0; e < (Nd4jLong) x.size(); e++)
+        x[e] = (e * 7919) % 1000;
+
+    auto exp = x;
+    std::stable_sort(exp.begin(), exp.end());
+
+    SortEngine::mergeSort(x.data(), (Nd4jLong) x.size(), [] (const Nd4jLong a, const Nd4jLong b) { return a < b; });
+
+    ASSERT_EQ(exp, x);
+}
@@ -24,6 +24,8 @@
 #include "testlayers.h"
 #include <NDArray.h>
 #include <helpers/TAD.h>
+#include <helpers/ConstantTadHelper.h>
+#include <Environment.h>
 #include <array>
 
 using namespace nd4j;
@@ -162,6 +164,62 @@ TEST_F(TadTests, TadEdgeCase_2) {
     delete tad;
 }
 
+TEST_F(TadTests, TadCache_1) {
+    auto array = NDArrayFactory::create<float>('c', {3, 4, 5});
+    std::vector<int> dims({0, 2});
+
+    shape::TAD tad(array.getShapeInfo(), dims.data(), dims.size());
+    tad.createTadOnlyShapeInfo();
+    tad.createOffsets();
+
+    auto hits = Environment::getInstance()->tadCacheHits();
+
+    auto packA = ConstantTadHelper::getInstance()->tadForDimensions(array.getShapeInfo(), dims);
+    auto packB = ConstantTadHelper::getInstance()->tadForDimensions(array.getShapeInfo(), dims);
+
+    // second request must be served from cache
+    ASSERT_EQ(hits + 1, Environment::getInstance()->tadCacheHits());
+    ASSERT_EQ(packA.primaryShapeInfo(), packB.primaryShapeInfo());
+    ASSERT_EQ(packA.primaryOffsets(), packB.primaryOffsets());
+
+    ASSERT_EQ(tad.numTads, packA.numberOfTads());
+    ASSERT_TRUE(shape::equalsStrict(tad.tadOnlyShapeInfo, packA.primaryShapeInfo()));
+    for (int e = 0; e < tad.numTads; e++)
+        ASSERT_EQ(tad.tadOffsets[e], packA.primaryOffsets()[e]);
+}
+
+TEST_F(TadTests, TadCache_2) {
+    auto arrayC = NDArrayFactory::create<float>('c', {3, 4});
+    auto arrayF = NDArrayFactory::create<float>('f', {3, 4});
+
+    auto packC = ConstantTadHelper::getInstance()->tadForDimensions(arrayC.getShapeInfo(), 1);
+    auto packF = ConstantTadHelper::getInstance()->tadForDimensions(arrayF.getShapeInfo(), 1);
+
+    // different strides must never share cache entry
+    ASSERT_NE(packC.primaryShapeInfo(), packF.primaryShapeInfo());
+    ASSERT_EQ(1, shape::stride(packC.primaryShapeInfo())[1]);
+    ASSERT_EQ(3, shape::stride(packF.primaryShapeInfo())[1]);
+}
+
+TEST_F(TadTests, TadCache_3) {
+    auto limit = Environment::getInstance()->tadCacheLimit();
+    Environment::getInstance()->setTadCacheLimit(2);
+    ConstantTadHelper::getInstance()->purge();
+
+    auto array = NDArrayFactory::create<float>('c', {2, 3, 4});
+    auto pack = ConstantTadHelper::getInstance()->tadForDimensions(array.getShapeInfo(), 0);
+    ConstantTadHelper::getInstance()->tadForDimensions(array.getShapeInfo(), 1);
+    ConstantTadHelper::getInstance()->tadForDimensions(array.getShapeInfo(), 2);
+
+    ASSERT_EQ(2, ConstantTadHelper::getInstance()->cachedEntries());
+
+    // evicted pack must still be usable by its holder
+    ASSERT_EQ(12, pack.numberOfTads());
+    ASSERT_EQ(2, shape::length(pack.primaryShapeInfo()));
+
+    Environment::getInstance()->setTadCacheLimit(limit);
+}
+
 /*
  // FIXME: we want this test passing eventually
 TEST_F(TadTests, Tad_1D_1) {
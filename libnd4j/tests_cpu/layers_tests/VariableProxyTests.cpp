@@ -20,6 +20,7 @@
 
 #include "testlayers.h"
 #include <graph/VariableProxy.h>
+#include <graph/Graph.h>
 
 using namespace nd4j;
 using namespace nd4j::graph;
@@ -170,4 +171,73 @@ TEST_F(VariableProxyTests, Test_Clone_1) {
     ASSERT_TRUE(clone->hasVariable(119));
 
     delete clone;
-}
\ No newline at end of file
+}
+
+TEST_F(VariableProxyTests, Test_CopyOnWrite_1) {
+    auto x = NDArrayFactory::create_<float>('c', {2, 2}, {1, 2, 3, 4});
+    auto y = NDArrayFactory::create_<float>('c', {2, 2}, {4, 2, 3, 1});
+    VariableSpace ref;
+
+    ref.putVariable(-118, x);
+    ref.putVariable(119, new Variable(nullptr, nullptr, 119));
+
+    VariableProxy proxy(&ref, true);
+
+    // variables with arrays are shared
+    ASSERT_TRUE(ref.getVariable(-118) == proxy.getVariable(-118));
+
+    // empty ones are replaced with local copies
+    auto local = proxy.getVariable(119);
+    ASSERT_FALSE(ref.getVariable(119) == local);
+    ASSERT_TRUE(local == proxy.getVariable(119));
+
+    local->setNDArray(y);
+    ASSERT_FALSE(ref.getVariable(119)->hasNDArray());
+
+    proxy.reset();
+
+    ASSERT_FALSE(proxy.getVariable(119)->hasNDArray());
+}
+
+TEST_F(VariableProxyTests, Test_CopyOnWrite_2) {
+    Graph graph;
+    graph.getVariableSpace()->putVariable(-1, NDArrayFactory::create_<float>('c', {2, 2}, {1, 2, 3, 4}));
+    graph.getVariableSpace()->putVariable(1, new Variable(nullptr, nullptr, 1));
+
+    // plain clone hands out Variables of original graph as is
+    auto clone = graph.cloneWithProxy();
+    ASSERT_FALSE(reinterpret_cast<VariableProxy*>(clone->getVariableSpace())->isCopyOnWrite());
+    ASSERT_TRUE(clone->getVariableSpace()->getVariable(1) == graph.getVariableSpace()->getVariable(1));
+    delete clone;
+
+    // copy-on-write clone keeps empty Variables of original graph untouched
+    clone = graph.cloneWithProxy(true);
+    ASSERT_TRUE(reinterpret_cast<VariableProxy*>(clone->getVariableSpace())->isCopyOnWrite());
+    ASSERT_TRUE(clone->getVariableSpace()->getVariable(-1) == graph.getVariableSpace()->getVariable(-1));
+    ASSERT_FALSE(clone->getVariableSpace()->getVariable(1) == graph.getVariableSpace()->getVariable(1));
+    delete clone;
+}
+
+TEST_F(VariableProxyTests, Test_Dense_1) {
+    VariableSpace ref;
+    ref.putVariable(-1, NDArrayFactory::create_<float>('c', {2, 2}, {1, 2, 3, 4}));
+    ref.putVariable(1, new Variable());
+
+    std::vector<int> ids({-1, 1});
+    ref.setVariableIndex(std::make_shared<const VariableIndex>(ids));
+
+    VariableProxy proxy(&ref, true);
+    ASSERT_TRUE(proxy.variableIndex() == ref.variableIndex());
+
+    // constants are shared, empty output slots would be localized, so they aren't resolved densely
+    ASSERT_TRUE(proxy.denseVariable(-1) == ref.getVariable(-1));
+    ASSERT_TRUE(proxy.denseVariable(1, 0) == nullptr);
+
+    auto local = proxy.getVariable(1, 0);
+    ASSERT_TRUE(local != ref.getVariable(1, 0));
+    ASSERT_TRUE(proxy.denseVariable(1, 0) == local);
+
+    proxy.reset();
+    ASSERT_TRUE(proxy.variableIndex() == ref.variableIndex());
+    ASSERT_TRUE(proxy.denseVariable(1, 0) == nullptr);
+}
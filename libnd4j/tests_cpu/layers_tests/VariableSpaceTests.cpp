@@ -189,6 +189,77 @@ TEST_F(VariableSpaceTest, CloneTests_2) {
 }
 
 
+TEST_F(VariableSpaceTest, DenseIndex_1) {
+    VariableSpace space;
+
+    // variable stored before index is attached must be mirrored
+    space.putVariable(-1, NDArrayFactory::create_<float>('c', {2, 2}));
+
+    std::vector<int> ids({-1, 1, 2, 3});
+    space.setVariableIndex(std::make_shared<const VariableIndex>(ids));
+
+    ASSERT_TRUE(space.hasVariable(-1));
+    ASSERT_TRUE(space.denseVariable(-1) == space.getVariable(-1));
+
+    ASSERT_FALSE(space.hasVariable(2));
+    ASSERT_TRUE(space.denseVariable(2) == nullptr);
+
+    space.putVariable(2, NDArrayFactory::create_<float>('c', {3}));
+    space.putVariable(2, 1, NDArrayFactory::create_<float>('c', {4}));
+
+    // index beyond dense width and non-indexed id go through maps
+    space.putVariable(3, VariableIndex::MAX_OUTPUTS, NDArrayFactory::create_<float>('c', {5}));
+    space.putVariable(100, NDArrayFactory::create_<float>('c', {6}));
+
+    ASSERT_TRUE(space.hasVariable(2));
+    ASSERT_TRUE(space.hasVariable(2, 1));
+    ASSERT_FALSE(space.hasVariable(2, 2));
+    ASSERT_EQ(3, space.getVariable(2)->getNDArray()->lengthOf());
+    ASSERT_EQ(4, space.getVariable(2, 1)->getNDArray()->lengthOf());
+    ASSERT_TRUE(space.denseVariable(2, 1) == space.getVariable(2, 1));
+
+    ASSERT_TRUE(space.hasVariable(3, VariableIndex::MAX_OUTPUTS));
+    ASSERT_TRUE(space.denseVariable(3, VariableIndex::MAX_OUTPUTS) == nullptr);
+    ASSERT_EQ(5, space.getVariable(3, VariableIndex::MAX_OUTPUTS)->getNDArray()->lengthOf());
+
+    ASSERT_TRUE(space.hasVariable(100));
+    ASSERT_TRUE(space.denseVariable(100) == nullptr);
+    ASSERT_EQ(6, space.getVariable(100)->getNDArray()->lengthOf());
+
+    auto clone = space.clone();
+    ASSERT_TRUE(clone->variableIndex() == space.variableIndex());
+    ASSERT_TRUE(clone->denseVariable(2, 1) != nullptr);
+    ASSERT_EQ(4, clone->denseVariable(2, 1)->getNDArray()->lengthOf());
+
+    delete clone;
+}
+
+TEST_F(VariableSpaceTest, DenseIndex_2) {
+    VariableIndex index(std::vector<int>({7, -3, 1000000, 7}));
+
+    // sparse ids are still mapped onto contiguous slots
+    ASSERT_EQ(3, index.size());
+    ASSERT_EQ(0, index.slot(-3));
+    ASSERT_EQ(1, index.slot(7));
+    ASSERT_EQ(2, index.slot(1000000));
+    ASSERT_EQ(-1, index.slot(8));
+    ASSERT_EQ(1000000, index.id(2));
+
+    FlowPath flow;
+    flow.markBranch(7, 1);
+    flow.markBranch(8, 2);
+
+    flow.setVariableIndex(std::make_shared<const VariableIndex>(std::vector<int>({7, -3, 1000000})));
+
+    ASSERT_EQ(1, flow.branch(7));
+    ASSERT_EQ(2, flow.branch(8));
+
+    flow.markExecuted(1000000, true);
+    ASSERT_TRUE(flow.wasExecuted(1000000));
+    ASSERT_FALSE(flow.wasExecuted(7));
+}
+
+
 TEST_F(VariableSpaceTest, Test_DType_Conversion_1) {
     /*
     VariableSpace spaceA;
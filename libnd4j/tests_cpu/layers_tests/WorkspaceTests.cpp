@@ -26,6 +26,7 @@
 #include <Workspace.h>
 #include <MemoryRegistrator.h>
 #include <MmulHelper.h>
+#include <algorithm>
 
 using namespace nd4j;
 using namespace nd4j::memory;
@@ -243,8 +244,9 @@ TEST_F(WorkspaceTests, Test_Externalized_1) {
 
     auto x = NDArrayFactory::create<float>('c', {10, 10}, &ws);
 
-    ASSERT_EQ(64 + 400, ws.getUsedSize());
-    ASSERT_EQ(64 + 400, ws.getCurrentOffset());
+    // allocations are aligned to 64 bytes
+    ASSERT_EQ(64 + 448, ws.getUsedSize());
+    ASSERT_EQ(64 + 448, ws.getCurrentOffset());
 
     x.assign(2.0);
 
@@ -252,6 +254,102 @@ TEST_F(WorkspaceTests, Test_Externalized_1) {
     ASSERT_NEAR(2.0f, m, 1e-5);
 }
 
+TEST_F(WorkspaceTests, Test_ScopeTo_1) {
+    Workspace ws(1024);
+
+    ws.scopeTo(256, 512);
+
+    auto p0 = reinterpret_cast<int8_t *>(ws.allocateBytes(200));
+    ASSERT_EQ(512, ws.getCurrentOffset());
+    ASSERT_EQ(0, ws.getSpilledSize());
+
+    // this allocation crosses the limit, so it goes to spills
+    ws.allocateBytes(100);
+    ASSERT_EQ(512, ws.getCurrentOffset());
+    ASSERT_EQ(128, ws.getSpilledSize());
+
+    ws.scopeTo(256, 512);
+    auto p1 = reinterpret_cast<int8_t *>(ws.allocateBytes(200));
+    ASSERT_TRUE(p0 == p1);
+
+    // limit is gone after scopeOut
+    ws.scopeOut();
+    ws.allocateBytes(800);
+    ASSERT_EQ(832, ws.getCurrentOffset());
+}
+
+TEST_F(WorkspaceTests, Test_Alignment_1) {
+    Workspace ws(4096);
+
+    for (int e = 1; e < 20; e++) {
+        auto p = ws.allocateBytes(e * 3);
+        ASSERT_EQ(0, reinterpret_cast<Nd4jLong>(p) % Workspace::ALIGNMENT);
+    }
+
+    // spills are aligned as well
+    auto p = ws.allocateBytes(8192);
+    ASSERT_EQ(0, reinterpret_cast<Nd4jLong>(p) % Workspace::ALIGNMENT);
+}
+
+TEST_F(WorkspaceTests, Test_Spills_Reuse_1) {
+    Workspace ws(1024);
+
+    ws.scopeTo(0L, 0L);
+    auto p0 = ws.allocateBytes(4000);
+    ASSERT_EQ(4032, ws.getSpilledSize());
+    ws.scopeOut();
+
+    // spill chunk of previous cycle is reused
+    ws.scopeIn();
+    ws.scopeTo(0L, 0L);
+    auto p1 = ws.allocateBytes(3000);
+    ASSERT_TRUE(p0 == p1);
+    ASSERT_EQ(3008, ws.getSpilledSize());
+    ws.scopeOut();
+}
+
+TEST_F(WorkspaceTests, Test_Concurrent_Allocations_1) {
+    const int numAllocations = 1000;
+    Workspace ws(numAllocations * 128);
+    std::vector<int8_t*> pointers(numAllocations);
+
+#pragma omp parallel for num_threads(4)
+    for (int e = 0; e < numAllocations; e++)
+        pointers[e] = reinterpret_cast<int8_t *>(ws.allocateBytes(100));
+
+    // every allocation got its own 128 bytes within workspace
+    ASSERT_EQ(numAllocations * 128, ws.getCurrentOffset());
+    ASSERT_EQ(0, ws.getSpilledSize());
+
+    std::sort(pointers.begin(), pointers.end());
+    for (int e = 1; e < numAllocations; e++)
+        ASSERT_EQ(128, pointers[e] - pointers[e - 1]);
+}
+
+TEST_F(WorkspaceTests, Test_AllocationPolicy_1) {
+    AllocationPolicy policy(NUMA_INTERLEAVE, HUGE_PAGES_TRANSPARENT, true);
+    Workspace ws(4L * 1024L * 1024L, policy);
+
+    auto x = NDArrayFactory::create<float>('c', {100, 100}, &ws);
+    x.assign(2.0f);
+    ASSERT_NEAR(2.0f, x.meanNumber().e<float>(0), 1e-5f);
+
+    // growth keeps policy
+    ws.expandTo(8L * 1024L * 1024L);
+    ASSERT_EQ(NUMA_INTERLEAVE, ws.getAllocationPolicy().numa);
+    ASSERT_EQ(HUGE_PAGES_TRANSPARENT, ws.getAllocationPolicy().hugePages);
+
+    // whole buffer was touched on allocation, so all of it is resident somewhere
+    MemoryReport report;
+    if (ws.retrieveNumaStatistics(report)) {
+        Nd4jLong resident = 0;
+        for (const auto &v: report.getNumaBytes())
+            resident += v.second;
+
+        ASSERT_EQ(ws.getCurrentSize(), resident);
+    }
+}
+
 // TODO: uncomment this test once long shapes are introduced
 /*
 TEST_F(WorkspaceTests, Test_Big_Allocation_1) {